@@ -0,0 +1,462 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_ANALYSIS_ANALYZE_BACKTRACKING_HPP
+#define TAO_PEGTL_ANALYSIS_ANALYZE_BACKTRACKING_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <iostream>
+
+#include "../config.hpp"
+
+#include "analyze_cycles.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::analysis
+{
+   // A cost model for backtracking that only uses the information from
+   // analyze_t, i.e. the rule types and sub-rules; the sub-rules of a rule
+   // that are attempted at the position where the rule starts are the same
+   // as for analyze_cycles, except that all alternatives of a sor are
+   // attempted in the worst case.
+   //
+   // Exponential: A sor that attempts another rule at its start position
+   // via more than one of its alternatives, when that other rule leads back
+   // to the sor; every level of nesting multiplies the work.
+   //
+   // Quadratic: A repeated sub-rule of a rule, i.e. one that is followed by
+   // a sub-rule leading back to the rule without consuming input, that is a
+   // sor where an alternative that can consume an unbounded amount of input
+   // and then fail is followed by an alternative that consumes a bounded
+   // amount of input. The repetition then continues a bounded distance
+   // from where the failed alternative started and can re-scan the same
+   // input again and again.
+   //
+   // Rules that can not fail, or that raise an exception instead of failing
+   // like must, are not visible in analyze_t; only a rule of type opt with
+   // sub-rules is assumed to never fail, a rule is assumed to consume an
+   // unbounded amount of input when it can reach a cycle of the grammar.
+
+   struct analyze_backtracking_impl
+      : analyze_cycles_impl
+   {
+   protected:
+      explicit analyze_backtracking_impl( const bool verbose ) noexcept
+         : analyze_cycles_impl( verbose )
+      {
+      }
+
+      // The sub-rules attempted at the start of rule i are the edges from
+      // m_offsets[ i ] to m_starts[ i ] - 1.
+
+      std::vector< std::size_t > m_starts;
+      std::vector< std::size_t > m_components;
+      std::vector< bool > m_cyclic;
+      std::vector< bool > m_unbounded;
+      std::vector< bool > m_infallible;
+      std::vector< bool > m_wastes;
+      std::vector< std::pair< std::size_t, std::size_t > > m_reasons;
+
+      [[nodiscard]] std::size_t subs( const std::size_t i ) const noexcept
+      {
+         return m_offsets[ i + 1 ] - m_offsets[ i ];
+      }
+
+      [[nodiscard]] std::string_view name( const std::size_t i ) const noexcept
+      {
+         return m_rules[ i ]->first;
+      }
+
+      void prepare_starts()
+      {
+         cycle_search search( m_types.data(), m_offsets.data(), m_edges.data(), m_rules.size(), m_states.data(), m_frames.data() );
+         (void)search.problems( []( const std::size_t /*unused*/ ) {} );
+         m_starts.reserve( m_rules.size() );
+         for( std::size_t i = 0; i < m_rules.size(); ++i ) {
+            auto e = m_offsets[ i ];
+            if( m_types[ i ] == rule_type::sor ) {
+               e = m_offsets[ i + 1 ];
+            }
+            else {
+               while( e != m_offsets[ i + 1 ] ) {
+                  if( m_states[ m_edges[ e++ ] ].result ) {
+                     break;
+                  }
+               }
+            }
+            m_starts.emplace_back( e );
+         }
+      }
+
+      // Strongly connected components with Kosaraju's algorithm, a rule is
+      // cyclic when it can reach itself.
+
+      void prepare_components()
+      {
+         const auto size = m_rules.size();
+         std::vector< std::size_t > order;
+         std::vector< bool > seen( size, false );
+         std::vector< std::pair< std::size_t, std::size_t > > stack;
+         for( std::size_t r = 0; r < size; ++r ) {
+            if( seen[ r ] ) {
+               continue;
+            }
+            seen[ r ] = true;
+            stack.emplace_back( r, m_offsets[ r ] );
+            while( !stack.empty() ) {
+               auto& [ i, e ] = stack.back();
+               if( e != m_offsets[ i + 1 ] ) {
+                  const auto j = m_edges[ e++ ];
+                  if( !seen[ j ] ) {
+                     seen[ j ] = true;
+                     stack.emplace_back( j, m_offsets[ j ] );
+                  }
+               }
+               else {
+                  order.emplace_back( i );
+                  stack.pop_back();
+               }
+            }
+         }
+         std::vector< std::size_t > offsets( size + 1, 0 );
+         for( const auto j : m_edges ) {
+            ++offsets[ j + 1 ];
+         }
+         for( std::size_t i = 0; i < size; ++i ) {
+            offsets[ i + 1 ] += offsets[ i ];
+         }
+         std::vector< std::size_t > reverse( m_edges.size() );
+         std::vector< std::size_t > fill( offsets.begin(), offsets.end() - 1 );
+         for( std::size_t i = 0; i < size; ++i ) {
+            for( auto e = m_offsets[ i ]; e != m_offsets[ i + 1 ]; ++e ) {
+               reverse[ fill[ m_edges[ e ] ]++ ] = i;
+            }
+         }
+         m_components.assign( size, size );
+         m_cyclic.assign( size, false );
+         std::vector< std::size_t > todo;
+         for( auto o = order.rbegin(); o != order.rend(); ++o ) {
+            if( m_components[ *o ] != size ) {
+               continue;
+            }
+            m_components[ *o ] = *o;
+            todo.emplace_back( *o );
+            while( !todo.empty() ) {
+               const auto i = todo.back();
+               todo.pop_back();
+               for( auto e = offsets[ i ]; e != offsets[ i + 1 ]; ++e ) {
+                  const auto j = reverse[ e ];
+                  if( m_components[ j ] == size ) {
+                     m_components[ j ] = *o;
+                     todo.emplace_back( j );
+                  }
+                  if( m_components[ j ] == *o ) {
+                     m_cyclic[ *o ] = true;
+                     m_cyclic[ j ] = true;
+                  }
+               }
+            }
+         }
+         m_unbounded.assign( size, false );
+         for( std::size_t i = 0; i < size; ++i ) {
+            if( m_cyclic[ i ] ) {
+               m_unbounded[ i ] = true;
+               todo.emplace_back( i );
+            }
+         }
+         while( !todo.empty() ) {
+            const auto i = todo.back();
+            todo.pop_back();
+            for( auto e = offsets[ i ]; e != offsets[ i + 1 ]; ++e ) {
+               const auto j = reverse[ e ];
+               if( !m_unbounded[ j ] ) {
+                  m_unbounded[ j ] = true;
+                  todo.emplace_back( j );
+               }
+            }
+         }
+      }
+
+      // Returns a sub-rule attempted at the start position that can consume
+      // unbounded input, and a following sub-rule that can fail, or just a
+      // sub-rule attempted at the start position with the same property.
+
+      [[nodiscard]] std::pair< std::size_t, std::size_t > wasted( const std::size_t i ) const noexcept
+      {
+         const auto none = m_rules.size();
+         auto u = none;
+         for( auto e = m_offsets[ i ]; e != m_offsets[ i + 1 ]; ++e ) {
+            const auto j = m_edges[ e ];
+            if( u != none ) {
+               if( !m_infallible[ j ] ) {
+                  return { u, j };
+               }
+               continue;
+            }
+            if( e == m_starts[ i ] ) {
+               break;
+            }
+            if( m_wastes[ j ] ) {
+               return { j, none };
+            }
+            if( ( m_types[ i ] != rule_type::sor ) && m_unbounded[ j ] ) {
+               u = j;
+            }
+         }
+         return { none, none };
+      }
+
+      [[nodiscard]] bool infallible( const std::size_t i ) const noexcept
+      {
+         const auto b = m_edges.begin() + m_offsets[ i ];
+         const auto e = m_edges.begin() + m_offsets[ i + 1 ];
+         switch( m_types[ i ] ) {
+            case rule_type::opt:
+               return b != e;
+            case rule_type::sor:
+               return std::any_of( b, e, [ this ]( const std::size_t j ) { return bool( m_infallible[ j ] ); } );
+            default:
+               return ( b != e ) && std::all_of( b, e, [ this ]( const std::size_t j ) { return bool( m_infallible[ j ] ); } );
+         }
+      }
+
+      // Both properties are least fixed points over the (cyclic) grammar,
+      // the reason why a rule wastes input is recorded when it is found.
+
+      template< typename F >
+      void fixed_point( std::vector< bool >& v, const F& f )
+      {
+         v.assign( m_rules.size(), false );
+         for( bool changed = true; changed; ) {
+            changed = false;
+            for( std::size_t i = 0; i < m_rules.size(); ++i ) {
+               if( !v[ i ] && f( i ) ) {
+                  v[ i ] = true;
+                  changed = true;
+               }
+            }
+         }
+      }
+
+      void prepare_backtracking()
+      {
+         prepare_starts();
+         prepare_components();
+         fixed_point( m_infallible, [ this ]( const std::size_t i ) { return infallible( i ); } );
+         m_reasons.assign( m_rules.size(), { m_rules.size(), m_rules.size() } );
+         fixed_point( m_wastes, [ this ]( const std::size_t i ) {
+            m_reasons[ i ] = wasted( i );
+            return m_reasons[ i ].first != m_rules.size();
+         } );
+      }
+
+      [[nodiscard]] std::string path( const std::vector< std::size_t >& rules ) const
+      {
+         std::string result;
+         for( const auto i : rules ) {
+            if( !result.empty() ) {
+               result += " -> ";
+            }
+            result += name( i );
+         }
+         return result;
+      }
+
+      // Shortest path from rule i to rule j, following all sub-rules, or
+      // only the sub-rules attempted at the start position.
+
+      [[nodiscard]] std::vector< std::size_t > shortest( const std::size_t i, const std::size_t j, const bool starts ) const
+      {
+         const auto size = m_rules.size();
+         std::vector< std::size_t > parent( size, size );
+         std::vector< std::size_t > todo = { i };
+         parent[ i ] = i;
+         for( std::size_t t = 0; t < todo.size(); ++t ) {
+            const auto k = todo[ t ];
+            const auto end = starts ? m_starts[ k ] : m_offsets[ k + 1 ];
+            for( auto e = m_offsets[ k ]; e != end; ++e ) {
+               const auto l = m_edges[ e ];
+               if( parent[ l ] == size ) {
+                  parent[ l ] = k;
+                  todo.emplace_back( l );
+               }
+               if( l == j ) {
+                  std::vector< std::size_t > result = { j };
+                  for( auto p = k; p != i; p = parent[ p ] ) {
+                     result.emplace_back( p );
+                  }
+                  result.emplace_back( i );
+                  return { result.rbegin(), result.rend() };
+               }
+            }
+         }
+         return {};
+      }
+
+      [[nodiscard]] std::size_t exponential()
+      {
+         const auto size = m_rules.size();
+         std::size_t problems = 0;
+         std::vector< std::size_t > order;
+         std::vector< std::size_t > index( size, size );
+         std::vector< std::size_t > count;
+         std::vector< std::size_t > alternative;
+         std::vector< bool > seen( size, false );
+         std::vector< std::pair< std::size_t, std::size_t > > stack;
+         const auto none = std::size_t( -1 );
+         const auto many = std::size_t( -2 );
+         for( std::size_t r = 0; r < size; ++r ) {
+            if( !m_cyclic[ r ] || ( m_types[ r ] != rule_type::sor ) ) {
+               continue;
+            }
+            // Count the paths from r to every rule attempted at its start
+            // position, in topological order, and note whether they start
+            // with different alternatives of r; the sub-graph is acyclic
+            // for grammars without problems, otherwise back edges are ignored.
+            order.clear();
+            seen[ r ] = true;
+            stack.emplace_back( r, m_offsets[ r ] );
+            while( !stack.empty() ) {
+               auto& [ i, e ] = stack.back();
+               if( e != m_starts[ i ] ) {
+                  const auto j = m_edges[ e++ ];
+                  if( !seen[ j ] ) {
+                     seen[ j ] = true;
+                     stack.emplace_back( j, m_offsets[ j ] );
+                  }
+               }
+               else {
+                  order.emplace_back( i );
+                  stack.pop_back();
+               }
+            }
+            for( std::size_t k = 0; k < order.size(); ++k ) {
+               seen[ order[ k ] ] = false;
+               index[ order[ k ] ] = k;
+            }
+            count.assign( order.size(), 0 );
+            count.back() = 1;
+            alternative.assign( order.size(), none );
+            auto best = size;
+            for( auto k = order.size(); k-- != 0; ) {
+               const auto i = order[ k ];
+               for( auto e = m_offsets[ i ]; e != m_starts[ i ]; ++e ) {
+                  const auto l = index[ m_edges[ e ] ];
+                  if( l < k ) {
+                     const auto a = ( i == r ) ? e : alternative[ k ];
+                     count[ l ] += count[ k ];
+                     alternative[ l ] = ( ( alternative[ l ] == none ) || ( alternative[ l ] == a ) ) ? a : many;
+                  }
+               }
+               if( ( alternative[ k ] == many ) && ( subs( i ) != 0 ) && ( m_components[ i ] == m_components[ r ] ) && ( ( best == size ) || ( count[ k ] > count[ index[ best ] ] ) ) ) {
+                  best = i;
+               }
+            }
+            if( best != size ) {
+               ++problems;
+               if( m_verbose ) {
+                  std::cout << "problem: exponential backtracking at rule class " << name( r ) << std::endl;  // LCOV_EXCL_LINE
+                  std::cout << "  attempts " << count[ index[ best ] ] << " times at the same position: " << path( shortest( r, best, true ) ) << std::endl;  // LCOV_EXCL_LINE
+                  std::cout << "  which leads back to it: " << path( shortest( best, r, false ) ) << std::endl;  // LCOV_EXCL_LINE
+               }
+            }
+         }
+         return problems;
+      }
+
+      [[nodiscard]] bool reaches( const std::size_t i, const std::size_t j ) const
+      {
+         return ( i == j ) || !shortest( i, j, true ).empty();
+      }
+
+      // Whether rule l starts again after the sub-rule at edge a without
+      // consuming further input, i.e. whether the sub-rule is repeated.
+
+      [[nodiscard]] bool repeated( const std::size_t l, const std::size_t a ) const
+      {
+         for( auto e = a + 1; e != m_offsets[ l + 1 ]; ++e ) {
+            if( reaches( m_edges[ e ], l ) ) {
+               return true;
+            }
+            if( m_states[ m_edges[ e ] ].result ) {
+               break;
+            }
+         }
+         return false;
+      }
+
+      [[nodiscard]] std::size_t quadratic()
+      {
+         const auto size = m_rules.size();
+         std::size_t problems = 0;
+         std::vector< bool > reported( size, false );
+         for( std::size_t l = 0; l < size; ++l ) {
+            if( !m_cyclic[ l ] ) {
+               continue;
+            }
+            for( auto a = m_offsets[ l ]; a != m_offsets[ l + 1 ]; ++a ) {
+               const auto p = m_edges[ a ];
+               if( ( m_types[ p ] != rule_type::sor ) || !repeated( l, a ) ) {
+                  continue;
+               }
+               for( auto w = m_offsets[ p ]; w != m_offsets[ p + 1 ]; ++w ) {
+                  if( !m_wastes[ m_edges[ w ] ] || reported[ m_edges[ w ] ] ) {
+                     continue;
+                  }
+                  for( auto b = w + 1; b != m_offsets[ p + 1 ]; ++b ) {
+                     if( m_unbounded[ m_edges[ b ] ] ) {
+                        continue;
+                     }
+                     reported[ m_edges[ w ] ] = true;
+                     ++problems;
+                     if( m_verbose ) {
+                        auto [ x, y ] = m_reasons[ m_edges[ w ] ];
+                        while( y == size ) {
+                           std::tie( x, y ) = m_reasons[ x ];
+                        }
+                        std::cout << "problem: quadratic backtracking at rule class " << name( m_edges[ w ] ) << std::endl;  // LCOV_EXCL_LINE
+                        std::cout << "  can consume unbounded input in " << name( x ) << " and then fail in " << name( y ) << std::endl;  // LCOV_EXCL_LINE
+                        std::cout << "  after which the repetition continues with a bounded alternative: " << path( { l, p, m_edges[ b ] } ) << std::endl;  // LCOV_EXCL_LINE
+                     }
+                     break;
+                  }
+               }
+            }
+         }
+         return problems;
+      }
+
+      [[nodiscard]] std::size_t problems_impl()
+      {
+         prepare_backtracking();
+         return exponential() + quadratic();
+      }
+   };
+
+   template< typename Grammar >
+   struct analyze_backtracking
+      : private analyze_backtracking_impl
+   {
+      explicit analyze_backtracking( const bool verbose )
+         : analyze_backtracking_impl( verbose )
+      {
+         Grammar::analyze_t::template insert< Grammar >( m_info );
+         prepare();
+      }
+
+      [[nodiscard]] std::size_t problems()
+      {
+         return problems_impl();
+      }
+   };
+
+}  // namespace TAO_PEGTL_NAMESPACE::analysis
+
+#endif
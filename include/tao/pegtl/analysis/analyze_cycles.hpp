@@ -5,19 +5,18 @@
 #define TAO_PEGTL_ANALYSIS_ANALYZE_CYCLES_HPP
 
 #include <cassert>
+#include <cstddef>
 
-#include <map>
-#include <set>
-#include <stdexcept>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include <iostream>
-#include <utility>
 
 #include "../config.hpp"
 
+#include "cycle_search.hpp"
 #include "grammar_info.hpp"
-#include "insert_guard.hpp"
 
 namespace TAO_PEGTL_NAMESPACE::analysis
 {
@@ -25,72 +24,62 @@ namespace TAO_PEGTL_NAMESPACE::analysis
    {
    protected:
       explicit analyze_cycles_impl( const bool verbose ) noexcept
-         : m_verbose( verbose ),
-           m_problems( 0 )
+         : m_verbose( verbose )
       {
       }
 
       const bool m_verbose;
-      unsigned m_problems;
       grammar_info m_info;
-      std::set< std::string_view > m_stack;
-      std::map< std::string_view, bool > m_cache;
-      std::map< std::string_view, bool > m_results;
 
-      [[nodiscard]] std::map< std::string_view, rule_info >::const_iterator find( const std::string_view name ) const noexcept
-      {
-         const auto iter = m_info.map.find( name );
-         assert( iter != m_info.map.end() );
-         return iter;
-      }
+      // Rules are numbered in the order of m_info.map, see cycle_search
+      // for the meaning of the other members.
 
-      [[nodiscard]] bool work( const std::map< std::string_view, rule_info >::const_iterator& start, const bool accum )
-      {
-         const auto j = m_cache.find( start->first );
+      std::vector< grammar_info::map_t::const_iterator > m_rules;
+      std::unordered_map< std::string_view, std::size_t > m_ids;
+      std::vector< rule_type > m_types;
+      std::vector< std::size_t > m_offsets;
+      std::vector< std::size_t > m_edges;
+      std::vector< cycle_rule > m_states;
+      std::vector< cycle_frame > m_frames;
 
-         if( j != m_cache.end() ) {
-            return j->second;
+      void prepare()
+      {
+         const auto size = m_info.map.size();
+         m_rules.reserve( size );
+         m_ids.reserve( size );
+         m_types.reserve( size );
+         for( auto i = m_info.map.begin(); i != m_info.map.end(); ++i ) {
+            m_ids.try_emplace( i->first, m_rules.size() );
+            m_rules.emplace_back( i );
+            m_types.emplace_back( i->second.type );
          }
-         if( const auto g = insert_guard( m_stack, start->first ) ) {
-            switch( start->second.type ) {
-               case rule_type::any: {
-                  bool a = false;
-                  for( const auto& r : start->second.rules ) {
-                     a = a || work( find( r ), accum || a );
-                  }
-                  return m_cache[ start->first ] = true;
-               }
-               case rule_type::opt: {
-                  bool a = false;
-                  for( const auto& r : start->second.rules ) {
-                     a = a || work( find( r ), accum || a );
-                  }
-                  return m_cache[ start->first ] = false;
-               }
-               case rule_type::seq: {
-                  bool a = false;
-                  for( const auto& r : start->second.rules ) {
-                     a = a || work( find( r ), accum || a );
-                  }
-                  return m_cache[ start->first ] = a;
-               }
-               case rule_type::sor: {
-                  bool a = true;
-                  for( const auto& r : start->second.rules ) {
-                     a = a && work( find( r ), accum );
-                  }
-                  return m_cache[ start->first ] = a;
-               }
+         m_offsets.reserve( size + 1 );
+         m_offsets.emplace_back( 0 );
+         for( const auto& i : m_rules ) {
+            for( const auto& r : i->second.rules ) {
+               m_edges.emplace_back( find( r ) );
             }
-            throw std::logic_error( "code should be unreachable: invalid rule_type value" );  // LCOV_EXCL_LINE
+            m_offsets.emplace_back( m_edges.size() );
          }
-         if( !accum ) {
-            ++m_problems;
+         m_states.resize( size );
+         m_frames.resize( size );
+      }
+
+      [[nodiscard]] std::size_t find( const std::string_view name ) const noexcept
+      {
+         const auto iter = m_ids.find( name );
+         assert( iter != m_ids.end() );
+         return iter->second;
+      }
+
+      [[nodiscard]] std::size_t problems_impl()
+      {
+         cycle_search search( m_types.data(), m_offsets.data(), m_edges.data(), m_rules.size(), m_states.data(), m_frames.data() );
+         return search.problems( [ this ]( const std::size_t i ) {
             if( m_verbose ) {
-               std::cout << "problem: cycle without progress detected at rule class " << start->first << std::endl;  // LCOV_EXCL_LINE
+               std::cout << "problem: cycle without progress detected at rule class " << m_rules[ i ]->first << std::endl;  // LCOV_EXCL_LINE
             }
-         }
-         return m_cache[ start->first ] = accum;
+         } );
       }
    };
 
@@ -102,23 +91,18 @@ namespace TAO_PEGTL_NAMESPACE::analysis
          : analyze_cycles_impl( verbose )
       {
          Grammar::analyze_t::template insert< Grammar >( m_info );
+         prepare();
       }
 
       [[nodiscard]] std::size_t problems()
       {
-         for( auto i = m_info.map.begin(); i != m_info.map.end(); ++i ) {
-            m_results[ i->first ] = work( i, false );
-            m_cache.clear();
-         }
-         return m_problems;
+         return problems_impl();
       }
 
       template< typename Rule >
       [[nodiscard]] bool consumes() const noexcept
       {
-         const auto i = m_results.find( internal::demangle< Rule >() );
-         assert( i != m_results.end() );
-         return i->second;
+         return m_states[ find( internal::demangle< Rule >() ) ].result;
       }
    };
 
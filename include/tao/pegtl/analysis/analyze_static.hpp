@@ -0,0 +1,167 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_ANALYSIS_ANALYZE_STATIC_HPP
+#define TAO_PEGTL_ANALYSIS_ANALYZE_STATIC_HPP
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "../config.hpp"
+
+#include "cycle_search.hpp"
+#include "rule_list.hpp"
+#include "rule_type.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::analysis
+{
+   // The rules of a grammar are collected level by level in breadth-first
+   // order, starting with the grammar itself; the rules of each level are
+   // added with a fold expression to keep the template recursion depth
+   // down to the depth of the grammar. Membership and index lookups use
+   // base classes rather than comparing with every rule, which keeps the
+   // compile time reasonable for large grammars.
+
+   template< typename Rule >
+   struct rule_tag
+   {
+   };
+
+   template< typename... Rules >
+   struct rule_set
+      : rule_tag< Rules >...
+   {
+   };
+
+   template< std::size_t I, typename Rule >
+   struct rule_index
+   {
+   };
+
+   template< typename Rule, std::size_t I >
+   [[nodiscard]] constexpr std::size_t index_of( const rule_index< I, Rule >* /*unused*/ ) noexcept
+   {
+      return I;
+   }
+
+   template< typename Indices, typename... Rules >
+   struct rule_indices;
+
+   template< std::size_t... Is, typename... Rules >
+   struct rule_indices< std::index_sequence< Is... >, Rules... >
+      : rule_index< Is, Rules >...
+   {
+   };
+
+   template< typename Done, typename Todo >
+   struct rule_collector;
+
+   template< typename... Done, typename... Todo >
+   struct rule_collector< rule_list< Done... >, rule_list< Todo... > >
+   {
+      using done_t = rule_list< Done... >;
+      using todo_t = rule_list< Todo... >;
+
+      template< typename Rule >
+      [[nodiscard]] constexpr auto operator+( Rule* /*unused*/ ) const noexcept
+      {
+         if constexpr( std::is_base_of_v< rule_tag< Rule >, rule_set< Done... > > ) {
+            return rule_collector();
+         }
+         else {
+            return rule_collector< rule_list< Done..., Rule >, rule_list< Todo..., Rule > >();
+         }
+      }
+
+      template< typename... Rules >
+      [[nodiscard]] constexpr auto operator+( rule_list< Rules... > /*unused*/ ) const noexcept
+      {
+         return ( *this + ... + static_cast< Rules* >( nullptr ) );
+      }
+   };
+
+   template< typename Done, typename Todo >
+   struct rule_closure;
+
+   template< typename... Done >
+   struct rule_closure< rule_list< Done... >, rule_list<> >
+   {
+      using type = rule_list< Done... >;
+   };
+
+   template< typename... Done, typename... Todo >
+   struct rule_closure< rule_list< Done... >, rule_list< Todo... > >
+   {
+      using next = decltype( ( rule_collector< rule_list< Done... >, rule_list<> >() + ... + typename Todo::analyze_t::rules_t() ) );
+      using type = typename rule_closure< typename next::done_t, typename next::todo_t >::type;
+   };
+
+   template< typename Grammar >
+   using rule_closure_t = typename rule_closure< rule_list< Grammar >, rule_list< Grammar > >::type;
+
+   struct static_result
+   {
+      std::size_t problems = 0;
+      bool consumes = false;
+   };
+
+   template< typename Rules >
+   struct rule_graph;
+
+   template< typename... Rules >
+   struct rule_graph< rule_list< Rules... > >
+   {
+      static constexpr std::size_t size = sizeof...( Rules );
+
+      using indices_t = rule_indices< std::index_sequence_for< Rules... >, Rules... >;
+
+      template< typename... Subs >
+      [[nodiscard]] static constexpr std::size_t count( rule_list< Subs... > /*unused*/ ) noexcept
+      {
+         return sizeof...( Subs );
+      }
+
+      template< typename... Subs >
+      static constexpr std::size_t append( rule_list< Subs... > /*unused*/, std::size_t* edges, std::size_t n ) noexcept
+      {
+         ( ( edges[ n++ ] = index_of< Subs >( static_cast< const indices_t* >( nullptr ) ) ), ... );
+         (void)edges;
+         return n;
+      }
+
+      static constexpr std::size_t edge_count = ( count( typename Rules::analyze_t::rules_t() ) + ... + 0 );
+
+      // Uses the same search as analyze(), the grammar is rule 0.
+
+      [[nodiscard]] static constexpr static_result analyze()
+      {
+         const std::array< rule_type, size > types = { { Rules::analyze_t::type_v... } };
+         std::array< std::size_t, size + 1 > offsets{};
+         std::array< std::size_t, edge_count + 1 > edges{};
+         std::size_t i = 0;
+         ( ( offsets[ i + 1 ] = append( typename Rules::analyze_t::rules_t(), edges.data(), offsets[ i ] ), ++i ), ... );
+         std::array< cycle_rule, size > rules{};
+         std::array< cycle_frame, size > frames{};
+         cycle_search search( types.data(), offsets.data(), edges.data(), size, rules.data(), frames.data() );
+         const std::size_t problems = search.problems( []( const std::size_t /*unused*/ ) {} );
+         return { problems, search.consumes( 0 ) };
+      }
+   };
+
+   template< typename Grammar >
+   inline constexpr static_result analyze_static_v = rule_graph< rule_closure_t< Grammar > >::analyze();
+
+   // Whether Rule always consumes input on success, or can succeed without
+   // consuming input; only meaningful when analyze_v< Rule > is zero.
+
+   template< typename Rule >
+   inline constexpr bool consumes_v = analyze_static_v< Rule >.consumes;
+
+   template< typename Rule >
+   inline constexpr bool nullable_v = !consumes_v< Rule >;
+
+}  // namespace TAO_PEGTL_NAMESPACE::analysis
+
+#endif
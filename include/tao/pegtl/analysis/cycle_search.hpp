@@ -0,0 +1,201 @@
+// Copyright (c) 2014-2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_ANALYSIS_CYCLE_SEARCH_HPP
+#define TAO_PEGTL_ANALYSIS_CYCLE_SEARCH_HPP
+
+#include <cstddef>
+#include <stdexcept>
+
+#include "../config.hpp"
+
+#include "rule_type.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::analysis
+{
+   // The result of a rule is computed by a depth-first search that
+   // follows the sub-rules that are attempted without the rule having
+   // consumed input; a rule that is found on the stack again is a
+   // cycle without progress. Conceptually the search is repeated from
+   // every rule with an empty cache, which is quadratic in the size
+   // of the grammar, so the search is done once over all rules with
+   // a shared cache and repeated only for rules whose result depends
+   // on a cycle. The results and diagnostics are the same as those of
+   // the repeated searches.
+
+   // The search uses an explicit stack and no allocations in order to
+   // be usable both at run time and in constant evaluation, where the
+   // recursion depth is limited.
+
+   struct cycle_rule
+   {
+      enum class state : char
+      {
+         unknown,
+         consumes,
+         optional
+      };
+
+      state cache = state::unknown;
+      std::size_t run = 0;
+      bool stack = false;
+      bool cyclic = false;
+      bool repeat = false;
+      bool result = false;
+   };
+
+   struct cycle_frame
+   {
+      std::size_t rule = 0;
+      std::size_t edge = 0;
+      bool consumes = false;
+      bool cycle = false;
+   };
+
+   class cycle_search
+   {
+   public:
+      // Rules are numbered from 0 to size - 1, the sub-rules of rule i
+      // are edges[ offsets[ i ] ] to edges[ offsets[ i + 1 ] - 1 ]; the
+      // rules and frames arrays must have size elements.
+
+      constexpr cycle_search( const rule_type* types, const std::size_t* offsets, const std::size_t* edges, const std::size_t size, cycle_rule* rules, cycle_frame* frames ) noexcept
+         : m_types( types ),
+           m_offsets( offsets ),
+           m_edges( edges ),
+           m_size( size ),
+           m_rules( rules ),
+           m_frames( frames )
+      {
+      }
+
+      // Calls report( i ) for every problem at rule i and returns the
+      // number of problems found.
+
+      template< typename Report >
+      [[nodiscard]] constexpr std::size_t problems( Report&& report )
+      {
+         for( std::size_t i = 0; i < m_size; ++i ) {
+            if( m_rules[ i ].cache == cycle_rule::state::unknown ) {
+               (void)run( i, false, report );
+            }
+         }
+         for( std::size_t i = 0; i < m_size; ++i ) {
+            m_rules[ i ].result = ( m_rules[ i ].cache == cycle_rule::state::consumes );
+            m_rules[ i ].repeat = m_rules[ i ].cyclic;
+         }
+         for( std::size_t i = 0; i < m_size; ++i ) {
+            if( m_rules[ i ].repeat ) {
+               ++m_run;
+               m_rules[ i ].result = run( i, true, report );
+            }
+         }
+         return m_problems;
+      }
+
+      [[nodiscard]] constexpr bool consumes( const std::size_t i ) const noexcept
+      {
+         return m_rules[ i ].result;
+      }
+
+   private:
+      const rule_type* m_types;
+      const std::size_t* m_offsets;
+      const std::size_t* m_edges;
+      std::size_t m_size;
+      cycle_rule* m_rules;
+      cycle_frame* m_frames;
+      std::size_t m_depth = 0;
+      std::size_t m_run = 0;
+      std::size_t m_problems = 0;
+      bool m_cycle = false;
+
+      // Returns true when a frame for rule i was pushed, otherwise the
+      // result of rule i is stored in a.
+
+      template< typename Report >
+      [[nodiscard]] constexpr bool enter( const std::size_t i, const bool report, Report& r, bool& a )
+      {
+         auto& rule = m_rules[ i ];
+         if( rule.run != m_run ) {
+            rule.run = m_run;
+            rule.cache = cycle_rule::state::unknown;
+         }
+         if( rule.cache != cycle_rule::state::unknown ) {
+            m_cycle = m_cycle || rule.cyclic;
+            a = ( rule.cache == cycle_rule::state::consumes );
+            return false;
+         }
+         if( rule.stack ) {
+            if( report ) {
+               ++m_problems;
+               r( i );
+            }
+            m_cycle = true;
+            rule.cyclic = true;
+            rule.cache = cycle_rule::state::optional;
+            a = false;
+            return false;
+         }
+         rule.stack = true;
+         m_frames[ m_depth++ ] = cycle_frame{ i, m_offsets[ i ], m_types[ i ] == rule_type::sor, m_cycle };
+         m_cycle = false;
+         return true;
+      }
+
+      [[nodiscard]] static constexpr bool result( const rule_type type, const bool consumes )
+      {
+         switch( type ) {
+            case rule_type::any:
+               return true;
+            case rule_type::opt:
+               return false;
+            case rule_type::seq:
+            case rule_type::sor:
+               return consumes;
+         }
+         throw std::logic_error( "code should be unreachable: invalid rule_type value" );  // LCOV_EXCL_LINE
+      }
+
+      [[nodiscard]] constexpr bool leave()
+      {
+         const auto& frame = m_frames[ --m_depth ];
+         auto& rule = m_rules[ frame.rule ];
+         const bool a = result( m_types[ frame.rule ], frame.consumes );
+         rule.stack = false;
+         rule.cyclic = m_cycle;
+         m_cycle = m_cycle || frame.cycle;
+         rule.cache = a ? cycle_rule::state::consumes : cycle_rule::state::optional;
+         return a;
+      }
+
+      // The sub-rules of any, opt and seq are followed until one of them
+      // consumes, those of sor until one of them does not consume.
+
+      template< typename Report >
+      [[nodiscard]] constexpr bool run( const std::size_t root, const bool report, Report& r )
+      {
+         bool a = false;
+         if( !enter( root, report, r, a ) ) {
+            return a;
+         }
+         while( true ) {
+            auto& frame = m_frames[ m_depth - 1 ];
+            if( ( frame.consumes == ( m_types[ frame.rule ] == rule_type::sor ) ) && ( frame.edge != m_offsets[ frame.rule + 1 ] ) ) {
+               if( !enter( m_edges[ frame.edge++ ], report, r, a ) ) {
+                  frame.consumes = a;
+               }
+               continue;
+            }
+            a = leave();
+            if( m_depth == 0 ) {
+               return a;
+            }
+            m_frames[ m_depth - 1 ].consumes = a;
+         }
+      }
+   };
+
+}  // namespace TAO_PEGTL_NAMESPACE::analysis
+
+#endif
@@ -8,6 +8,7 @@
 
 #include "grammar_info.hpp"
 #include "insert_rules.hpp"
+#include "rule_list.hpp"
 #include "rule_type.hpp"
 
 namespace TAO_PEGTL_NAMESPACE::analysis
@@ -15,6 +16,9 @@ namespace TAO_PEGTL_NAMESPACE::analysis
    template< rule_type Type, typename... Rules >
    struct generic
    {
+      static constexpr rule_type type_v = Type;
+      using rules_t = rule_list< Rules... >;
+
       template< typename Name >
       static std::string_view insert( grammar_info& g )
       {
@@ -4,7 +4,7 @@
 #ifndef TAO_PEGTL_ANALYSIS_RULE_INFO_HPP
 #define TAO_PEGTL_ANALYSIS_RULE_INFO_HPP
 
-#include <string>
+#include <string_view>
 #include <vector>
 
 #include "../config.hpp"
@@ -21,7 +21,7 @@ namespace TAO_PEGTL_NAMESPACE::analysis
       }
 
       rule_type type;
-      std::vector< std::string > rules;
+      std::vector< std::string_view > rules;
    };
 
 }  // namespace TAO_PEGTL_NAMESPACE::analysis
@@ -0,0 +1,18 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_ANALYSIS_RULE_LIST_HPP
+#define TAO_PEGTL_ANALYSIS_RULE_LIST_HPP
+
+#include "../config.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::analysis
+{
+   template< typename... Rules >
+   struct rule_list
+   {
+   };
+
+}  // namespace TAO_PEGTL_NAMESPACE::analysis
+
+#endif
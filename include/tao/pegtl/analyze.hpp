@@ -6,7 +6,9 @@
 
 #include "config.hpp"
 
+#include "analysis/analyze_backtracking.hpp"
 #include "analysis/analyze_cycles.hpp"
+#include "analysis/analyze_static.hpp"
 
 namespace TAO_PEGTL_NAMESPACE
 {
@@ -16,6 +18,18 @@ namespace TAO_PEGTL_NAMESPACE
       return analysis::analyze_cycles< Rule >( verbose ).problems();
    }
 
+   template< typename Rule >
+   [[nodiscard]] std::size_t analyze_backtracking( const bool verbose = true )
+   {
+      return analysis::analyze_backtracking< Rule >( verbose ).problems();
+   }
+
+   // The same analysis as analyze() in constant evaluation, i.e. the number
+   // of problems that analyze< Rule >() would return, for static_assert.
+
+   template< typename Rule >
+   inline constexpr std::size_t analyze_v = analysis::analyze_static_v< Rule >.problems;
+
 }  // namespace TAO_PEGTL_NAMESPACE
 
 #endif
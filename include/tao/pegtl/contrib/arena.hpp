@@ -0,0 +1,87 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_ARENA_HPP
+#define TAO_PEGTL_CONTRIB_ARENA_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "../config.hpp"
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   // Monotonic allocator for trivially copyable and destructible objects,
+   // e.g. the arrays, objects and unescaped strings of a json_dom document;
+   // memory is only released when the arena is destroyed.
+
+   class arena
+   {
+   public:
+      explicit arena( const std::size_t block_size = 64 * 1024 ) noexcept
+         : m_block_size( block_size )
+      {
+      }
+
+      arena( const arena& ) = delete;
+      arena( arena&& ) noexcept = default;
+
+      ~arena() = default;
+
+      arena& operator=( const arena& ) = delete;
+      arena& operator=( arena&& ) noexcept = default;
+
+      [[nodiscard]] void* allocate( const std::size_t size, const std::size_t align = alignof( std::max_align_t ) )
+      {
+         assert( ( align & ( align - 1 ) ) == 0 );
+         std::size_t pad = padding( align );
+         if( pad + size > std::size_t( m_end - m_next ) ) {
+            grow( size + align );
+            pad = padding( align );
+         }
+         char* r = m_next + pad;
+         m_next = r + size;
+         return r;
+      }
+
+      template< typename T >
+      [[nodiscard]] T* allocate_array( const std::size_t count )
+      {
+         static_assert( std::is_trivially_copyable_v< T > && std::is_trivially_destructible_v< T > );
+         return static_cast< T* >( allocate( count * sizeof( T ), alignof( T ) ) );
+      }
+
+      [[nodiscard]] std::size_t blocks() const noexcept
+      {
+         return m_blocks.size();
+      }
+
+   private:
+      [[nodiscard]] std::size_t padding( const std::size_t align ) const noexcept
+      {
+         return ( align - ( reinterpret_cast< std::uintptr_t >( m_next ) & ( align - 1 ) ) ) & ( align - 1 );
+      }
+
+      void grow( const std::size_t minimum )
+      {
+         const std::size_t size = ( std::max )( m_block_size, minimum );
+         m_blocks.emplace_back( new char[ size ] );
+         m_next = m_blocks.back().get();
+         m_end = m_next + size;
+         m_block_size = ( std::min )( m_block_size * 2, std::size_t( 16 * 1024 * 1024 ) );
+      }
+
+      std::vector< std::unique_ptr< char[] > > m_blocks;
+      char* m_next = nullptr;
+      char* m_end = nullptr;
+      std::size_t m_block_size;
+   };
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#endif
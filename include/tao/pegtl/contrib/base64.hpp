@@ -0,0 +1,259 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_BASE64_HPP
+#define TAO_PEGTL_CONTRIB_BASE64_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "../config.hpp"
+
+#include "../analysis/generic.hpp"
+#include "../internal/endian.hpp"
+#include "../internal/fast_path.hpp"
+#include "../internal/simd.hpp"
+#include "../internal/skip_control.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::base64
+{
+   // Base64 encoded data as per RFC 4648, with the standard alphabet in
+   // namespace base64 and the URL and filename safe alphabet in namespace
+   // base64url; the latter does not require padding. Line breaks within
+   // the data are not supported.
+
+   namespace internal
+   {
+      template< char C62, char C63, bool Padding >
+      struct alphabet
+      {
+         static constexpr char c62 = C62;
+         static constexpr char c63 = C63;
+         static constexpr bool padding = Padding;
+
+         [[nodiscard]] static constexpr bool contains( const char c ) noexcept
+         {
+            return ( ( 'A' <= c ) && ( c <= 'Z' ) ) || ( ( 'a' <= c ) && ( c <= 'z' ) ) || ( ( '0' <= c ) && ( c <= '9' ) ) || ( c == C62 ) || ( c == C63 );
+         }
+
+         [[nodiscard]] static constexpr std::array< std::uint8_t, 256 > make_table() noexcept
+         {
+            std::array< std::uint8_t, 256 > r{};
+            for( unsigned i = 0; i < 26; ++i ) {
+               r[ 'A' + i ] = std::uint8_t( i );
+               r[ 'a' + i ] = std::uint8_t( i + 26 );
+            }
+            for( unsigned i = 0; i < 10; ++i ) {
+               r[ '0' + i ] = std::uint8_t( i + 52 );
+            }
+            r[ static_cast< unsigned char >( C62 ) ] = 62;
+            r[ static_cast< unsigned char >( C63 ) ] = 63;
+            return r;
+         }
+
+         static constexpr std::array< std::uint8_t, 256 > table = make_table();
+      };
+
+      using standard = alphabet< '+', '/', true >;
+      using url = alphabet< '-', '_', false >;
+
+      // Returns the first byte in [ p, e ) that is not in the alphabet.
+
+      template< typename Alphabet >
+      [[nodiscard]] const char* scan( const char* p, const char* e ) noexcept
+      {
+         using block = TAO_PEGTL_NAMESPACE::internal::simd::block64;
+         return TAO_PEGTL_NAMESPACE::internal::simd::find_first( p, e, []( const block& b ) {
+            return ~( b.in_range< 'A', 'Z' >() | b.in_range< 'a', 'z' >() | b.in_range< '0', '9' >() | b.eq< Alphabet::c62, Alphabet::c63 >() );
+         } );
+      }
+
+      // Matches a non-empty sequence of characters from the alphabet whose
+      // length is a valid length of encoded data, followed by the padding
+      // that completes the last group of four, which is optional when the
+      // alphabet does not require padding.
+
+      template< typename Alphabet >
+      struct value
+      {
+         using analyze_t = analysis::generic< analysis::rule_type::any >;
+
+         template< typename Input >
+         [[nodiscard]] static bool match( Input& in )
+         {
+            std::size_t n = 0;
+            if constexpr( TAO_PEGTL_NAMESPACE::internal::is_memory_input_v< Input > ) {
+               n = std::size_t( scan< Alphabet >( in.current(), in.end() ) - in.current() );
+            }
+            else {
+               while( ( in.size( n + 1 ) > n ) && Alphabet::contains( in.peek_char( n ) ) ) {
+                  ++n;
+               }
+            }
+            if( ( n == 0 ) || ( n % 4 == 1 ) ) {
+               return false;
+            }
+            if( const std::size_t p = ( 4 - n % 4 ) % 4; p != 0 ) {
+               if( ( in.size( n + p ) >= n + p ) && ( in.peek_char( n ) == '=' ) && ( ( p == 1 ) || ( in.peek_char( n + 1 ) == '=' ) ) ) {
+                  n += p;
+               }
+               else if( Alphabet::padding ) {
+                  return false;
+               }
+            }
+            in.bump_in_this_line( n );
+            return true;
+         }
+      };
+
+      [[nodiscard]] inline std::size_t decoded_size( const char* begin, const char* end ) noexcept
+      {
+         while( ( begin != end ) && ( end[ -1 ] == '=' ) ) {
+            --end;
+         }
+         const auto n = std::size_t( end - begin );
+         return n / 4 * 3 + ( n % 4 ) * 3 / 4;
+      }
+
+#if defined( TAO_PEGTL_INTERNAL_SIMD_SSE2 )
+      // Decodes 16 characters to 12 bytes: the characters are mapped to
+      // their values by adding an offset that depends on the range they
+      // are in, then pairs of values are combined into 12 bits, pairs of
+      // those into 24 bits, and pairs of those are stored as 6 bytes.
+
+      template< typename Alphabet >
+      void decode16( const char* p, char* out ) noexcept
+      {
+         const __m128i v = _mm_loadu_si128( reinterpret_cast< const __m128i* >( p ) );
+         const __m128i upper = _mm_and_si128( _mm_cmpgt_epi8( v, _mm_set1_epi8( 'A' - 1 ) ), _mm_cmplt_epi8( v, _mm_set1_epi8( 'Z' + 1 ) ) );
+         const __m128i lower = _mm_and_si128( _mm_cmpgt_epi8( v, _mm_set1_epi8( 'a' - 1 ) ), _mm_cmplt_epi8( v, _mm_set1_epi8( 'z' + 1 ) ) );
+         const __m128i digit = _mm_and_si128( _mm_cmpgt_epi8( v, _mm_set1_epi8( '0' - 1 ) ), _mm_cmplt_epi8( v, _mm_set1_epi8( '9' + 1 ) ) );
+         const __m128i c62 = _mm_cmpeq_epi8( v, _mm_set1_epi8( Alphabet::c62 ) );
+         const __m128i c63 = _mm_cmpeq_epi8( v, _mm_set1_epi8( Alphabet::c63 ) );
+         const __m128i letters = _mm_or_si128( _mm_and_si128( upper, _mm_set1_epi8( -'A' ) ), _mm_and_si128( lower, _mm_set1_epi8( 26 - 'a' ) ) );
+         const __m128i others = _mm_or_si128( _mm_and_si128( digit, _mm_set1_epi8( 52 - '0' ) ), _mm_or_si128( _mm_and_si128( c62, _mm_set1_epi8( char( 62 - Alphabet::c62 ) ) ), _mm_and_si128( c63, _mm_set1_epi8( char( 63 - Alphabet::c63 ) ) ) ) );
+         const __m128i s = _mm_add_epi8( v, _mm_or_si128( letters, others ) );
+         const __m128i w = _mm_or_si128( _mm_slli_epi16( _mm_and_si128( s, _mm_set1_epi16( 0x00ff ) ), 6 ), _mm_srli_epi16( s, 8 ) );
+         const __m128i d = _mm_madd_epi16( w, _mm_set1_epi32( 0x00011000 ) );
+         alignas( 16 ) std::uint64_t t[ 2 ];
+         _mm_store_si128( reinterpret_cast< __m128i* >( t ), d );
+         for( unsigned i = 0; i < 2; ++i ) {
+            const std::uint64_t u = TAO_PEGTL_NAMESPACE::internal::h_to_be( ( ( t[ i ] & 0xffffff ) << 40 ) | ( ( t[ i ] >> 32 ) << 16 ) );
+            std::memcpy( out + 6 * i, &u, 6 );
+         }
+      }
+#endif
+
+      template< typename Alphabet >
+      [[nodiscard]] char* decode( const char* p, const char* e, char* out ) noexcept
+      {
+         while( ( p != e ) && ( e[ -1 ] == '=' ) ) {
+            --e;
+         }
+#if defined( TAO_PEGTL_INTERNAL_SIMD_SSE2 )
+         while( e - p >= 16 ) {
+            decode16< Alphabet >( p, out );
+            p += 16;
+            out += 12;
+         }
+#endif
+         const auto& t = Alphabet::table;
+         while( e - p >= 4 ) {
+            const std::uint32_t v = ( std::uint32_t( t[ std::uint8_t( p[ 0 ] ) ] ) << 18 ) | ( std::uint32_t( t[ std::uint8_t( p[ 1 ] ) ] ) << 12 ) | ( std::uint32_t( t[ std::uint8_t( p[ 2 ] ) ] ) << 6 ) | t[ std::uint8_t( p[ 3 ] ) ];
+            out[ 0 ] = char( v >> 16 );
+            out[ 1 ] = char( v >> 8 );
+            out[ 2 ] = char( v );
+            p += 4;
+            out += 3;
+         }
+         if( e - p >= 2 ) {
+            const std::uint32_t v = ( std::uint32_t( t[ std::uint8_t( p[ 0 ] ) ] ) << 18 ) | ( std::uint32_t( t[ std::uint8_t( p[ 1 ] ) ] ) << 12 ) | ( ( e - p == 3 ) ? ( std::uint32_t( t[ std::uint8_t( p[ 2 ] ) ] ) << 6 ) : 0 );
+            *out++ = char( v >> 16 );
+            if( e - p == 3 ) {
+               *out++ = char( v >> 8 );
+            }
+         }
+         return out;
+      }
+
+      template< typename Alphabet >
+      struct append_decoded
+      {
+         template< typename Input, typename Container >
+         static void apply( const Input& in, Container& c )
+         {
+            static_assert( sizeof( typename Container::value_type ) == 1 );
+            const auto n = c.size();
+            c.resize( n + decoded_size( in.begin(), in.end() ) );
+            (void)decode< Alphabet >( in.begin(), in.end(), reinterpret_cast< char* >( c.data() ) + n );
+         }
+      };
+
+   }  // namespace internal
+
+   struct value
+      : internal::value< internal::standard >
+   {
+   };
+
+   // The number of bytes encoded by [ begin, end ), which MUST have been
+   // matched by value.
+
+   [[nodiscard]] inline std::size_t decoded_size( const char* begin, const char* end ) noexcept
+   {
+      return internal::decoded_size( begin, end );
+   }
+
+   // Decodes [ begin, end ), which MUST have been matched by value, to out,
+   // which MUST have room for decoded_size( begin, end ) bytes; returns the
+   // end of the decoded data.
+
+   [[nodiscard]] inline char* decode( const char* begin, const char* end, char* out ) noexcept
+   {
+      return internal::decode< internal::standard >( begin, end, out );
+   }
+
+   // Action that appends the decoded data to a std::string, or another
+   // container of bytes with resize() and data(), as state.
+
+   struct append_decoded
+      : internal::append_decoded< internal::standard >
+   {
+   };
+
+}  // namespace TAO_PEGTL_NAMESPACE::base64
+
+namespace TAO_PEGTL_NAMESPACE::base64url
+{
+   struct value
+      : base64::internal::value< base64::internal::url >
+   {
+   };
+
+   [[nodiscard]] inline std::size_t decoded_size( const char* begin, const char* end ) noexcept
+   {
+      return base64::internal::decoded_size( begin, end );
+   }
+
+   [[nodiscard]] inline char* decode( const char* begin, const char* end, char* out ) noexcept
+   {
+      return base64::internal::decode< base64::internal::url >( begin, end, out );
+   }
+
+   struct append_decoded
+      : base64::internal::append_decoded< base64::internal::url >
+   {
+   };
+
+}  // namespace TAO_PEGTL_NAMESPACE::base64url
+
+namespace TAO_PEGTL_NAMESPACE::internal
+{
+   template< typename Alphabet >
+   inline constexpr bool skip_control< base64::internal::value< Alphabet > > = true;
+
+}  // namespace TAO_PEGTL_NAMESPACE::internal
+
+#endif
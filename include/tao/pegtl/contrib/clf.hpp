@@ -0,0 +1,307 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_CLF_HPP
+#define TAO_PEGTL_CONTRIB_CLF_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "../ascii.hpp"
+#include "../config.hpp"
+#include "../memory_input.hpp"
+#include "../nothing.hpp"
+#include "../parse.hpp"
+#include "../rules.hpp"
+#include "../tracking_mode.hpp"
+
+#include "../analysis/generic.hpp"
+#include "../internal/escaped_string.hpp"
+#include "../internal/skip_control.hpp"
+
+#include "timestamp.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::clf
+{
+   // Access log lines in the Common Log Format and the Combined Log Format
+   // as written by Apache and NGINX, e.g.
+   //
+   //   127.0.0.1 - frank [10/Oct/2000:13:55:36 -0700] "GET /a.gif HTTP/1.0" 200 2326 "http://example.com/" "Mozilla/4.08"
+   //
+   // where the last two fields, the referer and the user agent, are only
+   // present in the latter; the rules require a memory input. Quoted fields
+   // can contain backslash escapes. The function parse() accepts either
+   // format and fills a structure with views into the line.
+
+   namespace internal
+   {
+      // Bytes other than control characters, SP and DEL.
+
+      struct token_table
+      {
+         bool table[ 256 ] = {};
+
+         constexpr token_table() noexcept
+         {
+            for( unsigned c = 33; c < 256; ++c ) {
+               table[ c ] = ( c != 127 );
+            }
+         }
+      };
+
+      inline constexpr token_table tokens{};
+
+      [[nodiscard]] inline const char* token_end( const char* p, const char* e ) noexcept
+      {
+         while( ( p != e ) && tokens.table[ static_cast< unsigned char >( *p ) ] ) {
+            ++p;
+         }
+         return p;
+      }
+
+      // Matches a non-empty sequence of bytes up to token_end().
+
+      struct token
+      {
+         using analyze_t = analysis::generic< analysis::rule_type::any >;
+
+         template< typename Input >
+         [[nodiscard]] static bool match( Input& in ) noexcept( noexcept( in.end() ) )
+         {
+            const auto n = std::size_t( token_end( in.current(), in.end() ) - in.current() );
+            in.bump_in_this_line( n );
+            return n != 0;
+         }
+      };
+
+   }  // namespace internal
+
+   // clang-format off
+   struct sp : one< ' ' > {};
+
+   struct host : internal::token {};
+   struct ident : internal::token {};
+   struct user : internal::token {};
+   struct timestamp : seq< one< '[' >, TAO_PEGTL_NAMESPACE::timestamp::clf, one< ']' > > {};
+   struct request_line : TAO_PEGTL_NAMESPACE::internal::escaped_string {};
+   struct request : seq< one< '"' >, request_line, one< '"' > > {};
+   struct status : rep< 3, digit > {};
+   struct bytes : sor< one< '-' >, rep_min_max< 1, 19, digit > > {};
+   struct referer_value : TAO_PEGTL_NAMESPACE::internal::escaped_string {};
+   struct referer : seq< one< '"' >, referer_value, one< '"' > > {};
+   struct user_agent_value : TAO_PEGTL_NAMESPACE::internal::escaped_string {};
+   struct user_agent : seq< one< '"' >, user_agent_value, one< '"' > > {};
+
+   struct common : seq< host, sp, ident, sp, user, sp, timestamp, sp, request, sp, status, sp, bytes > {};
+   struct combined : seq< common, sp, referer, sp, user_agent > {};
+   // clang-format on
+
+   struct entry
+   {
+      std::string_view host;
+      std::string_view ident;  // Empty for "-".
+      std::string_view user;  // Empty for "-".
+      TAO_PEGTL_NAMESPACE::timestamp::epoch timestamp;
+
+      std::string_view request;  // As in the input, see unescape().
+      std::string_view method;  // The three parts of the request, when
+      std::string_view target;  // it has three parts separated by SP,
+      std::string_view protocol;  // otherwise empty.
+
+      unsigned status = 0;
+      std::uint64_t bytes = 0;  // Also for "-".
+
+      // As in the input, empty for "-" and the Common Log Format.
+      std::string_view referer;
+      std::string_view user_agent;
+   };
+
+   namespace internal
+   {
+      [[nodiscard]] inline std::string_view view( const char* b, const char* e ) noexcept
+      {
+         return std::string_view( b, std::size_t( e - b ) );
+      }
+
+      [[nodiscard]] inline std::string_view nil_view( const char* b, const char* e ) noexcept
+      {
+         return ( ( e - b == 1 ) && ( *b == '-' ) ) ? std::string_view() : view( b, e );
+      }
+
+      template< typename Rule >
+      struct action
+         : nothing< Rule >
+      {
+      };
+
+      template<>
+      struct action< host >
+      {
+         template< typename Input >
+         static void apply( const Input& in, entry& r )
+         {
+            r.host = view( in.begin(), in.end() );
+         }
+      };
+
+      template<>
+      struct action< ident >
+      {
+         template< typename Input >
+         static void apply( const Input& in, entry& r )
+         {
+            r.ident = nil_view( in.begin(), in.end() );
+         }
+      };
+
+      template<>
+      struct action< user >
+      {
+         template< typename Input >
+         static void apply( const Input& in, entry& r )
+         {
+            r.user = nil_view( in.begin(), in.end() );
+         }
+      };
+
+      template<>
+      struct action< TAO_PEGTL_NAMESPACE::timestamp::clf >
+      {
+         template< typename Input >
+         static void apply( const Input& in, entry& r )
+         {
+            (void)TAO_PEGTL_NAMESPACE::timestamp::parse_clf( in.begin(), in.end(), r.timestamp );
+         }
+      };
+
+      template<>
+      struct action< request_line >
+      {
+         template< typename Input >
+         static void apply( const Input& in, entry& r )
+         {
+            r.request = view( in.begin(), in.end() );
+            const auto a = r.request.find( ' ' );
+            const auto b = r.request.rfind( ' ' );
+            if( ( a != 0 ) && ( a != std::string_view::npos ) && ( b > a + 1 ) && ( b + 1 < r.request.size() ) && ( r.request.find( ' ', a + 1 ) == b ) ) {
+               r.method = r.request.substr( 0, a );
+               r.target = r.request.substr( a + 1, b - a - 1 );
+               r.protocol = r.request.substr( b + 1 );
+            }
+         }
+      };
+
+      template<>
+      struct action< status >
+      {
+         template< typename Input >
+         static void apply( const Input& in, entry& r )
+         {
+            const char* p = in.begin();
+            r.status = unsigned( p[ 0 ] - '0' ) * 100 + unsigned( p[ 1 ] - '0' ) * 10 + unsigned( p[ 2 ] - '0' );
+         }
+      };
+
+      template<>
+      struct action< bytes >
+      {
+         template< typename Input >
+         static void apply( const Input& in, entry& r )
+         {
+            for( const char c : view( in.begin(), in.end() ) ) {
+               if( c != '-' ) {
+                  r.bytes = r.bytes * 10 + std::uint64_t( c - '0' );
+               }
+            }
+         }
+      };
+
+      template<>
+      struct action< referer_value >
+      {
+         template< typename Input >
+         static void apply( const Input& in, entry& r )
+         {
+            r.referer = nil_view( in.begin(), in.end() );
+         }
+      };
+
+      template<>
+      struct action< user_agent_value >
+      {
+         template< typename Input >
+         static void apply( const Input& in, entry& r )
+         {
+            r.user_agent = nil_view( in.begin(), in.end() );
+         }
+      };
+
+   }  // namespace internal
+
+   // Parses one line in the Common or Combined Log Format, without the
+   // line end, and returns whether it is valid.
+
+   [[nodiscard]] inline bool parse( const std::string_view line, entry& r )
+   {
+      r = entry();
+      memory_input< tracking_mode::lazy, eol::lf_crlf, const char* > in( line.data(), line.data() + line.size(), "clf" );
+      return TAO_PEGTL_NAMESPACE::parse< seq< common, opt< sp, referer, sp, user_agent >, opt< one< '\r' > >, eof >, internal::action >( in, r );
+   }
+
+   // Appends a quoted field with the escape sequences \xHH, \", \\, \n, \r
+   // and \t, as written by Apache and NGINX, replaced; other backslashes
+   // are kept.
+
+   inline void unescape( const std::string_view value, std::string& s )
+   {
+      const auto nibble = []( const char c ) {
+         return ( ( c >= '0' ) && ( c <= '9' ) ) ? ( c - '0' ) : ( ( ( c | 0x20 ) >= 'a' ) && ( ( c | 0x20 ) <= 'f' ) ) ? ( ( c | 0x20 ) - 'a' + 10 ) : -1;
+      };
+      for( std::size_t i = 0; i < value.size(); ++i ) {
+         if( ( value[ i ] != '\\' ) || ( i + 1 == value.size() ) ) {
+            s += value[ i ];
+            continue;
+         }
+         switch( const char c = value[ i + 1 ] ) {
+            case '"':
+            case '\\':
+               s += c;
+               ++i;
+               break;
+            case 'n':
+               s += '\n';
+               ++i;
+               break;
+            case 'r':
+               s += '\r';
+               ++i;
+               break;
+            case 't':
+               s += '\t';
+               ++i;
+               break;
+            case 'x':
+               if( ( i + 3 < value.size() ) && ( nibble( value[ i + 2 ] ) >= 0 ) && ( nibble( value[ i + 3 ] ) >= 0 ) ) {
+                  s += char( nibble( value[ i + 2 ] ) * 16 + nibble( value[ i + 3 ] ) );
+                  i += 3;
+                  break;
+               }
+               [[fallthrough]];
+            default:
+               s += '\\';
+         }
+      }
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE::clf
+
+namespace TAO_PEGTL_NAMESPACE::internal
+{
+   template<>
+   inline constexpr bool skip_control< clf::internal::token > = true;
+
+}  // namespace TAO_PEGTL_NAMESPACE::internal
+
+#endif
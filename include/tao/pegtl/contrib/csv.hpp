@@ -0,0 +1,524 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_CSV_HPP
+#define TAO_PEGTL_CONTRIB_CSV_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../apply_mode.hpp"
+#include "../ascii.hpp"
+#include "../config.hpp"
+#include "../nothing.hpp"
+#include "../parse_error.hpp"
+#include "../position.hpp"
+#include "../rewind_mode.hpp"
+#include "../rules.hpp"
+
+#include "../analysis/generic.hpp"
+#include "../internal/fast_path.hpp"
+#include "../internal/simd.hpp"
+
+#include "arena.hpp"
+#include "integer.hpp"
+#include "json_number.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::csv
+{
+   // Comma-separated values as per RFC 4180, with a configurable separator:
+   // fields are either plain, i.e. without quotes, line ends and separators,
+   // or quoted, i.e. enclosed in double quotes with embedded double quotes
+   // doubled; records are terminated by CR+LF or LF, except for the last.
+
+   namespace internal
+   {
+      template< char... Cs >
+      [[nodiscard]] const char* find( const char* p, const char* e ) noexcept
+      {
+         using block = TAO_PEGTL_NAMESPACE::internal::simd::block64;
+         return TAO_PEGTL_NAMESPACE::internal::simd::find_first( p, e, []( const block& b ) { return b.eq< Cs... >(); } );
+      }
+
+      // Returns the end of the content of a quoted field that starts at p,
+      // i.e. the first quote that is not doubled, or e.
+
+      [[nodiscard]] inline const char* quoted_end( const char* p, const char* e ) noexcept
+      {
+         while( ( p = find< '"' >( p, e ) ) != e ) {
+            if( ( e - p < 2 ) || ( p[ 1 ] != '"' ) ) {
+               break;
+            }
+            p += 2;
+         }
+         return p;
+      }
+
+      // The content of fields is matched as a whole, in bulk for memory inputs.
+
+      template< char Sep >
+      struct plain
+      {
+         using analyze_t = analysis::generic< analysis::rule_type::opt, not_one< Sep, '"', '\r', '\n' > >;
+
+         template< apply_mode,
+                   rewind_mode,
+                   template< typename... >
+                   class Action,
+                   template< typename... >
+                   class Control,
+                   typename Input,
+                   typename... States >
+         [[nodiscard]] static bool match( Input& in, States&&... /*unused*/ )
+         {
+            if constexpr( TAO_PEGTL_NAMESPACE::internal::is_memory_input_v< Input > ) {
+               in.bump_in_this_line( std::size_t( find< Sep, '"', '\r', '\n' >( in.current(), in.end() ) - in.current() ) );
+            }
+            else {
+               while( in.size( 1 ) != 0 ) {
+                  const char c = in.peek_char();
+                  if( ( c == Sep ) || ( c == '"' ) || ( c == '\r' ) || ( c == '\n' ) ) {
+                     break;
+                  }
+                  in.bump_in_this_line();
+               }
+            }
+            return true;
+         }
+      };
+
+      struct quoted_content
+      {
+         using analyze_t = analysis::generic< analysis::rule_type::opt, sor< two< '"' >, not_one< '"' > > >;
+
+         template< apply_mode,
+                   rewind_mode,
+                   template< typename... >
+                   class Action,
+                   template< typename... >
+                   class Control,
+                   typename Input,
+                   typename... States >
+         [[nodiscard]] static bool match( Input& in, States&&... /*unused*/ )
+         {
+            if constexpr( TAO_PEGTL_NAMESPACE::internal::is_memory_input_v< Input > ) {
+               in.bump( std::size_t( quoted_end( in.current(), in.end() ) - in.current() ) );
+            }
+            else {
+               while( in.size( 2 ) != 0 ) {
+                  if( in.peek_char() == '"' ) {
+                     if( ( in.size( 2 ) < 2 ) || ( in.peek_char( 1 ) != '"' ) ) {
+                        break;
+                     }
+                     in.bump_in_this_line( 2 );
+                  }
+                  else {
+                     in.bump();
+                  }
+               }
+            }
+            return true;
+         }
+      };
+
+   }  // namespace internal
+
+   // clang-format off
+   template< char Sep = ',' > struct plain : internal::plain< Sep > {};
+   struct quoted_content : internal::quoted_content {};
+   struct quoted : if_must< one< '"' >, quoted_content, one< '"' > > {};
+
+   template< char Sep = ',' > struct field : sor< quoted, plain< Sep > > {};
+   template< char Sep = ',' > struct record : list< field< Sep >, one< Sep > > {};
+   // clang-format on
+
+   // The last record does not need a line end, which the analysis can not
+   // see through since until<> checks for eof before every record; hence
+   // file is analysed as the (equivalent) star< record, eol >, opt< record >.
+
+   template< char Sep = ',' >
+   struct file
+      : until< eof, record< Sep >, must< eolf > >
+   {
+      using analyze_t = analysis::generic< analysis::rule_type::seq, star< record< Sep >, eol >, opt< record< Sep > >, eof >;
+   };
+
+   // A table stores the fields of a CSV file in columns, i.e. as a
+   // struct of arrays, that are converted while parsing according to
+   // their column_type. Text fields are string_views into the input
+   // unless they contain doubled quotes, therefore the input MUST
+   // outlive the table.
+
+   enum class column_type : std::uint8_t
+   {
+      skip,
+      text,
+      integer,
+      real
+   };
+
+   class table
+   {
+   public:
+      explicit table( std::vector< column_type > types, const bool header = false )
+         : m_columns( types.size() ),
+           m_header( header )
+      {
+         for( std::size_t i = 0; i < types.size(); ++i ) {
+            m_columns[ i ].type = types[ i ];
+         }
+      }
+
+      [[nodiscard]] std::size_t columns() const noexcept
+      {
+         return m_columns.size();
+      }
+
+      [[nodiscard]] std::size_t rows() const noexcept
+      {
+         return m_rows;
+      }
+
+      // Reserves memory in all columns for the given number of rows.
+
+      void reserve( const std::size_t rows )
+      {
+         for( auto& c : m_columns ) {
+            switch( c.type ) {
+               case column_type::skip:
+                  break;
+               case column_type::text:
+                  c.text.reserve( rows );
+                  break;
+               case column_type::integer:
+                  c.integers.reserve( rows );
+                  break;
+               case column_type::real:
+                  c.reals.reserve( rows );
+                  break;
+            }
+         }
+      }
+
+      // The fields of the first record when the table has a header, which
+      // is not counted as row.
+
+      [[nodiscard]] const std::vector< std::string >& names() const noexcept
+      {
+         return m_names;
+      }
+
+      [[nodiscard]] column_type type( const std::size_t i ) const noexcept
+      {
+         return m_columns[ i ].type;
+      }
+
+      [[nodiscard]] const std::vector< std::string_view >& text( const std::size_t i ) const noexcept
+      {
+         return m_columns[ i ].text;
+      }
+
+      [[nodiscard]] const std::vector< std::int64_t >& integers( const std::size_t i ) const noexcept
+      {
+         return m_columns[ i ].integers;
+      }
+
+      [[nodiscard]] const std::vector< double >& reals( const std::size_t i ) const noexcept
+      {
+         return m_columns[ i ].reals;
+      }
+
+      // Appends the (raw, possibly quoted) field [ b, e ) to the next
+      // column of the current row; returns an error message or nullptr.
+      // The quotes of the field are assumed to be valid.
+
+      [[nodiscard]] const char* field( const char* b, const char* e )
+      {
+         if( m_column == m_columns.size() ) {
+            return "too many fields";
+         }
+         const bool is_quoted = ( b != e ) && ( *b == '"' );
+         if( is_quoted ) {
+            if( ( e - b < 2 ) || ( e[ -1 ] != '"' ) ) {
+               return "invalid quoted field";
+            }
+            ++b;
+            --e;
+         }
+         if( m_header ) {
+            m_names.emplace_back( is_quoted ? unescape( b, e ) : std::string_view( b, std::size_t( e - b ) ) );
+            ++m_column;
+            return nullptr;
+         }
+         auto& c = m_columns[ m_column++ ];
+         switch( c.type ) {
+            case column_type::skip:
+               break;
+            case column_type::text:
+               c.text.emplace_back( is_quoted ? unescape( b, e ) : std::string_view( b, std::size_t( e - b ) ) );
+               break;
+            case column_type::integer:
+               if( !is_integer( b, e ) || !integer::internal::convert_signed( c.integers.emplace_back( 0 ), std::string_view( b, std::size_t( e - b ) ) ) ) {
+                  return "invalid integer";
+               }
+               break;
+            case column_type::real:
+               if( !is_number( b, e ) ) {
+                  return "invalid number";
+               }
+               c.reals.emplace_back( json::number_view( std::string_view( b, std::size_t( e - b ) ) ).to_double() );
+               break;
+         }
+         return nullptr;
+      }
+
+      // Completes the current row; returns an error message or nullptr.
+
+      [[nodiscard]] const char* end_row() noexcept
+      {
+         if( m_column != m_columns.size() ) {
+            return "too few fields";
+         }
+         m_column = 0;
+         if( m_header ) {
+            m_header = false;
+         }
+         else {
+            ++m_rows;
+         }
+         return nullptr;
+      }
+
+      [[nodiscard]] bool in_row() const noexcept
+      {
+         return m_column != 0;
+      }
+
+   private:
+      struct column
+      {
+         column_type type = column_type::skip;
+         std::vector< std::string_view > text;
+         std::vector< std::int64_t > integers;
+         std::vector< double > reals;
+      };
+
+      [[nodiscard]] std::string_view unescape( const char* b, const char* e )
+      {
+         const char* q = static_cast< const char* >( std::memchr( b, '"', std::size_t( e - b ) ) );
+         if( q == nullptr ) {
+            return std::string_view( b, std::size_t( e - b ) );
+         }
+         char* const r = m_arena.allocate_array< char >( std::size_t( e - b ) );
+         char* o = r;
+         do {
+            ++q;  // Copies the first quote of a pair.
+            std::memcpy( o, b, std::size_t( q - b ) );
+            o += q - b;
+            b = q + 1;
+         } while( ( q = static_cast< const char* >( std::memchr( b, '"', std::size_t( e - b ) ) ) ) != nullptr );
+         std::memcpy( o, b, std::size_t( e - b ) );
+         o += e - b;
+         return std::string_view( r, std::size_t( o - r ) );
+      }
+
+      [[nodiscard]] static bool digits( const char*& p, const char* e ) noexcept
+      {
+         const char* b = p;
+         while( ( p != e ) && integer::internal::is_digit( *p ) ) {
+            ++p;
+         }
+         return p != b;
+      }
+
+      [[nodiscard]] static bool is_integer( const char* p, const char* e ) noexcept
+      {
+         p += int( ( p != e ) && ( ( *p == '-' ) || ( *p == '+' ) ) );
+         return digits( p, e ) && ( p == e );
+      }
+
+      // Decimal numbers with optional fraction and exponent, i.e. JSON
+      // numbers with optional leading zeros.
+
+      [[nodiscard]] static bool is_number( const char* p, const char* e ) noexcept
+      {
+         p += int( ( p != e ) && ( *p == '-' ) );
+         if( !digits( p, e ) ) {
+            return false;
+         }
+         if( ( p != e ) && ( *p == '.' ) && !digits( ++p, e ) ) {
+            return false;
+         }
+         if( ( p != e ) && ( ( *p == 'e' ) || ( *p == 'E' ) ) ) {
+            ++p;
+            p += int( ( p != e ) && ( ( *p == '-' ) || ( *p == '+' ) ) );
+            if( !digits( p, e ) ) {
+               return false;
+            }
+         }
+         return p == e;
+      }
+
+      std::vector< column > m_columns;
+      std::vector< std::string > m_names;
+      arena m_arena;  // For fields with doubled quotes.
+      std::size_t m_column = 0;
+      std::size_t m_rows = 0;
+      bool m_header;  // True until the header, if any, is complete.
+   };
+
+   // Actions to fill a table while parsing with csv::file, the input
+   // has to be a memory input.
+
+   template< typename Rule >
+   struct columnar_action
+      : nothing< Rule >
+   {
+   };
+
+   template< char Sep >
+   struct columnar_action< field< Sep > >
+   {
+      template< typename Input >
+      static void apply( const Input& in, table& t )
+      {
+         if( const char* message = t.field( in.begin(), in.end() ) ) {
+            throw parse_error( message, in );
+         }
+      }
+   };
+
+   template< char Sep >
+   struct columnar_action< record< Sep > >
+   {
+      template< typename Input >
+      static void apply( const Input& in, table& t )
+      {
+         if( const char* message = t.end_row() ) {
+            throw parse_error( message, in );
+         }
+      }
+   };
+
+   namespace internal
+   {
+      template< typename Input >
+      [[noreturn]] void raise( const Input& in, const char* p, const char* message )
+      {
+         position pos = in.position();
+         for( const char* q = in.current(); q != p; ++q ) {
+            ++pos.byte;
+            if( *q == '\n' ) {
+               ++pos.line;
+               pos.byte_in_line = 0;
+            }
+            else {
+               ++pos.byte_in_line;
+            }
+         }
+         throw parse_error( message, std::move( pos ) );
+      }
+
+   }  // namespace internal
+
+   // Fills a table with the records of a memory input without using the
+   // grammar: the separators, quotes, CRs and LFs of 64 bytes at a time
+   // are classified in parallel (SIMD where available), the separators
+   // and line ends within quoted fields are masked with a prefix-xor of
+   // the quotes, and misplaced quotes and CRs are found with shifted
+   // masks; only the fields are then visited individually. Accepts and
+   // rejects the same inputs as csv::file.
+
+   template< char Sep = ',', typename Input >
+   void read( const Input& in, table& t )
+   {
+      static_assert( TAO_PEGTL_NAMESPACE::internal::is_memory_input_v< Input >, "csv::read() requires a memory input" );
+      using block = TAO_PEGTL_NAMESPACE::internal::simd::block64;
+
+      const char* const end = in.end();
+      const char* row = in.current();
+      const char* field = row;
+
+      const auto emit = [ & ]( const char* e, const bool last ) {
+         if( ( e != end ) && ( e != field ) && ( e[ -1 ] == '\r' ) ) {
+            --e;
+         }
+         if( const char* message = t.field( field, e ) ) {
+            internal::raise( in, field, message );
+         }
+         if( last ) {
+            if( const char* message = t.end_row() ) {
+               internal::raise( in, row, message );
+            }
+         }
+      };
+
+      std::uint64_t in_quotes = 0;
+      std::uint64_t after_close = 0;  // Whether the last byte of the previous block was a closing quote,
+      std::uint64_t after_cr = 0;  // a CR outside of quotes,
+      std::uint64_t after_boundary = 1;  // or a separator, LF or quote.
+
+      for( const char* p = in.current(); p < end; p += block::size ) {
+         const auto r = std::size_t( end - p );
+         const block b = ( r >= block::size ) ? block( p ) : block( p, r, '"' );
+         const std::uint64_t valid = ( r >= block::size ) ? ~std::uint64_t( 0 ) : ( ~std::uint64_t( 0 ) >> ( block::size - r ) );
+
+         const std::uint64_t quote = b.eq< '"' >() & valid;
+         const std::uint64_t inside = TAO_PEGTL_NAMESPACE::internal::simd::prefix_xor( quote ) ^ in_quotes;
+         in_quotes = std::uint64_t( -std::int64_t( inside >> 63 ) );
+
+         const std::uint64_t sep = b.eq< Sep >() & ~inside;
+         const std::uint64_t lf = b.eq< '\n' >() & ~inside;
+         const std::uint64_t cr = b.eq< '\r' >() & ~inside;
+         const std::uint64_t open = quote & inside;
+         const std::uint64_t close = quote & ~inside;
+         const std::uint64_t boundary = sep | lf | quote;
+
+         // An opening quote must start a field or follow a closing quote
+         // (doubled quotes), a closing quote must end a field or precede
+         // an opening quote, and a CR must precede an LF; the end of the
+         // input, i.e. the padding of the last block, is a boundary.
+         const std::uint64_t bad_open = open & ~( ( boundary << 1 ) | after_boundary );
+         const std::uint64_t bad_next = ( ( ( close << 1 ) | after_close ) & ~( boundary | cr | ~valid ) ) | ( ( ( cr << 1 ) | after_cr ) & ~( lf | ~valid ) );
+         const std::uint64_t bad = ( bad_open | ( bad_next >> 1 ) ) & valid;
+
+         if( ( bad_next & 1 ) != 0 ) {
+            internal::raise( in, p - 1, "invalid quote or carriage return" );
+         }
+         const std::uint64_t before_bad = ( bad != 0 ) ? ( ( std::uint64_t( 1 ) << TAO_PEGTL_NAMESPACE::internal::simd::ctz64( bad ) ) - 1 ) : ~std::uint64_t( 0 );
+
+         for( std::uint64_t m = ( sep | lf ) & valid & before_bad; m != 0; m &= m - 1 ) {
+            const char* s = p + TAO_PEGTL_NAMESPACE::internal::simd::ctz64( m );
+            const bool last = ( *s == '\n' );
+            emit( s, last );
+            field = s + 1;
+            if( last ) {
+               row = field;
+            }
+         }
+         if( bad != 0 ) {
+            internal::raise( in, p + TAO_PEGTL_NAMESPACE::internal::simd::ctz64( bad ), "invalid quote or carriage return" );
+         }
+         after_close = close >> 63;
+         after_cr = cr >> 63;
+         after_boundary = boundary >> 63;
+      }
+      if( in_quotes != 0 ) {
+         internal::raise( in, field, "unterminated quoted field" );
+      }
+      if( ( end != in.current() ) && ( end[ -1 ] == '\r' ) ) {
+         internal::raise( in, end - 1, "invalid quote or carriage return" );
+      }
+      if( ( field != end ) || t.in_row() ) {
+         emit( end, true );
+      }
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE::csv
+
+#endif
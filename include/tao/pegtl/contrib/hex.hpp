@@ -0,0 +1,141 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_HEX_HPP
+#define TAO_PEGTL_CONTRIB_HEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../config.hpp"
+
+#include "../analysis/generic.hpp"
+#include "../internal/fast_path.hpp"
+#include "../internal/simd.hpp"
+#include "../internal/skip_control.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::hex
+{
+   // Binary data encoded with two hexadecimal digits per byte, the most
+   // significant digit first, in upper and/or lower case.
+
+   namespace internal
+   {
+      [[nodiscard]] constexpr bool is_digit( const char c ) noexcept
+      {
+         return ( ( '0' <= c ) && ( c <= '9' ) ) || ( ( 'a' <= c ) && ( c <= 'f' ) ) || ( ( 'A' <= c ) && ( c <= 'F' ) );
+      }
+
+      // Returns the first byte in [ p, e ) that is not a hexadecimal digit.
+
+      [[nodiscard]] inline const char* scan( const char* p, const char* e ) noexcept
+      {
+         using block = TAO_PEGTL_NAMESPACE::internal::simd::block64;
+         return TAO_PEGTL_NAMESPACE::internal::simd::find_first( p, e, []( const block& b ) {
+            return ~( b.in_range< '0', '9' >() | b.in_range< 'a', 'f' >() | b.in_range< 'A', 'F' >() );
+         } );
+      }
+
+      // Matches a non-empty sequence of hexadecimal digits of even length,
+      // fails when the sequence of hexadecimal digits has an odd length.
+
+      struct value
+      {
+         using analyze_t = analysis::generic< analysis::rule_type::any >;
+
+         template< typename Input >
+         [[nodiscard]] static bool match( Input& in )
+         {
+            std::size_t n = 0;
+            if constexpr( TAO_PEGTL_NAMESPACE::internal::is_memory_input_v< Input > ) {
+               n = std::size_t( scan( in.current(), in.end() ) - in.current() );
+            }
+            else {
+               while( ( in.size( n + 1 ) > n ) && is_digit( in.peek_char( n ) ) ) {
+                  ++n;
+               }
+            }
+            if( ( n == 0 ) || ( n % 2 != 0 ) ) {
+               return false;
+            }
+            in.bump_in_this_line( n );
+            return true;
+         }
+      };
+
+      // Maps '0' to '9', 'a' to 'f' and 'A' to 'F' to their values.
+
+      [[nodiscard]] constexpr std::uint8_t nibble( const char c ) noexcept
+      {
+         return std::uint8_t( ( c & 0x0f ) + 9 * ( ( c >> 6 ) & 1 ) );
+      }
+
+   }  // namespace internal
+
+   struct value
+      : internal::value
+   {
+   };
+
+   // The number of bytes encoded by [ begin, end ), which MUST have been
+   // matched by value.
+
+   [[nodiscard]] inline std::size_t decoded_size( const char* begin, const char* end ) noexcept
+   {
+      return std::size_t( end - begin ) / 2;
+   }
+
+   // Decodes [ begin, end ), which MUST have been matched by value, to out,
+   // which MUST have room for decoded_size( begin, end ) bytes; returns the
+   // end of the decoded data. Where SSE2 is available 32 digits are decoded
+   // at a time: after folding to lower case the digits are mapped to their
+   // values with one subtraction, plus one more for letters, and adjacent
+   // values are combined into bytes.
+
+   [[nodiscard]] inline char* decode( const char* p, const char* e, char* out ) noexcept
+   {
+#if defined( TAO_PEGTL_INTERNAL_SIMD_SSE2 )
+      const auto nibbles = []( const char* q ) {
+         const __m128i v = _mm_or_si128( _mm_loadu_si128( reinterpret_cast< const __m128i* >( q ) ), _mm_set1_epi8( 0x20 ) );
+         const __m128i letters = _mm_and_si128( _mm_cmpgt_epi8( v, _mm_set1_epi8( '9' ) ), _mm_set1_epi8( 'a' - '0' - 10 ) );
+         const __m128i n = _mm_sub_epi8( _mm_sub_epi8( v, _mm_set1_epi8( '0' ) ), letters );
+         return _mm_or_si128( _mm_slli_epi16( _mm_and_si128( n, _mm_set1_epi16( 0x00ff ) ), 4 ), _mm_srli_epi16( n, 8 ) );
+      };
+      while( e - p >= 32 ) {
+         _mm_storeu_si128( reinterpret_cast< __m128i* >( out ), _mm_packus_epi16( nibbles( p ), nibbles( p + 16 ) ) );
+         p += 32;
+         out += 16;
+      }
+#endif
+      while( e - p >= 2 ) {
+         *out++ = char( ( internal::nibble( p[ 0 ] ) << 4 ) | internal::nibble( p[ 1 ] ) );
+         p += 2;
+      }
+      return out;
+   }
+
+   // Action that appends the decoded data to a std::string, or another
+   // container of bytes with resize() and data(), as state.
+
+   struct append_decoded
+   {
+      template< typename Input, typename Container >
+      static void apply( const Input& in, Container& c )
+      {
+         static_assert( sizeof( typename Container::value_type ) == 1 );
+         const auto n = c.size();
+         c.resize( n + decoded_size( in.begin(), in.end() ) );
+         (void)decode( in.begin(), in.end(), reinterpret_cast< char* >( c.data() ) + n );
+      }
+   };
+
+}  // namespace TAO_PEGTL_NAMESPACE::hex
+
+namespace TAO_PEGTL_NAMESPACE::internal
+{
+   template<>
+   inline constexpr bool skip_control< hex::internal::value > = true;
+
+}  // namespace TAO_PEGTL_NAMESPACE::internal
+
+#endif
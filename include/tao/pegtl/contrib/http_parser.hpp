@@ -0,0 +1,815 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_HTTP_PARSER_HPP
+#define TAO_PEGTL_CONTRIB_HTTP_PARSER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../ascii.hpp"
+#include "../config.hpp"
+#include "../memory_input.hpp"
+#include "../nothing.hpp"
+#include "../parse.hpp"
+#include "../parse_error.hpp"
+#include "../rules.hpp"
+#include "../tracking_mode.hpp"
+
+#include "../internal/iterator.hpp"
+#include "../internal/simd.hpp"
+
+#include "http.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::http::parser
+{
+   // High-performance parser for HTTP/1.x message heads and chunked bodies.
+   //
+   // Compared to the grammar in http.hpp the rules here match tokens with
+   // a lookup table and field values and request targets with 64-byte
+   // block scans, accept LF as well as CR+LF as line end, and reject
+   // obsolete line folding. The functions parse_request() and
+   // parse_response() fill a structure with views into the input.
+
+   enum class header_id : std::uint8_t
+   {
+      unknown,
+      accept,
+      accept_charset,
+      accept_encoding,
+      accept_language,
+      accept_ranges,
+      age,
+      authorization,
+      cache_control,
+      connection,
+      content_encoding,
+      content_language,
+      content_length,
+      content_location,
+      content_range,
+      content_type,
+      cookie,
+      date,
+      etag,
+      expect,
+      forwarded,
+      host,
+      if_match,
+      if_modified_since,
+      if_none_match,
+      if_range,
+      if_unmodified_since,
+      keep_alive,
+      last_modified,
+      location,
+      max_forwards,
+      origin,
+      pragma,
+      proxy_authenticate,
+      proxy_authorization,
+      range,
+      referer,
+      retry_after,
+      server,
+      set_cookie,
+      te,
+      trailer,
+      transfer_encoding,
+      upgrade,
+      user_agent,
+      vary,
+      via,
+      www_authenticate,
+      x_forwarded_for,
+      x_forwarded_host,
+      x_forwarded_proto,
+      x_real_ip,
+      x_request_id
+   };
+
+   namespace internal
+   {
+      // Lower-case names, indexed by header_id.
+
+      inline constexpr std::string_view header_names[] = {
+         "",
+         "accept",
+         "accept-charset",
+         "accept-encoding",
+         "accept-language",
+         "accept-ranges",
+         "age",
+         "authorization",
+         "cache-control",
+         "connection",
+         "content-encoding",
+         "content-language",
+         "content-length",
+         "content-location",
+         "content-range",
+         "content-type",
+         "cookie",
+         "date",
+         "etag",
+         "expect",
+         "forwarded",
+         "host",
+         "if-match",
+         "if-modified-since",
+         "if-none-match",
+         "if-range",
+         "if-unmodified-since",
+         "keep-alive",
+         "last-modified",
+         "location",
+         "max-forwards",
+         "origin",
+         "pragma",
+         "proxy-authenticate",
+         "proxy-authorization",
+         "range",
+         "referer",
+         "retry-after",
+         "server",
+         "set-cookie",
+         "te",
+         "trailer",
+         "transfer-encoding",
+         "upgrade",
+         "user-agent",
+         "vary",
+         "via",
+         "www-authenticate",
+         "x-forwarded-for",
+         "x-forwarded-host",
+         "x-forwarded-proto",
+         "x-real-ip",
+         "x-request-id"
+      };
+
+      // A perfect hash for the names above, based on the length and three
+      // characters, that maps them to distinct slots of a 128 entry table.
+      // Setting bit 5 makes letters lower-case; all other characters of the
+      // known names are unaffected and for tokens no other character can
+      // become a letter or '-', so the final comparison is exact.
+
+      [[nodiscard]] constexpr unsigned char lower( const char c ) noexcept
+      {
+         return static_cast< unsigned char >( c | 0x20 );
+      }
+
+      [[nodiscard]] constexpr std::size_t header_hash( const std::string_view s ) noexcept
+      {
+         return ( s.size() * 35 + lower( s[ 0 ] ) * 36 + lower( s[ s.size() - 1 ] ) * 59 + lower( s[ s.size() / 2 ] ) ) & 127;
+      }
+
+      struct header_table
+      {
+         std::array< std::uint8_t, 128 > slots{};
+         bool perfect = true;
+      };
+
+      [[nodiscard]] constexpr header_table make_header_table() noexcept
+      {
+         header_table t;
+         for( std::size_t i = 1; i < std::size( header_names ); ++i ) {
+            auto& slot = t.slots[ header_hash( header_names[ i ] ) ];
+            t.perfect = t.perfect && ( slot == 0 );
+            slot = std::uint8_t( i );
+         }
+         return t;
+      }
+
+      inline constexpr header_table header_slots = make_header_table();
+
+      static_assert( header_slots.perfect, "header_hash() is not perfect for header_names" );
+
+      [[nodiscard]] inline bool iequal( const std::string_view s, const std::string_view lower_case ) noexcept
+      {
+         if( s.size() != lower_case.size() ) {
+            return false;
+         }
+         for( std::size_t i = 0; i < s.size(); ++i ) {
+            if( lower( s[ i ] ) != static_cast< unsigned char >( lower_case[ i ] ) ) {
+               return false;
+            }
+         }
+         return true;
+      }
+
+   }  // namespace internal
+
+   // Returns the id of a header field name, compared case-insensitively,
+   // or header_id::unknown. The name must be a token.
+
+   [[nodiscard]] inline header_id find_header_id( const std::string_view name ) noexcept
+   {
+      if( name.empty() ) {
+         return header_id::unknown;
+      }
+      const auto i = internal::header_slots.slots[ internal::header_hash( name ) ];
+      return internal::iequal( name, internal::header_names[ i ] ) ? header_id( i ) : header_id::unknown;
+   }
+
+   [[nodiscard]] inline std::string_view header_name( const header_id id ) noexcept
+   {
+      return internal::header_names[ std::size_t( id ) ];
+   }
+
+   namespace internal
+   {
+      // tchar from RFC 7230, see http::tchar.
+
+      struct tchar_table
+      {
+         bool table[ 256 ] = {};
+
+         constexpr tchar_table() noexcept
+         {
+            for( const char c : std::string_view( "!#$%&'*+-.^_`|~" ) ) {
+               table[ static_cast< unsigned char >( c ) ] = true;
+            }
+            for( unsigned c = '0'; c <= '9'; ++c ) {
+               table[ c ] = true;
+            }
+            for( unsigned c = 'a'; c <= 'z'; ++c ) {
+               table[ c ] = true;
+               table[ c - 'a' + 'A' ] = true;
+            }
+         }
+      };
+
+      inline constexpr tchar_table tchars{};
+
+      [[nodiscard]] inline const char* token_end( const char* p, const char* e ) noexcept
+      {
+         while( ( p != e ) && tchars.table[ static_cast< unsigned char >( *p ) ] ) {
+            ++p;
+         }
+         return p;
+      }
+
+      // Control characters except HTAB, and DEL, end a field value.
+
+      [[nodiscard]] inline const char* field_value_end( const char* p, const char* e ) noexcept
+      {
+         using block = TAO_PEGTL_NAMESPACE::internal::simd::block64;
+         return TAO_PEGTL_NAMESPACE::internal::simd::find_first< '\n' >( p, e, []( const block& b ) {
+            return b.in_range< 0x00, 0x08 >() | b.in_range< 0x0A, 0x1F >() | b.eq< 0x7F >();
+         } );
+      }
+
+      // Control characters, DEL and SP end a request target.
+
+      [[nodiscard]] inline const char* target_end( const char* p, const char* e ) noexcept
+      {
+         using block = TAO_PEGTL_NAMESPACE::internal::simd::block64;
+         return TAO_PEGTL_NAMESPACE::internal::simd::find_first< ' ' >( p, e, []( const block& b ) {
+            return b.in_range< 0x00, 0x20 >() | b.eq< 0x7F >();
+         } );
+      }
+
+      // Matches the bytes up to the first for which End() stops, which
+      // must not be at the beginning when NonEmpty is true.
+
+      template< const char* ( *End )( const char*, const char* ), bool NonEmpty >
+      struct scan
+      {
+         template< apply_mode,
+                   rewind_mode,
+                   template< typename... >
+                   class Action,
+                   template< typename... >
+                   class Control,
+                   typename Input,
+                   typename... States >
+         [[nodiscard]] static bool match( Input& in, States&&... /*unused*/ ) noexcept( noexcept( in.end() ) )
+         {
+            const auto n = std::size_t( End( in.current(), in.end() ) - in.current() );
+            in.bump_in_this_line( n );
+            return ( n != 0 ) || !NonEmpty;
+         }
+      };
+
+   }  // namespace internal
+
+   struct token
+   {
+      using analyze_t = plus< http::tchar >::analyze_t;
+
+      template< apply_mode,
+                rewind_mode,
+                template< typename... >
+                class Action,
+                template< typename... >
+                class Control,
+                typename Input,
+                typename... States >
+      [[nodiscard]] static bool match( Input& in, States&&... /*unused*/ ) noexcept( noexcept( in.end() ) )
+      {
+         const auto n = std::size_t( internal::token_end( in.current(), in.end() ) - in.current() );
+         in.bump_in_this_line( n );
+         return n != 0;
+      }
+   };
+
+   struct field_value
+      : internal::scan< internal::field_value_end, false >
+   {
+      using analyze_t = http::field_value::analyze_t;
+   };
+
+   struct reason_phrase
+      : internal::scan< internal::field_value_end, false >
+   {
+      using analyze_t = http::reason_phrase::analyze_t;
+   };
+
+   struct request_target
+      : internal::scan< internal::target_end, true >
+   {
+      using analyze_t = plus< abnf::VCHAR >::analyze_t;
+   };
+
+   // clang-format off
+   using OWS = star< one< ' ', '\t' > >;
+   using eol = seq< opt< one< '\r' > >, one< '\n' > >;
+
+   struct method : token {};
+   struct field_name : token {};
+   struct minor_version : digit {};
+   struct HTTP_version : seq< string< 'H', 'T', 'T', 'P', '/', '1', '.' >, minor_version > {};
+   struct status_code : rep< 3, digit > {};
+
+   struct request_line : if_must< method, one< ' ' >, request_target, one< ' ' >, HTTP_version, eol > {};
+   struct status_line : if_must< HTTP_version, one< ' ' >, status_code, opt< one< ' ' >, reason_phrase >, eol > {};
+
+   struct header_field : if_must< field_name, one< ':' >, OWS, field_value, eol > {};
+   struct headers : star< header_field > {};
+
+   struct request_head : must< request_line, headers, eol > {};
+   struct response_head : must< status_line, headers, eol > {};
+   // clang-format on
+
+   struct header
+   {
+      header_id id;
+      std::string_view name;
+      std::string_view value;  // Without leading and trailing whitespace.
+   };
+
+   struct message_head
+   {
+      unsigned minor_version = 1;
+      std::vector< header > headers;
+
+      // Interpretation of the headers for the framing of the body.
+      std::optional< std::size_t > content_length;
+      bool chunked = false;  // Whether the last transfer coding is chunked.
+      bool keep_alive = true;  // From the version and the Connection header.
+
+      // Returns the value of the first header with the given id.
+      [[nodiscard]] std::optional< std::string_view > find( const header_id id ) const noexcept
+      {
+         for( const auto& h : headers ) {
+            if( h.id == id ) {
+               return h.value;
+            }
+         }
+         return std::nullopt;
+      }
+   };
+
+   struct request
+      : message_head
+   {
+      std::string_view method;
+      std::string_view target;
+   };
+
+   struct response
+      : message_head
+   {
+      unsigned status = 0;
+      std::string_view reason;
+   };
+
+   namespace internal
+   {
+      [[nodiscard]] inline std::string_view view( const char* b, const char* e ) noexcept
+      {
+         return std::string_view( b, std::size_t( e - b ) );
+      }
+
+      // Calls f( token ) for the elements of a comma-separated list.
+
+      template< typename F >
+      void for_each_element( std::string_view s, const F& f )
+      {
+         while( !s.empty() ) {
+            const auto n = s.find( ',' );
+            auto t = s.substr( 0, n );
+            while( !t.empty() && ( ( t.front() == ' ' ) || ( t.front() == '\t' ) ) ) {
+               t.remove_prefix( 1 );
+            }
+            while( !t.empty() && ( ( t.back() == ' ' ) || ( t.back() == '\t' ) ) ) {
+               t.remove_suffix( 1 );
+            }
+            if( !t.empty() ) {
+               f( t );
+            }
+            s.remove_prefix( ( n == std::string_view::npos ) ? s.size() : ( n + 1 ) );
+         }
+      }
+
+      template< typename Input >
+      void framing( const Input& in, message_head& m, const header& h )
+      {
+         switch( h.id ) {
+            case header_id::content_length: {
+               if( h.value.empty() ) {
+                  throw parse_error( "invalid Content-Length", in );
+               }
+               std::size_t n = 0;
+               for( const char c : h.value ) {
+                  if( ( c < '0' ) || ( c > '9' ) ) {
+                     throw parse_error( "invalid Content-Length", in );
+                  }
+                  const auto d = std::size_t( c - '0' );
+                  if( n > ( std::numeric_limits< std::size_t >::max() - d ) / 10 ) {
+                     throw parse_error( "Content-Length too large", in );
+                  }
+                  n = n * 10 + d;
+               }
+               if( m.content_length && ( *m.content_length != n ) ) {
+                  throw parse_error( "conflicting Content-Length", in );
+               }
+               m.content_length = n;
+               break;
+            }
+            case header_id::transfer_encoding:
+               m.chunked = false;
+               for_each_element( h.value, [ & ]( const std::string_view t ) { m.chunked = iequal( t, "chunked" ); } );
+               break;
+            case header_id::connection:
+               for_each_element( h.value, [ & ]( const std::string_view t ) {
+                  if( iequal( t, "close" ) ) {
+                     m.keep_alive = false;
+                  }
+                  else if( iequal( t, "keep-alive" ) ) {
+                     m.keep_alive = true;
+                  }
+               } );
+               break;
+            default:
+               return;
+         }
+         // RFC 7230, 3.3.3: A message with both can be an attempt at request smuggling.
+         if( m.content_length && ( m.find( header_id::transfer_encoding ) ) ) {
+            throw parse_error( "Content-Length with Transfer-Encoding", in );
+         }
+      }
+
+      template< typename Rule >
+      struct head_action
+         : nothing< Rule >
+      {
+      };
+
+      template<>
+      struct head_action< method >
+      {
+         template< typename Input >
+         static void apply( const Input& in, request& r )
+         {
+            r.method = view( in.begin(), in.end() );
+         }
+      };
+
+      template<>
+      struct head_action< request_target >
+      {
+         template< typename Input >
+         static void apply( const Input& in, request& r )
+         {
+            r.target = view( in.begin(), in.end() );
+         }
+      };
+
+      template<>
+      struct head_action< minor_version >
+      {
+         template< typename Input >
+         static void apply( const Input& in, message_head& m )
+         {
+            m.minor_version = unsigned( *in.begin() - '0' );
+            m.keep_alive = ( m.minor_version != 0 );
+         }
+      };
+
+      template<>
+      struct head_action< status_code >
+      {
+         template< typename Input >
+         static void apply( const Input& in, response& r )
+         {
+            const char* p = in.begin();
+            r.status = unsigned( p[ 0 ] - '0' ) * 100 + unsigned( p[ 1 ] - '0' ) * 10 + unsigned( p[ 2 ] - '0' );
+         }
+      };
+
+      template<>
+      struct head_action< reason_phrase >
+      {
+         template< typename Input >
+         static void apply( const Input& in, response& r )
+         {
+            r.reason = view( in.begin(), in.end() );
+         }
+      };
+
+      template<>
+      struct head_action< field_name >
+      {
+         template< typename Input >
+         static void apply( const Input& in, message_head& m )
+         {
+            const auto name = view( in.begin(), in.end() );
+            m.headers.push_back( { find_header_id( name ), name, std::string_view() } );
+         }
+      };
+
+      template<>
+      struct head_action< field_value >
+      {
+         template< typename Input >
+         static void apply( const Input& in, message_head& m )
+         {
+            const char* e = in.end();
+            while( ( e != in.begin() ) && ( ( e[ -1 ] == ' ' ) || ( e[ -1 ] == '\t' ) ) ) {
+               --e;
+            }
+            auto& h = m.headers.back();
+            h.value = view( in.begin(), e );
+            if( h.id != header_id::unknown ) {
+               framing( in, m, h );
+            }
+         }
+      };
+
+      template< typename Head, typename Message >
+      [[nodiscard]] std::size_t parse_head( const char* data, const std::size_t size, Message& m, const char* source )
+      {
+         auto headers = std::move( m.headers );  // Keeps the capacity when m is reused.
+         headers.clear();
+         m = Message();
+         m.headers = std::move( headers );
+         memory_input< tracking_mode::lazy, TAO_PEGTL_NAMESPACE::eol::lf_crlf, const char* > in( data, data + size, source );
+         try {
+            (void)TAO_PEGTL_NAMESPACE::parse< Head, head_action >( in, m );
+         }
+         catch( const parse_error& e ) {
+            // Only an error in the last, incomplete line can go away with more data.
+            const char* p = data + std::min( e.positions.at( 0 ).byte, size );
+            if( std::memchr( p, '\n', std::size_t( data + size - p ) ) == nullptr ) {
+               return 0;
+            }
+            throw;
+         }
+         return std::size_t( in.current() - data );
+      }
+
+   }  // namespace internal
+
+   // Parses the head of a request or response at the beginning of the
+   // data and returns its size, or 0 when the data ends before the head.
+   // In the latter case the function can be called again when more data
+   // has arrived; the head is then parsed from the beginning. Callers
+   // have to limit the size of heads they are willing to buffer.
+   //
+   // The views in the result point into the data. Throws parse_error for
+   // malformed heads as soon as a complete line is malformed, including
+   // invalid, too large or conflicting Content-Length and messages with
+   // both Content-Length and Transfer-Encoding.
+
+   [[nodiscard]] inline std::size_t parse_request( const char* data, const std::size_t size, request& r )
+   {
+      return internal::parse_head< request_head >( data, size, r, "HTTP request" );
+   }
+
+   [[nodiscard]] inline std::size_t parse_request( const std::string_view data, request& r )
+   {
+      return parser::parse_request( data.data(), data.size(), r );
+   }
+
+   [[nodiscard]] inline std::size_t parse_response( const char* data, const std::size_t size, response& r )
+   {
+      return internal::parse_head< response_head >( data, size, r, "HTTP response" );
+   }
+
+   [[nodiscard]] inline std::size_t parse_response( const std::string_view data, response& r )
+   {
+      return parser::parse_response( data.data(), data.size(), r );
+   }
+
+   // Incremental decoder for chunked bodies (RFC 7230, 4.1) that can be
+   // fed the body in arbitrary pieces as they are read. The chunk data
+   // is passed to a callback as views into the pieces, chunk extensions
+   // and trailer fields are skipped. Throws parse_error with the byte
+   // offset relative to the beginning of the body.
+
+   class chunked_decoder
+   {
+   public:
+      // Decodes up to size bytes and calls f( std::string_view ) for every
+      // piece of chunk data. Returns the number of bytes consumed, which is
+      // less than size only when the end of the body was found, i.e. the
+      // remaining bytes belong to the next message.
+
+      template< typename F >
+      [[nodiscard]] std::size_t decode( const char* data, const std::size_t size, F&& f )
+      {
+         const char* p = data;
+         const char* const e = data + size;
+         while( ( p != e ) && ( m_state != state::done ) ) {
+            switch( m_state ) {
+               case state::size:
+                  p = size_digits( data, p, e );
+                  break;
+               case state::extension:
+                  if( const void* n = std::memchr( p, '\n', std::size_t( e - p ) ) ) {
+                     p = static_cast< const char* >( n ) + 1;
+                     end_of_size_line();
+                  }
+                  else {
+                     p = e;
+                  }
+                  break;
+               case state::size_lf:
+                  expect( data, p, '\n' );
+                  end_of_size_line();
+                  break;
+               case state::data: {
+                  const auto n = std::min( m_remaining, std::size_t( e - p ) );
+                  f( std::string_view( p, n ) );
+                  p += n;
+                  m_remaining -= n;
+                  if( m_remaining == 0 ) {
+                     m_state = state::data_cr;
+                  }
+                  break;
+               }
+               case state::data_cr:
+                  if( *p == '\r' ) {
+                     ++p;
+                     m_state = state::data_lf;
+                     break;
+                  }
+                  [[fallthrough]];
+               case state::data_lf:
+                  expect( data, p, '\n' );
+                  m_state = state::size;
+                  break;
+               case state::trailer:
+                  if( *p == '\r' ) {
+                     ++p;
+                     m_state = state::trailer_lf;
+                  }
+                  else if( *p == '\n' ) {
+                     ++p;
+                     m_state = state::done;
+                  }
+                  else {
+                     m_state = state::trailer_field;
+                  }
+                  break;
+               case state::trailer_field:
+                  if( const void* n = std::memchr( p, '\n', std::size_t( e - p ) ) ) {
+                     p = static_cast< const char* >( n ) + 1;
+                     m_state = state::trailer;
+                  }
+                  else {
+                     p = e;
+                  }
+                  break;
+               case state::trailer_lf:
+                  expect( data, p, '\n' );
+                  m_state = state::done;
+                  break;
+               case state::done:
+                  break;
+            }
+         }
+         m_byte += std::size_t( p - data );
+         return std::size_t( p - data );
+      }
+
+      template< typename F >
+      [[nodiscard]] std::size_t decode( const std::string_view data, F&& f )
+      {
+         return decode( data.data(), data.size(), f );
+      }
+
+      // Whether the last chunk and the trailer have been decoded.
+
+      [[nodiscard]] bool done() const noexcept
+      {
+         return m_state == state::done;
+      }
+
+      void reset() noexcept
+      {
+         *this = chunked_decoder();
+      }
+
+   private:
+      enum class state : std::uint8_t
+      {
+         size,
+         extension,
+         size_lf,
+         data,
+         data_cr,
+         data_lf,
+         trailer,
+         trailer_field,
+         trailer_lf,
+         done
+      };
+
+      [[noreturn]] void raise( const char* data, const char* p, const char* message ) const
+      {
+         const std::size_t byte = m_byte + std::size_t( p - data );
+         throw parse_error( message, position( TAO_PEGTL_NAMESPACE::internal::iterator( p, byte, 1, byte ), "chunked body" ) );
+      }
+
+      void expect( const char* data, const char*& p, const char c ) const
+      {
+         if( *p != c ) {
+            raise( data, p, "invalid chunked body" );
+         }
+         ++p;
+      }
+
+      [[nodiscard]] const char* size_digits( const char* data, const char* p, const char* e )
+      {
+         for( ; p != e; ++p ) {
+            const char c = *p;
+            unsigned d;
+            if( ( '0' <= c ) && ( c <= '9' ) ) {
+               d = unsigned( c - '0' );
+            }
+            else if( ( 'a' <= ( c | 0x20 ) ) && ( ( c | 0x20 ) <= 'f' ) ) {
+               d = unsigned( ( c | 0x20 ) - 'a' + 10 );
+            }
+            else {
+               if( m_digits == 0 ) {
+                  raise( data, p, "invalid chunk size" );
+               }
+               if( ( c == ';' ) || ( c == ' ' ) || ( c == '\t' ) ) {
+                  m_state = state::extension;
+               }
+               else if( c == '\r' ) {
+                  m_state = state::size_lf;
+               }
+               else if( c == '\n' ) {
+                  end_of_size_line();
+               }
+               else {
+                  raise( data, p, "invalid chunk size" );
+               }
+               return p + 1;
+            }
+            if( m_remaining >> ( sizeof( std::size_t ) * 8 - 4 ) ) {
+               raise( data, p, "chunk size too large" );
+            }
+            m_remaining = ( m_remaining << 4 ) | d;
+            ++m_digits;
+         }
+         return p;
+      }
+
+      void end_of_size_line() noexcept
+      {
+         m_state = ( m_remaining == 0 ) ? state::trailer : state::data;
+         m_digits = 0;
+      }
+
+      state m_state = state::size;
+      std::size_t m_remaining = 0;  // Of the current chunk size or data.
+      std::size_t m_digits = 0;
+      std::size_t m_byte = 0;  // Consumed by previous calls to decode().
+   };
+
+}  // namespace TAO_PEGTL_NAMESPACE::http::parser
+
+#endif
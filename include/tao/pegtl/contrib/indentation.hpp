@@ -0,0 +1,327 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_INDENTATION_HPP
+#define TAO_PEGTL_CONTRIB_INDENTATION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "../config.hpp"
+#include "../rewind_mode.hpp"
+
+#include "../internal/action_input.hpp"
+#include "../internal/marker.hpp"
+#include "../internal/simd.hpp"
+
+#include "../analysis/generic.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::indentation
+{
+   // The indentation of a line is the number of spaces at its start,
+   // lines end with '\n' (which includes "\r\n"). The cache classifies
+   // the input 64 bytes at a time, lazily and at most one block ahead of
+   // the current position, and computes the indentation of every line
+   // exactly once.
+
+   class cache
+   {
+   public:
+      cache( const char* in_begin, const char* in_end )
+         : m_next( in_begin ),
+           m_end( in_end )
+      {
+      }
+
+      // Returns the indentation of the line starting at p, or npos when p
+      // is not the start of a line. The end of the input is considered to
+      // be the start of an empty line.
+
+      static constexpr std::size_t npos = std::size_t( -1 );
+
+      [[nodiscard]] std::size_t at( const char* p )
+      {
+         if( p == m_end ) {
+            return 0;
+         }
+         while( m_next <= p ) {
+            scan();
+         }
+         // Lines are mostly visited in order, and often more than once.
+         if( m_starts[ m_hint ] != p ) {
+            const auto b = m_starts.begin();
+            const auto h = b + std::ptrdiff_t( m_hint );
+            const auto i = ( m_starts[ m_hint ] < p ) ? std::lower_bound( h, h + std::min( std::ptrdiff_t( 4 ), m_starts.end() - h ), p ) : std::lower_bound( b, h, p );
+            const auto j = ( ( i == m_starts.end() ) || ( *i < p ) ) ? std::lower_bound( i, m_starts.end(), p ) : i;
+            if( ( j == m_starts.end() ) || ( *j != p ) ) {
+               return npos;
+            }
+            m_hint = std::size_t( j - b );
+         }
+         return m_indents[ m_hint ];
+      }
+
+      [[nodiscard]] std::size_t lines() const noexcept
+      {
+         return m_starts.size();
+      }
+
+   private:
+      void scan()
+      {
+         using block = TAO_PEGTL_NAMESPACE::internal::simd::block64;
+         const char* p = m_next;
+         const auto n = std::min( std::size_t( m_end - p ), block::size );
+         const block b = ( n == block::size ) ? block( p ) : block( p, n, 'x' );
+         const std::uint64_t valid = ~std::uint64_t( 0 ) >> ( block::size - n );
+         const std::uint64_t lf = b.eq< '\n' >();
+         const std::uint64_t sp = b.eq< ' ' >();
+         for( std::uint64_t m = ( ( lf << 1 ) | m_carry ) & valid; m != 0; m &= m - 1 ) {
+            const unsigned i = TAO_PEGTL_NAMESPACE::internal::simd::ctz64( m );
+            const unsigned k = TAO_PEGTL_NAMESPACE::internal::simd::ctz64( ~( sp >> i ) );
+            std::size_t indent = k;
+            if( i + k == block::size ) {
+               const char* q = TAO_PEGTL_NAMESPACE::internal::simd::find_first( p + block::size, m_end, []( const block& c ) { return ~c.eq< ' ' >(); } );
+               indent = std::size_t( q - p ) - i;
+            }
+            m_starts.emplace_back( p + i );
+            m_indents.emplace_back( std::uint32_t( indent ) );
+         }
+         m_carry = lf >> ( block::size - 1 );
+         m_next = p + n;
+      }
+
+      const char* m_next;  // Start of the first block not yet scanned.
+      const char* m_end;
+      std::uint64_t m_carry = 1;  // Whether the next block starts a line.
+      std::size_t m_hint = 0;
+      std::vector< const char* > m_starts;
+      std::vector< std::uint32_t > m_indents;
+   };
+
+   // The stack of open blocks is a tree of levels that only grows, the
+   // current block is an index into it. Markers save and restore this
+   // index together with the input position, therefore rules that push
+   // or pop levels are rewound like any other rule.
+
+   template< typename Iterator, rewind_mode M >
+   class marker
+      : public TAO_PEGTL_NAMESPACE::internal::marker< Iterator, M >
+   {
+   public:
+      marker( Iterator& i, std::size_t& /*unused*/ ) noexcept
+         : TAO_PEGTL_NAMESPACE::internal::marker< Iterator, M >( i )
+      {
+      }
+   };
+
+   template< typename Iterator >
+   class marker< Iterator, rewind_mode::required >
+      : public TAO_PEGTL_NAMESPACE::internal::marker< Iterator, rewind_mode::required >
+   {
+   public:
+      marker( Iterator& i, std::size_t& top ) noexcept
+         : TAO_PEGTL_NAMESPACE::internal::marker< Iterator, rewind_mode::required >( i ),
+           m_saved( top ),
+           m_top( &top )
+      {
+      }
+
+      marker( const marker& ) = delete;
+      marker( marker&& ) = delete;
+
+      ~marker() noexcept
+      {
+         if( m_top != nullptr ) {
+            ( *m_top ) = m_saved;
+         }
+      }
+
+      void operator=( const marker& ) = delete;
+      void operator=( marker&& ) = delete;
+
+      [[nodiscard]] bool operator()( const bool result ) noexcept
+      {
+         if( result ) {
+            m_top = nullptr;
+         }
+         return TAO_PEGTL_NAMESPACE::internal::marker< Iterator, rewind_mode::required >::operator()( result );
+      }
+
+   private:
+      const std::size_t m_saved;
+      std::size_t* m_top;
+   };
+
+   // Adds the indentation cache and the stack of open blocks to a memory
+   // input, e.g. memory_input, string_input or file_input.
+
+   template< typename Input >
+   class input
+      : public Input
+   {
+   public:
+      using action_t = TAO_PEGTL_NAMESPACE::internal::action_input< input >;
+
+      template< typename... Ts >
+      explicit input( Ts&&... ts )
+         : Input( std::forward< Ts >( ts )... ),
+           m_cache( this->begin(), this->end() ),
+           m_levels( 1, level{ 0, 0 } )
+      {
+      }
+
+      input( const input& ) = delete;
+      input( input&& ) = delete;
+
+      ~input() = default;
+
+      void operator=( const input& ) = delete;
+      void operator=( input&& ) = delete;
+
+      template< rewind_mode M >
+      [[nodiscard]] marker< typename Input::iterator_t, M > mark() noexcept
+      {
+         return marker< typename Input::iterator_t, M >( this->iterator(), m_top );
+      }
+
+      // The indentation of the innermost open block, and the number of
+      // open blocks (not counting the outermost level with indentation 0).
+
+      [[nodiscard]] std::size_t indentation() const noexcept
+      {
+         return m_levels[ m_top ].indent;
+      }
+
+      [[nodiscard]] std::size_t depth() const noexcept
+      {
+         std::size_t r = 0;
+         for( std::size_t i = m_top; i != 0; i = m_levels[ i ].parent ) {
+            ++r;
+         }
+         return r;
+      }
+
+      [[nodiscard]] std::size_t line_indentation()
+      {
+         return m_cache.at( this->current() );
+      }
+
+      [[nodiscard]] bool match_indent()
+      {
+         const auto n = m_cache.at( this->current() );
+         if( ( n == cache::npos ) || ( n <= indentation() ) ) {
+            return false;
+         }
+         m_levels.push_back( level{ n, m_top } );
+         m_top = m_levels.size() - 1;
+         this->bump_in_this_line( n );
+         return true;
+      }
+
+      [[nodiscard]] bool match_same_indent()
+      {
+         const auto n = m_cache.at( this->current() );
+         if( ( n == cache::npos ) || ( n != indentation() ) ) {
+            return false;
+         }
+         this->bump_in_this_line( n );
+         return true;
+      }
+
+      [[nodiscard]] bool match_any_indent()
+      {
+         const auto n = m_cache.at( this->current() );
+         if( n == cache::npos ) {
+            return false;
+         }
+         this->bump_in_this_line( n );
+         return true;
+      }
+
+      [[nodiscard]] bool match_dedent()
+      {
+         const auto n = m_cache.at( this->current() );
+         if( ( n == cache::npos ) || ( n >= indentation() ) ) {
+            return false;
+         }
+         m_top = m_levels[ m_top ].parent;
+         return true;
+      }
+
+   private:
+      struct level
+      {
+         std::size_t indent;
+         std::size_t parent;
+      };
+
+      cache m_cache;
+      std::vector< level > m_levels;
+      std::size_t m_top = 0;
+   };
+
+   // Must be at the start of a line, consume the indentation of the line.
+   // Rule indent succeeds when the line is indented more than the current
+   // block, and opens a new block; rule same_indent succeeds when the line
+   // is indented as much as the current block.
+
+   struct indent
+   {
+      using analyze_t = analysis::generic< analysis::rule_type::any >;
+
+      template< typename Input >
+      [[nodiscard]] static bool match( Input& in )
+      {
+         return in.match_indent();
+      }
+   };
+
+   struct same_indent
+   {
+      using analyze_t = analysis::generic< analysis::rule_type::opt >;
+
+      template< typename Input >
+      [[nodiscard]] static bool match( Input& in )
+      {
+         return in.match_same_indent();
+      }
+   };
+
+   // Must be at the start of a line, consumes the indentation of the line
+   // regardless of the current block, e.g. for blank or comment lines.
+
+   struct any_indent
+   {
+      using analyze_t = analysis::generic< analysis::rule_type::opt >;
+
+      template< typename Input >
+      [[nodiscard]] static bool match( Input& in )
+      {
+         return in.match_any_indent();
+      }
+   };
+
+   // Must be at the start of a line, consumes nothing. Succeeds when the
+   // line is indented less than the current block, and closes the block;
+   // closing multiple blocks requires multiple matches of dedent. At the
+   // end of the input all blocks are closed by dedent.
+
+   struct dedent
+   {
+      using analyze_t = analysis::generic< analysis::rule_type::opt >;
+
+      template< typename Input >
+      [[nodiscard]] static bool match( Input& in )
+      {
+         return in.match_dedent();
+      }
+   };
+
+}  // namespace TAO_PEGTL_NAMESPACE::indentation
+
+#endif
@@ -6,6 +6,7 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <limits>
 
 #include <type_traits>
 
@@ -112,7 +113,7 @@ namespace TAO_PEGTL_NAMESPACE::integer
          constexpr Unsigned maximum = static_cast< Unsigned >( ( std::numeric_limits< Signed >::max )() ) + 1;
          Unsigned temporary = 0;
          if( accumulate_digits< Unsigned, maximum >( temporary, input ) ) {
-            result = static_cast< Signed >( ~temporary ) + 1;
+            result = static_cast< Signed >( ~temporary + 1 );
             return true;
          }
          return false;
@@ -4,26 +4,115 @@
 #ifndef TAO_PEGTL_CONTRIB_JSON_HPP
 #define TAO_PEGTL_CONTRIB_JSON_HPP
 
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "../apply_mode.hpp"
 #include "../ascii.hpp"
 #include "../config.hpp"
+#include "../rewind_mode.hpp"
 #include "../rules.hpp"
 #include "../utf8.hpp"
 
+#include "../analysis/generic.hpp"
+#include "../internal/fast_path.hpp"
+#include "../internal/simd.hpp"
+
 namespace TAO_PEGTL_NAMESPACE::json
 {
+   namespace internal
+   {
+      // Inputs that carry a json::structural_index, see json_index.hpp.
+
+      template< typename Input, typename = void >
+      inline constexpr bool has_json_index_v = false;
+
+      template< typename Input >
+      inline constexpr bool has_json_index_v< Input, decltype( (void)std::declval< const Input& >().json_index() ) > = true;
+
+      // Returns the first byte in [ p, e ) that is not JSON whitespace;
+      // whitespace between tokens is usually short, hence no SIMD here.
+
+      [[nodiscard]] inline const char* skip_ws( const char* p, const char* e ) noexcept
+      {
+         while( ( p != e ) && ( ( *p == ' ' ) || ( *p == '\n' ) || ( *p == '\r' ) || ( *p == '\t' ) ) ) {
+            ++p;
+         }
+         return p;
+      }
+
+      // Returns the first byte in [ p, e ) that can NOT be matched by
+      // json::unescaped as a single ASCII character, i.e. a quote, a
+      // backslash, a control character or the start of a UTF-8 sequence.
+
+      [[nodiscard]] inline const char* skip_plain( const char* p, const char* e ) noexcept
+      {
+         return TAO_PEGTL_NAMESPACE::internal::simd::find_first( p, e, []( const TAO_PEGTL_NAMESPACE::internal::simd::block64& b ) {
+            return b.eq< '"', '\\' >() | b.in_range< 0x00, 0x1f >() | b.in_range< 0x80, 0xff >();
+         } );
+      }
+
+   }  // namespace internal
+
    // JSON grammar according to RFC 8259
 
    // clang-format off
    struct ws : one< ' ', '\t', '\n', '\r' > {};
+   // clang-format on
+
+   // Matches like star< ws >; skipping JSON whitespace is the single most
+   // frequent operation of the JSON grammar, so when nobody can observe the
+   // individual matches of ws the entire run is skipped in one go, with a
+   // json::structural_index the end of the run is found in the index.
+
+   struct ws_star
+   {
+      using analyze_t = analysis::generic< analysis::rule_type::opt, ws, ws_star >;
+
+      template< apply_mode A,
+                rewind_mode,
+                template< typename... >
+                class Action,
+                template< typename... >
+                class Control,
+                typename Input,
+                typename... States >
+      [[nodiscard]] static bool match( Input& in, States&&... st )
+      {
+         if constexpr( TAO_PEGTL_NAMESPACE::internal::is_memory_input_v< Input > && TAO_PEGTL_NAMESPACE::internal::fast_path_v< ws, A, Action, Control, Input, States... > ) {
+            // Short runs are skipped directly, longer runs with the index (if any).
+            const char* p = in.current();
+            const char* e = in.end();
+            const char* l = ( e - p > 16 ) ? ( p + 16 ) : e;
+            const char* q = internal::skip_ws( p, l );
+            if( ( q == l ) && ( q != e ) ) {
+               if constexpr( internal::has_json_index_v< Input > ) {
+                  q = in.json_index().next_non_whitespace( q );
+               }
+               else {
+                  q = internal::skip_ws( q, e );
+               }
+            }
+            in.bump( std::size_t( q - p ) );
+         }
+         else {
+            while( Control< ws >::template match< A, rewind_mode::required, Action, Control >( in, st... ) ) {
+            }
+         }
+         return true;
+      }
+   };
 
+   // clang-format off
    template< typename R, typename P = ws >
-   struct padr : internal::seq< R, internal::star< P > > {};
+   struct padr : TAO_PEGTL_NAMESPACE::internal::seq< R, std::conditional_t< std::is_same_v< P, ws >, ws_star, TAO_PEGTL_NAMESPACE::internal::star< P > > > {};
 
    struct begin_array : padr< one< '[' > > {};
    struct begin_object : padr< one< '{' > > {};
    struct end_array : one< ']' > {};
    struct end_object : one< '}' > {};
-   struct name_separator : pad< one< ':' >, ws > {};
+   struct name_separator : seq< ws_star, one< ':' >, ws_star > {};
    struct value_separator : padr< one< ',' > > {};
 
    struct false_ : string< 'f', 'a', 'l', 's', 'e' > {};  // NOLINT(readability-identifier-naming)
@@ -42,14 +131,76 @@ namespace TAO_PEGTL_NAMESPACE::json
    struct escaped : sor< escaped_char, unicode > {};
    struct unescaped : utf8::range< 0x20, 0x10FFFF > {};
    struct char_ : if_then_else< one< '\\' >, must< escaped >, unescaped > {};  // NOLINT(readability-identifier-naming)
+   // clang-format on
 
-   struct string_content : until< at< one< '"' > >, must< char_ > > {};
+   namespace internal
+   {
+      // Matches like until< at< one< '"' > >, must< char_ > >, however when
+      // nobody can observe the individual characters the runs of plain ASCII
+      // characters are skipped in bulk, with a json::structural_index they
+      // are skipped without even looking at the input again. Escape sequences
+      // and UTF-8 sequences are always matched by the regular rules.
+
+      struct content
+         : until< at< one< '"' > >, must< char_ > >
+      {
+         template< apply_mode A, template< typename... > class Action, template< typename... > class Control, typename Input, typename... States >
+         static constexpr bool fast_path = TAO_PEGTL_NAMESPACE::internal::is_memory_input_v< Input >
+                                           && TAO_PEGTL_NAMESPACE::internal::fast_path_v< at< one< '"' > >, A, Action, Control, Input, States... >
+                                           && TAO_PEGTL_NAMESPACE::internal::fast_path_v< one< '"' >, A, Action, Control, Input, States... >
+                                           && TAO_PEGTL_NAMESPACE::internal::fast_path_v< must< char_ >, A, Action, Control, Input, States... >
+                                           && TAO_PEGTL_NAMESPACE::internal::fast_path_v< char_, A, Action, Control, Input, States... >
+                                           && TAO_PEGTL_NAMESPACE::internal::fast_path_v< one< '\\' >, A, Action, Control, Input, States... >
+                                           && TAO_PEGTL_NAMESPACE::internal::fast_path_v< unescaped, A, Action, Control, Input, States... >;
+
+         template< apply_mode A,
+                   rewind_mode M,
+                   template< typename... >
+                   class Action,
+                   template< typename... >
+                   class Control,
+                   typename Input,
+                   typename... States >
+         [[nodiscard]] static bool match( Input& in, States&&... st )
+         {
+            if constexpr( fast_path< A, Action, Control, Input, States... > ) {
+               auto m = in.template mark< M >();
+
+               while( true ) {
+                  const char* p = in.current();
+                  const char* q;
+                  if constexpr( has_json_index_v< Input > ) {
+                     q = in.json_index().next_string_stop( p );
+                  }
+                  else {
+                     q = skip_plain( p, in.end() );
+                  }
+                  in.bump_in_this_line( std::size_t( q - p ) );  // Plain characters do not include any line endings.
+
+                  if( ( q != in.end() ) && ( *q == '"' ) ) {
+                     return m( true );
+                  }
+                  if( !Control< must< char_ > >::template match< A, rewind_mode::required, Action, Control >( in, st... ) ) {
+                     return false;
+                  }
+               }
+            }
+            else {
+               return until< at< one< '"' > >, must< char_ > >::template match< A, M, Action, Control >( in, st... );
+            }
+         }
+      };
+
+   }  // namespace internal
+
+   // clang-format off
+   struct string_content : internal::content {};
    struct string : seq< one< '"' >, must< string_content >, any >
    {
       using content = string_content;
    };
 
-   struct key_content : until< at< one< '"' > >, must< char_ > > {};
+   struct key_content : internal::content {};
    struct key : seq< one< '"' >, must< key_content >, any >
    {
       using content = key_content;
@@ -80,7 +231,7 @@ namespace TAO_PEGTL_NAMESPACE::json
    struct value : padr< sor< string, number, object, array, false_, true_, null > > {};
    struct array_element : seq< value > {};
 
-   struct text : seq< star< ws >, value > {};
+   struct text : seq< ws_star, value > {};
    // clang-format on
 
 }  // namespace TAO_PEGTL_NAMESPACE::json
@@ -0,0 +1,375 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_JSON_ARRAY_HPP
+#define TAO_PEGTL_CONTRIB_JSON_ARRAY_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../config.hpp"
+#include "../eol.hpp"
+#include "../memory_input.hpp"
+#include "../mmap_input.hpp"
+#include "../normal.hpp"
+#include "../nothing.hpp"
+#include "../parse.hpp"
+#include "../parse_error.hpp"
+#include "../rules.hpp"
+#include "../tracking_mode.hpp"
+
+#include "../internal/simd.hpp"
+
+#include "json.hpp"
+#include "json_index.hpp"
+#include "parallel.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::json_array
+{
+   // Parallel parsing of a JSON text that consists of one (huge) array.
+
+   using options = parallel::options;
+
+   template< typename State >
+   struct result
+   {
+      std::vector< State > states;  // One per group of elements, in file order.
+      std::size_t elements = 0;
+      bool speculative = true;  // False when the sequential fallback was used.
+   };
+
+   namespace internal
+   {
+      // The speculative scan of a chunk that might start inside or outside
+      // of a string; for both hypotheses it records the change of nesting
+      // depth, and the first and the number of the commas at the lowest
+      // depth reached in the chunk, which are the separators of the
+      // top-level array iff that depth turns out to be 1.
+
+      struct hypothesis
+      {
+         std::ptrdiff_t delta = 0;
+         std::ptrdiff_t min = 0;
+         const char* first_comma = nullptr;
+         std::size_t commas = 0;
+
+         void close() noexcept
+         {
+            if( --delta < min ) {
+               min = delta;
+               first_comma = nullptr;
+               commas = 0;
+            }
+         }
+
+         void comma( const char* p ) noexcept
+         {
+            if( delta == min ) {
+               if( commas++ == 0 ) {
+                  first_comma = p;
+               }
+            }
+         }
+      };
+
+      struct chunk
+      {
+         chunk( const char* b, const char* e ) noexcept
+            : begin( b ),
+              end( e )
+         {
+         }
+
+         const char* begin;
+         const char* end;
+         bool odd_quotes = false;
+         std::size_t newlines = 0;
+         const char* last_newline = nullptr;
+         hypothesis h[ 2 ];  // Index is whether the chunk starts inside a string.
+      };
+
+      // Chunk boundaries are never placed after a backslash, hence no
+      // chunk starts with an escaped character, regardless of strings.
+
+      [[nodiscard]] inline std::vector< chunk > split( const char* begin, const char* end, const std::size_t chunk_size )
+      {
+         std::vector< chunk > result;
+         const char* b = begin;
+         while( b != end ) {
+            const char* e = ( std::size_t( end - b ) > chunk_size ) ? ( b + chunk_size ) : end;
+            while( ( e != end ) && ( e[ -1 ] == '\\' ) ) {
+               ++e;
+            }
+            result.emplace_back( b, e );
+            b = e;
+         }
+         return result;
+      }
+
+      inline void scan( chunk& c ) noexcept
+      {
+         using block = TAO_PEGTL_NAMESPACE::internal::simd::block64;
+
+         bool carry = false;
+         std::uint64_t in_string = 0;
+         std::uint64_t last_newlines = 0;
+         const char* last_block = nullptr;
+
+         for( const char* p = c.begin; p < c.end; p += block::size ) {
+            const auto r = std::size_t( c.end - p );
+            const block b = ( r >= block::size ) ? block( p ) : block( p, r, ' ' );
+
+            const std::uint64_t quote = b.eq< '"' >() & ~json::internal::escaped( b.eq< '\\' >(), carry );
+            const std::uint64_t inside = TAO_PEGTL_NAMESPACE::internal::simd::prefix_xor( quote ) ^ in_string;
+            in_string = std::uint64_t( -std::int64_t( inside >> 63 ) );
+
+            if( const std::uint64_t n = b.eq< '\n' >() ) {
+               c.newlines += TAO_PEGTL_NAMESPACE::internal::simd::popcount64( n );
+               last_newlines = n;
+               last_block = p;
+            }
+            for( std::uint64_t m = b.eq< '[', ']', '{', '}', ',' >(); m != 0; m &= m - 1 ) {
+               const unsigned i = TAO_PEGTL_NAMESPACE::internal::simd::ctz64( m );
+               // Outside of a string for the hypothesis that the chunk starts inside one iff inside.
+               auto& h = c.h[ ( inside >> i ) & 1 ];
+               switch( p[ i ] ) {
+                  case '[':
+                  case '{':
+                     ++h.delta;
+                     break;
+                  case ']':
+                  case '}':
+                     h.close();
+                     break;
+                  default:
+                     h.comma( p + i );
+               }
+            }
+         }
+         c.odd_quotes = ( in_string != 0 );
+         if( last_block != nullptr ) {
+            unsigned i = 63;
+            while( ( last_newlines >> i ) == 0 ) {
+               --i;
+            }
+            c.last_newline = last_block + i;
+         }
+      }
+
+      // clang-format off
+      template< typename Rule >
+      struct first_group : must< json::ws_star, list_must< Rule, json::value_separator >, eof > {};
+
+      template< typename Rule >
+      struct next_group : must< plus< json::value_separator, must< Rule > >, eof > {};
+
+      template< typename Rule >
+      struct sequential : must< json::ws_star, json::begin_array, opt< list_must< Rule, json::value_separator > >, json::end_array, json::ws_star, eof > {};
+      // clang-format on
+
+      // A group of elements that is parsed as one unit; all but the
+      // first group start with the comma that precedes their first
+      // element.
+
+      struct group
+      {
+         const char* begin;
+         const char* end;
+         std::size_t line;
+         std::size_t byte_in_line;
+         std::size_t elements;
+      };
+
+      // Resolves the hypotheses of all chunks in file order and returns
+      // the groups, or an empty vector when the input is not a valid
+      // array (or an empty one).
+
+      [[nodiscard]] inline std::vector< group > resolve( const std::vector< chunk >& chunks, const char* begin, const char* open, const char* close )
+      {
+         std::vector< group > result;
+         std::ptrdiff_t depth = 1;
+         bool in_string = false;
+         std::size_t line = 1 + std::size_t( std::count( begin, open, '\n' ) );
+         const char* last_newline = nullptr;
+         for( const char* p = open; p != begin; ) {
+            if( *--p == '\n' ) {
+               last_newline = p;
+               break;
+            }
+         }
+         const auto start = [ & ]( const chunk& c, const char* b ) {
+            std::size_t l = line;
+            const char* n = last_newline;
+            for( const char* p = c.begin; p != b; ++p ) {
+               if( *p == '\n' ) {
+                  ++l;
+                  n = p;
+               }
+            }
+            const std::size_t column = std::size_t( b - ( ( n != nullptr ) ? ( n + 1 ) : begin ) );
+            result.push_back( { b, nullptr, l, column, 0 } );
+         };
+         for( const auto& c : chunks ) {
+            const auto& h = c.h[ in_string ? 1 : 0 ];
+            if( depth + h.min < 1 ) {
+               return {};
+            }
+            if( result.empty() ) {
+               start( c, c.begin );
+            }
+            if( depth + h.min == 1 ) {
+               if( ( h.commas != 0 ) && ( &c != &chunks.front() ) ) {
+                  result.back().end = h.first_comma;
+                  start( c, h.first_comma );
+               }
+               result.back().elements += h.commas;
+            }
+            depth += h.delta;
+            in_string ^= c.odd_quotes;
+            line += c.newlines;
+            if( c.last_newline != nullptr ) {
+               last_newline = c.last_newline;
+            }
+         }
+         if( ( depth != 1 ) || in_string || result.empty() ) {
+            return {};
+         }
+         result.back().end = close;
+         ++result.front().elements;
+         return result;
+      }
+
+   }  // namespace internal
+
+   // Parses a JSON text that consists of a single array, possibly
+   // surrounded by whitespace, and matches every element with Rule,
+   // which, like json::value, has to consume trailing whitespace.
+   //
+   // The input between the brackets is split into chunks that are
+   // scanned in parallel for the top-level commas, assuming both that
+   // the chunk starts inside and outside of a string; the ambiguity is
+   // resolved at the chunk joins. The elements are then parsed on up to
+   // options::threads threads in groups, each group with its own state
+   // created by make_state(); all positions are relative to begin.
+   //
+   // When the speculation fails, i.e. for invalid input, everything is
+   // parsed again sequentially with a single fresh state, which also
+   // throws the appropriate parse_error. Exceptions thrown by actions
+   // are rethrown after all threads have finished (the first in file
+   // order).
+
+   template< typename Rule = json::value,
+             template< typename... > class Action = nothing,
+             template< typename... > class Control = normal,
+             typename MakeState >
+   [[nodiscard]] auto parse( const char* begin, const char* end, const std::string& source, MakeState&& make_state, const options& op = options() )
+   {
+      using state_t = std::decay_t< decltype( make_state() ) >;
+      using input_t = memory_input< tracking_mode::eager, eol::lf_crlf, const std::string& >;
+
+      result< state_t > r;
+      const char* open = json::internal::skip_ws( begin, end );
+      const char* close = end;
+      while( ( close != open ) && ( ( close[ -1 ] == ' ' ) || ( close[ -1 ] == '\t' ) || ( close[ -1 ] == '\n' ) || ( close[ -1 ] == '\r' ) ) ) {
+         --close;
+      }
+      if( ( open != end ) && ( *open == '[' ) && ( close - open >= 2 ) && ( close[ -1 ] == ']' ) ) {
+         ++open;
+         --close;
+         if( json::internal::skip_ws( open, close ) == close ) {
+            r.states.emplace_back( make_state() );
+            return r;
+         }
+         const std::size_t threads = parallel::internal::thread_count( op );
+
+         auto chunks = internal::split( open, close, std::max( op.chunk_size, std::size_t( 1 ) ) );
+         parallel::internal::for_each( chunks.size(), threads, [ & ]( const std::size_t i ) {
+            internal::scan( chunks[ i ] );
+         } );
+         const auto groups = internal::resolve( chunks, begin, open, close );
+
+         if( !groups.empty() ) {
+            r.states.reserve( groups.size() );
+            for( std::size_t i = 0; i < groups.size(); ++i ) {
+               r.states.emplace_back( make_state() );
+            }
+            // The first failure in file order decides between rethrowing
+            // an exception and falling back to the sequential parse.
+            std::vector< std::exception_ptr > exceptions( groups.size() );
+            std::vector< char > parse_errors( groups.size(), 0 );
+            parallel::internal::first_failure failure;
+            parallel::internal::for_each( groups.size(), threads, [ & ]( const std::size_t i ) {
+               if( !failure.skip( i ) ) {
+                  const auto& g = groups[ i ];
+                  try {
+                     input_t in( g.begin, g.end, source, std::size_t( g.begin - begin ), g.line, g.byte_in_line );
+                     if( i == 0 ) {
+                        TAO_PEGTL_NAMESPACE::parse< internal::first_group< Rule >, Action, Control >( in, r.states[ i ] );
+                     }
+                     else {
+                        TAO_PEGTL_NAMESPACE::parse< internal::next_group< Rule >, Action, Control >( in, r.states[ i ] );
+                     }
+                  }
+                  catch( const parse_error& /*unused*/ ) {
+                     parse_errors[ i ] = 1;
+                     failure.set( i );
+                  }
+                  catch( ... ) {
+                     exceptions[ i ] = std::current_exception();
+                     failure.set( i );
+                  }
+               }
+            } );
+            std::size_t i = 0;
+            while( ( i < groups.size() ) && !exceptions[ i ] && !parse_errors[ i ] ) {
+               ++i;
+            }
+            if( i == groups.size() ) {
+               for( const auto& g : groups ) {
+                  r.elements += g.elements;
+               }
+               return r;
+            }
+            if( exceptions[ i ] ) {
+               std::rethrow_exception( exceptions[ i ] );
+            }
+         }
+      }
+      r.states.clear();
+      r.states.emplace_back( make_state() );
+      r.speculative = false;
+      input_t in( begin, end, source );
+      TAO_PEGTL_NAMESPACE::parse< internal::sequential< Rule >, Action, Control >( in, r.states.front() );
+      return r;
+   }
+
+   // Parses the data of a memory input, e.g. a mmap_input.
+
+   template< typename Rule = json::value,
+             template< typename... > class Action = nothing,
+             template< typename... > class Control = normal,
+             typename Input,
+             typename MakeState >
+   [[nodiscard]] auto parse( const Input& in, MakeState&& make_state, const options& op = options() )
+   {
+      return json_array::parse< Rule, Action, Control >( in.begin(), in.end(), in.source(), make_state, op );
+   }
+
+   template< typename Rule = json::value,
+             template< typename... > class Action = nothing,
+             template< typename... > class Control = normal,
+             typename MakeState >
+   [[nodiscard]] auto parse_file( const std::string& filename, MakeState&& make_state, const options& op = options() )
+   {
+      const mmap_input< tracking_mode::lazy > in( filename );
+      return json_array::parse< Rule, Action, Control >( in, make_state, op );
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE::json_array
+
+#endif
@@ -0,0 +1,517 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_JSON_DOM_HPP
+#define TAO_PEGTL_CONTRIB_JSON_DOM_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../config.hpp"
+#include "../nothing.hpp"
+#include "../parse.hpp"
+#include "../parse_error.hpp"
+#include "../rules.hpp"
+
+#include "arena.hpp"
+#include "json.hpp"
+#include "json_number.hpp"
+#include "unescape.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::json_dom
+{
+   // The arena of a document, see contrib/arena.hpp.
+
+   using arena = TAO_PEGTL_NAMESPACE::arena;
+
+   enum class type : std::uint8_t
+   {
+      null,
+      boolean,
+      number,
+      string,
+      array,
+      object
+   };
+
+   struct member;
+
+   // A value occupies 16 bytes: a pointer to the payload, a 32-bit size
+   // (string length, array or object element count) and the type tag.
+   // Strings and numbers point into the parsed input whenever possible,
+   // i.e. the input MUST outlive all values obtained from parsing it.
+
+   class value
+   {
+   public:
+      constexpr value() noexcept = default;
+
+      [[nodiscard]] static constexpr value make_boolean( const bool b ) noexcept
+      {
+         return value( type::boolean, nullptr, std::uint32_t( b ) );
+      }
+
+      [[nodiscard]] static constexpr value make_number( const std::string_view raw ) noexcept
+      {
+         return value( type::number, raw.data(), std::uint32_t( raw.size() ) );
+      }
+
+      [[nodiscard]] static constexpr value make_string( const std::string_view s ) noexcept
+      {
+         return value( type::string, s.data(), std::uint32_t( s.size() ) );
+      }
+
+      [[nodiscard]] static constexpr value make_array( const value* data, const std::uint32_t size ) noexcept
+      {
+         return value( type::array, data, size );
+      }
+
+      [[nodiscard]] static constexpr value make_object( const member* data, const std::uint32_t size ) noexcept
+      {
+         return value( type::object, data, size );
+      }
+
+      [[nodiscard]] constexpr type get_type() const noexcept
+      {
+         return m_type;
+      }
+
+      [[nodiscard]] constexpr bool is_null() const noexcept
+      {
+         return m_type == type::null;
+      }
+
+      [[nodiscard]] constexpr bool is_boolean() const noexcept
+      {
+         return m_type == type::boolean;
+      }
+
+      [[nodiscard]] constexpr bool is_number() const noexcept
+      {
+         return m_type == type::number;
+      }
+
+      [[nodiscard]] constexpr bool is_string() const noexcept
+      {
+         return m_type == type::string;
+      }
+
+      [[nodiscard]] constexpr bool is_array() const noexcept
+      {
+         return m_type == type::array;
+      }
+
+      [[nodiscard]] constexpr bool is_object() const noexcept
+      {
+         return m_type == type::object;
+      }
+
+      [[nodiscard]] constexpr bool get_boolean() const noexcept
+      {
+         assert( is_boolean() );
+         return m_size != 0;
+      }
+
+      [[nodiscard]] constexpr json::number_view get_number() const noexcept
+      {
+         assert( is_number() );
+         return json::number_view( std::string_view( static_cast< const char* >( m_data ), m_size ) );
+      }
+
+      [[nodiscard]] constexpr std::string_view get_string() const noexcept
+      {
+         assert( is_string() );
+         return std::string_view( static_cast< const char* >( m_data ), m_size );
+      }
+
+      // Number of elements for arrays and objects, otherwise 0.
+
+      [[nodiscard]] constexpr std::size_t size() const noexcept
+      {
+         return ( is_array() || is_object() ) ? m_size : 0;
+      }
+
+      [[nodiscard]] const value* array_begin() const noexcept
+      {
+         assert( is_array() );
+         return static_cast< const value* >( m_data );
+      }
+
+      [[nodiscard]] const value* array_end() const noexcept
+      {
+         return array_begin() + m_size;
+      }
+
+      [[nodiscard]] const member* object_begin() const noexcept
+      {
+         assert( is_object() );
+         return static_cast< const member* >( m_data );
+      }
+
+      [[nodiscard]] const member* object_end() const noexcept;
+
+      [[nodiscard]] const value& operator[]( const std::size_t index ) const noexcept
+      {
+         assert( index < m_size );
+         return array_begin()[ index ];
+      }
+
+      // Linear search in the members, in input order; returns the first
+      // member with the given key, or nullptr when there is none (or this
+      // value is not an object).
+
+      [[nodiscard]] const value* find( const std::string_view key ) const noexcept;
+
+   private:
+      constexpr value( const type t, const void* data, const std::uint32_t size ) noexcept
+         : m_data( data ),
+           m_size( size ),
+           m_type( t )
+      {
+      }
+
+      const void* m_data = nullptr;
+      std::uint32_t m_size = 0;
+      type m_type = type::null;
+   };
+
+   static_assert( sizeof( value ) == 16 || sizeof( void* ) != 8 );
+   static_assert( std::is_trivially_copyable_v< value > );
+
+   struct member
+   {
+      json_dom::value key;
+      json_dom::value value;
+   };
+
+   inline const member* value::object_end() const noexcept
+   {
+      return object_begin() + m_size;
+   }
+
+   inline const value* value::find( const std::string_view key ) const noexcept
+   {
+      if( is_object() ) {
+         for( const member* m = object_begin(); m != object_end(); ++m ) {
+            if( m->key.get_string() == key ) {
+               return &m->value;
+            }
+         }
+      }
+      return nullptr;
+   }
+
+   // A document owns the arena that holds the memory of all arrays,
+   // objects and unescaped strings of the parsed JSON text.
+
+   class document
+   {
+   public:
+      explicit document( const std::size_t block_size = 64 * 1024 ) noexcept
+         : m_arena( block_size )
+      {
+      }
+
+      [[nodiscard]] const json_dom::value& root() const noexcept
+      {
+         return m_root;
+      }
+
+      [[nodiscard]] json_dom::arena& arena() noexcept
+      {
+         return m_arena;
+      }
+
+      void set_root( const json_dom::value& v ) noexcept
+      {
+         m_root = v;
+      }
+
+   private:
+      json_dom::arena m_arena;
+      json_dom::value m_root;
+   };
+
+   namespace internal
+   {
+      // The builder keeps all completed values -- and the keys of objects
+      // under construction -- on a single stack; when an array or object
+      // is finished, its elements are moved to the arena in one block.
+
+      struct builder
+      {
+         explicit builder( arena& a )
+            : m_arena( a )
+         {
+            m_values.reserve( 1024 );
+            m_frames.reserve( 64 );
+         }
+
+         template< typename Input >
+         [[nodiscard]] static std::uint32_t checked_size( const std::size_t size, const Input& in )
+         {
+            if( size > ( std::numeric_limits< std::uint32_t >::max )() ) {
+               throw parse_error( "JSON value too large for DOM", in );
+            }
+            return std::uint32_t( size );
+         }
+
+         template< typename Input >
+         void push_string( const Input& in )
+         {
+            const std::string_view raw = in.string_view();
+            const auto size = checked_size( raw.size(), in );
+            if( std::memchr( raw.data(), '\\', raw.size() ) == nullptr ) {
+               m_values.emplace_back( value::make_string( raw ) );
+               return;
+            }
+            char* b = m_arena.allocate_array< char >( size );
+            char* e = unescape::unescape_json( raw.data(), raw.data() + raw.size(), b );
+            if( e == nullptr ) {
+               throw parse_error( "invalid escaped unicode code point", in );
+            }
+            m_values.emplace_back( value::make_string( std::string_view( b, std::size_t( e - b ) ) ) );
+         }
+
+         void begin()
+         {
+            m_frames.emplace_back( m_values.size() );
+         }
+
+         template< typename Input >
+         void end_array( const Input& in )
+         {
+            const std::size_t start = m_frames.back();
+            m_frames.pop_back();
+            const auto size = checked_size( m_values.size() - start, in );
+            value* data = m_arena.allocate_array< value >( size );
+            std::copy( m_values.begin() + std::ptrdiff_t( start ), m_values.end(), data );
+            m_values.resize( start );
+            m_values.emplace_back( value::make_array( data, size ) );
+         }
+
+         template< typename Input >
+         void end_object( const Input& in )
+         {
+            const std::size_t start = m_frames.back();
+            m_frames.pop_back();
+            const auto size = checked_size( ( m_values.size() - start ) / 2, in );
+            member* data = m_arena.allocate_array< member >( size );
+            for( std::size_t i = 0; i < size; ++i ) {
+               data[ i ].key = m_values[ start + 2 * i ];
+               data[ i ].value = m_values[ start + 2 * i + 1 ];
+            }
+            m_values.resize( start );
+            m_values.emplace_back( value::make_object( data, size ) );
+         }
+
+         arena& m_arena;
+         std::vector< value > m_values;
+         std::vector< std::size_t > m_frames;
+      };
+
+      template< typename Rule >
+      struct action
+         : nothing< Rule >
+      {
+      };
+
+      template<>
+      struct action< json::null >
+      {
+         static void apply0( builder& b )
+         {
+            b.m_values.emplace_back();
+         }
+      };
+
+      template<>
+      struct action< json::true_ >
+      {
+         static void apply0( builder& b )
+         {
+            b.m_values.emplace_back( value::make_boolean( true ) );
+         }
+      };
+
+      template<>
+      struct action< json::false_ >
+      {
+         static void apply0( builder& b )
+         {
+            b.m_values.emplace_back( value::make_boolean( false ) );
+         }
+      };
+
+      template<>
+      struct action< json::number >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            b.m_values.emplace_back( value::make_number( in.string_view() ) );
+         }
+      };
+
+      template<>
+      struct action< json::string::content >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            b.push_string( in );
+         }
+      };
+
+      template<>
+      struct action< json::key::content >
+         : action< json::string::content >
+      {
+      };
+
+      template<>
+      struct action< json::array::begin >
+      {
+         static void apply0( builder& b )
+         {
+            b.begin();
+         }
+      };
+
+      template<>
+      struct action< json::array::end >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            b.end_array( in );
+         }
+      };
+
+      template<>
+      struct action< json::object::begin >
+         : action< json::array::begin >
+      {
+      };
+
+      template<>
+      struct action< json::object::end >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            b.end_object( in );
+         }
+      };
+
+      using grammar = must< json::text, eof >;
+
+   }  // namespace internal
+
+   // Parses a complete JSON text into a document; the input MUST keep
+   // all of its data in memory for as long as the document is used, as
+   // is the case for memory_input, string_input, mmap_input, etc.
+
+   template< typename Input >
+   void parse( Input&& in, document& doc )
+   {
+      internal::builder b( doc.arena() );
+      TAO_PEGTL_NAMESPACE::parse< internal::grammar, internal::action >( in, b );
+      assert( b.m_values.size() == 1 );
+      assert( b.m_frames.empty() );
+      doc.set_root( b.m_values.back() );
+   }
+
+   template< typename Input >
+   [[nodiscard]] document parse( Input&& in )
+   {
+      document doc;
+      json_dom::parse( in, doc );
+      return doc;
+   }
+
+   // Writes compact JSON, e.g. for debugging or round-trip testing.
+
+   inline void write_string( std::ostream& o, const std::string_view s )
+   {
+      static const char* h = "0123456789abcdef";
+
+      o << '"';
+      const char* l = s.data();  // Start of the pending run of unescaped characters.
+      for( const char* p = s.data(); p != s.data() + s.size(); ++p ) {
+         const auto c = static_cast< unsigned char >( *p );
+         if( ( c >= 0x20 ) && ( c != '"' ) && ( c != '\\' ) && ( c != 0x7f ) ) {
+            continue;
+         }
+         o.write( l, p - l );
+         l = p + 1;
+         switch( c ) {
+            case '"':
+               o << "\\\"";
+               break;
+            case '\\':
+               o << "\\\\";
+               break;
+            case '\n':
+               o << "\\n";
+               break;
+            case '\t':
+               o << "\\t";
+               break;
+            default:
+               o << "\\u00" << h[ ( c & 0xf0 ) >> 4 ] << h[ c & 0x0f ];
+               break;
+         }
+      }
+      o.write( l, s.data() + s.size() - l );
+      o << '"';
+   }
+
+   inline std::ostream& operator<<( std::ostream& o, const value& v )
+   {
+      switch( v.get_type() ) {
+         case type::null:
+            return o << "null";
+         case type::boolean:
+            return o << ( v.get_boolean() ? "true" : "false" );
+         case type::number:
+            return o << v.get_number().raw();
+         case type::string:
+            write_string( o, v.get_string() );
+            return o;
+         case type::array:
+            o << '[';
+            for( const value* i = v.array_begin(); i != v.array_end(); ++i ) {
+               if( i != v.array_begin() ) {
+                  o << ',';
+               }
+               o << *i;
+            }
+            return o << ']';
+         case type::object:
+            o << '{';
+            for( const member* i = v.object_begin(); i != v.object_end(); ++i ) {
+               if( i != v.object_begin() ) {
+                  o << ',';
+               }
+               write_string( o, i->key.get_string() );
+               o << ':' << i->value;
+            }
+            return o << '}';
+      }
+      return o;  // LCOV_EXCL_LINE
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE::json_dom
+
+#endif
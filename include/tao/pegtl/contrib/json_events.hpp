@@ -0,0 +1,253 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_JSON_EVENTS_HPP
+#define TAO_PEGTL_CONTRIB_JSON_EVENTS_HPP
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "../config.hpp"
+#include "../nothing.hpp"
+#include "../parse.hpp"
+#include "../rules.hpp"
+
+#include "json.hpp"
+#include "json_number.hpp"
+#include "unescape.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::json_events
+{
+   // A string_ref references the content of a JSON string (or key) in
+   // the input, i.e. the text between the quotes; unescaping is only
+   // performed when -- and each time -- it is requested.
+
+   class string_ref
+   {
+   public:
+      constexpr string_ref( const std::string_view raw, const bool escaped ) noexcept
+         : m_raw( raw ),
+           m_escaped( escaped )
+      {
+      }
+
+      [[nodiscard]] constexpr std::string_view raw() const noexcept
+      {
+         return m_raw;
+      }
+
+      [[nodiscard]] constexpr bool has_escapes() const noexcept
+      {
+         return m_escaped;
+      }
+
+      // Returns the unescaped string; without escape sequences this is
+      // the raw string, otherwise the string is unescaped into buffer.
+
+      [[nodiscard]] std::string_view view( std::string& buffer ) const
+      {
+         if( !m_escaped ) {
+            return m_raw;
+         }
+         buffer.resize( m_raw.size() );
+         char* b = buffer.data();
+         char* e = unescape::unescape_json( m_raw.data(), m_raw.data() + m_raw.size(), b );
+         if( e == nullptr ) {
+            throw std::runtime_error( "invalid escaped unicode code point" );
+         }
+         buffer.resize( std::size_t( e - b ) );
+         return buffer;
+      }
+
+      [[nodiscard]] std::string unescape() const
+      {
+         if( !m_escaped ) {
+            return std::string( m_raw );
+         }
+         std::string r;
+         (void)view( r );
+         return r;
+      }
+
+   private:
+      std::string_view m_raw;
+      bool m_escaped;
+   };
+
+   // Consumers can derive from consumer_base to only implement the
+   // events they are interested in; there are no virtual functions,
+   // the calls are resolved at compile time on the derived class.
+
+   struct consumer_base
+   {
+      void null() noexcept
+      {
+      }
+
+      void boolean( const bool /*unused*/ ) noexcept
+      {
+      }
+
+      void number( const json::number_view& /*unused*/ ) noexcept
+      {
+      }
+
+      void string( const string_ref& /*unused*/ ) noexcept
+      {
+      }
+
+      void begin_array() noexcept
+      {
+      }
+
+      void end_array() noexcept
+      {
+      }
+
+      void begin_object() noexcept
+      {
+      }
+
+      void key( const string_ref& /*unused*/ ) noexcept
+      {
+      }
+
+      void end_object() noexcept
+      {
+      }
+   };
+
+   namespace internal
+   {
+      template< typename Input >
+      [[nodiscard]] string_ref make_string_ref( const Input& in ) noexcept
+      {
+         const auto raw = in.string_view();
+         return string_ref( raw, std::memchr( raw.data(), '\\', raw.size() ) != nullptr );
+      }
+
+   }  // namespace internal
+
+   template< typename Rule >
+   struct action
+      : nothing< Rule >
+   {
+   };
+
+   template<>
+   struct action< json::null >
+   {
+      template< typename Consumer >
+      static void apply0( Consumer& c )
+      {
+         c.null();
+      }
+   };
+
+   template<>
+   struct action< json::true_ >
+   {
+      template< typename Consumer >
+      static void apply0( Consumer& c )
+      {
+         c.boolean( true );
+      }
+   };
+
+   template<>
+   struct action< json::false_ >
+   {
+      template< typename Consumer >
+      static void apply0( Consumer& c )
+      {
+         c.boolean( false );
+      }
+   };
+
+   template<>
+   struct action< json::number >
+   {
+      template< typename Input, typename Consumer >
+      static void apply( const Input& in, Consumer& c )
+      {
+         c.number( json::number_view( in.string_view() ) );
+      }
+   };
+
+   template<>
+   struct action< json::string::content >
+   {
+      template< typename Input, typename Consumer >
+      static void apply( const Input& in, Consumer& c )
+      {
+         c.string( internal::make_string_ref( in ) );
+      }
+   };
+
+   template<>
+   struct action< json::key::content >
+   {
+      template< typename Input, typename Consumer >
+      static void apply( const Input& in, Consumer& c )
+      {
+         c.key( internal::make_string_ref( in ) );
+      }
+   };
+
+   template<>
+   struct action< json::array::begin >
+   {
+      template< typename Consumer >
+      static void apply0( Consumer& c )
+      {
+         c.begin_array();
+      }
+   };
+
+   template<>
+   struct action< json::array::end >
+   {
+      template< typename Consumer >
+      static void apply0( Consumer& c )
+      {
+         c.end_array();
+      }
+   };
+
+   template<>
+   struct action< json::object::begin >
+   {
+      template< typename Consumer >
+      static void apply0( Consumer& c )
+      {
+         c.begin_object();
+      }
+   };
+
+   template<>
+   struct action< json::object::end >
+   {
+      template< typename Consumer >
+      static void apply0( Consumer& c )
+      {
+         c.end_object();
+      }
+   };
+
+   using grammar = must< json::text, eof >;
+
+   // Parses a complete JSON text and calls the consumer for each event;
+   // the string_refs and number_views passed to the consumer reference
+   // the input and are only valid as long as the input data is.
+
+   template< typename Input, typename Consumer >
+   bool parse( Input&& in, Consumer& c )
+   {
+      return TAO_PEGTL_NAMESPACE::parse< grammar, action >( in, c );
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE::json_events
+
+#endif
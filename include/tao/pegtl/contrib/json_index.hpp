@@ -0,0 +1,196 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_JSON_INDEX_HPP
+#define TAO_PEGTL_CONTRIB_JSON_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../config.hpp"
+#include "../eol.hpp"
+#include "../memory_input.hpp"
+#include "../tracking_mode.hpp"
+
+#include "../internal/simd.hpp"
+
+#include "json.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::json
+{
+   namespace internal
+   {
+      // Returns the mask of the characters escaped by a backslash, carrying
+      // over whether the first character of the next block is escaped.
+
+      [[nodiscard]] inline std::uint64_t escaped( std::uint64_t backslash, bool& carry ) noexcept
+      {
+         constexpr std::uint64_t even_bits = 0x5555555555555555ULL;
+
+         backslash &= ~std::uint64_t( carry );
+         const std::uint64_t follows_escape = ( backslash << 1 ) | std::uint64_t( carry );
+         const std::uint64_t odd_starts = backslash & ~even_bits & ~follows_escape;
+         const std::uint64_t even_starts = TAO_PEGTL_NAMESPACE::internal::simd::add_overflow( odd_starts, backslash, carry );
+         return ( even_bits ^ ( even_starts << 1 ) ) & follows_escape;
+      }
+
+   }  // namespace internal
+
+   // A structural_index is built by a single branch-free pass over the
+   // input that classifies all bytes 64 at a time (cf. "stage 1" of
+   // simdjson). For every block of 64 bytes it stores two bitmaps:
+   //
+   // - string stops: the quotes and all bytes that can not be matched
+   //   by json::unescaped as a plain ASCII character, namely backslashes,
+   //   control characters and bytes of UTF-8 sequences;
+   // - whitespace: the JSON whitespace characters.
+   //
+   // The index does NOT validate anything, the JSON grammar still does
+   // that, but the specialised rules of the grammar use it to skip the
+   // whitespace and the plain runs in strings without looking at the
+   // input again. As the grammar matches escape sequences as a whole it
+   // never needs to distinguish escaped from unescaped quotes, and the
+   // structural characters are not indexed as no rule would use them.
+   // The index uses 16 bytes of memory per 64 bytes of input.
+
+   class structural_index
+   {
+   public:
+      structural_index( const char* begin, const char* end )
+         : m_begin( begin ),
+           m_end( end ),
+           m_masks( 2 * ( ( std::size_t( end - begin ) + block::size - 1 ) / block::size ) )
+      {
+         build();
+      }
+
+      structural_index( const structural_index& ) = delete;
+      structural_index( structural_index&& ) = delete;
+
+      ~structural_index() = default;
+
+      void operator=( const structural_index& ) = delete;
+      void operator=( structural_index&& ) = delete;
+
+      [[nodiscard]] const char* begin() const noexcept
+      {
+         return m_begin;
+      }
+
+      [[nodiscard]] const char* end() const noexcept
+      {
+         return m_end;
+      }
+
+      [[nodiscard]] std::size_t blocks() const noexcept
+      {
+         return m_masks.size() / 2;
+      }
+
+      [[nodiscard]] std::uint64_t string_stops( const std::size_t i ) const noexcept
+      {
+         return m_masks[ 2 * i + string_stop_mask ];
+      }
+
+      [[nodiscard]] std::uint64_t whitespace( const std::size_t i ) const noexcept
+      {
+         return m_masks[ 2 * i + whitespace_mask ];
+      }
+
+      // The following functions return the first byte at or after p
+      // with the respective property, or end() when there is none.
+
+      [[nodiscard]] const char* next_string_stop( const char* p ) const noexcept
+      {
+         return next< string_stop_mask, 0 >( p );
+      }
+
+      [[nodiscard]] const char* next_non_whitespace( const char* p ) const noexcept
+      {
+         return next< whitespace_mask, ~std::uint64_t( 0 ) >( p );
+      }
+
+   private:
+      using block = TAO_PEGTL_NAMESPACE::internal::simd::block64;
+
+      static constexpr std::size_t string_stop_mask = 0;
+      static constexpr std::size_t whitespace_mask = 1;
+
+      template< std::size_t Mask, std::uint64_t Flip >
+      [[nodiscard]] const char* next( const char* p ) const noexcept
+      {
+         const auto o = std::size_t( p - m_begin );
+         std::size_t i = o / block::size;
+         const std::size_t n = blocks();
+         if( i < n ) {
+            std::uint64_t m = ( m_masks[ 2 * i + Mask ] ^ Flip ) & ( ~std::uint64_t( 0 ) << ( o % block::size ) );
+            while( m == 0 ) {
+               if( ++i == n ) {
+                  return m_end;
+               }
+               m = m_masks[ 2 * i + Mask ] ^ Flip;
+            }
+            const char* r = m_begin + i * block::size + TAO_PEGTL_NAMESPACE::internal::simd::ctz64( m );
+            return ( r < m_end ) ? r : m_end;
+         }
+         return m_end;
+      }
+
+      void build() noexcept
+      {
+         const char* p = m_begin;
+
+         for( std::size_t i = 0; i < blocks(); ++i, p += block::size ) {
+            const auto r = std::size_t( m_end - p );
+            // The padding is classified as whitespace, i.e. never as string stop.
+            const block b = ( r >= block::size ) ? block( p ) : block( p, r, ' ' );
+
+            m_masks[ 2 * i + string_stop_mask ] = b.eq< '"', '\\' >() | b.in_range< 0x00, 0x1f >() | b.in_range< 0x80, 0xff >();
+            m_masks[ 2 * i + whitespace_mask ] = b.eq< ' ', '\t', '\n', '\r' >();
+         }
+      }
+
+      const char* m_begin;
+      const char* m_end;
+      std::vector< std::uint64_t > m_masks;
+   };
+
+   // A memory_input that builds a structural_index of its complete
+   // input on construction; the JSON grammar automatically uses the
+   // index when parsing an indexed_input.
+
+   template< tracking_mode P = tracking_mode::eager, typename Eol = eol::lf_crlf, typename Source = std::string >
+   class indexed_input
+      : public memory_input< P, Eol, Source >
+   {
+   public:
+      template< typename... Ts >
+      explicit indexed_input( Ts&&... ts )
+         : memory_input< P, Eol, Source >( std::forward< Ts >( ts )... ),
+           m_index( this->begin(), this->end() )
+      {
+      }
+
+      indexed_input( const indexed_input& ) = delete;
+      indexed_input( indexed_input&& ) = delete;
+
+      ~indexed_input() = default;
+
+      void operator=( const indexed_input& ) = delete;
+      void operator=( indexed_input&& ) = delete;
+
+      [[nodiscard]] const structural_index& json_index() const noexcept
+      {
+         return m_index;
+      }
+
+   private:
+      structural_index m_index;
+   };
+
+}  // namespace TAO_PEGTL_NAMESPACE::json
+
+#endif
@@ -0,0 +1,155 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_JSON_NUMBER_HPP
+#define TAO_PEGTL_CONTRIB_JSON_NUMBER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "../config.hpp"
+
+#include "integer.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::json
+{
+   namespace internal
+   {
+      // Exactly representable powers of ten for the fast path of to_double().
+
+      inline constexpr double exact_powers_of_ten[] = {
+         1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+         1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+      };
+
+   }  // namespace internal
+
+   // A number_view references the text of a number that was matched by
+   // json::number, i.e. no conversion is performed while parsing. The
+   // conversion functions assume -- but do not check -- that the text is
+   // a valid JSON number; the viewed text MUST outlive the number_view.
+
+   class number_view
+   {
+   public:
+      constexpr number_view() noexcept = default;
+
+      explicit constexpr number_view( const std::string_view raw ) noexcept
+         : m_raw( raw )
+      {
+      }
+
+      [[nodiscard]] constexpr std::string_view raw() const noexcept
+      {
+         return m_raw;
+      }
+
+      [[nodiscard]] constexpr bool is_integer() const noexcept
+      {
+         return m_raw.find_first_of( ".eE" ) == std::string_view::npos;
+      }
+
+      [[nodiscard]] constexpr bool is_negative() const noexcept
+      {
+         return ( !m_raw.empty() ) && ( m_raw[ 0 ] == '-' );
+      }
+
+      // Returns false when the number has a fraction or exponent part,
+      // or when it does not fit into the given integer type.
+
+      template< typename Integer >
+      [[nodiscard]] bool to_integer( Integer& result ) const noexcept
+      {
+         static_assert( std::is_integral_v< Integer > );
+
+         if( !is_integer() ) {
+            return false;
+         }
+         result = 0;
+         if constexpr( std::is_signed_v< Integer > ) {
+            return integer::internal::convert_signed( result, m_raw );
+         }
+         else {
+            return ( !is_negative() ) && integer::internal::convert_unsigned( result, m_raw );
+         }
+      }
+
+      // Numbers with at most 19 significant digits whose mantissa and
+      // decimal exponent allow for an exact computation are converted
+      // directly; everything else is delegated to std::strtod().
+
+      [[nodiscard]] double to_double() const
+      {
+         const char* p = m_raw.data();
+         const char* const e = p + m_raw.size();
+
+         const bool negative = ( p != e ) && ( *p == '-' );
+         p += negative;
+
+         std::uint64_t mantissa = 0;
+         int digits = 0;
+         int exponent = 0;
+
+         for( ; ( p != e ) && integer::internal::is_digit( *p ); ++p ) {
+            mantissa = mantissa * 10 + std::uint64_t( *p - '0' );
+            digits += int( ( digits != 0 ) || ( *p != '0' ) );
+         }
+         if( ( p != e ) && ( *p == '.' ) ) {
+            for( ++p; ( p != e ) && integer::internal::is_digit( *p ); ++p ) {
+               mantissa = mantissa * 10 + std::uint64_t( *p - '0' );
+               digits += int( ( digits != 0 ) || ( *p != '0' ) );
+               --exponent;
+            }
+         }
+         if( ( p != e ) && ( ( *p == 'e' ) || ( *p == 'E' ) ) ) {
+            ++p;
+            const bool minus = ( p != e ) && ( *p == '-' );
+            p += int( ( p != e ) && ( ( *p == '-' ) || ( *p == '+' ) ) );
+            int x = 0;
+            for( ; ( p != e ) && integer::internal::is_digit( *p ); ++p ) {
+               if( x < 100000 ) {
+                  x = x * 10 + ( *p - '0' );
+               }
+            }
+            exponent += minus ? -x : x;
+         }
+         if( ( digits <= 19 ) && ( mantissa <= ( std::uint64_t( 1 ) << 53 ) ) && ( -22 <= exponent ) && ( exponent <= 22 ) ) {
+            double d = double( mantissa );
+            if( exponent < 0 ) {
+               d /= internal::exact_powers_of_ten[ -exponent ];
+            }
+            else {
+               d *= internal::exact_powers_of_ten[ exponent ];
+            }
+            return negative ? -d : d;
+         }
+         return slow_to_double();
+      }
+
+   private:
+      [[nodiscard]] double slow_to_double() const
+      {
+         // std::strtod() requires a terminating NUL; JSON numbers are never
+         // locale-dependent, but std::strtod() is -- as in other places we
+         // assume the "C" locale for LC_NUMERIC.
+
+         char buffer[ 64 ];
+         if( m_raw.size() < sizeof( buffer ) ) {
+            m_raw.copy( buffer, m_raw.size() );
+            buffer[ m_raw.size() ] = 0;
+            return std::strtod( buffer, nullptr );
+         }
+         const std::string s( m_raw );
+         return std::strtod( s.c_str(), nullptr );
+      }
+
+      std::string_view m_raw;
+   };
+
+}  // namespace TAO_PEGTL_NAMESPACE::json
+
+#endif
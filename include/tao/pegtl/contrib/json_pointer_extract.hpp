@@ -0,0 +1,364 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_JSON_POINTER_EXTRACT_HPP
+#define TAO_PEGTL_CONTRIB_JSON_POINTER_EXTRACT_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../apply_mode.hpp"
+#include "../config.hpp"
+#include "../memory_input.hpp"
+#include "../nothing.hpp"
+#include "../parse.hpp"
+#include "../rewind_mode.hpp"
+#include "../rules.hpp"
+
+#include "../analysis/generic.hpp"
+#include "../internal/fast_path.hpp"
+
+#include "json.hpp"
+#include "json_pointer.hpp"
+#include "json_skip.hpp"
+#include "unescape.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::json_pointer
+{
+   namespace internal
+   {
+      template< typename Rule >
+      struct token_action
+         : nothing< Rule >
+      {
+      };
+
+      template<>
+      struct token_action< reference_token >
+      {
+         template< typename Input >
+         static void apply( const Input& in, std::vector< std::string >& tokens )
+         {
+            std::string& t = tokens.emplace_back();
+            for( const char* p = in.begin(); p != in.end(); ++p ) {
+               if( *p == '~' ) {
+                  t += ( *++p == '0' ) ? '~' : '/';
+               }
+               else {
+                  t += *p;
+               }
+            }
+         }
+      };
+
+   }  // namespace internal
+
+   // Returns the unescaped reference tokens of a JSON pointer, throws a
+   // parse_error when the pointer is invalid.
+
+   [[nodiscard]] inline std::vector< std::string > tokens( const std::string& pointer )
+   {
+      std::vector< std::string > result;
+      memory_input in( pointer, "json pointer" );
+      TAO_PEGTL_NAMESPACE::parse< must< json_pointer, eof >, internal::token_action >( in, result );
+      return result;
+   }
+
+   // An extractor compiles a set of JSON pointers into a trie of reference
+   // tokens that is used as automaton while parsing a JSON text: values on
+   // a path to one of the pointers are parsed with the JSON grammar, all
+   // other values are skipped with json::skip_value, i.e. without actions
+   // and only with minimal validation (see json_skip.hpp).
+
+   class extractor
+   {
+   public:
+      static constexpr std::size_t npos = std::size_t( -1 );
+
+      extractor()
+         : m_nodes( 1 )
+      {
+      }
+
+      extractor( const std::initializer_list< std::string > pointers )
+         : extractor()
+      {
+         for( const auto& p : pointers ) {
+            (void)add( p );
+         }
+      }
+
+      // Adds a pointer and returns its id, the ids are consecutive from 0.
+
+      std::size_t add( const std::string& pointer )
+      {
+         std::size_t n = 0;
+         for( auto& t : tokens( pointer ) ) {
+            auto& c = m_nodes[ n ].children;
+            const auto i = std::lower_bound( c.begin(), c.end(), t, []( const auto& l, const std::string& r ) { return l.first < r; } );
+            if( ( i != c.end() ) && ( i->first == t ) ) {
+               n = i->second;
+            }
+            else {
+               c.emplace( i, std::move( t ), m_nodes.size() );
+               n = m_nodes.size();
+               m_nodes.emplace_back();
+            }
+         }
+         m_nodes[ n ].ids.emplace_back( m_size );
+         return m_size++;
+      }
+
+      [[nodiscard]] std::size_t size() const noexcept
+      {
+         return m_size;
+      }
+
+      // Parses a JSON text from a memory input and calls f( id, value ) for
+      // each value referenced by a pointer, where value is a string_view of
+      // the value in the input. For pointers to objects or arrays f() is
+      // called after the pointers to their elements. Throws a parse_error
+      // when the JSON text is invalid outside of the skipped values.
+
+      template< typename Input, typename F >
+      bool extract( Input&& in, F&& f ) const;
+
+      struct node
+      {
+         std::vector< std::size_t > ids;
+         std::vector< std::pair< std::string, std::size_t > > children;
+      };
+
+      [[nodiscard]] const node& get( const std::size_t n ) const noexcept
+      {
+         return m_nodes[ n ];
+      }
+
+      // Returns the node for the (raw, possibly escaped) key of a member
+      // of an object, or npos.
+
+      [[nodiscard]] std::size_t child( const std::size_t n, const std::string_view raw ) const
+      {
+         const auto& c = m_nodes[ n ].children;
+         if( c.empty() ) {
+            return npos;
+         }
+         std::string buffer;
+         std::string_view key = raw;
+         if( std::memchr( raw.data(), '\\', raw.size() ) != nullptr ) {
+            buffer.resize( raw.size() );
+            char* e = unescape::unescape_json( raw.data(), raw.data() + raw.size(), buffer.data() );
+            if( e == nullptr ) {
+               return npos;
+            }
+            key = std::string_view( buffer.data(), std::size_t( e - buffer.data() ) );
+         }
+         const auto i = std::lower_bound( c.begin(), c.end(), key, []( const auto& l, const std::string_view r ) { return l.first < r; } );
+         return ( ( i != c.end() ) && ( i->first == key ) ) ? i->second : npos;
+      }
+
+      // Returns the node for an element of an array, or npos.
+
+      [[nodiscard]] std::size_t child( const std::size_t n, const std::size_t index ) const
+      {
+         if( m_nodes[ n ].children.empty() ) {
+            return npos;
+         }
+         char buffer[ 24 ];
+         const auto r = std::to_chars( buffer, buffer + sizeof( buffer ), index );
+         return child( n, std::string_view( buffer, std::size_t( r.ptr - buffer ) ) );
+      }
+
+   private:
+      std::vector< node > m_nodes;
+      std::size_t m_size = 0;
+   };
+
+   namespace internal
+   {
+      template< typename F >
+      class cursor
+      {
+      public:
+         cursor( const extractor& x, F& f ) noexcept
+            : m_extractor( x ),
+              m_f( f )
+         {
+         }
+
+         [[nodiscard]] const extractor::node& current() const noexcept
+         {
+            return m_extractor.get( m_node );
+         }
+
+         template< typename Key >
+         [[nodiscard]] std::size_t child( const Key& key ) const
+         {
+            return m_extractor.child( m_node, key );
+         }
+
+         [[nodiscard]] std::size_t enter( const std::size_t n ) noexcept
+         {
+            return std::exchange( m_node, n );
+         }
+
+         void leave( const std::size_t n ) noexcept
+         {
+            m_node = n;
+         }
+
+         void deliver( const std::string_view value ) const
+         {
+            for( const auto id : current().ids ) {
+               m_f( id, value );
+            }
+         }
+
+      private:
+         const extractor& m_extractor;
+         F& m_f;
+         std::size_t m_node = 0;
+      };
+
+      // clang-format off
+      struct any_value : sor< json::string, json::number, json::object, json::array, json::false_, json::true_, json::null > {};
+      // clang-format on
+
+      struct value_at_node;
+
+      // Matches the value of a member or element for the child node n
+      // of the current node; skips the value when there is no such child.
+
+      template< apply_mode A, rewind_mode M, template< typename... > class Action, template< typename... > class Control, typename Input, typename Cursor >
+      [[nodiscard]] bool descend( Input& in, Cursor& c, const std::size_t n )
+      {
+         if( n == extractor::npos ) {
+            return Control< must< json::skip_value > >::template match< A, M, Action, Control >( in, c );
+         }
+         const auto saved = c.enter( n );
+         const bool result = Control< must< json::padr< value_at_node > > >::template match< A, M, Action, Control >( in, c );
+         c.leave( saved );
+         return result;
+      }
+
+      struct member_at_node
+      {
+         using analyze_t = analysis::generic< analysis::rule_type::seq, json::key, json::name_separator, json::value >;
+
+         template< apply_mode A,
+                   rewind_mode M,
+                   template< typename... >
+                   class Action,
+                   template< typename... >
+                   class Control,
+                   typename Input,
+                   typename Cursor >
+         [[nodiscard]] static bool match( Input& in, Cursor& c )
+         {
+            const char* b = in.current();
+            if( !Control< json::key >::template match< A, M, Action, Control >( in, c ) ) {
+               return false;
+            }
+            const std::string_view raw( b + 1, std::size_t( in.current() - b - 2 ) );
+            return Control< must< json::name_separator > >::template match< A, M, Action, Control >( in, c )
+                   && descend< A, M, Action, Control >( in, c, c.child( raw ) );
+         }
+      };
+
+      // clang-format off
+      struct object_at_node : seq< json::begin_object, opt< list_must< member_at_node, json::value_separator > >, must< json::end_object > > {};
+      // clang-format on
+
+      struct array_at_node
+      {
+         using analyze_t = analysis::generic< analysis::rule_type::seq, json::array >;
+
+         template< apply_mode A,
+                   rewind_mode M,
+                   template< typename... >
+                   class Action,
+                   template< typename... >
+                   class Control,
+                   typename Input,
+                   typename Cursor >
+         [[nodiscard]] static bool match( Input& in, Cursor& c )
+         {
+            if( !Control< json::begin_array >::template match< A, M, Action, Control >( in, c ) ) {
+               return false;
+            }
+            if( !in.empty() && ( in.peek_char() != ']' ) ) {
+               std::size_t index = 0;
+               do {
+                  if( !descend< A, M, Action, Control >( in, c, c.child( index++ ) ) ) {
+                     return false;
+                  }
+               } while( Control< json::value_separator >::template match< A, M, Action, Control >( in, c ) );
+            }
+            return Control< must< json::end_array > >::template match< A, M, Action, Control >( in, c );
+         }
+      };
+
+      struct value_at_node
+      {
+         using analyze_t = analysis::generic< analysis::rule_type::sor, any_value >;
+
+         template< apply_mode A,
+                   rewind_mode M,
+                   template< typename... >
+                   class Action,
+                   template< typename... >
+                   class Control,
+                   typename Input,
+                   typename Cursor >
+         [[nodiscard]] static bool match( Input& in, Cursor& c )
+         {
+            const auto& n = c.current();
+            const char* b = in.current();
+            bool result;
+            if( n.children.empty() && n.ids.empty() ) {
+               return Control< json::internal::skip >::template match< A, M, Action, Control >( in, c );
+            }
+            if( n.children.empty() || in.empty() ) {
+               result = Control< any_value >::template match< A, M, Action, Control >( in, c );
+            }
+            else if( in.peek_char() == '{' ) {
+               result = Control< object_at_node >::template match< A, M, Action, Control >( in, c );
+            }
+            else if( in.peek_char() == '[' ) {
+               result = Control< array_at_node >::template match< A, M, Action, Control >( in, c );
+            }
+            else {
+               result = Control< any_value >::template match< A, M, Action, Control >( in, c );
+            }
+            if( result ) {
+               c.deliver( std::string_view( b, std::size_t( in.current() - b ) ) );
+            }
+            return result;
+         }
+      };
+
+      // clang-format off
+      struct text : must< json::ws_star, json::padr< value_at_node >, eof > {};
+      // clang-format on
+
+   }  // namespace internal
+
+   template< typename Input, typename F >
+   bool extractor::extract( Input&& in, F&& f ) const
+   {
+      static_assert( TAO_PEGTL_NAMESPACE::internal::is_memory_input_v< std::decay_t< Input > >, "extraction requires a memory input" );
+      internal::cursor< std::remove_reference_t< F > > c( *this, f );
+      return TAO_PEGTL_NAMESPACE::parse< internal::text >( in, c );
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE::json_pointer
+
+#endif
@@ -0,0 +1,344 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_JSON_SKIP_HPP
+#define TAO_PEGTL_CONTRIB_JSON_SKIP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../apply_mode.hpp"
+#include "../config.hpp"
+#include "../rewind_mode.hpp"
+#include "../rules.hpp"
+
+#include "../analysis/generic.hpp"
+#include "../internal/fast_path.hpp"
+#include "../internal/simd.hpp"
+
+#include "json.hpp"
+#include "unescape.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::json
+{
+   namespace internal
+   {
+      namespace simd = TAO_PEGTL_NAMESPACE::internal::simd;
+
+      // The following functions return a pointer behind the skipped
+      // string, container or scalar, or nullptr when the input ends
+      // prematurely or the brackets are not balanced. Containers and
+      // strings are scanned with SIMD; a bitmap of the structural
+      // characters was measured to be slower as it also stops at every
+      // comma and colon, which is why json::structural_index has none.
+
+      [[nodiscard]] inline const char* skip_scalar( const char* p, const char* e ) noexcept
+      {
+         for( ; p != e; ++p ) {
+            switch( *p ) {
+               case ' ':
+               case '\t':
+               case '\n':
+               case '\r':
+               case ',':
+               case ':':
+               case '[':
+               case ']':
+               case '{':
+               case '}':
+               case '"':
+                  return p;
+               default:
+                  break;
+            }
+         }
+         return p;
+      }
+
+      // Scans the input directly, the classification of the current
+      // block of 64 bytes is kept for the following calls.
+
+      class input_scanner
+      {
+      public:
+         input_scanner( const char* p, const char* e ) noexcept
+            : m_end( e )
+         {
+            load( p );
+         }
+
+         // Returns the next quote or bracket at or after p, or end.
+
+         [[nodiscard]] const char* next( const char* p ) noexcept
+         {
+            return find< 0 >( p );
+         }
+
+         // Returns a pointer behind the string, p points behind the opening quote.
+
+         [[nodiscard]] const char* string_end( const char* p ) noexcept
+         {
+            while( ( p = find< 1 >( p ) ) != m_end ) {
+               if( *p == '"' ) {
+                  return p + 1;
+               }
+               if( m_end - p < 2 ) {
+                  return nullptr;
+               }
+               p += 2;
+            }
+            return nullptr;
+         }
+
+      private:
+         template< unsigned I >
+         [[nodiscard]] const char* find( const char* p ) noexcept
+         {
+            while( p != m_end ) {
+               if( ( p < m_base ) || ( std::size_t( p - m_base ) >= simd::block64::size ) ) {
+                  load( p );
+               }
+               if( const std::uint64_t m = m_masks[ I ] >> ( p - m_base ) ) {
+                  return p + simd::ctz64( m );
+               }
+               p = ( m_end - m_base > std::ptrdiff_t( simd::block64::size ) ) ? ( m_base + simd::block64::size ) : m_end;
+            }
+            return m_end;
+         }
+
+         void load( const char* p ) noexcept
+         {
+            const auto n = std::size_t( m_end - p );
+            const simd::block64 b = ( n >= simd::block64::size ) ? simd::block64( p ) : simd::block64( p, n, ' ' );
+            m_base = p;
+            m_masks[ 0 ] = b.eq< '"', '[', ']', '{', '}' >();
+            m_masks[ 1 ] = b.eq< '"', '\\' >();
+         }
+
+         const char* m_base;
+         const char* m_end;
+         std::uint64_t m_masks[ 2 ];
+      };
+
+      [[nodiscard]] inline const char* skip_container( const char* p, const char* e )
+      {
+         // p points to the opening bracket; the closing brackets
+         // that are still expected are kept in a string as stack.
+         input_scanner scanner( p, e );
+         std::string stack;
+         while( ( p = scanner.next( p ) ) != e ) {
+            switch( *p ) {
+               case '"':
+                  p = scanner.string_end( p + 1 );
+                  if( p == nullptr ) {
+                     return nullptr;
+                  }
+                  continue;
+               case '[':
+                  stack += ']';
+                  break;
+               case '{':
+                  stack += '}';
+                  break;
+               case ']':
+               case '}':
+                  if( stack.empty() || ( stack.back() != *p ) ) {
+                     return nullptr;
+                  }
+                  stack.pop_back();
+                  if( stack.empty() ) {
+                     return p + 1;
+                  }
+                  break;
+               default:
+                  break;
+            }
+            ++p;
+         }
+         return nullptr;
+      }
+
+      template< typename Input >
+      [[nodiscard]] const char* skip_end( const Input& in )
+      {
+         const char* p = in.current();
+         const char* e = in.end();
+         if( p == e ) {
+            return nullptr;
+         }
+         switch( *p ) {
+            case '"':
+               return input_scanner( p, e ).string_end( p + 1 );
+            case '[':
+            case '{':
+               return skip_container( p, e );
+            default:
+               p = skip_scalar( p, e );
+               return ( p == in.current() ) ? nullptr : p;
+         }
+      }
+
+      // Matches a complete JSON value without matching the sub-rules
+      // of the JSON grammar, i.e. without calling any actions or the
+      // control functions for sub-rules, and without validation beyond
+      // balanced brackets and terminated strings.
+
+      struct skip
+      {
+         using analyze_t = analysis::generic< analysis::rule_type::any >;
+
+         template< apply_mode A,
+                   rewind_mode M,
+                   template< typename... >
+                   class Action,
+                   template< typename... >
+                   class Control,
+                   typename Input,
+                   typename... States >
+         [[nodiscard]] static bool match( Input& in, States&&... st )
+         {
+            if constexpr( TAO_PEGTL_NAMESPACE::internal::is_memory_input_v< Input > ) {
+               if( const char* p = skip_end( in ) ) {
+                  in.bump( std::size_t( p - in.current() ) );
+                  return true;
+               }
+               return false;
+            }
+            else {
+               // Inputs that are not contiguous use the full grammar.
+               return Control< sor< json::string, number, object, array, false_, true_, null > >::template match< apply_mode::nothing, M, Action, Control >( in, st... );
+            }
+         }
+      };
+
+   }  // namespace internal
+
+   // Drop-in replacement for json::value (including the trailing whitespace).
+
+   struct skip_value : padr< internal::skip > {};
+
+   // A key_set is a set of (unescaped) object keys that can be
+   // looked up with the raw, possibly still escaped, keys from
+   // the input as they are passed to Select::select() below.
+
+   class key_set
+   {
+   public:
+      key_set() = default;
+
+      key_set( const std::initializer_list< std::string > keys )
+         : m_keys( keys )
+      {
+      }
+
+      void insert( std::string key )
+      {
+         if( !contains( key ) ) {
+            m_keys.emplace_back( std::move( key ) );
+         }
+      }
+
+      [[nodiscard]] std::size_t size() const noexcept
+      {
+         return m_keys.size();
+      }
+
+      [[nodiscard]] bool empty() const noexcept
+      {
+         return m_keys.empty();
+      }
+
+      // The key must be unescaped, returns whether it is in the set.
+
+      [[nodiscard]] bool contains( const std::string_view key ) const noexcept
+      {
+         return std::find( m_keys.begin(), m_keys.end(), key ) != m_keys.end();
+      }
+
+      // The key is the raw content of a JSON string, i.e. it may contain
+      // escape sequences; returns whether the unescaped key is in the set.
+
+      [[nodiscard]] bool contains_raw( const std::string_view raw ) const
+      {
+         if( std::memchr( raw.data(), '\\', raw.size() ) == nullptr ) {
+            return contains( raw );
+         }
+         std::string buffer( raw.size(), '\0' );
+         char* b = buffer.data();
+         char* e = unescape::unescape_json( raw.data(), raw.data() + raw.size(), b );
+         return ( e != nullptr ) && contains( std::string_view( b, std::size_t( e - b ) ) );
+      }
+
+   private:
+      std::vector< std::string > m_keys;
+   };
+
+   // Object members for which Select::select( raw_key, states... ) returns
+   // false are skipped with skip_value, all other members are parsed with
+   // the normal JSON grammar, raw_key is the content of the key string as
+   // found in the input (see key_set::contains_raw()). Requires an input
+   // that keeps all data in memory.
+
+   template< typename Select >
+   struct selective_member
+   {
+      using analyze_t = analysis::generic< analysis::rule_type::seq, key, name_separator, value >;
+
+      template< apply_mode A,
+                rewind_mode M,
+                template< typename... >
+                class Action,
+                template< typename... >
+                class Control,
+                typename Input,
+                typename... States >
+      [[nodiscard]] static bool match( Input& in, States&&... st )
+      {
+         static_assert( TAO_PEGTL_NAMESPACE::internal::is_memory_input_v< Input >, "selective parsing requires a memory input" );
+
+         auto m = in.template mark< M >();
+         using m_t = decltype( m );
+
+         const char* b = in.current();
+         if( !Control< key >::template match< A, m_t::next_rewind_mode, Action, Control >( in, st... ) ) {
+            return false;
+         }
+         const std::string_view raw( b + 1, std::size_t( in.current() - b - 2 ) );
+         if( !Control< must< name_separator > >::template match< A, m_t::next_rewind_mode, Action, Control >( in, st... ) ) {
+            return false;
+         }
+         if( Select::select( raw, st... ) ) {
+            return m( Control< must< value > >::template match< A, m_t::next_rewind_mode, Action, Control >( in, st... ) );
+         }
+         return m( Control< must< skip_value > >::template match< A, m_t::next_rewind_mode, Action, Control >( in, st... ) );
+      }
+   };
+
+   // clang-format off
+   template< typename Select >
+   struct selective_object_content : opt< list_must< selective_member< Select >, value_separator > > {};
+
+   template< typename Select >
+   struct selective_object : seq< begin_object, selective_object_content< Select >, must< end_object > >
+   {
+      using begin = begin_object;
+      using end = end_object;
+      using element = selective_member< Select >;
+      using content = selective_object_content< Select >;
+   };
+
+   // A JSON text where the members of a top-level object are selected.
+   template< typename Select >
+   struct selective_text : seq< ws_star, sor< padr< selective_object< Select > >, value > > {};
+   // clang-format on
+
+}  // namespace TAO_PEGTL_NAMESPACE::json
+
+#endif
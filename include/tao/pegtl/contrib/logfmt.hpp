@@ -0,0 +1,190 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_LOGFMT_HPP
+#define TAO_PEGTL_CONTRIB_LOGFMT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../ascii.hpp"
+#include "../config.hpp"
+#include "../memory_input.hpp"
+#include "../nothing.hpp"
+#include "../parse.hpp"
+#include "../rules.hpp"
+#include "../tracking_mode.hpp"
+
+#include "../analysis/generic.hpp"
+#include "../internal/escaped_string.hpp"
+#include "../internal/skip_control.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::logfmt
+{
+   // Lines of key=value pairs separated by blanks, as in
+   //
+   //   level=info msg="request done" path=/api?a=b took=12ms cached
+   //
+   // where values can be quoted, with backslash escapes, and a key without
+   // '=' is a flag with an empty value; the rules require a memory input.
+   // Unlike some writers bare values may contain '='. The function parse()
+   // fills a vector with views into the line.
+
+   namespace internal
+   {
+      // Bit 0 for bytes allowed in bare values, i.e. all except control
+      // characters, SP, DEL and '"', bit 1 for those also allowed in keys,
+      // i.e. all of the former except '='.
+
+      struct char_table
+      {
+         unsigned char table[ 256 ] = {};
+
+         constexpr char_table() noexcept
+         {
+            for( unsigned c = 33; c < 256; ++c ) {
+               table[ c ] = ( ( c == 127 ) || ( c == '"' ) ) ? 0 : ( ( c == '=' ) ? 1 : 3 );
+            }
+         }
+      };
+
+      inline constexpr char_table char_classes{};
+
+      template< bool Key >
+      [[nodiscard]] const char* chars_end( const char* p, const char* e ) noexcept
+      {
+         while( ( p != e ) && ( char_classes.table[ static_cast< unsigned char >( *p ) ] & ( Key ? 2 : 1 ) ) ) {
+            ++p;
+         }
+         return p;
+      }
+
+      template< bool Key >
+      struct chars
+      {
+         using analyze_t = analysis::generic< Key ? analysis::rule_type::any : analysis::rule_type::opt >;
+
+         template< typename Input >
+         [[nodiscard]] static bool match( Input& in ) noexcept( noexcept( in.end() ) )
+         {
+            const auto n = std::size_t( chars_end< Key >( in.current(), in.end() ) - in.current() );
+            in.bump_in_this_line( n );
+            return ( n != 0 ) || !Key;
+         }
+      };
+
+   }  // namespace internal
+
+   // clang-format off
+   struct ws : one< ' ', '\t' > {};
+   struct key : internal::chars< true > {};
+   struct value : internal::chars< false > {};
+   struct quoted_value : TAO_PEGTL_NAMESPACE::internal::escaped_string {};
+   struct pair : seq< key, opt< one< '=' >, sor< seq< one< '"' >, quoted_value, one< '"' > >, value > > > {};
+   struct line : seq< star< ws >, opt< list< pair, plus< ws > > >, star< ws > > {};
+   // clang-format on
+
+   struct field
+   {
+      std::string_view key;
+      std::string_view value;  // Without quotes, as in the input, see unescape().
+      bool quoted = false;
+   };
+
+   namespace internal
+   {
+      template< typename Rule >
+      struct action
+         : nothing< Rule >
+      {
+      };
+
+      template<>
+      struct action< key >
+      {
+         template< typename Input >
+         static void apply( const Input& in, std::vector< field >& f )
+         {
+            f.push_back( { std::string_view( in.begin(), in.size() ), std::string_view(), false } );
+         }
+      };
+
+      template<>
+      struct action< value >
+      {
+         template< typename Input >
+         static void apply( const Input& in, std::vector< field >& f )
+         {
+            f.back().value = std::string_view( in.begin(), in.size() );
+         }
+      };
+
+      template<>
+      struct action< quoted_value >
+      {
+         template< typename Input >
+         static void apply( const Input& in, std::vector< field >& f )
+         {
+            f.back().value = std::string_view( in.begin(), in.size() );
+            f.back().quoted = true;
+         }
+      };
+
+   }  // namespace internal
+
+   // Parses one line, without the line end, and returns whether it is
+   // valid; fields is cleared first.
+
+   [[nodiscard]] inline bool parse( const std::string_view text, std::vector< field >& fields )
+   {
+      fields.clear();
+      memory_input< tracking_mode::lazy, eol::lf_crlf, const char* > in( text.data(), text.data() + text.size(), "logfmt" );
+      return TAO_PEGTL_NAMESPACE::parse< seq< line, opt< one< '\r' > >, eof >, internal::action >( in, fields );
+   }
+
+   // Appends a quoted value with the escape sequences \", \\, \n, \r and
+   // \t replaced; other backslashes are kept.
+
+   inline void unescape( const std::string_view value, std::string& s )
+   {
+      for( std::size_t i = 0; i < value.size(); ++i ) {
+         if( ( value[ i ] != '\\' ) || ( i + 1 == value.size() ) ) {
+            s += value[ i ];
+            continue;
+         }
+         switch( value[ ++i ] ) {
+            case '"':
+               s += '"';
+               break;
+            case '\\':
+               s += '\\';
+               break;
+            case 'n':
+               s += '\n';
+               break;
+            case 'r':
+               s += '\r';
+               break;
+            case 't':
+               s += '\t';
+               break;
+            default:
+               s += '\\';
+               --i;
+         }
+      }
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE::logfmt
+
+namespace TAO_PEGTL_NAMESPACE::internal
+{
+   template< bool Key >
+   inline constexpr bool skip_control< logfmt::internal::chars< Key > > = true;
+
+}  // namespace TAO_PEGTL_NAMESPACE::internal
+
+#endif
@@ -0,0 +1,573 @@
+// Copyright (c) 2015-2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_LUA53_HPP
+#define TAO_PEGTL_CONTRIB_LUA53_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "../apply_mode.hpp"
+#include "../ascii.hpp"
+#include "../config.hpp"
+#include "../rewind_mode.hpp"
+#include "../rules.hpp"
+
+#include "../analysis/generic.hpp"
+#include "../internal/eol.hpp"
+#include "../internal/skip_control.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::lua53
+{
+   // PEGTL grammar for the Lua 5.3.0 lexer and parser.
+   //
+   // The grammar here is not very similar to the grammar
+   // in the Lua reference documentation on which it is based
+   // which is due to multiple causes.
+   //
+   // The main difference is that this grammar includes really
+   // "everything", not just the structural parts from the
+   // reference documentation:
+   // - The PEG-approach combines lexer and parser; this grammar
+   //   handles comments and tokenisation.
+   // - The operator precedence and associativity are reflected
+   //   in the structure of this grammar.
+   // - All details for all types of literals are included, with
+   //   escape-sequences for literal strings, and long literals.
+   //
+   // The second necessary difference is that all left-recursion
+   // had to be eliminated.
+   //
+   // In some places the grammar was optimised to require as little
+   // back-tracking as possible, most prominently for expressions.
+   // The original grammar contains the following production rules:
+   //
+   //   prefixexp ::= var | functioncall | ‘(’ exp ‘)’
+   //   functioncall ::=  prefixexp args | prefixexp ‘:’ Name args
+   //   var ::=  Name | prefixexp ‘[’ exp ‘]’ | prefixexp ‘.’ Name
+   //
+   // After eliminating prefixexp, splitting function calls and
+   // variables into a "head" and a "tail", and combining both,
+   // a single expression takes care of var, function_call, and
+   // expressions in a bracket:
+   //
+   //   chead ::= '(' exp ')' | Name
+   //   combined ::= chead { functail | vartail }
+   //
+   // The rule expr_thirteen below implements "combined".
+   //
+   // Most rules adopt the convention that they take care of
+   // "internal padding", i.e. spaces and comments that can occur
+   // within the rule, but not "external padding", i.e. they don't
+   // start or end with a rule that "eats up" all extra padding, so
+   // that the input of an action is exactly the matched construct.
+   //
+   // Unlike the grammar in src/example/pegtl/lua53_parse.cpp, from
+   // which this one was derived, the lexical rules are not composed
+   // from single characters: runs of white-space and comments are
+   // skipped in one go, long brackets are closed with memchr(), and
+   // a name is scanned once and then checked against the reserved
+   // words with a perfect hash. The rules require a memory input.
+
+   struct long_string;
+
+   namespace internal
+   {
+      enum char_class : std::uint8_t
+      {
+         name_first = 1 << 0,  // ALPHA / "_"
+         name_other = 1 << 1,  // ALPHA / DIGIT / "_"
+         space_char = 1 << 2  // SP / HT / LF / VT / FF / CR
+      };
+
+      struct char_table
+      {
+         std::uint8_t table[ 256 ] = {};
+
+         constexpr char_table() noexcept
+         {
+            for( unsigned c = 0; c < 256; ++c ) {
+               const bool alpha = ( ( 'a' <= c ) && ( c <= 'z' ) ) || ( ( 'A' <= c ) && ( c <= 'Z' ) ) || ( c == '_' );
+               const bool digit = ( '0' <= c ) && ( c <= '9' );
+               const bool space = ( c == ' ' ) || ( ( '\t' <= c ) && ( c <= '\r' ) );
+               table[ c ] = std::uint8_t( ( alpha ? name_first : 0 ) | ( ( alpha || digit ) ? name_other : 0 ) | ( space ? space_char : 0 ) );
+            }
+         }
+      };
+
+      inline constexpr char_table chars{};
+
+      [[nodiscard]] inline bool is( const char c, const char_class m ) noexcept
+      {
+         return ( chars.table[ static_cast< unsigned char >( c ) ] & m ) != 0;
+      }
+
+      [[nodiscard]] inline const char* name_end( const char* p, const char* e ) noexcept
+      {
+         while( ( p != e ) && is( *p, name_other ) ) {
+            ++p;
+         }
+         return p;
+      }
+
+      // The 22 reserved words have distinct values of keyword_hash(),
+      // hence a name is a reserved word iff it is equal to the entry
+      // of the keyword table with the same hash.
+
+      [[nodiscard]] constexpr unsigned keyword_hash( const char* p, const std::size_t n ) noexcept
+      {
+         return ( unsigned( static_cast< unsigned char >( p[ 0 ] ) ) * 31 + unsigned( static_cast< unsigned char >( p[ 1 ] ) ) * 21 + unsigned( static_cast< unsigned char >( p[ n - 1 ] ) ) + unsigned( n ) * 27 ) & 31;
+      }
+
+      struct keyword_table
+      {
+         std::string_view table[ 32 ] = {};
+
+         constexpr keyword_table() noexcept
+         {
+            constexpr std::string_view words[] = { "and", "break", "do", "else", "elseif", "end", "false", "for", "function", "goto", "if", "in", "local", "nil", "not", "or", "repeat", "return", "then", "true", "until", "while" };
+            for( const auto w : words ) {
+               table[ keyword_hash( w.data(), w.size() ) ] = w;
+            }
+         }
+      };
+
+      inline constexpr keyword_table keywords{};
+
+      [[nodiscard]] inline bool is_keyword( const char* p, const std::size_t n ) noexcept
+      {
+         return ( n >= 2 ) && ( n <= 8 ) && ( keywords.table[ keyword_hash( p, n ) ] == std::string_view( p, n ) );
+      }
+
+      // Returns the level of the long bracket that opens at p, i.e. the
+      // number of '=' in "[==[", or -1 when there is none.
+
+      [[nodiscard]] inline std::ptrdiff_t long_open( const char* p, const char* e ) noexcept
+      {
+         if( ( p == e ) || ( *p != '[' ) ) {
+            return -1;
+         }
+         const char* q = p + 1;
+         while( ( q != e ) && ( *q == '=' ) ) {
+            ++q;
+         }
+         return ( ( q != e ) && ( *q == '[' ) ) ? ( q - p - 1 ) : -1;
+      }
+
+      // Returns the end of the first closing long bracket of the given
+      // level in [ p, e ), or nullptr when there is none.
+
+      [[nodiscard]] inline const char* long_close( const char* p, const char* e, const std::ptrdiff_t level ) noexcept
+      {
+         while( ( p = static_cast< const char* >( std::memchr( p, ']', std::size_t( e - p ) ) ) ) != nullptr ) {
+            const char* q = p + 1;
+            while( ( q != e ) && ( *q == '=' ) ) {
+               ++q;
+            }
+            if( ( q != e ) && ( *q == ']' ) && ( q - p - 1 == level ) ) {
+               return q + 1;
+            }
+            p = q;
+         }
+         return nullptr;
+      }
+
+      // Returns the end of the white-space and comments that start at p;
+      // sets unterminated to the start of a long comment without end.
+
+      [[nodiscard]] inline const char* trivia_end( const char* p, const char* e, const char*& unterminated ) noexcept
+      {
+         while( true ) {
+            while( ( p != e ) && is( *p, space_char ) ) {
+               ++p;
+            }
+            if( ( e - p < 2 ) || ( p[ 0 ] != '-' ) || ( p[ 1 ] != '-' ) ) {
+               return p;
+            }
+            p += 2;
+            if( const auto level = long_open( p, e ); level >= 0 ) {
+               if( const char* c = long_close( p + level + 2, e, level ) ) {
+                  p = c;
+                  continue;
+               }
+               unterminated = p;
+               return p;
+            }
+            const auto* n = static_cast< const char* >( std::memchr( p, '\n', std::size_t( e - p ) ) );
+            p = ( n != nullptr ) ? ( n + 1 ) : e;
+         }
+      }
+
+      template< bool NonEmpty >
+      struct trivia
+      {
+         using analyze_t = analysis::generic< NonEmpty ? analysis::rule_type::any : analysis::rule_type::opt >;
+
+         template< apply_mode,
+                   rewind_mode,
+                   template< typename... >
+                   class Action,
+                   template< typename... >
+                   class Control,
+                   typename Input,
+                   typename... States >
+         [[nodiscard]] static bool match( Input& in, States&&... st )
+         {
+            const char* const b = in.current();
+            const char* u = nullptr;
+            const char* const p = trivia_end( b, in.end(), u );
+            in.bump( std::size_t( p - b ) );
+            if( u != nullptr ) {
+               Control< lua53::long_string >::raise( static_cast< const Input& >( in ), st... );
+            }
+            return ( p != b ) || !NonEmpty;
+         }
+      };
+
+      struct long_string
+      {
+         using analyze_t = analysis::generic< analysis::rule_type::any >;
+
+         template< apply_mode,
+                   rewind_mode,
+                   template< typename... >
+                   class Action,
+                   template< typename... >
+                   class Control,
+                   typename Input,
+                   typename... States >
+         [[nodiscard]] static bool match( Input& in, States&&... st )
+         {
+            const auto level = long_open( in.current(), in.end() );
+            if( level < 0 ) {
+               return false;
+            }
+            in.bump_in_this_line( std::size_t( level + 2 ) );
+            (void)TAO_PEGTL_NAMESPACE::internal::eol::match( in );
+            const char* const p = in.current();
+            const char* const c = long_close( p, in.end(), level );
+            if( c == nullptr ) {
+               Control< lua53::long_string >::raise( static_cast< const Input& >( in ), st... );
+            }
+            in.bump( std::size_t( c - p ) );
+            return true;
+         }
+      };
+
+      struct name
+      {
+         using analyze_t = analysis::generic< analysis::rule_type::any >;
+
+         template< typename Input >
+         [[nodiscard]] static bool match( Input& in ) noexcept( noexcept( in.end() ) )
+         {
+            const char* const b = in.current();
+            const char* const e = in.end();
+            if( ( b == e ) || !is( *b, name_first ) ) {
+               return false;
+            }
+            const char* const p = name_end( b + 1, e );
+            if( is_keyword( b, std::size_t( p - b ) ) ) {
+               return false;
+            }
+            in.bump_in_this_line( std::size_t( p - b ) );
+            return true;
+         }
+      };
+
+      struct keyword
+      {
+         using analyze_t = analysis::generic< analysis::rule_type::any >;
+
+         template< typename Input >
+         [[nodiscard]] static bool match( Input& in ) noexcept( noexcept( in.end() ) )
+         {
+            const char* const b = in.current();
+            const char* const p = name_end( b, in.end() );
+            if( !is_keyword( b, std::size_t( p - b ) ) ) {
+               return false;
+            }
+            in.bump_in_this_line( std::size_t( p - b ) );
+            return true;
+         }
+      };
+
+      template< char... Cs >
+      struct key
+      {
+         using analyze_t = analysis::generic< analysis::rule_type::any >;
+
+         template< typename Input >
+         [[nodiscard]] static bool match( Input& in ) noexcept( noexcept( in.end() ) )
+         {
+            static constexpr char s[] = { Cs... };
+            constexpr std::size_t n = sizeof...( Cs );
+            const char* const b = in.current();
+            const auto size = std::size_t( in.end() - b );
+            if( ( size < n ) || ( std::memcmp( b, s, n ) != 0 ) || ( ( size > n ) && is( b[ n ], name_other ) ) ) {
+               return false;
+            }
+            in.bump_in_this_line( n );
+            return true;
+         }
+      };
+
+      // Matches a non-empty run of characters of a short literal string
+      // that are neither the quote Q nor a backslash or line end.
+
+      template< char Q >
+      struct plain
+      {
+         using analyze_t = analysis::generic< analysis::rule_type::any >;
+
+         template< typename Input >
+         [[nodiscard]] static bool match( Input& in ) noexcept( noexcept( in.end() ) )
+         {
+            const char* const b = in.current();
+            const char* const e = in.end();
+            const char* p = b;
+            while( ( p != e ) && ( *p != Q ) && ( *p != '\\' ) && ( *p != '\n' ) && ( *p != '\r' ) ) {
+               ++p;
+            }
+            in.bump_in_this_line( std::size_t( p - b ) );
+            return p != b;
+         }
+      };
+
+   }  // namespace internal
+
+   // clang-format off
+   struct long_string : internal::long_string {};
+
+   struct sep : internal::trivia< true > {};
+   struct seps : internal::trivia< false > {};
+
+   struct key_and : internal::key< 'a', 'n', 'd' > {};
+   struct key_break : internal::key< 'b', 'r', 'e', 'a', 'k' > {};
+   struct key_do : internal::key< 'd', 'o' > {};
+   struct key_else : internal::key< 'e', 'l', 's', 'e' > {};
+   struct key_elseif : internal::key< 'e', 'l', 's', 'e', 'i', 'f' > {};
+   struct key_end : internal::key< 'e', 'n', 'd' > {};
+   struct key_false : internal::key< 'f', 'a', 'l', 's', 'e' > {};
+   struct key_for : internal::key< 'f', 'o', 'r' > {};
+   struct key_function : internal::key< 'f', 'u', 'n', 'c', 't', 'i', 'o', 'n' > {};
+   struct key_goto : internal::key< 'g', 'o', 't', 'o' > {};
+   struct key_if : internal::key< 'i', 'f' > {};
+   struct key_in : internal::key< 'i', 'n' > {};
+   struct key_local : internal::key< 'l', 'o', 'c', 'a', 'l' > {};
+   struct key_nil : internal::key< 'n', 'i', 'l' > {};
+   struct key_not : internal::key< 'n', 'o', 't' > {};
+   struct key_or : internal::key< 'o', 'r' > {};
+   struct key_repeat : internal::key< 'r', 'e', 'p', 'e', 'a', 't' > {};
+   struct key_return : internal::key< 'r', 'e', 't', 'u', 'r', 'n' > {};
+   struct key_then : internal::key< 't', 'h', 'e', 'n' > {};
+   struct key_true : internal::key< 't', 'r', 'u', 'e' > {};
+   struct key_until : internal::key< 'u', 'n', 't', 'i', 'l' > {};
+   struct key_while : internal::key< 'w', 'h', 'i', 'l', 'e' > {};
+
+   struct keyword : internal::keyword {};
+
+   template< typename R >
+   struct pad : TAO_PEGTL_NAMESPACE::pad< R, sep > {};
+
+   struct name : internal::name {};
+
+   struct single : one< 'a', 'b', 'f', 'n', 'r', 't', 'v', '\\', '"', '\'', '0', '\n' > {};
+   struct spaces : seq< one< 'z' >, star< space > > {};
+   struct hexbyte : if_must< one< 'x' >, xdigit, xdigit > {};
+   struct decbyte : if_must< digit, rep_opt< 2, digit > > {};
+   struct unichar : if_must< one< 'u' >, one< '{' >, plus< xdigit >, one< '}' > > {};
+   struct escaped : if_must< one< '\\' >, sor< hexbyte, decbyte, unichar, single, spaces > > {};
+   template< char Q >
+   struct regular : internal::plain< Q > {};
+   template< char Q >
+   struct character : sor< escaped, regular< Q > > {};
+
+   template< char Q >
+   struct short_string : if_must< one< Q >, until< one< Q >, character< Q > > > {};
+   struct literal_string : sor< short_string< '"' >, short_string< '\'' >, long_string > {};
+
+   template< typename E >
+   struct exponent : opt_must< E, opt< one< '+', '-' > >, plus< digit > > {};
+
+   template< typename D, typename E >
+   struct numeral_three : seq< if_must< one< '.' >, plus< D > >, exponent< E > > {};
+   template< typename D, typename E >
+   struct numeral_two : seq< plus< D >, opt< one< '.' >, star< D > >, exponent< E > > {};
+   template< typename D, typename E >
+   struct numeral_one : sor< numeral_two< D, E >, numeral_three< D, E > > {};
+
+   struct decimal : numeral_one< digit, one< 'e', 'E' > > {};
+   struct hexadecimal : if_must< istring< '0', 'x' >, numeral_one< xdigit, one< 'p', 'P' > > > {};
+   struct numeral : sor< hexadecimal, decimal > {};
+
+   struct label_statement : if_must< two< ':' >, seps, name, seps, two< ':' > > {};
+   struct goto_statement : if_must< key_goto, seps, name > {};
+
+   struct statement;
+   struct expression;
+
+   struct name_list : list< name, one< ',' >, sep > {};
+   struct name_list_must : list_must< name, one< ',' >, sep > {};
+   struct expr_list_must : list_must< expression, one< ',' >, sep > {};
+
+   struct statement_return : seq< pad_opt< expr_list_must, sep >, opt< one< ';' >, seps > > {};
+
+   template< typename E >
+   struct statement_list : seq< seps, until< sor< E, if_must< key_return, statement_return, E > >, statement, seps > > {};
+
+   template< char O, char... N >
+   struct op_one : seq< one< O >, at< not_one< N... > > > {};
+   template< char O, char P, char... N >
+   struct op_two : seq< string< O, P >, at< not_one< N... > > > {};
+
+   struct table_field_one : if_must< one< '[' >, seps, expression, seps, one< ']' >, seps, one< '=' >, seps, expression > {};
+   struct table_field_two : if_must< seq< name, seps, op_one< '=', '=' > >, seps, expression > {};
+   struct table_field : sor< table_field_one, table_field_two, expression > {};
+   struct table_field_list : list_tail< table_field, one< ',', ';' >, sep > {};
+   struct table_constructor : if_must< one< '{' >, pad_opt< table_field_list, sep >, one< '}' > > {};
+
+   struct parameter_list_one : seq< name_list, opt_must< pad< one< ',' > >, ellipsis > > {};
+   struct parameter_list : sor< ellipsis, parameter_list_one > {};
+
+   struct function_body : seq< one< '(' >, pad_opt< parameter_list, sep >, one< ')' >, seps, statement_list< key_end > > {};
+   struct function_literal : if_must< key_function, seps, function_body > {};
+
+   struct bracket_expr : if_must< one< '(' >, seps, expression, seps, one< ')' > > {};
+
+   struct function_args_one : if_must< one< '(' >, pad_opt< expr_list_must, sep >, one< ')' > > {};
+   struct function_args : sor< function_args_one, table_constructor, literal_string > {};
+
+   struct variable_tail_one : if_must< one< '[' >, seps, expression, seps, one< ']' > > {};
+   struct variable_tail_two : if_must< seq< not_at< two< '.' > >, one< '.' > >, seps, name > {};
+   struct variable_tail : sor< variable_tail_one, variable_tail_two > {};
+
+   struct function_call_tail_one : if_must< seq< not_at< two< ':' > >, one< ':' > >, seps, name, seps, function_args > {};
+   struct function_call_tail : sor< function_args, function_call_tail_one > {};
+
+   struct variable_head_one : seq< bracket_expr, seps, variable_tail > {};
+   struct variable_head : sor< name, variable_head_one > {};
+
+   struct function_call_head : sor< name, bracket_expr > {};
+
+   struct variable : seq< variable_head, star< star< seps, function_call_tail >, seps, variable_tail > > {};
+   struct function_call : seq< function_call_head, plus< until< seq< seps, function_call_tail >, seps, variable_tail > > > {};
+
+   template< typename S, typename O >
+   struct left_assoc : seq< S, seps, star_must< O, seps, S, seps > > {};
+   template< typename S, typename O >
+   struct right_assoc : seq< S, seps, opt_must< O, seps, right_assoc< S, O > > > {};
+
+   struct unary_operators : sor< one< '-' >,
+                                 one< '#' >,
+                                 op_one< '~', '=' >,
+                                 key_not > {};
+
+   struct expr_ten;
+   struct expr_thirteen : seq< sor< bracket_expr, name >, star< seps, sor< function_call_tail, variable_tail > > > {};
+   struct expr_twelve : sor< key_nil,
+                             key_true,
+                             key_false,
+                             ellipsis,
+                             numeral,
+                             literal_string,
+                             function_literal,
+                             expr_thirteen,
+                             table_constructor > {};
+   struct expr_eleven : seq< expr_twelve, seps, opt< one< '^' >, seps, expr_ten, seps > > {};
+   struct unary_apply : if_must< unary_operators, seps, expr_ten, seps > {};
+   struct expr_ten : sor< unary_apply, expr_eleven > {};
+   struct operators_nine : sor< two< '/' >,
+                                one< '/' >,
+                                one< '*' >,
+                                one< '%' > > {};
+   struct expr_nine : left_assoc< expr_ten, operators_nine > {};
+   struct operators_eight : sor< one< '+' >,
+                                 one< '-' > > {};
+   struct expr_eight : left_assoc< expr_nine, operators_eight > {};
+   struct expr_seven : right_assoc< expr_eight, op_two< '.', '.', '.' > > {};
+   struct operators_six : sor< two< '<' >,
+                               two< '>' > > {};
+   struct expr_six : left_assoc< expr_seven, operators_six > {};
+   struct expr_five : left_assoc< expr_six, one< '&' > > {};
+   struct expr_four : left_assoc< expr_five, op_one< '~', '=' > > {};
+   struct expr_three : left_assoc< expr_four, one< '|' > > {};
+   struct operators_two : sor< two< '=' >,
+                               string< '<', '=' >,
+                               string< '>', '=' >,
+                               op_one< '<', '<' >,
+                               op_one< '>', '>' >,
+                               string< '~', '=' > > {};
+   struct expr_two : left_assoc< expr_three, operators_two > {};
+   struct expr_one : left_assoc< expr_two, key_and > {};
+   struct expression : left_assoc< expr_one, key_or > {};
+
+   struct do_statement : if_must< key_do, statement_list< key_end > > {};
+   struct while_statement : if_must< key_while, seps, expression, seps, key_do, statement_list< key_end > > {};
+   struct repeat_statement : if_must< key_repeat, statement_list< key_until >, seps, expression > {};
+
+   struct at_elseif_else_end : sor< at< key_elseif >, at< key_else >, at< key_end > > {};
+   struct elseif_statement : if_must< key_elseif, seps, expression, seps, key_then, statement_list< at_elseif_else_end > > {};
+   struct else_statement : if_must< key_else, statement_list< key_end > > {};
+   struct if_statement : if_must< key_if, seps, expression, seps, key_then, statement_list< at_elseif_else_end >, seps, until< sor< else_statement, key_end >, elseif_statement, seps > > {};
+
+   struct for_statement_one : seq< one< '=' >, seps, expression, seps, one< ',' >, seps, expression, pad_opt< if_must< one< ',' >, seps, expression >, sep > > {};
+   struct for_statement_two : seq< opt_must< one< ',' >, seps, name_list_must, seps >, key_in, seps, expr_list_must, seps > {};
+   struct for_statement : if_must< key_for, seps, name, seps, sor< for_statement_one, for_statement_two >, key_do, statement_list< key_end > > {};
+
+   struct assignment_variable_list : list_must< variable, one< ',' >, sep > {};
+   struct assignments_one : if_must< one< '=' >, seps, expr_list_must > {};
+   struct assignments : seq< assignment_variable_list, seps, assignments_one > {};
+   struct function_name : seq< list< name, one< '.' >, sep >, seps, opt_must< one< ':' >, seps, name, seps > > {};
+   struct function_definition : if_must< key_function, seps, function_name, function_body > {};
+
+   struct local_function : if_must< key_function, seps, name, seps, function_body > {};
+   struct local_variables : if_must< name_list_must, seps, opt< assignments_one > > {};
+   struct local_statement : if_must< key_local, seps, sor< local_function, local_variables > > {};
+
+   struct semicolon : one< ';' > {};
+   struct statement : sor< semicolon,
+                           assignments,
+                           function_call,
+                           label_statement,
+                           key_break,
+                           goto_statement,
+                           do_statement,
+                           while_statement,
+                           repeat_statement,
+                           if_statement,
+                           for_statement,
+                           function_definition,
+                           local_statement > {};
+
+   struct interpreter : seq< one< '#' >, until< eolf > > {};
+   struct grammar : must< opt< interpreter >, statement_list< eof > > {};
+   // clang-format on
+
+}  // namespace TAO_PEGTL_NAMESPACE::lua53
+
+namespace TAO_PEGTL_NAMESPACE::internal
+{
+   template< bool NonEmpty >
+   inline constexpr bool skip_control< lua53::internal::trivia< NonEmpty > > = true;
+
+   template<>
+   inline constexpr bool skip_control< lua53::internal::long_string > = true;
+
+   template<>
+   inline constexpr bool skip_control< lua53::internal::name > = true;
+
+   template<>
+   inline constexpr bool skip_control< lua53::internal::keyword > = true;
+
+   template< char... Cs >
+   inline constexpr bool skip_control< lua53::internal::key< Cs... > > = true;
+
+   template< char Q >
+   inline constexpr bool skip_control< lua53::internal::plain< Q > > = true;
+
+}  // namespace TAO_PEGTL_NAMESPACE::internal
+
+#endif
@@ -0,0 +1,151 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_NDJSON_HPP
+#define TAO_PEGTL_CONTRIB_NDJSON_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../apply_mode.hpp"
+#include "../config.hpp"
+#include "../memory_input.hpp"
+#include "../mmap_input.hpp"
+#include "../normal.hpp"
+#include "../nothing.hpp"
+#include "../parse.hpp"
+#include "../parse_error.hpp"
+#include "../rewind_mode.hpp"
+#include "../rules.hpp"
+#include "../tracking_mode.hpp"
+
+#include "../analysis/generic.hpp"
+
+#include "json.hpp"
+#include "parallel.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::ndjson
+{
+   // Parallel parsing of newline-delimited JSON (NDJSON, JSON Lines).
+
+   using options = parallel::options;
+
+   template< typename State >
+   struct result
+   {
+      std::vector< State > states;  // One per chunk, in file order.
+      std::vector< parse_error > errors;  // One per failed record, in file order.
+      std::size_t records = 0;  // Number of non-empty lines.
+   };
+
+   namespace internal
+   {
+      // The state that parallel::parse() passes to line< Rule >.
+
+      template< typename State >
+      struct chunk_state
+      {
+         State state;
+         std::size_t records = 0;
+      };
+
+      // Matches one line including its line end. Lines that contain only
+      // white-space are skipped, all others are counted as records and are
+      // parsed with must< Rule, eof > on an input that ends before the line
+      // end, with the state of the chunk.
+
+      template< typename Rule >
+      struct line
+      {
+         using analyze_t = analysis::generic< analysis::rule_type::any >;
+
+         template< apply_mode A,
+                   rewind_mode,
+                   template< typename... >
+                   class Action,
+                   template< typename... >
+                   class Control,
+                   typename Input,
+                   typename State >
+         [[nodiscard]] static bool match( Input& in, chunk_state< State >& s )
+         {
+            const char* b = in.current();
+            const char* n = static_cast< const char* >( std::memchr( b, '\n', in.size() ) );
+            const char* e = ( n != nullptr ) ? n : in.end();
+            const char* l = ( ( e != b ) && ( e[ -1 ] == '\r' ) ) ? ( e - 1 ) : e;
+            if( json::internal::skip_ws( b, l ) != l ) {
+               ++s.records;
+               memory_input< tracking_mode::eager, typename Input::eol_t, const typename Input::source_t& > li( in.iterator(), l, in.source() );
+               (void)Control< must< Rule, eof > >::template match< A, rewind_mode::dontcare, Action, Control >( li, s.state );
+            }
+            if( n != nullptr ) {
+               in.bump_to_next_line( std::size_t( n + 1 - b ) );
+            }
+            else {
+               in.bump_in_this_line( std::size_t( e - b ) );
+            }
+            return true;
+         }
+      };
+
+   }  // namespace internal
+
+   // Parses every non-empty line of [ begin, end ) with must< Rule, eof >
+   // using parallel::parse() with one< '\n' > as boundary, i.e. the input
+   // is split into chunks at line ends which are parsed on up to
+   // options::threads threads. Every chunk gets its own state, created by
+   // make_state(), which is passed to the actions of all records in the
+   // chunk. Parse errors of records are collected, all other exceptions
+   // are rethrown after all threads have finished (the first in file
+   // order). All positions are relative to begin, with correct lines.
+
+   template< typename Rule = json::text,
+             template< typename... > class Action = nothing,
+             template< typename... > class Control = normal,
+             typename MakeState >
+   [[nodiscard]] auto parse( const char* begin, const char* end, const std::string& source, MakeState&& make_state, const options& op = options() )
+   {
+      using state_t = std::decay_t< decltype( make_state() ) >;
+
+      auto p = parallel::parse< internal::line< Rule >, one< '\n' >, Action, Control >(
+         begin, end, source, [ & ]() { return internal::chunk_state< state_t >{ make_state() }; }, op );
+
+      result< state_t > r;
+      r.states.reserve( p.states.size() );
+      for( auto& c : p.states ) {
+         r.states.emplace_back( std::move( c.state ) );
+         r.records += c.records;
+      }
+      r.errors = std::move( p.errors );
+      return r;
+   }
+
+   // Parses the data of a memory input, e.g. a mmap_input.
+
+   template< typename Rule = json::text,
+             template< typename... > class Action = nothing,
+             template< typename... > class Control = normal,
+             typename Input,
+             typename MakeState >
+   [[nodiscard]] auto parse( const Input& in, MakeState&& make_state, const options& op = options() )
+   {
+      return ndjson::parse< Rule, Action, Control >( in.begin(), in.end(), in.source(), make_state, op );
+   }
+
+   template< typename Rule = json::text,
+             template< typename... > class Action = nothing,
+             template< typename... > class Control = normal,
+             typename MakeState >
+   [[nodiscard]] auto parse_file( const std::string& filename, MakeState&& make_state, const options& op = options() )
+   {
+      const mmap_input< tracking_mode::lazy > in( filename );
+      return ndjson::parse< Rule, Action, Control >( in, make_state, op );
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE::ndjson
+
+#endif
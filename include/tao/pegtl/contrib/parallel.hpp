@@ -0,0 +1,572 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_PARALLEL_HPP
+#define TAO_PEGTL_CONTRIB_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined( __unix__ ) || ( defined( __APPLE__ ) && defined( __MACH__ ) )
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "../ascii.hpp"
+#include "../config.hpp"
+#include "../eol.hpp"
+#include "../memory_input.hpp"
+#include "../mmap_input.hpp"
+#include "../normal.hpp"
+#include "../nothing.hpp"
+#include "../parse.hpp"
+#include "../parse_error.hpp"
+#include "../rules.hpp"
+#include "../tracking_mode.hpp"
+
+#include "../internal/file_reader.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::parallel
+{
+   // Parallel parsing of large inputs that consist of independent records.
+
+   struct options
+   {
+      std::size_t threads = 0;  // 0 means std::thread::hardware_concurrency().
+      std::size_t chunk_size = std::size_t( 1 ) << 20;  // Chunks end at the first boundary after this many bytes.
+      std::size_t readahead = 0;  // Number of upcoming files that parse_files() asks the OS to prefetch.
+   };
+
+   template< typename State >
+   struct result
+   {
+      std::vector< State > states;  // One per chunk, in file order.
+      std::vector< parse_error > errors;  // One per failed record, in file order.
+      std::size_t records = 0;  // Number of successfully parsed records.
+   };
+
+   namespace internal
+   {
+      [[nodiscard]] inline std::size_t thread_count( const options& op ) noexcept
+      {
+         if( op.threads != 0 ) {
+            return op.threads;
+         }
+         return std::max( std::size_t( std::thread::hardware_concurrency() ), std::size_t( 1 ) );
+      }
+
+      [[nodiscard]] inline std::size_t worker_count( const std::size_t n, const std::size_t threads ) noexcept
+      {
+         return std::max( std::min( threads, n ), std::size_t( 1 ) );
+      }
+
+      // The first index of the initial share of worker w.
+
+      [[nodiscard]] inline std::size_t share_begin( const std::size_t w, const std::size_t n, const std::size_t t ) noexcept
+      {
+         return w * n / t;
+      }
+
+      template< typename F >
+      void call( const F& f, const std::size_t i, const std::size_t w )
+      {
+         if constexpr( std::is_invocable_v< const F&, std::size_t, std::size_t > ) {
+            f( i, w );
+         }
+         else {
+            (void)w;
+            f( i );
+         }
+      }
+
+      // Calls f( i ) or f( i, w ) for all i in [ 0, n ) on worker_count()
+      // threads, with w the index of the calling thread. Every thread starts
+      // with an equal share of consecutive indices which it processes in
+      // increasing order; a thread that runs out of work steals the upper
+      // half of the remaining indices of another thread.
+
+      template< typename F >
+      void for_each( const std::size_t n, const std::size_t threads, const F& f )
+      {
+         const std::size_t t = worker_count( n, threads );
+         if( t == 1 ) {
+            for( std::size_t i = 0; i < n; ++i ) {
+               call( f, i, 0 );
+            }
+            return;
+         }
+         struct range
+         {
+            std::mutex mutex;
+            std::size_t next;
+            std::size_t end;
+         };
+         std::vector< range > ranges( t );
+         for( std::size_t w = 0; w < t; ++w ) {
+            ranges[ w ].next = share_begin( w, n, t );
+            ranges[ w ].end = share_begin( w + 1, n, t );
+         }
+         const auto take = [ & ]( const std::size_t w, std::size_t& i ) {
+            auto& r = ranges[ w ];
+            const std::lock_guard< std::mutex > lock( r.mutex );
+            if( r.next == r.end ) {
+               return false;
+            }
+            i = r.next++;
+            return true;
+         };
+         const auto steal = [ & ]( const std::size_t w, std::size_t& i ) {
+            for( std::size_t k = 1; k < t; ++k ) {
+               auto& v = ranges[ ( w + k ) % t ];
+               std::size_t b;
+               std::size_t e;
+               {
+                  const std::lock_guard< std::mutex > lock( v.mutex );
+                  if( v.next == v.end ) {
+                     continue;
+                  }
+                  b = v.end - ( v.end - v.next + 1 ) / 2;
+                  e = v.end;
+                  v.end = b;
+               }
+               auto& r = ranges[ w ];
+               const std::lock_guard< std::mutex > lock( r.mutex );
+               r.next = b + 1;
+               r.end = e;
+               i = b;
+               return true;
+            }
+            return false;
+         };
+         const auto work = [ & ]( const std::size_t w ) {
+            std::size_t i;
+            while( take( w, i ) || steal( w, i ) ) {
+               call( f, i, w );
+            }
+         };
+         std::vector< std::thread > pool;
+         for( std::size_t w = 1; w < t; ++w ) {
+            pool.emplace_back( work, w );
+         }
+         work( 0 );
+         for( auto& thread : pool ) {
+            thread.join();
+         }
+      }
+
+      // Records the lowest index of a failed task; tasks with a higher
+      // index can be skipped as only the first failure is reported.
+
+      class first_failure
+      {
+      public:
+         [[nodiscard]] bool skip( const std::size_t i ) const noexcept
+         {
+            return i > m_index.load( std::memory_order_relaxed );
+         }
+
+         void set( const std::size_t i ) noexcept
+         {
+            std::size_t c = m_index.load( std::memory_order_relaxed );
+            while( ( i < c ) && !m_index.compare_exchange_weak( c, i, std::memory_order_relaxed ) ) {
+            }
+         }
+
+      private:
+         std::atomic< std::size_t > m_index{ std::size_t( -1 ) };
+      };
+
+      // Returns the end of the first match of Boundary at or after p, or e.
+
+      template< typename Boundary >
+      struct find_boundary
+      {
+         [[nodiscard]] static const char* find( const char* p, const char* e )
+         {
+            for( ; p != e; ++p ) {
+               memory_input< tracking_mode::lazy, eol::lf_crlf, const char* > in( p, e, "" );
+               if( TAO_PEGTL_NAMESPACE::parse< Boundary >( in ) ) {
+                  return in.current();
+               }
+            }
+            return e;
+         }
+      };
+
+      template< char C >
+      struct find_boundary< one< C > >
+      {
+         [[nodiscard]] static const char* find( const char* p, const char* e ) noexcept
+         {
+            const void* r = std::memchr( p, C, std::size_t( e - p ) );
+            return ( r != nullptr ) ? ( static_cast< const char* >( r ) + 1 ) : e;
+         }
+      };
+
+      struct chunk
+      {
+         chunk( const char* b, const char* e ) noexcept
+            : begin( b ),
+              end( e )
+         {
+         }
+
+         const char* begin;
+         const char* end;
+         std::size_t line = 1;  // Global position of the beginning.
+         std::size_t byte_in_line = 0;
+         std::size_t newlines = 0;
+         const char* last_newline = nullptr;
+         std::size_t records = 0;
+         std::vector< parse_error > errors;
+         std::exception_ptr exception;
+      };
+
+      template< typename Boundary >
+      [[nodiscard]] std::vector< chunk > split( const char* begin, const char* end, const std::size_t chunk_size )
+      {
+         std::vector< chunk > result;
+         const char* b = begin;
+         while( b != end ) {
+            const char* e = ( std::size_t( end - b ) > chunk_size ) ? find_boundary< Boundary >::find( b + chunk_size, end ) : end;
+            result.emplace_back( b, e );
+            b = e;
+         }
+         return result;
+      }
+
+      // Counts the lines of all chunks in parallel to set the global line
+      // and column of the beginning of every chunk.
+
+      inline void locate( std::vector< chunk >& chunks, const char* begin, const std::size_t threads )
+      {
+         for_each( chunks.size(), threads, [ & ]( const std::size_t i ) {
+            auto& c = chunks[ i ];
+            for( const char* p = c.begin; ( p = static_cast< const char* >( std::memchr( p, '\n', std::size_t( c.end - p ) ) ) ) != nullptr; ++p ) {
+               ++c.newlines;
+               c.last_newline = p;
+            }
+         } );
+         const char* line_begin = begin;
+         for( std::size_t i = 1; i < chunks.size(); ++i ) {
+            auto& p = chunks[ i - 1 ];
+            if( p.last_newline != nullptr ) {
+               line_begin = p.last_newline + 1;
+            }
+            chunks[ i ].line = p.line + p.newlines;
+            chunks[ i ].byte_in_line = std::size_t( chunks[ i ].begin - line_begin );
+         }
+      }
+
+      // Parses the records of a chunk until its end; after a parse error
+      // the chunk is resynchronised after the next boundary.
+
+      template< typename Record, typename Boundary, template< typename... > class Action, template< typename... > class Control, typename State >
+      void parse_chunk( chunk& c, const char* begin, const std::string& source, State& state )
+      {
+         std::size_t byte = std::size_t( c.begin - begin );
+         std::size_t line = c.line;
+         std::size_t byte_in_line = c.byte_in_line;
+
+         for( const char* b = c.begin; b != c.end; ) {
+            memory_input< tracking_mode::eager, eol::lf_crlf, const std::string& > in( b, c.end, source, byte, line, byte_in_line );
+            try {
+               while( !in.empty() ) {
+                  const char* p = in.current();
+                  TAO_PEGTL_NAMESPACE::parse< must< Record >, Action, Control >( in, state );
+                  if( in.current() == p ) {
+                     throw parse_error( "record did not consume input", in );
+                  }
+                  ++c.records;
+               }
+               return;
+            }
+            catch( parse_error& error ) {
+               const auto& pos = error.positions.at( 0 );
+               const char* p = begin + pos.byte;
+               byte = pos.byte;
+               line = pos.line;
+               byte_in_line = pos.byte_in_line;
+               c.errors.emplace_back( std::move( error ) );
+
+               b = find_boundary< Boundary >::find( p, c.end );
+               if( ( b == p ) && ( b != c.end ) ) {
+                  ++b;
+               }
+               for( ; p != b; ++p ) {
+                  ++byte;
+                  ++byte_in_line;
+                  if( *p == '\n' ) {
+                     ++line;
+                     byte_in_line = 0;
+                  }
+               }
+            }
+         }
+      }
+
+      // Helpers for parse_files(); the size is only used for scheduling,
+      // hence 0 is returned when it can not be determined.
+
+      [[nodiscard]] inline std::size_t file_size( const std::string& path ) noexcept
+      {
+#if defined( _POSIX_VERSION )
+         struct stat st;
+         if( ::stat( path.c_str(), &st ) == 0 ) {
+            return std::size_t( st.st_size );
+         }
+#else
+         (void)path;
+#endif
+         return 0;
+      }
+
+      inline void prefetch( const std::string& path ) noexcept
+      {
+#if defined( _POSIX_VERSION ) && defined( POSIX_FADV_WILLNEED )
+         const int fd = ::open( path.c_str(), O_RDONLY );
+         if( fd >= 0 ) {
+            (void)::posix_fadvise( fd, 0, 0, POSIX_FADV_WILLNEED );
+            ::close( fd );
+         }
+#else
+         (void)path;
+#endif
+      }
+
+      // Reads a file into a buffer that is reused for many files, it only
+      // ever grows, and returns the size of the file.
+
+      [[nodiscard]] inline std::size_t read_file( const std::string& path, std::string& buffer )
+      {
+         const std::unique_ptr< std::FILE, TAO_PEGTL_NAMESPACE::internal::file_close > file( TAO_PEGTL_NAMESPACE::internal::file_open( path.c_str() ) );
+         std::size_t size = 0;
+         while( true ) {
+            if( size == buffer.size() ) {
+               buffer.resize( std::max( 2 * buffer.size(), std::size_t( 1 ) << 16 ) );
+            }
+            errno = 0;
+            size += std::fread( &buffer[ size ], 1, buffer.size() - size, file.get() );
+            if( size < buffer.size() ) {
+               if( std::ferror( file.get() ) != 0 ) {
+                  const auto ec = errno;
+                  throw std::system_error( ec, std::system_category(), path );
+               }
+               return size;
+            }
+         }
+      }
+
+      // Orders the files by decreasing size and deals them to the initial
+      // shares of the workers of for_each() like cards, so that every
+      // worker starts with its largest files and small files are left
+      // for stealing at the end.
+
+      [[nodiscard]] inline std::vector< std::size_t > schedule( const std::vector< std::string >& paths, const std::size_t threads )
+      {
+         const std::size_t n = paths.size();
+         std::vector< std::pair< std::size_t, std::size_t > > sizes;
+         sizes.reserve( n );
+         for( std::size_t i = 0; i < n; ++i ) {
+            sizes.emplace_back( file_size( paths[ i ] ), i );
+         }
+         std::stable_sort( sizes.begin(), sizes.end(), []( const auto& a, const auto& b ) { return a.first > b.first; } );
+
+         const std::size_t t = worker_count( n, threads );
+         std::vector< std::size_t > next;
+         for( std::size_t w = 0; w < t; ++w ) {
+            next.emplace_back( share_begin( w, n, t ) );
+         }
+         std::vector< std::size_t > result( n );
+         std::size_t w = 0;
+         for( const auto& s : sizes ) {
+            while( next[ w ] == share_begin( w + 1, n, t ) ) {
+               w = ( w + 1 ) % t;
+            }
+            result[ next[ w ]++ ] = s.second;
+            w = ( w + 1 ) % t;
+         }
+         return result;
+      }
+
+   }  // namespace internal
+
+   // Parses [ begin, end ) as a sequence of records, each of which is
+   // matched with must< Record >, similar to until< eof, must< Record > >.
+   // The input is split into chunks that end after a match of Boundary,
+   // e.g. a line end, which are parsed on up to options::threads threads.
+   // Every chunk gets its own state, created by make_state(), which is
+   // passed to the actions of all records in the chunk.
+   //
+   // Parse errors are collected, parsing continues after the next match
+   // of Boundary; all other exceptions are rethrown after all threads
+   // have finished (the first in file order). All positions are relative
+   // to begin, with correct lines.
+
+   template< typename Record,
+             typename Boundary = one< '\n' >,
+             template< typename... > class Action = nothing,
+             template< typename... > class Control = normal,
+             typename MakeState >
+   [[nodiscard]] auto parse( const char* begin, const char* end, const std::string& source, MakeState&& make_state, const options& op = options() )
+   {
+      using state_t = std::decay_t< decltype( make_state() ) >;
+
+      auto chunks = internal::split< Boundary >( begin, end, std::max( op.chunk_size, std::size_t( 1 ) ) );
+      const std::size_t threads = internal::thread_count( op );
+      internal::locate( chunks, begin, threads );
+
+      result< state_t > r;
+      r.states.reserve( chunks.size() );
+      for( std::size_t i = 0; i < chunks.size(); ++i ) {
+         r.states.emplace_back( make_state() );
+      }
+      internal::first_failure failure;
+      internal::for_each( chunks.size(), threads, [ & ]( const std::size_t i ) {
+         if( !failure.skip( i ) ) {
+            try {
+               internal::parse_chunk< Record, Boundary, Action, Control >( chunks[ i ], begin, source, r.states[ i ] );
+            }
+            catch( ... ) {
+               chunks[ i ].exception = std::current_exception();
+               failure.set( i );
+            }
+         }
+      } );
+      for( auto& c : chunks ) {
+         if( c.exception ) {
+            std::rethrow_exception( c.exception );
+         }
+         r.records += c.records;
+         for( auto& e : c.errors ) {
+            r.errors.emplace_back( std::move( e ) );
+         }
+      }
+      return r;
+   }
+
+   // Parses the data of a memory input, e.g. a mmap_input.
+
+   template< typename Record,
+             typename Boundary = one< '\n' >,
+             template< typename... > class Action = nothing,
+             template< typename... > class Control = normal,
+             typename Input,
+             typename MakeState >
+   [[nodiscard]] auto parse( const Input& in, MakeState&& make_state, const options& op = options() )
+   {
+      return parallel::parse< Record, Boundary, Action, Control >( in.begin(), in.end(), in.source(), make_state, op );
+   }
+
+   template< typename Record,
+             typename Boundary = one< '\n' >,
+             template< typename... > class Action = nothing,
+             template< typename... > class Control = normal,
+             typename MakeState >
+   [[nodiscard]] auto parse_file( const std::string& filename, MakeState&& make_state, const options& op = options() )
+   {
+      const mmap_input< tracking_mode::lazy > in( filename );
+      return parallel::parse< Record, Boundary, Action, Control >( in, make_state, op );
+   }
+
+   struct file_error
+   {
+      std::size_t index;  // Into the paths given to parse_files().
+      std::exception_ptr exception;
+   };
+
+   template< typename State >
+   struct files_result
+   {
+      std::vector< State > states;  // One per worker thread.
+      std::vector< file_error > errors;  // One per failed file, in path order.
+      std::size_t files = 0;  // Number of successfully parsed files.
+   };
+
+   // Parses many files with parse< Grammar, Action, Control >() on up to
+   // options::threads threads. The files are scheduled largest first,
+   // idle threads steal work from busy ones. Every thread reads its files
+   // into a reused buffer and passes its own state, created by make_state(),
+   // to the actions of all files it parses.
+   //
+   // A file fails when it can not be read, when the grammar does not match
+   // (reported as parse_error at the start of the file), or when the parse
+   // throws an exception; the failures of all files are collected.
+   // With options::readahead > 0 every thread asks the OS to prefetch the
+   // files that are scheduled next.
+
+   template< typename Grammar,
+             template< typename... > class Action = nothing,
+             template< typename... > class Control = normal,
+             typename MakeState >
+   [[nodiscard]] auto parse_files( const std::vector< std::string >& paths, MakeState&& make_state, const options& op = options() )
+   {
+      using state_t = std::decay_t< decltype( make_state() ) >;
+
+      const std::size_t n = paths.size();
+      const std::size_t threads = internal::thread_count( op );
+      const std::size_t t = internal::worker_count( n, threads );
+      const auto order = internal::schedule( paths, threads );
+
+      struct worker
+      {
+         std::string buffer;
+         std::size_t prefetched = 0;  // Position in order up to which prefetch() was called.
+         std::size_t files = 0;
+      };
+      std::vector< worker > workers( t );
+
+      files_result< state_t > r;
+      r.states.reserve( t );
+      for( std::size_t w = 0; w < t; ++w ) {
+         r.states.emplace_back( make_state() );
+      }
+      std::vector< std::exception_ptr > exceptions( n );
+      internal::for_each( n, threads, [ & ]( const std::size_t k, const std::size_t w ) {
+         auto& x = workers[ w ];
+         for( std::size_t j = std::max( x.prefetched, k + 1 ); j < std::min( k + 1 + op.readahead, n ); ++j ) {
+            internal::prefetch( paths[ order[ j ] ] );
+            x.prefetched = j + 1;
+         }
+         const auto& path = paths[ order[ k ] ];
+         try {
+            const std::size_t size = internal::read_file( path, x.buffer );
+            memory_input< tracking_mode::eager, eol::lf_crlf, const std::string& > in( x.buffer.data(), x.buffer.data() + size, path );
+            if( !TAO_PEGTL_NAMESPACE::parse< Grammar, Action, Control >( in, r.states[ w ] ) ) {
+               in.restart();
+               throw parse_error( "grammar did not match", in );
+            }
+            ++x.files;
+         }
+         catch( ... ) {
+            exceptions[ order[ k ] ] = std::current_exception();
+         }
+      } );
+      for( const auto& x : workers ) {
+         r.files += x.files;
+      }
+      for( std::size_t i = 0; i < n; ++i ) {
+         if( exceptions[ i ] ) {
+            r.errors.push_back( { i, std::move( exceptions[ i ] ) } );
+         }
+      }
+      return r;
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE::parallel
+
+#endif
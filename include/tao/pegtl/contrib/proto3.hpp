@@ -0,0 +1,1353 @@
+// Copyright (c) 2017-2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_PROTO3_HPP
+#define TAO_PEGTL_CONTRIB_PROTO3_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../ascii.hpp"
+#include "../config.hpp"
+#include "../nothing.hpp"
+#include "../parse_error.hpp"
+#include "../rules.hpp"
+
+#include "arena.hpp"
+#include "parallel.hpp"
+#include "trivia.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::proto3
+{
+   // Grammar for .proto files with syntax = "proto3", and a front-end
+   // that loads many files with their imports on multiple threads into
+   // a compact descriptor_set.
+
+   // clang-format off
+   struct line_comment : TAO_PEGTL_NAMESPACE::line_comment< two< '/' > > {};
+   struct block_comment : TAO_PEGTL_NAMESPACE::block_comment< string< '/', '*' >, string< '*', '/' > > {};
+   struct comment : sor< line_comment, block_comment > {};
+   struct sp : trivia< space, line_comment, block_comment > {};
+   struct sps : skip_trivia< space, line_comment, block_comment > {};
+
+   struct comma : one< ',' > {};
+   struct dot : one< '.' > {};
+   struct equ : one< '=' > {};
+   struct semi : one< ';' > {};
+
+   struct option;
+   struct message;
+
+   struct odigit : range< '0', '7' > {};
+
+   struct ident_first : ranges< 'a', 'z', 'A', 'Z' > {};  // NOTE: Yes, no '_'.
+   struct ident_other : ranges< 'a', 'z', 'A', 'Z', '0', '9', '_' > {};
+   struct ident : seq< ident_first, star< ident_other > > {};
+   struct full_ident : list_must< ident, dot > {};
+
+   template< char... Cs >
+   struct key : seq< string< Cs... >, not_at< ident_other > > {};
+
+   struct oct_lit : seq< one< '0' >, star< odigit > > {};
+   struct hex_lit : seq< one< '0' >, one< 'x', 'X' >, plus< xdigit > > {};
+   struct dec_lit : seq< range< '1', '9' >, star< digit > > {};
+   struct int_lit : sor< dec_lit, hex_lit, oct_lit > {};
+
+   struct hex_escape : if_must< one< 'x', 'X' >, xdigit, xdigit > {};
+   struct oct_escape : if_must< odigit, odigit, odigit > {};
+   struct char_escape : one< 'a', 'b', 'f', 'n', 'r', 't', 'v', '\\', '\'', '"' > {};
+   struct escape : if_must< one< '\\' >, sor< hex_escape, oct_escape, char_escape > > {};
+   struct char_value : sor< escape, not_one< '\n', '\0' > > {};  // NOTE: No need to exclude '\' from not_one<>, see escape rule.
+   template< char Q >
+   struct str_impl : if_must< one< Q >, until< one< Q >, char_value > > {};
+   struct str_lit : sor< str_impl< '\'' >, str_impl< '"' > > {};
+
+   struct bool_lit : seq< sor< string< 't', 'r', 'u', 'e' >, string< 'f', 'a', 'l', 's', 'e' > >, not_at< ident_other > > {};
+
+   struct sign : one< '+', '-' > {};
+   struct constant : sor< bool_lit, full_ident, seq< opt< sign, sps >, int_lit >, str_lit > {};  // NOTE: protoc reads the sign as a separate token, like in enum_number.
+
+   struct option_name : seq< sor< ident, if_must< one< '(' >, full_ident, one< ')' > > >, star_must< dot, ident > > {};
+   struct option : if_must< key< 'o', 'p', 't', 'i', 'o', 'n' >, sps, option_name, sps, equ, sps, constant, sps, semi, sps > {};
+
+   struct bool_type : string< 'b', 'o', 'o', 'l' > {};
+   struct bytes_type : string< 'b', 'y', 't', 'e', 's' > {};
+   struct double_type : string< 'd', 'o', 'u', 'b', 'l', 'e' > {};
+   struct float_type : string< 'f', 'l', 'o', 'a', 't' > {};
+   struct string_type : string< 's', 't', 'r', 'i', 'n', 'g' > {};
+
+   struct int32_type : string< 'i', 'n', 't', '3', '2' > {};
+   struct int64_type : string< 'i', 'n', 't', '6', '4' > {};
+   struct sint32_type : string< 's', 'i', 'n', 't', '3', '2' > {};
+   struct sint64_type : string< 's', 'i', 'n', 't', '6', '4' > {};
+   struct uint32_type : string< 'u', 'i', 'n', 't', '3', '2' > {};
+   struct uint64_type : string< 'u', 'i', 'n', 't', '6', '4' > {};
+   struct fixed32_type : string< 'f', 'i', 'x', 'e', 'd', '3', '2' > {};
+   struct fixed64_type : string< 'f', 'i', 'x', 'e', 'd', '6', '4' > {};
+   struct sfixed32_type : string< 's', 'f', 'i', 'x', 'e', 'd', '3', '2' > {};
+   struct sfixed64_type : string< 's', 'f', 'i', 'x', 'e', 'd', '6', '4' > {};
+
+   struct builtin_type : seq< sor< bool_type, bytes_type, double_type, float_type, string_type, int32_type, int64_type, sint32_type, sint64_type, uint32_type, uint64_type, fixed32_type, fixed64_type, sfixed32_type, sfixed64_type >, not_at< ident_other > > {};
+
+   struct defined_type : seq< opt< dot >, full_ident > {};  // NOTE: This replaces both message_type and enum_type -- they have the same syntax.
+
+   struct type : sor< builtin_type, defined_type > {};
+
+   struct field_option : if_must< option_name, sps, equ, sps, constant > {};
+   struct field_options : if_must< one< '[' >, sps, list< field_option, comma, sp >, sps, one< ']' > > {};
+   struct field_name : ident {};
+   struct field_number : int_lit {};
+   struct field : seq< opt< key< 'r', 'e', 'p', 'e', 'a', 't', 'e', 'd' >, sps >, type, sps, field_name, sps, equ, sps, field_number, sps, opt< field_options, sps >, semi > {};
+
+   struct oneof_name : ident {};
+   struct oneof_field : if_must< type, sps, field_name, sps, equ, sps, field_number, sps, opt< field_options, sps >, semi > {};
+   struct oneof_body : sor< oneof_field, semi > {};
+   struct oneof : if_must< key< 'o', 'n', 'e', 'o', 'f' >, sps, oneof_name, sps, one< '{' >, sps, until< one< '}' >, oneof_body, sps >, sps > {};
+
+   struct key_type : seq< sor< bool_type, string_type, int32_type, int64_type, sint32_type, sint64_type, uint32_type, uint64_type, fixed32_type, fixed64_type, sfixed32_type, sfixed64_type >, not_at< ident_other > > {};
+   struct map_name : ident {};
+   struct map_field : if_must< key< 'm', 'a', 'p' >, sps, one< '<' >, sps, key_type, sps, comma, sps, type, sps, one< '>' >, sps, map_name, sps, equ, sps, field_number, sps, opt< field_options, sps >, semi > {};
+
+   struct range : seq< int_lit, opt< sps, if_must< key< 't', 'o' >, sps, sor< int_lit, key< 'm', 'a', 'x' > > > > > {};
+   struct ranges : list_must< range, comma, sp > {};
+   struct field_names : list_must< str_lit, comma, sp > {};
+   struct reserved : if_must< key< 'r', 'e', 's', 'e', 'r', 'v', 'e', 'd' >, sps, sor< ranges, field_names >, sps, semi > {};
+
+   struct enum_name : ident {};
+   struct enum_value_name : ident {};
+   struct enum_number : seq< opt< one< '-' >, sps >, int_lit > {};
+   struct enum_value_option : seq< option_name, sps, equ, sps, constant > {};
+   struct enum_field : seq< enum_value_name, sps, equ, sps, enum_number, sps, opt_must< one< '[' >, sps, list_must< enum_value_option, comma, sp >, sps, one< ']' >, sps >, semi > {};
+   struct enum_body : if_must< one< '{' >, sps, star< sor< option, reserved, enum_field, semi >, sps >, one< '}' > > {};
+   struct enum_def : if_must< key< 'e', 'n', 'u', 'm' >, sps, enum_name, sps, enum_body > {};
+
+   struct message_name : ident {};
+   struct message_thing : sor< option, enum_def, message, oneof, map_field, reserved, field, semi > {};  // NOTE: field last, its type could match the keywords.
+   struct message : if_must< key< 'm', 'e', 's', 's', 'a', 'g', 'e' >, sps, message_name, sps, one< '{' >, sps, star< message_thing, sps >, one< '}' >, sps > {};
+
+   struct package_name : full_ident {};
+   struct package : if_must< key< 'p', 'a', 'c', 'k', 'a', 'g', 'e' >, sps, package_name, sps, semi, sps > {};
+
+   struct import_option : opt< sor< key< 'w', 'e', 'a', 'k' >, key< 'p', 'u', 'b', 'l', 'i', 'c' > > > {};
+   struct import_name : str_lit {};
+   struct import : if_must< key< 'i', 'm', 'p', 'o', 'r', 't' >, sps, import_option, sps, import_name, sps, semi, sps > {};
+
+   struct rpc_name : ident {};
+   struct rpc_stream : seq< key< 's', 't', 'r', 'e', 'a', 'm' >, sps, at< defined_type > > {};
+   struct rpc_message : defined_type {};
+   struct rpc_type : if_must< one< '(' >, sps, opt< rpc_stream >, rpc_message, sps, one< ')' > > {};
+   struct rpc_input : rpc_type {};
+   struct rpc_output : rpc_type {};
+   struct rpc_options : if_must< one< '{' >, sps, star< sor< option, semi >, sps >, one< '}' > > {};
+   struct rpc : if_must< key< 'r', 'p', 'c' >, sps, rpc_name, sps, rpc_input, sps, key< 'r', 'e', 't', 'u', 'r', 'n', 's' >, sps, rpc_output, sps, sor< semi, rpc_options > > {};
+   struct service_name : ident {};
+   struct service : if_must< key< 's', 'e', 'r', 'v', 'i', 'c', 'e' >, sps, service_name, sps, one< '{' >, sps, star< sor< option, rpc, semi >, sps >, one< '}' > > {};
+
+   struct body : sor< import, package, option, message, enum_def, service, semi > {};
+
+   struct head : if_must< key< 's', 'y', 'n', 't', 'a', 'x' >, sps, equ, sps, sor< string< '"', 'p', 'r', 'o', 't', 'o', '3', '"' >, string< '\'', 'p', 'r', 'o', 't', 'o', '3', '\'' > >, sps, semi > {};
+   struct proto : must< sps, head, sps, star< body, sps >, eof > {};
+   // clang-format on
+
+   // Descriptors are trivially copyable and live in arenas that are owned
+   // by a descriptor_set; arrays and names are views into these arenas.
+   // All names are interned by a name_table, i.e. two names are equal iff
+   // their data() pointers are equal.
+
+   template< typename T >
+   class array
+   {
+   public:
+      constexpr array() noexcept = default;
+
+      constexpr array( const T* data, const std::uint32_t size ) noexcept
+         : m_data( data ),
+           m_size( size )
+      {
+      }
+
+      [[nodiscard]] constexpr const T* begin() const noexcept
+      {
+         return m_data;
+      }
+
+      [[nodiscard]] constexpr const T* end() const noexcept
+      {
+         return m_data + m_size;
+      }
+
+      [[nodiscard]] constexpr std::size_t size() const noexcept
+      {
+         return m_size;
+      }
+
+      [[nodiscard]] constexpr bool empty() const noexcept
+      {
+         return m_size == 0;
+      }
+
+      [[nodiscard]] constexpr const T& operator[]( const std::size_t index ) const noexcept
+      {
+         return m_data[ index ];
+      }
+
+   private:
+      const T* m_data = nullptr;
+      std::uint32_t m_size = 0;
+   };
+
+   enum class field_type : std::uint8_t
+   {
+      defined_type,  // A message or enum, see type_name.
+      bool_type,
+      bytes_type,
+      double_type,
+      float_type,
+      string_type,
+      int32_type,
+      int64_type,
+      sint32_type,
+      sint64_type,
+      uint32_type,
+      uint64_type,
+      fixed32_type,
+      fixed64_type,
+      sfixed32_type,
+      sfixed64_type
+   };
+
+   enum class field_label : std::uint8_t
+   {
+      singular,
+      repeated,
+      map
+   };
+
+   struct option_descriptor
+   {
+      std::string_view name;  // As written, e.g. "(my.ext).x".
+      std::string_view value;  // As written, string literals with quotes.
+   };
+
+   struct message_descriptor;
+   struct enum_descriptor;
+
+   struct field_descriptor
+   {
+      static constexpr std::uint32_t no_oneof = std::numeric_limits< std::uint32_t >::max();
+
+      std::string_view name;
+      std::string_view type_name;  // As written, empty for builtin types.
+      std::uint32_t number = 0;
+      std::uint32_t oneof = no_oneof;  // Index into message_descriptor::oneofs.
+      field_type type = field_type::defined_type;
+      field_type key_type = field_type::defined_type;  // Only for maps.
+      field_label label = field_label::singular;
+      array< option_descriptor > options;
+
+      // The resolved defined_type, if any, set by descriptor_set::load().
+      mutable const message_descriptor* message_type = nullptr;
+      mutable const enum_descriptor* enum_type = nullptr;
+   };
+
+   struct enum_value_descriptor
+   {
+      std::string_view name;
+      std::int32_t number = 0;
+      array< option_descriptor > options;
+   };
+
+   struct enum_descriptor
+   {
+      std::string_view name;
+      std::string_view full_name;
+      array< enum_value_descriptor > values;
+      array< option_descriptor > options;
+   };
+
+   struct message_descriptor
+   {
+      std::string_view name;
+      std::string_view full_name;
+      array< field_descriptor > fields;
+      array< std::string_view > oneofs;
+      array< message_descriptor > messages;
+      array< enum_descriptor > enums;
+      array< option_descriptor > options;
+   };
+
+   struct method_descriptor
+   {
+      std::string_view name;
+      std::string_view input_type;  // As written.
+      std::string_view output_type;  // As written.
+      bool client_streaming = false;
+      bool server_streaming = false;
+      array< option_descriptor > options;
+
+      // Set by descriptor_set::load().
+      mutable const message_descriptor* input = nullptr;
+      mutable const message_descriptor* output = nullptr;
+   };
+
+   struct service_descriptor
+   {
+      std::string_view name;
+      std::string_view full_name;
+      array< method_descriptor > methods;
+      array< option_descriptor > options;
+   };
+
+   struct file_descriptor
+   {
+      std::string_view name;  // As given to, or imported via, descriptor_set::load().
+      std::string_view package;
+      array< std::string_view > imports;
+      array< message_descriptor > messages;
+      array< enum_descriptor > enums;
+      array< service_descriptor > services;
+      array< option_descriptor > options;
+
+      // The files of the imports that were loaded, set by descriptor_set::load().
+      mutable array< const file_descriptor* > dependencies;
+   };
+
+   // Thread-safe set of strings with stable storage; the strings are
+   // distributed over shards with their own lock and arena to keep
+   // contention low when many files are parsed at the same time.
+
+   class name_table
+   {
+   public:
+      name_table() = default;
+
+      name_table( const name_table& ) = delete;
+      name_table( name_table&& ) = delete;
+
+      ~name_table() = default;
+
+      name_table& operator=( const name_table& ) = delete;
+      name_table& operator=( name_table&& ) = delete;
+
+      [[nodiscard]] std::string_view intern( const std::string_view s )
+      {
+         const std::size_t h = std::hash< std::string_view >()( s );
+         auto& x = m_shards[ ( h >> 7 ) % shards ];
+         const std::lock_guard< std::mutex > lock( x.mutex );
+         if( const auto i = x.names.find( s ); i != x.names.end() ) {
+            return *i;
+         }
+         char* p = x.arena.allocate_array< char >( s.size() );
+         std::memcpy( p, s.data(), s.size() );
+         return *x.names.emplace( p, s.size() ).first;
+      }
+
+      [[nodiscard]] std::size_t size() const
+      {
+         std::size_t r = 0;
+         for( auto& x : m_shards ) {
+            const std::lock_guard< std::mutex > lock( x.mutex );
+            r += x.names.size();
+         }
+         return r;
+      }
+
+   private:
+      static constexpr std::size_t shards = 16;
+
+      struct shard
+      {
+         mutable std::mutex mutex;
+         std::unordered_set< std::string_view > names;
+         TAO_PEGTL_NAMESPACE::arena arena{ 16 * 1024 };
+      };
+
+      shard m_shards[ shards ];
+   };
+
+   class descriptor_set;
+
+   namespace internal
+   {
+      [[nodiscard]] inline field_type builtin( const std::string_view t ) noexcept
+      {
+         constexpr std::pair< std::string_view, field_type > types[] = {
+            { "bool", field_type::bool_type },
+            { "bytes", field_type::bytes_type },
+            { "double", field_type::double_type },
+            { "float", field_type::float_type },
+            { "string", field_type::string_type },
+            { "int32", field_type::int32_type },
+            { "int64", field_type::int64_type },
+            { "sint32", field_type::sint32_type },
+            { "sint64", field_type::sint64_type },
+            { "uint32", field_type::uint32_type },
+            { "uint64", field_type::uint64_type },
+            { "fixed32", field_type::fixed32_type },
+            { "fixed64", field_type::fixed64_type },
+            { "sfixed32", field_type::sfixed32_type },
+            { "sfixed64", field_type::sfixed64_type }
+         };
+         for( const auto& i : types ) {
+            if( i.first == t ) {
+               return i.second;
+            }
+         }
+         return field_type::defined_type;
+      }
+
+      [[nodiscard]] inline std::uint64_t int_value( std::string_view s ) noexcept
+      {
+         std::uint64_t r = 0;
+         unsigned base = 10;
+         if( ( s.size() > 1 ) && ( s[ 0 ] == '0' ) ) {
+            const bool hex = ( s[ 1 ] == 'x' ) || ( s[ 1 ] == 'X' );
+            base = hex ? 16 : 8;
+            s.remove_prefix( hex ? 2 : 1 );
+         }
+         for( const char c : s ) {
+            const unsigned d = ( c <= '9' ) ? unsigned( c - '0' ) : ( unsigned( c | 0x20 ) - 'a' + 10 );
+            r = ( r > ( std::numeric_limits< std::uint64_t >::max() - d ) / base ) ? std::numeric_limits< std::uint64_t >::max() : ( r * base + d );
+         }
+         return r;
+      }
+
+      // Builds the descriptors of the files parsed by one thread. Nested
+      // definitions are collected on stacks, when a definition is complete
+      // its part of the stacks is moved to the arena in one block.
+
+      class builder
+      {
+      public:
+         builder( name_table& names, const std::unordered_map< std::string, std::string >& paths ) noexcept
+            : m_names( names ),
+              m_paths( &paths )
+         {
+         }
+
+         [[nodiscard]] TAO_PEGTL_NAMESPACE::arena& arena() noexcept
+         {
+            return m_arena;
+         }
+
+         [[nodiscard]] const std::vector< const file_descriptor* >& files() const noexcept
+         {
+            return m_files;
+         }
+
+         template< typename Input >
+         [[nodiscard]] std::string_view intern( const Input& in )
+         {
+            return m_names.intern( std::string_view( in.begin(), in.size() ) );
+         }
+
+         template< typename T >
+         [[nodiscard]] array< T > take( std::vector< T >& v, const std::size_t mark )
+         {
+            const auto size = std::uint32_t( v.size() - mark );
+            if( size == 0 ) {
+               return array< T >();
+            }
+            T* data = m_arena.allocate_array< T >( size );
+            std::copy( v.begin() + std::ptrdiff_t( mark ), v.end(), data );
+            v.resize( mark );
+            return array< T >( data, size );
+         }
+
+         void begin_file()
+         {
+            m_frames.clear();
+            m_fields.clear();
+            m_oneofs.clear();
+            m_messages.clear();
+            m_enums.clear();
+            m_values.clear();
+            m_services.clear();
+            m_methods.clear();
+            m_options.clear();
+            m_item_options.clear();
+            m_imports.clear();
+            m_package = std::string_view();
+            m_frames.emplace_back( frame{ std::string_view(), std::string_view(), 0, 0, 0, 0, 0 } );
+         }
+
+         // The package can be declared anywhere at the top level; when it
+         // follows definitions their full names are qualified by end_file().
+
+         template< typename Input >
+         void set_package( const Input& in )
+         {
+            if( !m_package.empty() ) {
+               throw parse_error( "package must be declared only once", in );
+            }
+            m_package = intern( in );
+            if( m_messages.empty() && m_enums.empty() && m_services.empty() ) {
+               m_frames[ 0 ].full_name = m_package;
+            }
+         }
+
+         template< typename Input >
+         void add_import( const Input& in )
+         {
+            m_imports.emplace_back( m_names.intern( std::string_view( in.begin() + 1, in.size() - 2 ) ) );
+         }
+
+         template< typename Input >
+         void begin_message( const Input& in )
+         {
+            const auto name = intern( in );
+            m_frames.emplace_back( frame{ name, full_name( name ), m_fields.size(), m_oneofs.size(), m_messages.size(), m_enums.size(), m_options.size() } );
+         }
+
+         void end_message()
+         {
+            const frame f = m_frames.back();
+            m_frames.pop_back();
+            message_descriptor m;
+            m.name = f.name;
+            m.full_name = f.full_name;
+            m.fields = take( m_fields, f.fields );
+            m.oneofs = take( m_oneofs, f.oneofs );
+            m.messages = take( m_messages, f.messages );
+            m.enums = take( m_enums, f.enums );
+            m.options = take( m_options, f.options );
+            m_messages.emplace_back( m );
+         }
+
+         template< typename Input >
+         void begin_oneof( const Input& in )
+         {
+            m_oneof = std::uint32_t( m_oneofs.size() - m_frames.back().oneofs );
+            m_oneofs.emplace_back( intern( in ) );
+         }
+
+         template< typename Input >
+         void add_field( const Input& in, const field_label label, const std::uint32_t oneof )
+         {
+            if( ( m_number == 0 ) || ( m_number > 536870911 ) ) {
+               throw parse_error( "field number out of range", in );
+            }
+            field_descriptor d;
+            d.name = m_name;
+            d.type = m_type;
+            d.type_name = m_type_name;
+            d.key_type = m_key_type;
+            d.number = std::uint32_t( m_number );
+            d.oneof = oneof;
+            d.label = label;
+            d.options = take( m_item_options, 0 );
+            m_fields.emplace_back( d );
+            m_key_type = field_type::defined_type;
+         }
+
+         template< typename Input >
+         void begin_enum( const Input& in )
+         {
+            m_enum = enum_frame{ intern( in ), m_values.size(), m_options.size() };
+         }
+
+         template< typename Input >
+         void add_enum_value( const Input& in )
+         {
+            if( m_number > std::uint64_t( std::numeric_limits< std::int32_t >::max() ) + ( m_negative ? 1 : 0 ) ) {
+               throw parse_error( "enum value out of range", in );
+            }
+            enum_value_descriptor d;
+            d.name = m_name;
+            d.number = m_negative ? std::int32_t( -std::int64_t( m_number ) ) : std::int32_t( m_number );
+            d.options = take( m_item_options, 0 );
+            m_values.emplace_back( d );
+         }
+
+         void end_enum()
+         {
+            enum_descriptor d;
+            d.name = m_enum.name;
+            d.full_name = full_name( m_enum.name );
+            d.values = take( m_values, m_enum.values );
+            d.options = take( m_options, m_enum.options );
+            m_enums.emplace_back( d );
+         }
+
+         template< typename Input >
+         void begin_service( const Input& in )
+         {
+            m_service = service_frame{ intern( in ), m_methods.size(), m_options.size() };
+         }
+
+         template< typename Input >
+         void begin_method( const Input& in )
+         {
+            m_method = method_descriptor();
+            m_method.name = intern( in );
+            m_method_options = m_options.size();
+            m_stream = false;
+         }
+
+         void set_method_type( const bool output ) noexcept
+         {
+            ( output ? m_method.output_type : m_method.input_type ) = m_type_name;
+            ( output ? m_method.server_streaming : m_method.client_streaming ) = m_stream;
+            m_stream = false;
+         }
+
+         void end_method()
+         {
+            m_method.options = take( m_options, m_method_options );
+            m_methods.emplace_back( m_method );
+         }
+
+         void end_service()
+         {
+            service_descriptor d;
+            d.name = m_service.name;
+            d.full_name = full_name( m_service.name );
+            d.methods = take( m_methods, m_service.methods );
+            d.options = take( m_options, m_service.options );
+            m_services.emplace_back( d );
+         }
+
+         void add_option( const bool item )
+         {
+            ( item ? m_item_options : m_options ).emplace_back( option_descriptor{ m_option_name, m_option_value } );
+         }
+
+         template< typename Input >
+         void end_file( const Input& in )
+         {
+            auto* d = m_arena.allocate_array< file_descriptor >( 1 );
+            new( d ) file_descriptor();
+            const auto i = m_paths->find( in.input().source() );
+            d->name = m_names.intern( ( i != m_paths->end() ) ? i->second : in.input().source() );
+            if( m_frames[ 0 ].full_name != m_package ) {
+               for( auto& m : m_messages ) {
+                  qualify( m );
+               }
+               for( auto& e : m_enums ) {
+                  e.full_name = qualified( e.full_name );
+               }
+               for( auto& v : m_services ) {
+                  v.full_name = qualified( v.full_name );
+               }
+            }
+            d->package = m_package;
+            d->imports = take( m_imports, 0 );
+            d->messages = take( m_messages, 0 );
+            d->enums = take( m_enums, 0 );
+            d->services = take( m_services, 0 );
+            d->options = take( m_options, 0 );
+            m_files.emplace_back( d );
+         }
+
+         // Values of the rule that is currently being matched.
+
+         std::string_view m_name;
+         std::string_view m_type_name;
+         const char* m_type_begin = nullptr;  // Into the input.
+         bool m_stream = false;
+         field_type m_type = field_type::defined_type;
+         field_type m_key_type = field_type::defined_type;
+         std::uint64_t m_number = 0;
+         bool m_negative = false;
+         std::uint32_t m_oneof = 0;
+         std::string_view m_option_name;
+         std::string_view m_option_value;
+
+      private:
+         [[nodiscard]] std::string_view full_name( const std::string_view name )
+         {
+            const auto scope = m_frames.back().full_name;
+            if( scope.empty() ) {
+               return name;
+            }
+            m_buffer.assign( scope.data(), scope.size() );
+            m_buffer += '.';
+            m_buffer.append( name.data(), name.size() );
+            return m_names.intern( m_buffer );
+         }
+
+         [[nodiscard]] std::string_view qualified( const std::string_view name )
+         {
+            m_buffer.assign( m_package.data(), m_package.size() );
+            m_buffer += '.';
+            m_buffer.append( name.data(), name.size() );
+            return m_names.intern( m_buffer );
+         }
+
+         void qualify( message_descriptor& m )
+         {
+            m.full_name = qualified( m.full_name );
+            // The nested descriptors were allocated in m_arena by take().
+            for( const auto& n : m.messages ) {
+               qualify( const_cast< message_descriptor& >( n ) );
+            }
+            for( const auto& e : m.enums ) {
+               const_cast< enum_descriptor& >( e ).full_name = qualified( e.full_name );
+            }
+         }
+
+         struct frame
+         {
+            std::string_view name;
+            std::string_view full_name;
+            std::size_t fields;
+            std::size_t oneofs;
+            std::size_t messages;
+            std::size_t enums;
+            std::size_t options;
+         };
+
+         struct enum_frame
+         {
+            std::string_view name;
+            std::size_t values;
+            std::size_t options;
+         };
+
+         struct service_frame
+         {
+            std::string_view name;
+            std::size_t methods;
+            std::size_t options;
+         };
+
+         name_table& m_names;
+         const std::unordered_map< std::string, std::string >* m_paths;
+         TAO_PEGTL_NAMESPACE::arena m_arena;
+         std::string m_buffer;
+         std::string_view m_package;
+
+         std::vector< frame > m_frames;
+         enum_frame m_enum = {};
+         service_frame m_service = {};
+         method_descriptor m_method;
+         std::size_t m_method_options = 0;
+
+         std::vector< field_descriptor > m_fields;
+         std::vector< std::string_view > m_oneofs;
+         std::vector< message_descriptor > m_messages;
+         std::vector< enum_descriptor > m_enums;
+         std::vector< enum_value_descriptor > m_values;
+         std::vector< service_descriptor > m_services;
+         std::vector< method_descriptor > m_methods;
+         std::vector< option_descriptor > m_options;  // Of the enclosing definition or file.
+         std::vector< option_descriptor > m_item_options;  // Of the current field or enum value.
+         std::vector< std::string_view > m_imports;
+
+         std::vector< const file_descriptor* > m_files;
+      };
+
+      // Actions only store values of sub-rules in the builder, which might
+      // be overwritten after backtracking, and only the actions of complete
+      // definitions push to the stacks of the builder.
+
+      template< typename Rule >
+      struct action
+         : nothing< Rule >
+      {
+      };
+
+      template<>
+      struct action< head >
+      {
+         static void apply0( builder& b )
+         {
+            b.begin_file();
+         }
+      };
+
+      template<>
+      struct action< package_name >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            b.set_package( in );
+         }
+      };
+
+      template<>
+      struct action< import_name >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            b.add_import( in );
+         }
+      };
+
+      template<>
+      struct action< option_name >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            b.m_option_name = b.intern( in );
+         }
+      };
+
+      template<>
+      struct action< constant >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            b.m_option_value = b.intern( in );
+         }
+      };
+
+      template<>
+      struct action< proto3::option >
+      {
+         static void apply0( builder& b )
+         {
+            b.add_option( false );
+         }
+      };
+
+      template<>
+      struct action< field_option >
+      {
+         static void apply0( builder& b )
+         {
+            b.add_option( true );
+         }
+      };
+
+      template<>
+      struct action< enum_value_option >
+      {
+         static void apply0( builder& b )
+         {
+            b.add_option( true );
+         }
+      };
+
+      template<>
+      struct action< proto3::type >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            const std::string_view t( in.begin(), in.size() );
+            b.m_type = builtin( t );
+            b.m_type_begin = in.begin();
+            b.m_type_name = ( b.m_type == field_type::defined_type ) ? b.intern( in ) : std::string_view();
+         }
+      };
+
+      template<>
+      struct action< key_type >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            b.m_key_type = builtin( std::string_view( in.begin(), in.size() ) );
+         }
+      };
+
+      template<>
+      struct action< field_name >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            b.m_name = b.intern( in );
+         }
+      };
+
+      template<>
+      struct action< map_name >
+         : action< field_name >
+      {
+      };
+
+      template<>
+      struct action< enum_value_name >
+         : action< field_name >
+      {
+      };
+
+      template<>
+      struct action< field_number >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            b.m_number = int_value( std::string_view( in.begin(), in.size() ) );
+         }
+      };
+
+      template<>
+      struct action< enum_number >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            std::string_view s( in.begin(), in.size() );
+            b.m_negative = ( s[ 0 ] == '-' );
+            if( b.m_negative ) {
+               s.remove_prefix( s.find_first_of( "0123456789" ) );
+            }
+            b.m_number = int_value( s );
+         }
+      };
+
+      template<>
+      struct action< proto3::field >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            // The type starts later when the field is repeated.
+            b.add_field( in, ( b.m_type_begin != in.begin() ) ? field_label::repeated : field_label::singular, field_descriptor::no_oneof );
+         }
+      };
+
+      template<>
+      struct action< oneof_field >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            b.add_field( in, field_label::singular, b.m_oneof );
+         }
+      };
+
+      template<>
+      struct action< map_field >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            b.add_field( in, field_label::map, field_descriptor::no_oneof );
+         }
+      };
+
+      template<>
+      struct action< oneof_name >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            b.begin_oneof( in );
+         }
+      };
+
+      template<>
+      struct action< message_name >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            b.begin_message( in );
+         }
+      };
+
+      template<>
+      struct action< proto3::message >
+      {
+         static void apply0( builder& b )
+         {
+            b.end_message();
+         }
+      };
+
+      template<>
+      struct action< enum_name >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            b.begin_enum( in );
+         }
+      };
+
+      template<>
+      struct action< enum_field >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            b.add_enum_value( in );
+         }
+      };
+
+      template<>
+      struct action< enum_def >
+      {
+         static void apply0( builder& b )
+         {
+            b.end_enum();
+         }
+      };
+
+      template<>
+      struct action< service_name >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            b.begin_service( in );
+         }
+      };
+
+      template<>
+      struct action< rpc_name >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            b.begin_method( in );
+         }
+      };
+
+      template<>
+      struct action< rpc_stream >
+      {
+         static void apply0( builder& b ) noexcept
+         {
+            b.m_stream = true;
+         }
+      };
+
+      template<>
+      struct action< rpc_message >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            b.m_type_name = b.intern( in );
+         }
+      };
+
+      template<>
+      struct action< rpc_input >
+      {
+         static void apply0( builder& b ) noexcept
+         {
+            b.set_method_type( false );
+         }
+      };
+
+      template<>
+      struct action< rpc_output >
+      {
+         static void apply0( builder& b ) noexcept
+         {
+            b.set_method_type( true );
+         }
+      };
+
+      template<>
+      struct action< rpc >
+      {
+         static void apply0( builder& b )
+         {
+            b.end_method();
+         }
+      };
+
+      template<>
+      struct action< service >
+      {
+         static void apply0( builder& b )
+         {
+            b.end_service();
+         }
+      };
+
+      template<>
+      struct action< proto >
+      {
+         template< typename Input >
+         static void apply( const Input& in, builder& b )
+         {
+            b.end_file( in );
+         }
+      };
+
+      [[nodiscard]] inline bool file_exists( const std::string& path ) noexcept
+      {
+         std::FILE* f = std::fopen( path.c_str(), "rb" );  // NOLINT(cppcoreguidelines-owning-memory)
+         if( f != nullptr ) {
+            (void)std::fclose( f );  // NOLINT(cppcoreguidelines-owning-memory)
+            return true;
+         }
+         return false;
+      }
+
+   }  // namespace internal
+
+   struct load_error
+   {
+      std::string name;  // Of the file as given or imported.
+      std::exception_ptr exception;
+   };
+
+   // Loads .proto files and, transitively, the files they import, which
+   // are searched in the import paths given to the constructor like with
+   // the -I option of protoc. Every file is loaded only once, no matter
+   // how often it is imported or given to load().
+   //
+   // The files are parsed with parallel::parse_files(), every thread puts
+   // its descriptors in its own arena. When all files are loaded the type
+   // names of fields and methods are resolved as by protoc: the first
+   // component of a name is looked up from the innermost scope outwards,
+   // and the rest of the name only in the scope where it was found. Only
+   // packages, messages, enums and services are symbols for this lookup,
+   // protoc also finds e.g. fields, which never name an enclosing scope.
+
+   class descriptor_set
+   {
+   public:
+      explicit descriptor_set( std::vector< std::string > import_paths = {} )
+         : m_import_paths( std::move( import_paths ) )
+      {
+      }
+
+      descriptor_set( const descriptor_set& ) = delete;
+      descriptor_set( descriptor_set&& ) = delete;
+
+      ~descriptor_set() = default;
+
+      descriptor_set& operator=( const descriptor_set& ) = delete;
+      descriptor_set& operator=( descriptor_set&& ) = delete;
+
+      // Returns the files that could not be found or parsed; the other
+      // files are loaded even when some fail.
+
+      [[nodiscard]] std::vector< load_error > load( const std::vector< std::string >& names, const parallel::options& op = parallel::options() )
+      {
+         std::vector< load_error > errors;
+         std::vector< std::string > next;
+         for( const auto& n : names ) {
+            if( m_known.insert( n ).second ) {
+               next.emplace_back( n );
+            }
+         }
+         while( !next.empty() ) {
+            std::unordered_map< std::string, std::string > batch;
+            std::vector< std::string > paths;
+            for( auto& n : next ) {
+               const auto path = locate( n );
+               if( path.empty() ) {
+                  errors.push_back( { n, std::make_exception_ptr( std::runtime_error( "file not found: " + n ) ) } );
+               }
+               else if( batch.try_emplace( path, n ).second ) {
+                  paths.emplace_back( path );
+               }
+            }
+            auto r = parallel::parse_files< proto, internal::action >( paths, [ & ]() { return internal::builder( m_names, batch ); }, op );
+            for( auto& e : r.errors ) {
+               errors.push_back( { batch[ paths[ e.index ] ], std::move( e.exception ) } );
+            }
+            next.clear();
+            for( auto& b : r.states ) {
+               for( const auto* f : b.files() ) {
+                  m_files.emplace_back( f );
+                  m_files_by_name.try_emplace( f->name, f );
+                  for( const auto i : f->imports ) {
+                     if( m_known.emplace( i ).second ) {
+                        next.emplace_back( i );
+                     }
+                  }
+               }
+               m_arenas.emplace_back( std::move( b.arena() ) );
+            }
+         }
+         link();
+         return errors;
+      }
+
+      [[nodiscard]] const std::vector< const file_descriptor* >& files() const noexcept
+      {
+         return m_files;
+      }
+
+      [[nodiscard]] const file_descriptor* find_file( const std::string_view name ) const
+      {
+         const auto i = m_files_by_name.find( name );
+         return ( i != m_files_by_name.end() ) ? i->second : nullptr;
+      }
+
+      [[nodiscard]] const message_descriptor* find_message( const std::string_view full_name ) const
+      {
+         const auto i = m_symbols.find( full_name );
+         return ( i != m_symbols.end() ) ? i->second.message : nullptr;
+      }
+
+      [[nodiscard]] const enum_descriptor* find_enum( const std::string_view full_name ) const
+      {
+         const auto i = m_symbols.find( full_name );
+         return ( i != m_symbols.end() ) ? i->second.enumeration : nullptr;
+      }
+
+      [[nodiscard]] const service_descriptor* find_service( const std::string_view full_name ) const
+      {
+         const auto i = m_symbols.find( full_name );
+         return ( i != m_symbols.end() ) ? i->second.service : nullptr;
+      }
+
+      [[nodiscard]] name_table& names() noexcept
+      {
+         return m_names;
+      }
+
+   private:
+      struct symbol
+      {
+         const message_descriptor* message = nullptr;
+         const enum_descriptor* enumeration = nullptr;
+         const service_descriptor* service = nullptr;
+      };
+
+      [[nodiscard]] std::string locate( const std::string& name ) const
+      {
+         if( m_import_paths.empty() ) {
+            return internal::file_exists( name ) ? name : std::string();
+         }
+         for( const auto& p : m_import_paths ) {
+            std::string r = p.empty() ? name : ( p + '/' + name );
+            if( internal::file_exists( r ) ) {
+               return r;
+            }
+         }
+         return std::string();
+      }
+
+      void add_symbols( const message_descriptor& m )
+      {
+         m_symbols[ m.full_name ].message = &m;
+         for( const auto& e : m.enums ) {
+            m_symbols[ e.full_name ].enumeration = &e;
+         }
+         for( const auto& n : m.messages ) {
+            add_symbols( n );
+         }
+      }
+
+      void add_package( const std::string_view package )
+      {
+         for( std::size_t p = 0; p != std::string_view::npos; ) {
+            p = package.find( '.', p + 1 );
+            (void)m_symbols.try_emplace( package.substr( 0, p ) );
+         }
+      }
+
+      [[nodiscard]] const symbol* resolve( std::string_view scope, const std::string_view name )
+      {
+         if( name[ 0 ] == '.' ) {
+            const auto i = m_symbols.find( name.substr( 1 ) );
+            return ( i != m_symbols.end() ) ? &i->second : nullptr;
+         }
+         const auto first = name.substr( 0, name.find( '.' ) );
+         while( true ) {
+            m_buffer.assign( scope.data(), scope.size() );
+            if( !scope.empty() ) {
+               m_buffer += '.';
+            }
+            m_buffer.append( first.data(), first.size() );
+            if( const auto i = m_symbols.find( m_buffer ); i != m_symbols.end() ) {
+               if( first.size() == name.size() ) {
+                  return &i->second;
+               }
+               m_buffer.append( name.data() + first.size(), name.size() - first.size() );
+               const auto j = m_symbols.find( m_buffer );
+               return ( j != m_symbols.end() ) ? &j->second : nullptr;
+            }
+            if( scope.empty() ) {
+               return nullptr;
+            }
+            const auto p = scope.rfind( '.' );
+            scope = scope.substr( 0, ( p == std::string_view::npos ) ? 0 : p );
+         }
+      }
+
+      void resolve_fields( const message_descriptor& m )
+      {
+         for( const auto& f : m.fields ) {
+            if( f.type == field_type::defined_type ) {
+               if( const auto* s = resolve( m.full_name, f.type_name ) ) {
+                  f.message_type = s->message;
+                  f.enum_type = s->enumeration;
+               }
+            }
+         }
+         for( const auto& n : m.messages ) {
+            resolve_fields( n );
+         }
+      }
+
+      void link()
+      {
+         m_symbols.clear();
+         for( const auto* f : m_files ) {
+            if( !f->package.empty() ) {
+               add_package( f->package );
+            }
+            for( const auto& m : f->messages ) {
+               add_symbols( m );
+            }
+            for( const auto& e : f->enums ) {
+               m_symbols[ e.full_name ].enumeration = &e;
+            }
+            for( const auto& s : f->services ) {
+               m_symbols[ s.full_name ].service = &s;
+            }
+         }
+         for( const auto* f : m_files ) {
+            for( const auto& m : f->messages ) {
+               resolve_fields( m );
+            }
+            for( const auto& s : f->services ) {
+               for( const auto& x : s.methods ) {
+                  const auto* i = resolve( f->package, x.input_type );
+                  const auto* o = resolve( f->package, x.output_type );
+                  x.input = i ? i->message : nullptr;
+                  x.output = o ? o->message : nullptr;
+               }
+            }
+            if( f->dependencies.size() != f->imports.size() ) {
+               auto* d = m_link_arena.allocate_array< const file_descriptor* >( f->imports.size() );
+               std::uint32_t n = 0;
+               for( const auto i : f->imports ) {
+                  if( const auto* x = find_file( i ) ) {
+                     d[ n++ ] = x;
+                  }
+               }
+               f->dependencies = array< const file_descriptor* >( d, n );
+            }
+         }
+      }
+
+      std::vector< std::string > m_import_paths;
+      name_table m_names;
+      std::vector< TAO_PEGTL_NAMESPACE::arena > m_arenas;
+      TAO_PEGTL_NAMESPACE::arena m_link_arena;
+      std::string m_buffer;
+
+      std::unordered_set< std::string > m_known;
+      std::vector< const file_descriptor* > m_files;
+      std::unordered_map< std::string_view, const file_descriptor* > m_files_by_name;
+      std::unordered_map< std::string_view, symbol > m_symbols;
+   };
+
+}  // namespace TAO_PEGTL_NAMESPACE::proto3
+
+#endif
@@ -0,0 +1,398 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_REWRITE_HPP
+#define TAO_PEGTL_CONTRIB_REWRITE_HPP
+
+#include <array>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined( __unix__ ) || ( defined( __APPLE__ ) && defined( __MACH__ ) )
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include "../apply_mode.hpp"
+#include "../config.hpp"
+#include "../normal.hpp"
+#include "../nothing.hpp"
+#include "../rewind_mode.hpp"
+
+#include "../internal/seq.hpp"
+#include "../internal/skip_control.hpp"
+
+#include "search.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::rewrite
+{
+   // A contiguous part of the output, either a part of the input or a
+   // replacement. Sinks are called with up to output<>::max_spans spans
+   // at a time, the spans are only valid for the duration of the call.
+
+   struct span
+   {
+      const char* data;
+      std::size_t size;
+   };
+
+   class string_sink
+   {
+   public:
+      explicit string_sink( std::string& s ) noexcept
+         : m_string( s )
+      {
+      }
+
+      void operator()( const span* s, const std::size_t n ) const
+      {
+         for( std::size_t i = 0; i < n; ++i ) {
+            m_string.append( s[ i ].data, s[ i ].size );
+         }
+      }
+
+   private:
+      std::string& m_string;
+   };
+
+   class ostream_sink
+   {
+   public:
+      explicit ostream_sink( std::ostream& os ) noexcept
+         : m_stream( os )
+      {
+      }
+
+      void operator()( const span* s, const std::size_t n ) const
+      {
+         for( std::size_t i = 0; i < n; ++i ) {
+            m_stream.write( s[ i ].data, std::streamsize( s[ i ].size ) );
+         }
+      }
+
+   private:
+      std::ostream& m_stream;
+   };
+
+#if defined( _POSIX_VERSION )
+
+   // Writes all spans of a batch with one writev() call, unless the file
+   // descriptor accepts less; throws std::system_error on errors, and
+   // when writev() returns 0.
+
+   class fd_sink
+   {
+   public:
+      explicit fd_sink( const int fd ) noexcept
+         : m_fd( fd )
+      {
+      }
+
+      void operator()( const span* s, const std::size_t n ) const
+      {
+         ::iovec v[ 64 ];
+         std::size_t i = 0;
+         while( i != n ) {
+            std::size_t k = 0;
+            for( ; ( k < 64 ) && ( i + k != n ); ++k ) {
+               v[ k ].iov_base = const_cast< char* >( s[ i + k ].data );
+               v[ k ].iov_len = s[ i + k ].size;
+            }
+            std::size_t j = 0;
+            while( j != k ) {
+               const auto r = ::writev( m_fd, v + j, int( k - j ) );
+               if( r < 0 ) {
+                  if( errno == EINTR ) {
+                     continue;
+                  }
+                  const auto ec = errno;
+                  throw std::system_error( ec, std::system_category(), "writev() failed" );
+               }
+               if( r == 0 ) {
+                  // Nothing written for a non-empty batch, retrying would never end.
+                  throw std::system_error( std::make_error_code( std::errc::io_error ), "writev() wrote nothing" );
+               }
+               // Skip the fully written spans and adjust the first partially written one.
+               auto w = std::size_t( r );
+               while( ( j != k ) && ( w >= v[ j ].iov_len ) ) {
+                  w -= v[ j++ ].iov_len;
+               }
+               if( j != k ) {
+                  v[ j ].iov_base = static_cast< char* >( v[ j ].iov_base ) + w;
+                  v[ j ].iov_len -= w;
+               }
+            }
+            i += k;
+         }
+      }
+
+   private:
+      int m_fd;
+   };
+
+#endif
+
+   // Collects the output of a transformation of an input as a sequence of
+   // spans. Everything between the replaced parts of the input is passed
+   // through as spans of the input, replacements are copied to a buffer
+   // (or passed on directly when they are large). The spans are passed to
+   // the sink in batches; the input must remain valid until finish().
+   // Between stage() and commit() the replacements are only recorded, and
+   // discard() drops them again; transform() uses this to apply only the
+   // replacements made during successful matches of its rule.
+
+   template< typename Sink >
+   class output
+   {
+   public:
+      static constexpr std::size_t max_spans = 64;
+      static constexpr std::size_t buffer_size = 16384;
+
+      output( const char* in_begin, Sink sink )
+         : m_next( in_begin ),
+           m_sink( std::move( sink ) ),
+           m_buffer( new char[ buffer_size ] )
+      {
+      }
+
+      output( const output& ) = delete;
+      output( output&& ) = delete;
+
+      ~output() = default;
+
+      void operator=( const output& ) = delete;
+      void operator=( output&& ) = delete;
+
+      // Replaces the input [ b, e ) with r; replacements must not overlap
+      // and must be made in the order of the input. An empty r erases,
+      // and b == e inserts.
+
+      void replace( const char* b, const char* e, const std::string_view r )
+      {
+         if( m_staging ) {
+            assert( ( ( m_staged.empty() ? m_next : m_staged.back().end ) <= b ) && ( b <= e ) );
+            m_staged.push_back( staged{ b, e, m_text.size(), r.size() } );
+            m_text.append( r );
+         }
+         else {
+            apply( b, e, r );
+         }
+      }
+
+      template< typename ActionInput >
+      void replace( const ActionInput& in, const std::string_view r )
+      {
+         replace( in.begin(), in.end(), r );
+      }
+
+      template< typename ActionInput >
+      void erase( const ActionInput& in )
+      {
+         replace( in.begin(), in.end(), std::string_view() );
+      }
+
+      void stage() noexcept
+      {
+         assert( m_staged.empty() );
+         m_staging = true;
+      }
+
+      void commit()
+      {
+         m_staging = false;
+         for( const auto& t : m_staged ) {
+            apply( t.begin, t.end, std::string_view( m_text.data() + t.offset, t.size ) );
+         }
+         discard();
+      }
+
+      void discard() noexcept
+      {
+         m_staging = false;
+         m_staged.clear();
+         m_text.clear();
+      }
+
+      // Passes through the rest of the input up to in_end, and flushes.
+
+      void finish( const char* in_end )
+      {
+         assert( !m_staging && ( m_next <= in_end ) );
+         keep( m_next, in_end );
+         m_next = in_end;
+         flush();
+      }
+
+      void flush()
+      {
+         if( m_count != 0 ) {
+            m_sink( m_spans.data(), m_count );
+            m_count = 0;
+         }
+         m_used = 0;
+      }
+
+      // The number of bytes of output so far, and the number of those
+      // that are replacements.
+
+      [[nodiscard]] std::size_t size() const noexcept
+      {
+         return m_size;
+      }
+
+      [[nodiscard]] std::size_t replaced() const noexcept
+      {
+         return m_replaced;
+      }
+
+   private:
+      struct staged
+      {
+         const char* begin;
+         const char* end;
+         std::size_t offset;
+         std::size_t size;
+      };
+
+      void apply( const char* b, const char* e, const std::string_view r )
+      {
+         assert( ( m_next <= b ) && ( b <= e ) );
+         keep( m_next, b );
+         append( r );
+         m_next = e;
+      }
+
+      void push( const char* p, const std::size_t n )
+      {
+         m_size += n;
+         if( m_count != 0 ) {
+            span& l = m_spans[ m_count - 1 ];
+            if( l.data + l.size == p ) {
+               l.size += n;
+               return;
+            }
+         }
+         if( m_count == max_spans ) {
+            flush();
+         }
+         m_spans[ m_count++ ] = span{ p, n };
+      }
+
+      void keep( const char* b, const char* e )
+      {
+         if( b != e ) {
+            push( b, std::size_t( e - b ) );
+         }
+      }
+
+      void append( const std::string_view r )
+      {
+         if( r.empty() ) {
+            return;
+         }
+         m_replaced += r.size();
+         if( r.size() > buffer_size ) {
+            push( r.data(), r.size() );
+            flush();
+            return;
+         }
+         // Flushing reuses the buffer, and must therefore not happen
+         // between copying and pushing.
+         if( ( r.size() > buffer_size - m_used ) || ( m_count == max_spans ) ) {
+            flush();
+         }
+         char* const p = m_buffer.get() + m_used;
+         std::memcpy( p, r.data(), r.size() );
+         m_used += r.size();
+         push( p, r.size() );
+      }
+
+      const char* m_next;
+      Sink m_sink;
+      std::unique_ptr< char[] > m_buffer;
+      std::size_t m_used = 0;
+      std::size_t m_count = 0;
+      std::size_t m_size = 0;
+      std::size_t m_replaced = 0;
+      std::array< span, max_spans > m_spans;
+      bool m_staging = false;
+      std::vector< staged > m_staged;
+      std::string m_text;
+   };
+
+   namespace internal
+   {
+      // Matches Rule with the replacements staged, i.e. they are only
+      // applied when Rule succeeds; the output is the first state.
+
+      template< typename Rule >
+      struct staged
+         : TAO_PEGTL_NAMESPACE::internal::seq< Rule >
+      {
+         template< apply_mode A,
+                   rewind_mode M,
+                   template< typename... >
+                   class Action,
+                   template< typename... >
+                   class Control,
+                   typename Input,
+                   typename Output,
+                   typename... States >
+         [[nodiscard]] static bool match( Input& in, Output& out, States&&... st )
+         {
+            out.stage();
+            if( Control< Rule >::template match< A, M, Action, Control >( in, out, st... ) ) {
+               out.commit();
+               return true;
+            }
+            out.discard();
+            return false;
+         }
+      };
+
+   }  // namespace internal
+
+   // Copies the input from the current position to the end to the sink,
+   // except for the matches of Rule, which are found with search(). The
+   // actions are called with the output as first state and can replace
+   // or erase the matched parts of the input (or parts of them) with
+   // output::replace() and output::erase(); matches without replacement
+   // are passed through. The replacements made during an attempt to match
+   // Rule are discarded when the attempt fails, however within a successful
+   // match the actions of failed sub-rules are applied as usual. Returns
+   // the number of matches.
+
+   template< typename Rule,
+             template< typename... > class Action = nothing,
+             template< typename... > class Control = normal,
+             typename Input,
+             typename Sink,
+             typename... States >
+   std::size_t transform( Input& in, Sink&& sink, States&&... st )
+   {
+      output< std::decay_t< Sink > > out( in.current(), std::forward< Sink >( sink ) );
+      const std::size_t r = search< internal::staged< Rule >, Action, Control >( in, []( const auto& /*unused*/ ) {}, out, st... );
+      out.finish( in.end() );
+      return r;
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE::rewrite
+
+namespace TAO_PEGTL_NAMESPACE::internal
+{
+   template< typename Rule >
+   inline constexpr bool skip_control< rewrite::internal::staged< Rule > > = true;
+
+}  // namespace TAO_PEGTL_NAMESPACE::internal
+
+#endif
@@ -0,0 +1,515 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_SEARCH_HPP
+#define TAO_PEGTL_CONTRIB_SEARCH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include "../apply_mode.hpp"
+#include "../config.hpp"
+#include "../normal.hpp"
+#include "../nothing.hpp"
+#include "../rewind_mode.hpp"
+
+#include "../internal/any.hpp"
+#include "../internal/eol.hpp"
+#include "../internal/fast_path.hpp"
+#include "../internal/if_must.hpp"
+#include "../internal/istring.hpp"
+#include "../internal/must.hpp"
+#include "../internal/one.hpp"
+#include "../internal/peek_char.hpp"
+#include "../internal/range.hpp"
+#include "../internal/ranges.hpp"
+#include "../internal/result_on_found.hpp"
+#include "../internal/seq.hpp"
+#include "../internal/simd.hpp"
+#include "../internal/string.hpp"
+#include "../internal/trivial.hpp"
+
+#include "../analysis/rule_list.hpp"
+#include "../analysis/rule_type.hpp"
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   namespace internal
+   {
+      // The set of bytes that a successful match of a rule can start with,
+      // and whether the rule can succeed without consuming input. Sets are
+      // supersets, rules that are not known are assumed to start with any
+      // byte.
+
+      struct search_set
+      {
+         std::uint64_t bits[ 4 ] = { 0, 0, 0, 0 };
+         bool nullable = false;
+
+         [[nodiscard]] static constexpr search_set all( const bool n ) noexcept
+         {
+            search_set r;
+            for( auto& b : r.bits ) {
+               b = ~std::uint64_t( 0 );
+            }
+            r.nullable = n;
+            return r;
+         }
+
+         [[nodiscard]] static constexpr search_set none( const bool n ) noexcept
+         {
+            search_set r;
+            r.nullable = n;
+            return r;
+         }
+
+         [[nodiscard]] static constexpr search_set of( const unsigned char lo, const unsigned char hi, const bool complement = false ) noexcept
+         {
+            search_set r;
+            for( unsigned c = 0; c < 256; ++c ) {
+               if( ( ( lo <= c ) && ( c <= hi ) ) != complement ) {
+                  r.bits[ c / 64 ] |= std::uint64_t( 1 ) << ( c % 64 );
+               }
+            }
+            return r;
+         }
+
+         [[nodiscard]] constexpr bool contains( const unsigned c ) const noexcept
+         {
+            return ( bits[ c / 64 ] & ( std::uint64_t( 1 ) << ( c % 64 ) ) ) != 0;
+         }
+
+         [[nodiscard]] constexpr std::size_t count() const noexcept
+         {
+            std::size_t r = 0;
+            for( unsigned c = 0; c < 256; ++c ) {
+               r += contains( c );
+            }
+            return r;
+         }
+
+         [[nodiscard]] constexpr unsigned min() const noexcept
+         {
+            unsigned c = 0;
+            while( ( c < 256 ) && !contains( c ) ) {
+               ++c;
+            }
+            return c;
+         }
+
+         // The number of maximal ranges of consecutive bytes, and the
+         // first and last byte of the i-th range.
+
+         [[nodiscard]] constexpr std::size_t ranges( const bool complement = false ) const noexcept
+         {
+            std::size_t r = 0;
+            for( unsigned c = 0; c < 256; ++c ) {
+               r += ( contains( c ) != complement ) && ( ( c == 0 ) || ( contains( c - 1 ) == complement ) );
+            }
+            return r;
+         }
+
+         [[nodiscard]] constexpr unsigned char lo( const std::size_t i, const bool complement = false ) const noexcept
+         {
+            std::size_t r = 0;
+            for( unsigned c = 0; c < 256; ++c ) {
+               if( ( contains( c ) != complement ) && ( ( c == 0 ) || ( contains( c - 1 ) == complement ) ) && ( r++ == i ) ) {
+                  return static_cast< unsigned char >( c );
+               }
+            }
+            return 0;
+         }
+
+         [[nodiscard]] constexpr unsigned char hi( const std::size_t i, const bool complement = false ) const noexcept
+         {
+            unsigned c = lo( i, complement );
+            while( ( c < 255 ) && ( contains( c + 1 ) != complement ) ) {
+               ++c;
+            }
+            return static_cast< unsigned char >( c );
+         }
+
+         [[nodiscard]] constexpr search_set operator|( const search_set& o ) const noexcept
+         {
+            search_set r;
+            for( unsigned i = 0; i < 4; ++i ) {
+               r.bits[ i ] = bits[ i ] | o.bits[ i ];
+            }
+            r.nullable = nullable || o.nullable;
+            return r;
+         }
+      };
+
+      // Leaf rules are recognised by their (internal) base class, all other
+      // rules are analysed through their analyze_t.
+
+      template< result_on_found R, char... Cs >
+      [[nodiscard]] constexpr search_set search_first_of( const one< R, peek_char, Cs... >* /*unused*/ ) noexcept
+      {
+         return ( search_set::none( false ) | ... | search_set::of( static_cast< unsigned char >( Cs ), static_cast< unsigned char >( Cs ), R == result_on_found::failure ) );
+      }
+
+      template< result_on_found R, char Lo, char Hi >
+      [[nodiscard]] constexpr search_set search_first_of( const range< R, peek_char, Lo, Hi >* /*unused*/ ) noexcept
+      {
+         return search_set::of( static_cast< unsigned char >( Lo ), static_cast< unsigned char >( Hi ), R == result_on_found::failure );
+      }
+
+      template< char... Cs >
+      [[nodiscard]] constexpr search_set search_first_of( const ranges< peek_char, Cs... >* /*unused*/ ) noexcept
+      {
+         constexpr char d[] = { Cs..., 0 };
+         search_set r = search_set::none( false );
+         for( std::size_t i = 0; i < sizeof...( Cs ); i += 2 ) {
+            const auto lo = static_cast< unsigned char >( d[ i ] );
+            r = r | search_set::of( lo, ( i + 1 < sizeof...( Cs ) ) ? static_cast< unsigned char >( d[ i + 1 ] ) : lo );
+         }
+         return r;
+      }
+
+      [[nodiscard]] constexpr search_set search_first_of( const any< peek_char >* /*unused*/ ) noexcept
+      {
+         return search_set::all( false );
+      }
+
+      template< char C, char... Cs >
+      [[nodiscard]] constexpr search_set search_first_of( const string< C, Cs... >* /*unused*/ ) noexcept
+      {
+         return search_set::of( static_cast< unsigned char >( C ), static_cast< unsigned char >( C ) );
+      }
+
+      template< char C, char... Cs >
+      [[nodiscard]] constexpr search_set search_first_of( const istring< C, Cs... >* /*unused*/ ) noexcept
+      {
+         const auto c = static_cast< unsigned char >( C );
+         const auto d = static_cast< unsigned char >( ( ( 'a' <= C ) && ( C <= 'z' ) ) ? ( C - 'a' + 'A' ) : ( ( ( 'A' <= C ) && ( C <= 'Z' ) ) ? ( C - 'A' + 'a' ) : C ) );
+         return search_set::of( c, c ) | search_set::of( d, d );
+      }
+
+      template< bool Result >
+      [[nodiscard]] constexpr search_set search_first_of( const trivial< Result >* /*unused*/ ) noexcept
+      {
+         return search_set::none( Result );
+      }
+
+      [[nodiscard]] constexpr search_set search_first_of( const eol* /*unused*/ ) noexcept
+      {
+         return search_set::of( '\n', '\n' ) | search_set::of( '\r', '\r' );
+      }
+
+      template< typename Rule, typename = void >
+      struct search_first;
+
+      template< typename Rules >
+      struct search_first_seq;
+
+      template<>
+      struct search_first_seq< analysis::rule_list<> >
+      {
+         static constexpr search_set value = search_set::none( true );
+      };
+
+      template< typename Rule, typename... Rules >
+      struct search_first_seq< analysis::rule_list< Rule, Rules... > >
+      {
+         [[nodiscard]] static constexpr search_set compute() noexcept
+         {
+            constexpr search_set f = search_first< Rule >::value;
+            if constexpr( f.nullable ) {
+               search_set r = f | search_first_seq< analysis::rule_list< Rules... > >::value;
+               r.nullable = search_first_seq< analysis::rule_list< Rules... > >::value.nullable;
+               return r;
+            }
+            else {
+               return f;
+            }
+         }
+
+         static constexpr search_set value = compute();
+      };
+
+      template< typename Rules >
+      struct search_first_sor;
+
+      template< typename... Rules >
+      struct search_first_sor< analysis::rule_list< Rules... > >
+      {
+         static constexpr search_set value = ( search_set::none( false ) | ... | search_first< Rules >::value );
+      };
+
+      template< typename Rule, typename >
+      struct search_first
+      {
+         using analyze_t = typename Rule::analyze_t;
+         using rules_t = typename analyze_t::rules_t;
+
+         [[nodiscard]] static constexpr search_set compute() noexcept
+         {
+            if constexpr( std::is_same_v< rules_t, analysis::rule_list<> > ) {
+               return search_set::all( analyze_t::type_v != analysis::rule_type::any );
+            }
+            else if constexpr( analyze_t::type_v == analysis::rule_type::seq ) {
+               return search_first_seq< rules_t >::value;
+            }
+            else if constexpr( analyze_t::type_v == analysis::rule_type::sor ) {
+               return search_first_sor< rules_t >::value;
+            }
+            else if constexpr( analyze_t::type_v == analysis::rule_type::opt ) {
+               return search_set::none( true ) | search_first_seq< rules_t >::value;
+            }
+            else {
+               return search_set::all( false );
+            }
+         }
+
+         static constexpr search_set value = compute();
+      };
+
+      template< typename Rule >
+      struct search_first< Rule, std::void_t< decltype( search_first_of( static_cast< const Rule* >( nullptr ) ) ) > >
+      {
+         static constexpr search_set value = search_first_of( static_cast< const Rule* >( nullptr ) );
+      };
+
+      template< typename Rule >
+      inline constexpr search_set search_first_v = search_first< Rule >::value;
+
+      // The literal that every successful match of a rule starts with, and
+      // whether the rule matches exactly this literal. Only sequences of
+      // strings and single characters are considered.
+
+      template< bool Complete, char... Cs >
+      struct search_literal
+      {
+         static constexpr bool complete = Complete;
+         static constexpr std::size_t size = sizeof...( Cs );
+      };
+
+      template< bool Complete, char C, char... Cs >
+      struct search_literal< Complete, C, Cs... >
+      {
+         static constexpr bool complete = Complete;
+         static constexpr std::size_t size = 1 + sizeof...( Cs );
+         static constexpr char data[ size ] = { C, Cs... };
+
+         // Returns the first occurrence in [ p, e ), or e. Candidates are
+         // positions where both the first and the last character of the
+         // literal are found, 64 at a time.
+
+         [[nodiscard]] static const char* find( const char* p, const char* e ) noexcept
+         {
+            using block = simd::block64;
+            constexpr char last = data[ size - 1 ];
+            while( e - p >= std::ptrdiff_t( size - 1 + block::size ) ) {
+               for( std::uint64_t m = block( p ).eq< C >() & block( p + size - 1 ).eq< last >(); m != 0; m &= m - 1 ) {
+                  const char* q = p + simd::ctz64( m );
+                  if( std::memcmp( q + 1, data + 1, size - 2 ) == 0 ) {
+                     return q;
+                  }
+               }
+               p += block::size;
+            }
+            for( ; e - p >= std::ptrdiff_t( size ); ++p ) {
+               if( ( *p == C ) && ( std::memcmp( p + 1, data + 1, size - 1 ) == 0 ) ) {
+                  return p;
+               }
+            }
+            return e;
+         }
+      };
+
+      template< typename Literal, char... Cs >
+      struct search_literal_append;
+
+      template< bool Complete, char... Ls, char... Cs >
+      struct search_literal_append< search_literal< Complete, Ls... >, Cs... >
+      {
+         using type = search_literal< Complete, Cs..., Ls... >;
+      };
+
+      template< typename Literal, typename... Rules >
+      struct search_literal_seq
+      {
+         using type = Literal;
+      };
+
+      template< typename Rule >
+      struct search_literal_of;
+
+      template< char... Cs, typename Rule, typename... Rules >
+      struct search_literal_seq< search_literal< true, Cs... >, Rule, Rules... >
+      {
+         using type = typename search_literal_seq< typename search_literal_append< typename search_literal_of< Rule >::type, Cs... >::type, Rules... >::type;
+      };
+
+      template< char... Cs >
+      search_literal< true, Cs... > search_literal_select( const string< Cs... >* );
+
+      template< char C >
+      search_literal< true, C > search_literal_select( const one< result_on_found::success, peek_char, C >* );
+
+      template< typename... Rules >
+      search_literal_seq< search_literal< true >, Rules... > search_literal_select( const seq< Rules... >* );
+
+      template< typename... Rules >
+      search_literal_seq< search_literal< true >, Rules... > search_literal_select( const must< Rules... >* );
+
+      template< typename Cond, typename... Rules >
+      search_literal_seq< search_literal< true >, Cond, must< Rules... > > search_literal_select( const if_must< false, Cond, Rules... >* );
+
+      search_literal< false > search_literal_select( const void* );
+
+      template< typename T >
+      struct search_literal_type
+      {
+         using type = typename T::type;
+      };
+
+      template< bool Complete, char... Cs >
+      struct search_literal_type< search_literal< Complete, Cs... > >
+      {
+         using type = search_literal< Complete, Cs... >;
+      };
+
+      template< typename Rule >
+      struct search_literal_of
+      {
+         using type = typename search_literal_type< decltype( search_literal_select( static_cast< const Rule* >( nullptr ) ) ) >::type;
+      };
+
+      template< typename Rule >
+      using search_literal_t = typename search_literal_of< Rule >::type;
+
+      // Finds the next position where a match of Rule can start. Sets of
+      // up to 8 ranges (or whose complement has up to 8 ranges) classify
+      // the input 64 bytes at a time; the candidates of the last block are
+      // kept because the next search usually starts in the same block.
+
+      template< typename Rule >
+      class search_filter
+      {
+      public:
+         static constexpr search_set first = search_first_v< Rule >;
+         static constexpr bool nullable = first.nullable;
+
+         using literal_t = search_literal_t< Rule >;
+
+         [[nodiscard]] const char* find( const char* p, const char* e ) noexcept
+         {
+            if constexpr( nullable || ( first.count() == 256 ) ) {
+               return p;
+            }
+            else if constexpr( first.count() == 0 ) {
+               return e;
+            }
+            else if constexpr( literal_t::size >= 2 ) {
+               return literal_t::find( p, e );
+            }
+            else if constexpr( first.count() == 1 ) {
+               const auto* q = static_cast< const char* >( std::memchr( p, int( first.min() ), std::size_t( e - p ) ) );
+               return ( q != nullptr ) ? q : e;
+            }
+            else if constexpr( ( first.ranges() <= 8 ) || ( first.ranges( true ) <= 8 ) ) {
+               using block = simd::block64;
+               if( p == e ) {
+                  return e;
+               }
+               while( true ) {
+                  if( ( m_base == nullptr ) || ( p - m_base >= std::ptrdiff_t( block::size ) ) ) {
+                     const auto n = std::min( std::size_t( e - p ), block::size );
+                     m_base = p;
+                     m_mask = classify( ( n == block::size ) ? block( p ) : block( p, n ) ) & ( ~std::uint64_t( 0 ) >> ( block::size - n ) );
+                  }
+                  else {
+                     m_mask &= ~std::uint64_t( 0 ) << ( p - m_base );
+                  }
+                  if( m_mask != 0 ) {
+                     return m_base + simd::ctz64( m_mask );
+                  }
+                  if( e - m_base <= std::ptrdiff_t( block::size ) ) {
+                     return e;
+                  }
+                  p = m_base + block::size;
+               }
+            }
+            else {
+               while( ( p != e ) && !first.contains( static_cast< unsigned char >( *p ) ) ) {
+                  ++p;
+               }
+               return p;
+            }
+         }
+
+      private:
+         template< bool Complement, std::size_t... Is >
+         [[nodiscard]] static std::uint64_t classify( const simd::block64& b, std::index_sequence< Is... > /*unused*/ ) noexcept
+         {
+            return ( std::uint64_t( 0 ) | ... | b.in_range< first.lo( Is, Complement ), first.hi( Is, Complement ) >() );
+         }
+
+         [[nodiscard]] static std::uint64_t classify( const simd::block64& b ) noexcept
+         {
+            if constexpr( first.ranges() <= first.ranges( true ) ) {
+               return classify< false >( b, std::make_index_sequence< first.ranges() >() );
+            }
+            else {
+               return ~classify< true >( b, std::make_index_sequence< first.ranges( true ) >() );
+            }
+         }
+
+         const char* m_base = nullptr;
+         std::uint64_t m_mask = 0;
+      };
+
+   }  // namespace internal
+
+   // Finds all non-overlapping matches of Rule in a memory input, from the
+   // current position to the end, and calls f with an action input for the
+   // matched part of the input. Like until< Rule > or star< sor< Rule, any > >,
+   // but the set of bytes that a match can start with, or a literal that it
+   // must start with, is derived from the grammar and used to skip to the
+   // next candidate position with memchr() or 64 bytes at a time. Actions
+   // are applied, global errors are propagated. Returns the number of matches.
+
+   template< typename Rule,
+             template< typename... > class Action = nothing,
+             template< typename... > class Control = normal,
+             typename Input,
+             typename F,
+             typename... States >
+   std::size_t search( Input& in, F&& f, States&&... st )
+   {
+      static_assert( internal::is_memory_input_v< Input >, "search() requires a memory input" );
+
+      internal::search_filter< Rule > filter;
+      std::size_t r = 0;
+      while( true ) {
+         const char* const c = in.current();
+         const char* const p = filter.find( c, in.end() );
+         if( ( p == in.end() ) && !filter.nullable ) {
+            in.bump( std::size_t( p - c ) );
+            return r;
+         }
+         in.bump( std::size_t( p - c ) );
+         const auto b = in.iterator();
+         if( Control< Rule >::template match< apply_mode::action, rewind_mode::required, Action, Control >( in, st... ) ) {
+            ++r;
+            const typename Input::action_t a( b, in );
+            f( static_cast< const typename Input::action_t& >( a ) );
+            if( in.current() != p ) {
+               continue;
+            }
+         }
+         if( p == in.end() ) {
+            return r;
+         }
+         in.bump( 1 );
+      }
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#endif
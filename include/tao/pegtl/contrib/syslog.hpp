@@ -0,0 +1,374 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_SYSLOG_HPP
+#define TAO_PEGTL_CONTRIB_SYSLOG_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../ascii.hpp"
+#include "../config.hpp"
+#include "../memory_input.hpp"
+#include "../nothing.hpp"
+#include "../parse.hpp"
+#include "../rules.hpp"
+#include "../tracking_mode.hpp"
+
+#include "../analysis/generic.hpp"
+#include "../internal/escaped_string.hpp"
+#include "../internal/skip_control.hpp"
+
+#include "timestamp.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::syslog
+{
+   // Syslog messages as per RFC 5424, one per line; the rules require a
+   // memory input. The timestamp is matched with timestamp::rfc3339,
+   // which also accepts lower-case 't' and 'z' and longer fractions. The
+   // function parse() fills a structure with views into the line.
+
+   namespace internal
+   {
+      // Bit 0 for PRINTUSASCII, bit 1 for the subset allowed in SD-NAME.
+
+      struct char_table
+      {
+         unsigned char table[ 256 ] = {};
+
+         constexpr char_table() noexcept
+         {
+            for( unsigned c = 33; c < 127; ++c ) {
+               table[ c ] = ( ( c == '=' ) || ( c == ']' ) || ( c == '"' ) ) ? 1 : 3;
+            }
+         }
+      };
+
+      inline constexpr char_table chars{};
+
+      template< bool Name >
+      [[nodiscard]] const char* field_end( const char* p, const char* e ) noexcept
+      {
+         while( ( p != e ) && ( chars.table[ static_cast< unsigned char >( *p ) ] & ( Name ? 2 : 1 ) ) ) {
+            ++p;
+         }
+         return p;
+      }
+
+      // Matches 1 to Maximum bytes up to field_end(), and fails when there
+      // are more.
+
+      template< bool Name, std::size_t Maximum >
+      struct field
+      {
+         using analyze_t = analysis::generic< analysis::rule_type::any >;
+
+         template< typename Input >
+         [[nodiscard]] static bool match( Input& in ) noexcept( noexcept( in.end() ) )
+         {
+            const char* const b = in.current();
+            const auto n = std::size_t( field_end< Name >( b, b + std::min( std::size_t( in.end() - b ), Maximum + 1 ) ) - b );
+            if( ( n == 0 ) || ( n > Maximum ) ) {
+               return false;
+            }
+            in.bump_in_this_line( n );
+            return true;
+         }
+      };
+
+      // PRIVAL, a number from 0 to 191 with at most three digits.
+
+      struct prival
+      {
+         using analyze_t = analysis::generic< analysis::rule_type::any >;
+
+         template< typename Input >
+         [[nodiscard]] static bool match( Input& in ) noexcept( noexcept( in.end() ) )
+         {
+            const char* const b = in.current();
+            const char* const e = b + std::min( std::ptrdiff_t( in.end() - b ), std::ptrdiff_t( 4 ) );
+            const char* p = b;
+            unsigned v = 0;
+            for( ; ( p != e ) && ( unsigned( std::uint8_t( *p ) - '0' ) < 10 ); ++p ) {
+               v = v * 10 + unsigned( *p - '0' );
+            }
+            if( ( p == b ) || ( p - b > 3 ) || ( v > 191 ) ) {
+               return false;
+            }
+            in.bump_in_this_line( std::size_t( p - b ) );
+            return true;
+         }
+      };
+
+      [[nodiscard]] inline const char* line_end( const char* p, const char* e ) noexcept
+      {
+         const void* n = std::memchr( p, '\n', std::size_t( e - p ) );
+         return n ? static_cast< const char* >( n ) : e;
+      }
+
+      template< const char* ( *End )( const char*, const char* ) noexcept >
+      struct scan
+      {
+         using analyze_t = analysis::generic< analysis::rule_type::opt >;
+
+         template< typename Input >
+         [[nodiscard]] static bool match( Input& in ) noexcept( noexcept( in.end() ) )
+         {
+            in.bump_in_this_line( std::size_t( End( in.current(), in.end() ) - in.current() ) );
+            return true;
+         }
+      };
+
+   }  // namespace internal
+
+   // clang-format off
+   struct sp : one< ' ' > {};
+   struct nil : one< '-' > {};
+
+   struct prival : internal::prival {};
+   struct pri : seq< one< '<' >, prival, one< '>' > > {};
+   struct version : seq< range< '1', '9' >, rep_max< 2, digit > > {};
+   struct timestamp : sor< nil, TAO_PEGTL_NAMESPACE::timestamp::rfc3339 > {};
+   struct hostname : internal::field< false, 255 > {};
+   struct app_name : internal::field< false, 48 > {};
+   struct procid : internal::field< false, 128 > {};
+   struct msgid : internal::field< false, 32 > {};
+   struct header : seq< pri, version, sp, timestamp, sp, hostname, sp, app_name, sp, procid, sp, msgid > {};
+
+   struct sd_id : internal::field< true, 32 > {};
+   struct param_name : internal::field< true, 32 > {};
+   struct param_value : TAO_PEGTL_NAMESPACE::internal::escaped_string {};
+   struct sd_param : seq< param_name, one< '=' >, one< '"' >, param_value, one< '"' > > {};
+   struct sd_element : seq< one< '[' >, sd_id, star< sp, sd_param >, one< ']' > > {};
+   struct structured_data : sor< nil, plus< sd_element > > {};
+
+   struct msg : internal::scan< internal::line_end > {};
+   struct syslog_msg : seq< header, sp, structured_data, opt< sp, msg > > {};
+   // clang-format on
+
+   struct sd_param_view
+   {
+      std::string_view name;
+      std::string_view value;  // As in the input, see unescape().
+   };
+
+   struct sd_element_view
+   {
+      std::string_view id;
+      std::size_t first = 0;  // Index of the first parameter in message::params.
+      std::size_t count = 0;
+   };
+
+   struct message
+   {
+      unsigned facility = 0;
+      unsigned severity = 0;
+      unsigned version = 1;
+      std::optional< TAO_PEGTL_NAMESPACE::timestamp::epoch > timestamp;
+
+      // Empty for NILVALUE.
+      std::string_view hostname;
+      std::string_view app_name;
+      std::string_view procid;
+      std::string_view msgid;
+
+      std::vector< sd_element_view > structured_data;
+      std::vector< sd_param_view > params;
+
+      std::string_view msg;  // Without a trailing CR.
+   };
+
+   namespace internal
+   {
+      [[nodiscard]] inline std::string_view view( const char* b, const char* e ) noexcept
+      {
+         return std::string_view( b, std::size_t( e - b ) );
+      }
+
+      [[nodiscard]] inline std::string_view nil_view( const char* b, const char* e ) noexcept
+      {
+         return ( ( e - b == 1 ) && ( *b == '-' ) ) ? std::string_view() : view( b, e );
+      }
+
+      template< typename Rule >
+      struct action
+         : nothing< Rule >
+      {
+      };
+
+      template<>
+      struct action< syslog::prival >
+      {
+         template< typename Input >
+         static void apply( const Input& in, message& m )
+         {
+            unsigned v = 0;
+            for( const char c : view( in.begin(), in.end() ) ) {
+               v = v * 10 + unsigned( c - '0' );
+            }
+            m.facility = v / 8;
+            m.severity = v % 8;
+         }
+      };
+
+      template<>
+      struct action< version >
+      {
+         template< typename Input >
+         static void apply( const Input& in, message& m )
+         {
+            m.version = 0;
+            for( const char c : view( in.begin(), in.end() ) ) {
+               m.version = m.version * 10 + unsigned( c - '0' );
+            }
+         }
+      };
+
+      template<>
+      struct action< TAO_PEGTL_NAMESPACE::timestamp::rfc3339 >
+      {
+         template< typename Input >
+         static void apply( const Input& in, message& m )
+         {
+            (void)TAO_PEGTL_NAMESPACE::timestamp::parse_rfc3339( in.begin(), in.end(), m.timestamp.emplace() );
+         }
+      };
+
+      template<>
+      struct action< hostname >
+      {
+         template< typename Input >
+         static void apply( const Input& in, message& m )
+         {
+            m.hostname = nil_view( in.begin(), in.end() );
+         }
+      };
+
+      template<>
+      struct action< app_name >
+      {
+         template< typename Input >
+         static void apply( const Input& in, message& m )
+         {
+            m.app_name = nil_view( in.begin(), in.end() );
+         }
+      };
+
+      template<>
+      struct action< procid >
+      {
+         template< typename Input >
+         static void apply( const Input& in, message& m )
+         {
+            m.procid = nil_view( in.begin(), in.end() );
+         }
+      };
+
+      template<>
+      struct action< msgid >
+      {
+         template< typename Input >
+         static void apply( const Input& in, message& m )
+         {
+            m.msgid = nil_view( in.begin(), in.end() );
+         }
+      };
+
+      template<>
+      struct action< sd_id >
+      {
+         template< typename Input >
+         static void apply( const Input& in, message& m )
+         {
+            m.structured_data.push_back( { view( in.begin(), in.end() ), m.params.size(), 0 } );
+         }
+      };
+
+      template<>
+      struct action< param_name >
+      {
+         template< typename Input >
+         static void apply( const Input& in, message& m )
+         {
+            m.params.push_back( { view( in.begin(), in.end() ), std::string_view() } );
+            ++m.structured_data.back().count;
+         }
+      };
+
+      template<>
+      struct action< param_value >
+      {
+         template< typename Input >
+         static void apply( const Input& in, message& m )
+         {
+            m.params.back().value = view( in.begin(), in.end() );
+         }
+      };
+
+      template<>
+      struct action< msg >
+      {
+         template< typename Input >
+         static void apply( const Input& in, message& m )
+         {
+            const char* e = in.end();
+            if( ( e != in.begin() ) && ( e[ -1 ] == '\r' ) ) {
+               --e;
+            }
+            m.msg = view( in.begin(), e );
+         }
+      };
+
+   }  // namespace internal
+
+   // Parses one line, without the line end, and returns whether it is a
+   // valid message. The vectors in m keep their capacity when m is reused.
+
+   [[nodiscard]] inline bool parse( const std::string_view line, message& m )
+   {
+      auto elements = std::move( m.structured_data );
+      auto params = std::move( m.params );
+      elements.clear();
+      params.clear();
+      m = message();
+      m.structured_data = std::move( elements );
+      m.params = std::move( params );
+      memory_input< tracking_mode::lazy, eol::lf_crlf, const char* > in( line.data(), line.data() + line.size(), "syslog" );
+      return TAO_PEGTL_NAMESPACE::parse< seq< syslog_msg, eof >, internal::action >( in, m );
+   }
+
+   // Appends a PARAM-VALUE with the escape sequences \", \\ and \] replaced
+   // by the escaped character; other backslashes are kept.
+
+   inline void unescape( const std::string_view value, std::string& s )
+   {
+      for( std::size_t i = 0; i < value.size(); ++i ) {
+         if( ( value[ i ] == '\\' ) && ( i + 1 < value.size() ) && ( ( value[ i + 1 ] == '"' ) || ( value[ i + 1 ] == '\\' ) || ( value[ i + 1 ] == ']' ) ) ) {
+            ++i;
+         }
+         s += value[ i ];
+      }
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE::syslog
+
+namespace TAO_PEGTL_NAMESPACE::internal
+{
+   template< bool Name, std::size_t Maximum >
+   inline constexpr bool skip_control< syslog::internal::field< Name, Maximum > > = true;
+
+   template<>
+   inline constexpr bool skip_control< syslog::internal::prival > = true;
+
+   template< const char* ( *End )( const char*, const char* ) noexcept >
+   inline constexpr bool skip_control< syslog::internal::scan< End > > = true;
+
+}  // namespace TAO_PEGTL_NAMESPACE::internal
+
+#endif
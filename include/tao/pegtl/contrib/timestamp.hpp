@@ -0,0 +1,301 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_TIMESTAMP_HPP
+#define TAO_PEGTL_CONTRIB_TIMESTAMP_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../config.hpp"
+
+#include "../analysis/generic.hpp"
+#include "../internal/endian.hpp"
+#include "../internal/skip_control.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::timestamp
+{
+   // Time since 1970-01-01T00:00:00Z, without leap seconds, i.e. a leap
+   // second is the same as the first second of the following minute.
+
+   struct epoch
+   {
+      std::int64_t seconds = 0;
+      std::uint32_t nanoseconds = 0;
+   };
+
+   [[nodiscard]] constexpr bool operator==( const epoch& l, const epoch& r ) noexcept
+   {
+      return ( l.seconds == r.seconds ) && ( l.nanoseconds == r.nanoseconds );
+   }
+
+   [[nodiscard]] constexpr bool operator!=( const epoch& l, const epoch& r ) noexcept
+   {
+      return !( l == r );
+   }
+
+   // Days since 1970-01-01 of a date in the proleptic Gregorian calendar.
+
+   [[nodiscard]] constexpr std::int64_t days_from_civil( std::int64_t y, const unsigned m, const unsigned d ) noexcept
+   {
+      y -= ( m <= 2 );
+      const std::int64_t era = ( ( y >= 0 ) ? y : ( y - 399 ) ) / 400;
+      const auto yoe = unsigned( y - era * 400 );
+      const unsigned doy = ( 153 * ( ( m > 2 ) ? ( m - 3 ) : ( m + 9 ) ) + 2 ) / 5 + d - 1;
+      const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+      return era * 146097 + std::int64_t( doe ) - 719468;
+   }
+
+   namespace internal
+   {
+      // The fixed-width fields are read eight bytes at a time: a group of
+      // three two-digit numbers separated by S, i.e. "dd?dd?dd" as found
+      // in "HH:MM:SS" and the "YY-MM-DD" part of a full date, is checked
+      // for the separators and for digits with a few mask operations, and
+      // then the digits of all pairs are combined with one multiplication.
+
+      [[nodiscard]] constexpr bool all_digits( const std::uint64_t x ) noexcept
+      {
+         return ( ( x & 0xf0f0f0f0f0f0f0f0 ) == 0x3030303030303030 ) && ( ( ( x + 0x0606060606060606 ) & 0xf0f0f0f0f0f0f0f0 ) == 0x3030303030303030 );
+      }
+
+      template< char S >
+      [[nodiscard]] inline bool triple( const char* p, unsigned& a, unsigned& b, unsigned& c ) noexcept
+      {
+         constexpr std::uint64_t separators = 0x0000ff0000ff0000;
+         constexpr std::uint64_t expected = ( std::uint64_t( std::uint8_t( S ) ) << 16 ) | ( std::uint64_t( std::uint8_t( S ) ) << 40 );
+         const auto x = TAO_PEGTL_NAMESPACE::internal::le_to_h< std::uint64_t >( p );
+         const std::uint64_t d = ( x & ~separators ) | 0x0000300000300000;
+         if( ( ( x & separators ) != expected ) || !all_digits( d ) ) {
+            return false;
+         }
+         const std::uint64_t v = d - 0x3030303030303030;
+         const std::uint64_t t = v * 10 + ( v >> 8 );
+         a = unsigned( t & 0xff );
+         b = unsigned( ( t >> 24 ) & 0xff );
+         c = unsigned( ( t >> 48 ) & 0xff );
+         return true;
+      }
+
+      [[nodiscard]] inline bool pair( const char* p, unsigned& a ) noexcept
+      {
+         const auto d0 = unsigned( std::uint8_t( p[ 0 ] ) - '0' );
+         const auto d1 = unsigned( std::uint8_t( p[ 1 ] ) - '0' );
+         a = d0 * 10 + d1;
+         return ( d0 < 10 ) && ( d1 < 10 );
+      }
+
+      [[nodiscard]] constexpr bool is_leap( const unsigned y ) noexcept
+      {
+         return ( y % 4 == 0 ) && ( ( y % 100 != 0 ) || ( y % 400 == 0 ) );
+      }
+
+      [[nodiscard]] constexpr bool valid( const unsigned y, const unsigned mo, const unsigned d, const unsigned h, const unsigned mi, const unsigned s ) noexcept
+      {
+         constexpr unsigned char days[] = { 0, 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+         return ( mo - 1 < 12 ) && ( d != 0 ) && ( d <= days[ mo ] ) && ( ( mo != 2 ) || ( d != 29 ) || is_leap( y ) ) && ( h < 24 ) && ( mi < 60 ) && ( s <= 60 );
+      }
+
+      // As days_from_civil() for years 0 to 9999, with unsigned 32-bit
+      // arithmetic in which the divisions become multiplications.
+
+      [[nodiscard]] constexpr std::int64_t seconds( const unsigned y, const unsigned mo, const unsigned d, const unsigned h, const unsigned mi, const unsigned s ) noexcept
+      {
+         const unsigned yy = y + 400 - ( mo <= 2 );
+         const unsigned doy = ( 153 * ( ( mo > 2 ) ? ( mo - 3 ) : ( mo + 9 ) ) + 2 ) / 5 + d - 1;
+         const unsigned days = yy * 365 + yy / 4 - yy / 100 + yy / 400 + doy;
+         return ( std::int64_t( days ) - ( 719468 + 146097 ) ) * 86400 + std::int64_t( h * 3600 + mi * 60 + s );
+      }
+
+      static_assert( seconds( 1970, 1, 1, 0, 0, 0 ) == 0 );
+      static_assert( seconds( 0, 1, 1, 0, 0, 0 ) == days_from_civil( 0, 1, 1 ) * 86400 );
+      static_assert( seconds( 9999, 12, 31, 0, 0, 0 ) == days_from_civil( 9999, 12, 31 ) * 86400 );
+
+      // Parses the numeric time offset "+HH:MM" or "-HH:MM" or, when Colon
+      // is false, "+HHMM" or "-HHMM", returning the offset in seconds.
+
+      template< bool Colon >
+      [[nodiscard]] inline bool offset( const char* p, std::int64_t& r ) noexcept
+      {
+         unsigned h;
+         unsigned m;
+         if( ( ( p[ 0 ] != '+' ) && ( p[ 0 ] != '-' ) ) || !pair( p + 1, h ) || ( Colon && ( p[ 3 ] != ':' ) ) || !pair( p + 3 + Colon, m ) || ( h > 23 ) || ( m > 59 ) ) {
+            return false;
+         }
+         r = std::int64_t( h * 3600 + m * 60 );
+         r = ( p[ 0 ] == '-' ) ? -r : r;
+         return true;
+      }
+
+      // Maps "Jan" to "Dec" to 1 to 12, and everything else to 0, with a
+      // perfect hash of the three bytes.
+
+      [[nodiscard]] constexpr std::uint32_t month_key( const char* p ) noexcept
+      {
+         return std::uint32_t( std::uint8_t( p[ 0 ] ) ) | ( std::uint32_t( std::uint8_t( p[ 1 ] ) ) << 8 ) | ( std::uint32_t( std::uint8_t( p[ 2 ] ) ) << 16 );
+      }
+
+      [[nodiscard]] constexpr unsigned month_hash( const std::uint32_t k ) noexcept
+      {
+         return ( ( k * 284 ) >> 20 ) & 15;
+      }
+
+      inline constexpr const char* month_names[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+
+      struct month_table
+      {
+         std::uint32_t keys[ 16 ] = {};
+         unsigned char months[ 16 ] = {};
+
+         constexpr month_table() noexcept
+         {
+            for( unsigned i = 0; i < 12; ++i ) {
+               const auto k = month_key( month_names[ i ] );
+               keys[ month_hash( k ) ] = k;
+               months[ month_hash( k ) ] = static_cast< unsigned char >( i + 1 );
+            }
+         }
+      };
+
+      inline constexpr month_table months{};
+
+      static_assert( months.months[ month_hash( month_key( "Jan" ) ) ] == 1 );
+      static_assert( months.months[ month_hash( month_key( "Dec" ) ) ] == 12 );
+
+      [[nodiscard]] inline unsigned month( const char* p ) noexcept
+      {
+         const auto k = month_key( p );
+         const auto h = month_hash( k );
+         return ( months.keys[ h ] == k ) ? months.months[ h ] : 0;
+      }
+
+      template< const char* ( *Parse )( const char*, const char*, epoch& ) noexcept, std::size_t Maximum >
+      struct rule
+      {
+         using analyze_t = analysis::generic< analysis::rule_type::any >;
+
+         template< typename Input >
+         [[nodiscard]] static bool match( Input& in )
+         {
+            epoch t;
+            const char* p = in.current();
+            if( const char* e = Parse( p, p + in.size( Maximum ), t ) ) {
+               in.bump_in_this_line( std::size_t( e - p ) );
+               return true;
+            }
+            return false;
+         }
+      };
+
+   }  // namespace internal
+
+   // Parses an RFC 3339 date-time like "1985-04-12T23:20:50.52Z" or
+   // "1996-12-19T16:39:57-08:00" at begin, with 'T' and 'Z' in either case
+   // and any number of fractional digits of which the first nine are used.
+   // Returns the end of the timestamp, or nullptr when there is none.
+
+   [[nodiscard]] inline const char* parse_rfc3339( const char* p, const char* e, epoch& r ) noexcept
+   {
+      // A single size check covers all fixed-width fields and one more
+      // byte, which is enough for "Z", otherwise the size is checked again.
+      if( e - p < 20 ) {
+         return nullptr;
+      }
+      unsigned c;
+      unsigned y;
+      unsigned mo;
+      unsigned d;
+      unsigned h;
+      unsigned mi;
+      unsigned s;
+      if( !internal::pair( p, c ) || !internal::triple< '-' >( p + 2, y, mo, d ) || ( ( p[ 10 ] | 0x20 ) != 't' ) || !internal::triple< ':' >( p + 11, h, mi, s ) ) {
+         return nullptr;
+      }
+      y += c * 100;
+      if( !internal::valid( y, mo, d, h, mi, s ) ) {
+         return nullptr;
+      }
+      p += 19;
+      std::uint32_t ns = 0;
+      if( *p == '.' ) {
+         const char* const b = ++p;
+         for( ; ( p != e ) && ( unsigned( std::uint8_t( *p ) - '0' ) < 10 ); ++p ) {
+            if( p - b < 9 ) {
+               ns = ns * 10 + std::uint32_t( *p - '0' );
+            }
+         }
+         if( ( p == b ) || ( p == e ) ) {
+            return nullptr;
+         }
+         for( auto n = p - b; n < 9; ++n ) {
+            ns *= 10;
+         }
+      }
+      std::int64_t o = 0;
+      if( ( *p | 0x20 ) == 'z' ) {
+         ++p;
+      }
+      else if( ( e - p >= 6 ) && internal::offset< true >( p, o ) ) {
+         p += 6;
+      }
+      else {
+         return nullptr;
+      }
+      r.seconds = internal::seconds( y, mo, d, h, mi, s ) - o;
+      r.nanoseconds = ns;
+      return p;
+   }
+
+   // Parses a timestamp in the format of the Common Log Format, like
+   // "10/Oct/2000:13:55:36 -0700", which always has 26 bytes.
+
+   [[nodiscard]] inline const char* parse_clf( const char* p, const char* e, epoch& r ) noexcept
+   {
+      if( e - p < 26 ) {
+         return nullptr;
+      }
+      unsigned d;
+      unsigned c;
+      unsigned y;
+      unsigned h;
+      unsigned mi;
+      unsigned s;
+      std::int64_t o;
+      const unsigned mo = internal::month( p + 3 );
+      if( !internal::pair( p, d ) || ( p[ 2 ] != '/' ) || ( mo == 0 ) || ( p[ 6 ] != '/' ) || !internal::pair( p + 7, c ) || !internal::pair( p + 9, y ) || ( p[ 11 ] != ':' ) || !internal::triple< ':' >( p + 12, h, mi, s ) || ( p[ 20 ] != ' ' ) || !internal::offset< false >( p + 21, o ) ) {
+         return nullptr;
+      }
+      y += c * 100;
+      if( !internal::valid( y, mo, d, h, mi, s ) ) {
+         return nullptr;
+      }
+      r.seconds = internal::seconds( y, mo, d, h, mi, s ) - o;
+      r.nanoseconds = 0;
+      return p + 26;
+   }
+
+   // Rules that match the timestamps accepted by the functions above; an
+   // action can call the function on the matched input to get the value.
+   // For inputs that are not memory inputs only the first 64 bytes of an
+   // RFC 3339 timestamp are considered, which limits the fraction length.
+
+   struct rfc3339
+      : internal::rule< parse_rfc3339, 64 >
+   {
+   };
+
+   struct clf
+      : internal::rule< parse_clf, 26 >
+   {
+   };
+
+}  // namespace TAO_PEGTL_NAMESPACE::timestamp
+
+namespace TAO_PEGTL_NAMESPACE::internal
+{
+   template< const char* ( *Parse )( const char*, const char*, timestamp::epoch& ) noexcept, std::size_t Maximum >
+   inline constexpr bool skip_control< timestamp::internal::rule< Parse, Maximum > > = true;
+
+}  // namespace TAO_PEGTL_NAMESPACE::internal
+
+#endif
@@ -0,0 +1,257 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_TRIVIA_HPP
+#define TAO_PEGTL_CONTRIB_TRIVIA_HPP
+
+#include <cstddef>
+#include <cstring>
+
+#include "../apply_mode.hpp"
+#include "../config.hpp"
+#include "../rewind_mode.hpp"
+
+#include "../internal/fast_path.hpp"
+#include "../internal/one.hpp"
+#include "../internal/peek_char.hpp"
+#include "../internal/result_on_found.hpp"
+#include "../internal/simd.hpp"
+#include "../internal/skip_control.hpp"
+#include "../internal/string.hpp"
+
+#include "../analysis/generic.hpp"
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   template< typename Open, typename Close >
+   struct block_comment;
+
+   namespace internal
+   {
+      template< char... Cs >
+      struct trivia_chars
+      {
+         static constexpr std::size_t size = sizeof...( Cs );
+         static constexpr char data[ size ] = { Cs... };
+
+         [[nodiscard]] static bool starts( const char* p, const char* e ) noexcept
+         {
+            return ( std::size_t( e - p ) >= size ) && ( std::memcmp( p, data, size ) == 0 );
+         }
+
+         // Returns the first occurrence in [ p, e ), or nullptr. Searches
+         // for the last character, which is rarer in comments than the
+         // first for the usual closing sequences like "*/" or "-->".
+
+         [[nodiscard]] static const char* find( const char* p, const char* e ) noexcept
+         {
+            p += size - 1;
+            while( p < e ) {
+               p = static_cast< const char* >( std::memchr( p, data[ size - 1 ], std::size_t( e - p ) ) );
+               if( p == nullptr ) {
+                  return nullptr;
+               }
+               if( std::memcmp( p - ( size - 1 ), data, size - 1 ) == 0 ) {
+                  return p - ( size - 1 );
+               }
+               ++p;
+            }
+            return nullptr;
+         }
+      };
+
+      // Extracts the characters from rules like one< ' ', '\t' >, space,
+      // string< '/', '/' >, two< '-' > or TAO_PEGTL_STRING( "#" ).
+
+      template< char... Cs >
+      trivia_chars< Cs... > trivia_chars_of( const one< result_on_found::success, peek_char, Cs... >* );
+
+      template< char... Cs >
+      trivia_chars< Cs... > trivia_chars_of( const string< Cs... >* );
+
+      template< typename Rule >
+      using trivia_chars_t = decltype( trivia_chars_of( static_cast< const Rule* >( nullptr ) ) );
+
+      template< typename Space >
+      struct trivia_space;
+
+      template< char... Cs >
+      struct trivia_space< trivia_chars< Cs... > >
+      {
+         [[nodiscard]] static const char* skip( const char* p, const char* e ) noexcept
+         {
+            // Most runs are a single character, longer runs (indentation,
+            // blank lines) are classified 64 bytes at a time.
+            if( ( p == e ) || !( ( *p == Cs ) || ... ) ) {
+               return p;
+            }
+            if( ( ++p == e ) || !( ( *p == Cs ) || ... ) ) {
+               return p;
+            }
+            using block = simd::block64;
+            return simd::find_first( p, e, []( const block& b ) { return ~b.template eq< Cs... >(); } );
+         }
+      };
+
+      template< typename Open >
+      struct line_comment
+      {
+         using open_t = trivia_chars_t< Open >;
+
+         using analyze_t = analysis::generic< analysis::rule_type::any >;
+
+         // Returns p when there is no comment at p, otherwise the end of
+         // the comment, i.e. the next "\n" or "\r\n" (not included) or e.
+
+         [[nodiscard]] static const char* skip( const char* p, const char* e ) noexcept
+         {
+            if( !open_t::starts( p, e ) ) {
+               return p;
+            }
+            p += open_t::size;
+            const auto* n = static_cast< const char* >( std::memchr( p, '\n', std::size_t( e - p ) ) );
+            if( n == nullptr ) {
+               return e;
+            }
+            return ( ( n != p ) && ( n[ -1 ] == '\r' ) ) ? ( n - 1 ) : n;
+         }
+
+         template< typename Input >
+         [[nodiscard]] static bool match( Input& in )
+         {
+            const char* const b = in.current();
+            const char* const p = skip( b, in.end() );
+            in.bump_in_this_line( std::size_t( p - b ) );
+            return p != b;
+         }
+      };
+
+      template< typename Open, typename Close >
+      struct block_comment
+      {
+         using open_t = trivia_chars_t< Open >;
+         using close_t = trivia_chars_t< Close >;
+
+         using analyze_t = analysis::generic< analysis::rule_type::any >;
+
+         // Returns p when there is no comment at p, nullptr when the comment
+         // is not closed, otherwise the end of the comment.
+
+         [[nodiscard]] static const char* skip( const char* p, const char* e ) noexcept
+         {
+            if( !open_t::starts( p, e ) ) {
+               return p;
+            }
+            const char* q = close_t::find( p + open_t::size, e );
+            return ( q != nullptr ) ? ( q + close_t::size ) : nullptr;
+         }
+
+         template< apply_mode,
+                   rewind_mode,
+                   template< typename... >
+                   class Action,
+                   template< typename... >
+                   class Control,
+                   typename Input,
+                   typename... States >
+         [[nodiscard]] static bool match( Input& in, States&&... st )
+         {
+            const char* const b = in.current();
+            const char* const p = skip( b, in.end() );
+            if( p == nullptr ) {
+               Control< TAO_PEGTL_NAMESPACE::block_comment< Open, Close > >::raise( static_cast< const Input& >( in ), st... );
+            }
+            in.bump( std::size_t( p - b ) );
+            return p != b;
+         }
+      };
+
+      template< bool NonEmpty, typename Space, typename... Comments >
+      struct trivia
+      {
+         using analyze_t = analysis::generic< NonEmpty ? analysis::rule_type::any : analysis::rule_type::opt >;
+
+         template< typename Comment,
+                   template< typename... >
+                   class Control,
+                   typename Input,
+                   typename... States >
+         [[nodiscard]] static bool skip_comment( Input& in, const char* b, const char*& p, States&&... st )
+         {
+            const char* const q = Comment::skip( p, in.end() );
+            if( q == nullptr ) {
+               in.bump( std::size_t( p - b ) );
+               Control< Comment >::raise( static_cast< const Input& >( in ), st... );
+            }
+            if( q != p ) {
+               p = q;
+               return true;
+            }
+            return false;
+         }
+
+         template< apply_mode A,
+                   rewind_mode,
+                   template< typename... >
+                   class Action,
+                   template< typename... >
+                   class Control,
+                   typename Input,
+                   typename... States >
+         [[nodiscard]] static bool match( Input& in, States&&... st )
+         {
+            if constexpr( fast_path_v< Space, A, Action, Control, Input, States... > && ( fast_path_v< Comments, A, Action, Control, Input, States... > && ... ) ) {
+               const char* const b = in.current();
+               const char* p = b;
+               do {
+                  p = trivia_space< trivia_chars_t< Space > >::skip( p, in.end() );
+               } while( ( skip_comment< Comments, Control >( in, b, p, st... ) || ... ) );
+               in.bump( std::size_t( p - b ) );
+               return ( p != b ) || !NonEmpty;
+            }
+            else {
+               bool r = false;
+               while( Control< Space >::template match< A, rewind_mode::required, Action, Control >( in, st... ) || ( Control< Comments >::template match< A, rewind_mode::required, Action, Control >( in, st... ) || ... ) ) {
+                  r = true;
+               }
+               return r || !NonEmpty;
+            }
+         }
+      };
+
+      template< typename Open >
+      inline constexpr bool skip_control< line_comment< Open > > = true;
+
+      template< typename Open, typename Close >
+      inline constexpr bool skip_control< block_comment< Open, Close > > = true;
+
+      template< bool NonEmpty, typename Space, typename... Comments >
+      inline constexpr bool skip_control< trivia< NonEmpty, Space, Comments... > > = true;
+
+   }  // namespace internal
+
+   // Comments that start with Open and end before the next end-of-line, or
+   // that start with Open and end with Close. Open and Close are strings like
+   // TAO_PEGTL_STRING( "//" ) or two< '-' >, or single characters like
+   // one< '#' >. Unterminated block comments raise a global error.
+
+   // clang-format off
+   template< typename Open > struct line_comment : internal::line_comment< Open > {};
+   template< typename Open, typename Close > struct block_comment : internal::block_comment< Open, Close > {};
+   // clang-format on
+
+   // Equivalent to star< sor< Space, Comments... > > and plus< sor< Space,
+   // Comments... > >, respectively, but matched in a single loop without
+   // markers or calls to the control class unless an action or control is
+   // attached to one of the sub-rules. Space is a rule like space, blank or
+   // one< ' ', '\n' >; Comments are line_comment and block_comment. All of
+   // these rules require a memory input.
+
+   // clang-format off
+   template< typename Space, typename... Comments > struct skip_trivia : internal::trivia< false, Space, Comments... > {};
+   template< typename Space, typename... Comments > struct trivia : internal::trivia< true, Space, Comments... > {};
+   // clang-format on
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#endif
@@ -49,6 +49,40 @@ namespace TAO_PEGTL_NAMESPACE::unescape
       return false;
    }
 
+   // Like utf8_append_utf32(), but writes to a caller-supplied buffer that
+   // MUST have room for at least four more bytes; returns the new end of the
+   // written data, or nullptr when utf32 is not a valid code point.
+
+   [[nodiscard]] inline char* utf8_write_utf32( char* out, const unsigned utf32 ) noexcept
+   {
+      if( utf32 <= 0x7f ) {
+         *out++ = char( utf32 & 0xff );
+         return out;
+      }
+      if( utf32 <= 0x7ff ) {
+         *out++ = char( ( ( utf32 & 0x7c0 ) >> 6 ) | 0xc0 );
+         *out++ = char( ( ( utf32 & 0x03f ) ) | 0x80 );
+         return out;
+      }
+      if( utf32 <= 0xffff ) {
+         if( utf32 >= 0xd800 && utf32 <= 0xdfff ) {
+            return nullptr;
+         }
+         *out++ = char( ( ( utf32 & 0xf000 ) >> 12 ) | 0xe0 );
+         *out++ = char( ( ( utf32 & 0x0fc0 ) >> 6 ) | 0x80 );
+         *out++ = char( ( ( utf32 & 0x003f ) ) | 0x80 );
+         return out;
+      }
+      if( utf32 <= 0x10ffff ) {
+         *out++ = char( ( ( utf32 & 0x1c0000 ) >> 18 ) | 0xf0 );
+         *out++ = char( ( ( utf32 & 0x03f000 ) >> 12 ) | 0x80 );
+         *out++ = char( ( ( utf32 & 0x000fc0 ) >> 6 ) | 0x80 );
+         *out++ = char( ( ( utf32 & 0x00003f ) ) | 0x80 );
+         return out;
+      }
+      return nullptr;
+   }
+
    // This function MUST only be called for characters matching TAO_PEGTL_NAMESPACE::ascii::xdigit!
    template< typename I >
    [[nodiscard]] I unhex_char( const char c )
@@ -194,6 +228,66 @@ namespace TAO_PEGTL_NAMESPACE::unescape
       }
    };
 
+   // The unescape_json function unescapes the content of a JSON string in
+   // one pass, without going through the grammar rule by rule. It MUST only
+   // be called for input that was successfully matched by json::string_content
+   // (or json::key_content). The output buffer MUST have room for at least
+   // ( end - begin ) bytes, which is always sufficient as no escape sequence
+   // unescapes to more bytes than it occupies in the input. Returns the new
+   // end of the output, or nullptr on a lone UTF-16 surrogate.
+
+   [[nodiscard]] inline char* unescape_json( const char* begin, const char* end, char* out )
+   {
+      while( begin != end ) {
+         const char c = *begin++;
+         if( c != '\\' ) {
+            *out++ = c;
+            continue;
+         }
+         switch( *begin++ ) {
+            case '"':
+               *out++ = '"';
+               break;
+            case '\\':
+               *out++ = '\\';
+               break;
+            case '/':
+               *out++ = '/';
+               break;
+            case 'b':
+               *out++ = '\b';
+               break;
+            case 'f':
+               *out++ = '\f';
+               break;
+            case 'n':
+               *out++ = '\n';
+               break;
+            case 'r':
+               *out++ = '\r';
+               break;
+            case 't':
+               *out++ = '\t';
+               break;
+            default: {  // 'u', guaranteed by the grammar.
+               unsigned u = unhex_string< unsigned >( begin, begin + 4 );
+               begin += 4;
+               if( ( 0xd800 <= u ) && ( u <= 0xdbff ) && ( end - begin >= 6 ) && ( begin[ 0 ] == '\\' ) && ( begin[ 1 ] == 'u' ) ) {
+                  const auto d = unhex_string< unsigned >( begin + 2, begin + 6 );
+                  if( ( 0xdc00 <= d ) && ( d <= 0xdfff ) ) {
+                     begin += 6;
+                     u = ( ( ( u & 0x03ff ) << 10 ) | ( d & 0x03ff ) ) + 0x10000;
+                  }
+               }
+               if( ( out = utf8_write_utf32( out, u ) ) == nullptr ) {
+                  return nullptr;
+               }
+            } break;
+         }
+      }
+      return out;
+   }
+
 }  // namespace TAO_PEGTL_NAMESPACE::unescape
 
 #endif
@@ -0,0 +1,184 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_UNICODE_INTERNAL_HPP
+#define TAO_PEGTL_CONTRIB_UNICODE_INTERNAL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "tables.hpp"
+
+#include "../../config.hpp"
+
+#include "../../analysis/generic.hpp"
+#include "../../internal/peek_utf8.hpp"
+#include "../../internal/skip_control.hpp"
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   namespace internal::unicode
+   {
+      // Code points must not be larger than 0x10ffff, which is ensured
+      // by the peek classes.
+
+      [[nodiscard]] inline std::uint8_t properties( const char32_t c ) noexcept
+      {
+         return property_stage2[ ( std::size_t( property_stage1[ c >> property_shift ] ) << property_shift ) | ( c & ( ( 1U << property_shift ) - 1 ) ) ];
+      }
+
+      [[nodiscard]] inline std::uint8_t script_index( const char32_t c ) noexcept
+      {
+         return script_stage2[ ( std::size_t( script_stage1[ c >> script_shift ] ) << script_shift ) | ( c & ( ( 1U << script_shift ) - 1 ) ) ];
+      }
+
+      template< typename Peek, typename Predicate >
+      struct property_rule
+      {
+         using analyze_t = analysis::generic< analysis::rule_type::any >;
+
+         template< typename Input >
+         [[nodiscard]] static bool match( Input& in ) noexcept( noexcept( in.size( Peek::max_input_size ) ) )
+         {
+            if( const std::size_t s = in.size( Peek::max_input_size ); s >= Peek::min_input_size ) {
+               if( const auto r = Peek::peek( in, s ) ) {
+                  if( Predicate::test( r.data ) ) {
+                     in.bump( r.size );
+                     return true;
+                  }
+               }
+            }
+            return false;
+         }
+      };
+
+      template< std::uint8_t Flag, bool V >
+      struct has_flag
+      {
+         [[nodiscard]] static bool test( const char32_t c ) noexcept
+         {
+            return ( ( properties( c ) & Flag ) != 0 ) == V;
+         }
+      };
+
+      template< TAO_PEGTL_NAMESPACE::unicode::general_category V >
+      struct has_general_category
+      {
+         [[nodiscard]] static bool test( const char32_t c ) noexcept
+         {
+            return ( properties( c ) & general_category_mask ) == std::uint8_t( V );
+         }
+      };
+
+      template< TAO_PEGTL_NAMESPACE::unicode::script V >
+      struct has_script
+      {
+         [[nodiscard]] static bool test( const char32_t c ) noexcept
+         {
+            return script_index( c ) == std::uint8_t( V );
+         }
+      };
+
+      template< typename Peek, std::uint8_t Flag, bool V = true >
+      struct binary_property
+         : property_rule< Peek, has_flag< Flag, V > >
+      {
+      };
+
+      template< typename Peek, TAO_PEGTL_NAMESPACE::unicode::general_category V >
+      struct general_category_value
+         : property_rule< Peek, has_general_category< V > >
+      {
+      };
+
+      template< typename Peek, TAO_PEGTL_NAMESPACE::unicode::script V >
+      struct script_value
+         : property_rule< Peek, has_script< V > >
+      {
+      };
+
+      // Equivalent to seq< xid_start, star< xid_continue > > with a single
+      // rule, a single table lookup per code point, and a shortcut for the
+      // ASCII characters of UTF-8 input.
+
+      template< typename Peek >
+      struct identifier
+      {
+         using analyze_t = analysis::generic< analysis::rule_type::any >;
+
+         template< typename Input >
+         [[nodiscard]] static bool match_one( Input& in, const std::uint8_t flag ) noexcept( noexcept( in.size( Peek::max_input_size ) ) )
+         {
+            if constexpr( std::is_same_v< Peek, peek_utf8 > ) {
+               if( ( in.size( 1 ) >= 1 ) && ( in.peek_uint8() < 0x80 ) ) {
+                  if( ( properties( in.peek_uint8() ) & flag ) != 0 ) {
+                     in.bump_in_this_line( 1 );
+                     return true;
+                  }
+                  return false;
+               }
+            }
+            if( const std::size_t s = in.size( Peek::max_input_size ); s >= Peek::min_input_size ) {
+               if( const auto r = Peek::peek( in, s ) ) {
+                  if( ( properties( r.data ) & flag ) != 0 ) {
+                     in.bump( r.size );
+                     return true;
+                  }
+               }
+            }
+            return false;
+         }
+
+         template< typename Input >
+         [[nodiscard]] static bool match( Input& in ) noexcept( noexcept( in.size( Peek::max_input_size ) ) )
+         {
+            if( match_one( in, xid_start_flag ) ) {
+               while( match_one( in, xid_continue_flag ) ) {
+               }
+               return true;
+            }
+            return false;
+         }
+      };
+
+   }  // namespace internal::unicode
+
+   namespace unicode
+   {
+      // The general category and script of a code point from the tables.
+
+      [[nodiscard]] inline general_category general_category_of( const char32_t c ) noexcept
+      {
+         return general_category( internal::unicode::properties( c ) & internal::unicode::general_category_mask );
+      }
+
+      [[nodiscard]] inline script script_of( const char32_t c ) noexcept
+      {
+         return script( internal::unicode::script_index( c ) );
+      }
+
+   }  // namespace unicode
+
+   namespace internal
+   {
+      template< typename Peek, typename Predicate >
+      inline constexpr bool skip_control< unicode::property_rule< Peek, Predicate > > = true;
+
+      template< typename Peek, std::uint8_t Flag, bool V >
+      inline constexpr bool skip_control< unicode::binary_property< Peek, Flag, V > > = true;
+
+      template< typename Peek, TAO_PEGTL_NAMESPACE::unicode::general_category V >
+      inline constexpr bool skip_control< unicode::general_category_value< Peek, V > > = true;
+
+      template< typename Peek, TAO_PEGTL_NAMESPACE::unicode::script V >
+      inline constexpr bool skip_control< unicode::script_value< Peek, V > > = true;
+
+      template< typename Peek >
+      inline constexpr bool skip_control< unicode::identifier< Peek > > = true;
+
+   }  // namespace internal
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#endif
@@ -0,0 +1,48 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_UNICODE_UTF16_HPP
+#define TAO_PEGTL_CONTRIB_UNICODE_UTF16_HPP
+
+#include "internal.hpp"
+
+#include "../../config.hpp"
+#include "../../utf16.hpp"
+
+#include "../../internal/peek_utf16.hpp"
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   namespace utf16_be::unicode
+   {
+      // clang-format off
+      struct white_space : internal::unicode::binary_property< internal::peek_utf16_be, internal::unicode::white_space_flag > {};
+      struct xid_continue : internal::unicode::binary_property< internal::peek_utf16_be, internal::unicode::xid_continue_flag > {};
+      struct xid_start : internal::unicode::binary_property< internal::peek_utf16_be, internal::unicode::xid_start_flag > {};
+
+      struct identifier : internal::unicode::identifier< internal::peek_utf16_be > {};
+
+      template< TAO_PEGTL_NAMESPACE::unicode::general_category V > struct general_category : internal::unicode::general_category_value< internal::peek_utf16_be, V > {};
+      template< TAO_PEGTL_NAMESPACE::unicode::script V > struct script : internal::unicode::script_value< internal::peek_utf16_be, V > {};
+      // clang-format on
+
+   }  // namespace utf16_be::unicode
+
+   namespace utf16_le::unicode
+   {
+      // clang-format off
+      struct white_space : internal::unicode::binary_property< internal::peek_utf16_le, internal::unicode::white_space_flag > {};
+      struct xid_continue : internal::unicode::binary_property< internal::peek_utf16_le, internal::unicode::xid_continue_flag > {};
+      struct xid_start : internal::unicode::binary_property< internal::peek_utf16_le, internal::unicode::xid_start_flag > {};
+
+      struct identifier : internal::unicode::identifier< internal::peek_utf16_le > {};
+
+      template< TAO_PEGTL_NAMESPACE::unicode::general_category V > struct general_category : internal::unicode::general_category_value< internal::peek_utf16_le, V > {};
+      template< TAO_PEGTL_NAMESPACE::unicode::script V > struct script : internal::unicode::script_value< internal::peek_utf16_le, V > {};
+      // clang-format on
+
+   }  // namespace utf16_le::unicode
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#endif
@@ -0,0 +1,29 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_UNICODE_UTF8_HPP
+#define TAO_PEGTL_CONTRIB_UNICODE_UTF8_HPP
+
+#include "internal.hpp"
+
+#include "../../config.hpp"
+#include "../../utf8.hpp"
+
+#include "../../internal/peek_utf8.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::utf8::unicode
+{
+   // clang-format off
+   struct white_space : internal::unicode::binary_property< internal::peek_utf8, internal::unicode::white_space_flag > {};
+   struct xid_continue : internal::unicode::binary_property< internal::peek_utf8, internal::unicode::xid_continue_flag > {};
+   struct xid_start : internal::unicode::binary_property< internal::peek_utf8, internal::unicode::xid_start_flag > {};
+
+   struct identifier : internal::unicode::identifier< internal::peek_utf8 > {};
+
+   template< TAO_PEGTL_NAMESPACE::unicode::general_category V > struct general_category : internal::unicode::general_category_value< internal::peek_utf8, V > {};
+   template< TAO_PEGTL_NAMESPACE::unicode::script V > struct script : internal::unicode::script_value< internal::peek_utf8, V > {};
+   // clang-format on
+
+}  // namespace TAO_PEGTL_NAMESPACE::utf8::unicode
+
+#endif
@@ -0,0 +1,356 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_CONTRIB_URI_PARSER_HPP
+#define TAO_PEGTL_CONTRIB_URI_PARSER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "../ascii.hpp"
+#include "../config.hpp"
+#include "../memory_input.hpp"
+#include "../nothing.hpp"
+#include "../parse.hpp"
+#include "../rules.hpp"
+#include "../tracking_mode.hpp"
+
+#include "abnf.hpp"
+#include "uri.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::uri::parser
+{
+   // URI grammar according to RFC 3986 that matches the same language as
+   // the rules with the same names in uri.hpp, but where every character
+   // class is a single table lookup and where segments, paths, queries,
+   // fragments, host names and user information are scanned in bulk.
+
+   namespace internal
+   {
+      enum char_class : std::uint16_t
+      {
+         scheme_char = 1 << 0,  // ALPHA / DIGIT / "+" / "-" / "."
+         reg_name_char = 1 << 1,  // unreserved / sub-delims
+         userinfo_char = 1 << 2,  // unreserved / sub-delims / ":"
+         segment_nc_char = 1 << 3,  // unreserved / sub-delims / "@"
+         pchar = 1 << 4,  // unreserved / sub-delims / ":" / "@"
+         path_char = 1 << 5,  // pchar / "/"
+         query_char = 1 << 6,  // pchar / "/" / "?"
+         digit_char = 1 << 7,
+         alpha_char = 1 << 8,
+         hex_char = 1 << 9,
+         slash_char = 1 << 10
+      };
+
+      struct char_table
+      {
+         std::uint16_t table[ 256 ] = {};
+
+         constexpr char_table() noexcept
+         {
+            constexpr auto all = reg_name_char | userinfo_char | segment_nc_char | pchar | path_char | query_char;
+            for( unsigned c = 0; c < 256; ++c ) {
+               const bool alpha = ( ( 'a' <= c ) && ( c <= 'z' ) ) || ( ( 'A' <= c ) && ( c <= 'Z' ) );
+               const bool digit = ( '0' <= c ) && ( c <= '9' );
+               if( alpha || digit ) {
+                  table[ c ] = std::uint16_t( all | scheme_char | ( alpha ? alpha_char : digit_char ) );
+               }
+               if( digit || ( ( 'a' <= c ) && ( c <= 'f' ) ) || ( ( 'A' <= c ) && ( c <= 'F' ) ) ) {
+                  table[ c ] |= hex_char;
+               }
+            }
+            for( const char c : std::string_view( "-._~!$&'()*+,;=" ) ) {
+               table[ static_cast< unsigned char >( c ) ] |= all;
+            }
+            table[ static_cast< unsigned char >( '+' ) ] |= scheme_char;
+            table[ static_cast< unsigned char >( '-' ) ] |= scheme_char;
+            table[ static_cast< unsigned char >( '.' ) ] |= scheme_char;
+            table[ static_cast< unsigned char >( ':' ) ] |= userinfo_char | pchar | path_char | query_char;
+            table[ static_cast< unsigned char >( '@' ) ] |= segment_nc_char | pchar | path_char | query_char;
+            table[ static_cast< unsigned char >( '/' ) ] |= path_char | query_char | slash_char;
+            table[ static_cast< unsigned char >( '?' ) ] |= query_char;
+         }
+      };
+
+      inline constexpr char_table chars{};
+
+      [[nodiscard]] inline bool is( const char c, const std::uint16_t mask ) noexcept
+      {
+         return ( chars.table[ static_cast< unsigned char >( c ) ] & mask ) != 0;
+      }
+
+      // Returns the end of the longest prefix of [ p, e ) that consists of
+      // characters of the class and, when Pct is true, of pct-encoded
+      // octets. Sets bad to the first invalid hex digit after a "%".
+
+      template< std::uint16_t Class, bool Pct >
+      [[nodiscard]] const char* scan( const char* p, const char* e, const char*& bad ) noexcept
+      {
+         while( p != e ) {
+            if( is( *p, Class ) ) {
+               ++p;
+            }
+            else if( Pct && ( *p == '%' ) ) {
+               if( ( e - p < 2 ) || !is( p[ 1 ], hex_char ) ) {
+                  bad = p + 1;
+                  return p;
+               }
+               if( ( e - p < 3 ) || !is( p[ 2 ], hex_char ) ) {
+                  bad = p + 2;
+                  return p;
+               }
+               p += 3;
+            }
+            else {
+               break;
+            }
+         }
+         return p;
+      }
+
+      // Matches First characters (at least one when NonEmpty, none when
+      // First is 0), then, if the next character is in Then, the longest
+      // run of Rest characters.
+      // An invalid pct-encoding raises a global error at the same place as
+      // if_must< one< '%' >, abnf::HEXDIG, abnf::HEXDIG > does.
+
+      template< typename Rule, std::uint16_t First, bool NonEmpty, std::uint16_t Then = 0, std::uint16_t Rest = 0, bool Pct = true >
+      struct span
+      {
+         using analyze_t = typename Rule::analyze_t;
+
+         template< apply_mode,
+                   rewind_mode,
+                   template< typename... >
+                   class Action,
+                   template< typename... >
+                   class Control,
+                   typename Input,
+                   typename... States >
+         [[nodiscard]] static bool match( Input& in, States&&... st )
+         {
+            const char* const b = in.current();
+            const char* const e = in.end();
+            const char* bad = nullptr;
+            const char* p = b;
+            if constexpr( First != 0 ) {
+               p = scan< First, Pct >( b, e, bad );
+            }
+            if( ( bad == nullptr ) && ( p == b ) && NonEmpty ) {
+               return false;
+            }
+            if constexpr( Then != 0 ) {
+               if( ( bad == nullptr ) && ( p != e ) && is( *p, Then ) ) {
+                  p = scan< Rest, Pct >( p + 1, e, bad );
+               }
+            }
+            if( bad != nullptr ) {
+               in.bump_in_this_line( std::size_t( bad - b ) );
+               Control< abnf::HEXDIG >::raise( static_cast< const Input& >( in ), st... );
+            }
+            in.bump_in_this_line( std::size_t( p - b ) );
+            return true;
+         }
+      };
+
+   }  // namespace internal
+
+   using internal::char_class;
+
+   // clang-format off
+   struct scheme : internal::span< uri::scheme, char_class::alpha_char, true, char_class::scheme_char, char_class::scheme_char, false > {};
+
+   struct reg_name : internal::span< uri::reg_name, char_class::reg_name_char, false > {};
+   struct userinfo : internal::span< uri::userinfo, char_class::userinfo_char, false > {};
+   struct port : internal::span< uri::port, char_class::digit_char, false, 0, 0, false > {};
+
+   struct query : internal::span< uri::query, char_class::query_char, false > {};
+   struct fragment : internal::span< uri::fragment, char_class::query_char, false > {};
+
+   // In all paths "/" is followed by segment, hence star< one< '/' >, segment > is a run of path characters.
+   struct path_abempty : internal::span< uri::path_abempty, 0, false, char_class::slash_char, char_class::path_char > {};
+   struct path_absolute : seq< one< '/' >, opt< not_at< one< '/' > >, internal::span< uri::path_abempty, char_class::path_char, false > > >
+   {
+      using analyze_t = uri::path_absolute::analyze_t;
+   };
+   struct path_noscheme : internal::span< uri::path_noscheme, char_class::segment_nc_char, true, char_class::slash_char, char_class::path_char > {};
+   struct path_rootless : internal::span< uri::path_rootless, char_class::pchar, true, char_class::slash_char, char_class::path_char > {};
+   struct path_empty : uri::path_empty {};
+
+   struct host : sor< uri::IP_literal, uri::IPv4address, reg_name > {};
+   struct opt_userinfo : opt< userinfo, one< '@' > > {};
+   struct authority : seq< opt_userinfo, host, opt< uri::colon, port > > {};
+
+   using opt_query = opt_must< one< '?' >, query >;
+   using opt_fragment = opt_must< one< '#' >, fragment >;
+
+   struct hier_part : sor< if_must< uri::dslash, authority, path_abempty >, path_rootless, path_absolute, path_empty > {};
+   struct relative_part : sor< if_must< uri::dslash, authority, path_abempty >, path_noscheme, path_absolute, path_empty > {};
+   struct relative_ref : seq< relative_part, opt_query, opt_fragment > {};
+
+   struct URI : seq< scheme, one< ':' >, hier_part, opt_query, opt_fragment > {};
+   struct URI_reference : sor< URI, relative_ref > {};
+   struct absolute_URI : seq< scheme, one< ':' >, hier_part, opt_query > {};
+   // clang-format on
+
+   // The components of a URI reference as views into the parsed data;
+   // optional components that are absent are std::nullopt, while present
+   // but empty components are empty views.
+
+   struct components
+   {
+      std::optional< std::string_view > scheme;
+      std::optional< std::string_view > authority;
+      std::optional< std::string_view > userinfo;
+      std::string_view host;
+      std::optional< std::string_view > port;
+      std::string_view path;
+      std::optional< std::string_view > query;
+      std::optional< std::string_view > fragment;
+   };
+
+   template< typename Rule >
+   struct components_action
+      : nothing< Rule >
+   {
+   };
+
+   namespace internal
+   {
+      template< auto Member >
+      struct bind
+      {
+         template< typename Input >
+         static void apply( const Input& in, components& c )
+         {
+            c.*Member = std::string_view( in.begin(), in.size() );
+         }
+      };
+
+   }  // namespace internal
+
+   // clang-format off
+   template<> struct components_action< scheme > : internal::bind< &components::scheme > {};
+   template<> struct components_action< authority > : internal::bind< &components::authority > {};
+   template<> struct components_action< host > : internal::bind< &components::host > {};
+   template<> struct components_action< port > : internal::bind< &components::port > {};
+   template<> struct components_action< path_abempty > : internal::bind< &components::path > {};
+   template<> struct components_action< path_absolute > : internal::bind< &components::path > {};
+   template<> struct components_action< path_noscheme > : internal::bind< &components::path > {};
+   template<> struct components_action< path_rootless > : internal::bind< &components::path > {};
+   template<> struct components_action< query > : internal::bind< &components::query > {};
+   template<> struct components_action< fragment > : internal::bind< &components::fragment > {};
+   // clang-format on
+
+   template<>
+   struct components_action< opt_userinfo >
+   {
+      template< typename Input >
+      static void apply( const Input& in, components& c )
+      {
+         if( !in.empty() ) {
+            c.userinfo = std::string_view( in.begin(), in.size() - 1 );
+         }
+      }
+   };
+
+   // Splits a URI reference into its components, throws parse_error when
+   // the data is not a valid URI reference. Equivalent to parsing with
+   // must< URI_reference, eof >, but the actions of a failed attempt at URI
+   // are discarded before trying relative_ref.
+
+   [[nodiscard]] inline components split( const std::string_view data, const std::string& source = "URI reference" )
+   {
+      components c;
+      memory_input< tracking_mode::lazy, eol::lf_crlf, const std::string& > in( data.data(), data.data() + data.size(), source );
+      if( TAO_PEGTL_NAMESPACE::parse< URI, components_action >( in, c ) ) {
+         (void)TAO_PEGTL_NAMESPACE::parse< must< eof > >( in );
+         return c;
+      }
+      c = components();
+      (void)TAO_PEGTL_NAMESPACE::parse< must< relative_ref, eof >, components_action >( in, c );
+      return c;
+   }
+
+   namespace internal
+   {
+      // Converts two hex digits with one 16-bit SWAR step; for '0' to '9',
+      // 'A' to 'F' and 'a' to 'f' the low nibble plus 9 if bit 6 is set is
+      // the value of the digit.
+
+      [[nodiscard]] inline char hex_pair( const char* p ) noexcept
+      {
+         const auto v = std::uint16_t( ( static_cast< unsigned char >( p[ 0 ] ) << 8 ) | static_cast< unsigned char >( p[ 1 ] ) );
+         const auto n = std::uint16_t( ( v & 0x0F0F ) + 9 * ( ( v >> 6 ) & 0x0101 ) );
+         return char( ( ( n >> 4 ) & 0xF0 ) | ( n & 0x0F ) );
+      }
+
+   }  // namespace internal
+
+   // Decodes the pct-encoded octets in [ data, data + size ) in place and
+   // returns the new size; "%" that is not followed by two hex digits is
+   // left unchanged.
+
+   [[nodiscard]] inline std::size_t percent_decode( char* const data, const std::size_t size ) noexcept
+   {
+      const char* p = data;
+      const char* const e = data + size;
+      const char* pct = static_cast< const char* >( std::memchr( p, '%', size ) );
+      if( pct == nullptr ) {
+         return size;
+      }
+      char* o = data + ( pct - data );
+      p = pct;
+      while( true ) {
+         if( ( e - p >= 3 ) && internal::is( p[ 1 ], internal::hex_char ) && internal::is( p[ 2 ], internal::hex_char ) ) {
+            *o++ = internal::hex_pair( p + 1 );
+            p += 3;
+         }
+         else {
+            *o++ = *p++;
+         }
+         pct = static_cast< const char* >( std::memchr( p, '%', std::size_t( e - p ) ) );
+         const char* const next = ( pct != nullptr ) ? pct : e;
+         std::memmove( o, p, std::size_t( next - p ) );
+         o += next - p;
+         p = next;
+         if( pct == nullptr ) {
+            return std::size_t( o - data );
+         }
+      }
+   }
+
+   // Decodes user information, host, path, query and fragment of c in
+   // place, where c was obtained by splitting data. Each component is
+   // overwritten by its decoded form, which is never longer, and its view
+   // is shortened accordingly. The authority view still refers to the
+   // same bytes, which no longer contain the original authority.
+
+   inline void decode_in_place( components& c, std::string& data ) noexcept
+   {
+      const auto decode = [ & ]( std::string_view& v ) {
+         if( !v.empty() ) {
+            char* p = data.data() + ( v.data() - data.data() );
+            v = std::string_view( p, percent_decode( p, v.size() ) );
+         }
+      };
+      if( c.userinfo ) {
+         decode( *c.userinfo );
+      }
+      decode( c.host );
+      decode( c.path );
+      if( c.query ) {
+         decode( *c.query );
+      }
+      if( c.fragment ) {
+         decode( *c.fragment );
+      }
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE::uri::parser
+
+#endif
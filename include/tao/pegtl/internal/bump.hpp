@@ -4,6 +4,9 @@
 #ifndef TAO_PEGTL_INTERNAL_BUMP_HPP
 #define TAO_PEGTL_INTERNAL_BUMP_HPP
 
+#include <cstddef>
+#include <cstring>
+
 #include "../config.hpp"
 
 #include "iterator.hpp"
@@ -12,6 +15,21 @@ namespace TAO_PEGTL_NAMESPACE::internal
 {
    inline void bump( iterator& iter, const std::size_t count, const int ch ) noexcept
    {
+      if( count >= 16 ) {
+         // Rules that consume many bytes at once, e.g. comments, are
+         // accounted for with one memchr() per line.
+         const char* p = iter.data;
+         const char* const e = p + count;
+         while( const auto* n = static_cast< const char* >( std::memchr( p, ch, std::size_t( e - p ) ) ) ) {
+            ++iter.line;
+            iter.byte_in_line = 0;
+            p = n + 1;
+         }
+         iter.byte_in_line += std::size_t( e - p );
+         iter.byte += count;
+         iter.data += count;
+         return;
+      }
       for( std::size_t i = 0; i < count; ++i ) {
          if( iter.data[ i ] == ch ) {
             ++iter.line;
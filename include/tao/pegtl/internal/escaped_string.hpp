@@ -0,0 +1,49 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_INTERNAL_ESCAPED_STRING_HPP
+#define TAO_PEGTL_INTERNAL_ESCAPED_STRING_HPP
+
+#include <cstddef>
+
+#include "../config.hpp"
+
+#include "simd.hpp"
+#include "skip_control.hpp"
+
+#include "../analysis/generic.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::internal
+{
+   // Returns the closing quote of a quoted string, or the line end or end
+   // of input when there is none; a backslash escapes the next byte.
+
+   [[nodiscard]] inline const char* escaped_string_end( const char* p, const char* e ) noexcept
+   {
+      while( ( ( p = simd::find_first( p, e, []( const simd::block64& b ) { return b.eq< '"', '\\', '\n' >(); } ) ) != e ) && ( *p == '\\' ) ) {
+         p += ( e - p > 1 ) ? 2 : 1;
+      }
+      return p;
+   }
+
+   // Matches the content of a quoted string up to escaped_string_end(),
+   // as used by several log formats; requires a memory input.
+
+   struct escaped_string
+   {
+      using analyze_t = analysis::generic< analysis::rule_type::opt >;
+
+      template< typename Input >
+      [[nodiscard]] static bool match( Input& in ) noexcept( noexcept( in.end() ) )
+      {
+         in.bump_in_this_line( std::size_t( escaped_string_end( in.current(), in.end() ) - in.current() ) );
+         return true;
+      }
+   };
+
+   template<>
+   inline constexpr bool skip_control< escaped_string > = true;
+
+}  // namespace TAO_PEGTL_NAMESPACE::internal
+
+#endif
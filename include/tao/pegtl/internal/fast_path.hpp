@@ -0,0 +1,119 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_INTERNAL_FAST_PATH_HPP
+#define TAO_PEGTL_INTERNAL_FAST_PATH_HPP
+
+#include <type_traits>
+#include <utility>
+
+#include "../apply_mode.hpp"
+#include "../config.hpp"
+#include "../normal.hpp"
+#include "../rewind_mode.hpp"
+
+#include "has_apply.hpp"
+#include "has_apply0.hpp"
+
+namespace TAO_PEGTL_NAMESPACE::internal
+{
+   // Rules with hand-written scanning loops can only bypass the matching
+   // of their sub-rules when nobody can observe the difference, i.e. when
+   // no action is attached to the sub-rule and the control class does not
+   // customise the start(), success(), failure() or match() of normal<>.
+   // Raising errors is always delegated to the regular matching code.
+
+   template< typename C, typename N, typename Input, typename... States >
+   [[nodiscard]] constexpr auto same_start( int /*unused*/ ) -> decltype( &C::template start< Input, States... >, bool() )
+   {
+      if constexpr( std::is_same_v< decltype( &C::template start< Input, States... > ), decltype( &N::template start< Input, States... > ) > ) {
+         return &C::template start< Input, States... > == &N::template start< Input, States... >;
+      }
+      return false;
+   }
+
+   template< typename C, typename N, typename Input, typename... States >
+   [[nodiscard]] constexpr bool same_start( long /*unused*/ )
+   {
+      return false;
+   }
+
+   template< typename C, typename N, typename Input, typename... States >
+   [[nodiscard]] constexpr auto same_success( int /*unused*/ ) -> decltype( &C::template success< Input, States... >, bool() )
+   {
+      if constexpr( std::is_same_v< decltype( &C::template success< Input, States... > ), decltype( &N::template success< Input, States... > ) > ) {
+         return &C::template success< Input, States... > == &N::template success< Input, States... >;
+      }
+      return false;
+   }
+
+   template< typename C, typename N, typename Input, typename... States >
+   [[nodiscard]] constexpr bool same_success( long /*unused*/ )
+   {
+      return false;
+   }
+
+   template< typename C, typename N, typename Input, typename... States >
+   [[nodiscard]] constexpr auto same_failure( int /*unused*/ ) -> decltype( &C::template failure< Input, States... >, bool() )
+   {
+      if constexpr( std::is_same_v< decltype( &C::template failure< Input, States... > ), decltype( &N::template failure< Input, States... > ) > ) {
+         return &C::template failure< Input, States... > == &N::template failure< Input, States... >;
+      }
+      return false;
+   }
+
+   template< typename C, typename N, typename Input, typename... States >
+   [[nodiscard]] constexpr bool same_failure( long /*unused*/ )
+   {
+      return false;
+   }
+
+   template< typename C, typename N, apply_mode A, template< typename... > class Action, template< typename... > class Control, typename Input, typename... States >
+   [[nodiscard]] constexpr auto same_match( int /*unused*/ ) -> decltype( &C::template match< A, rewind_mode::required, Action, Control, Input, States... >, bool() )
+   {
+      if constexpr( std::is_same_v< decltype( &C::template match< A, rewind_mode::required, Action, Control, Input, States... > ), decltype( &N::template match< A, rewind_mode::required, Action, Control, Input, States... > ) > ) {
+         return &C::template match< A, rewind_mode::required, Action, Control, Input, States... > == &N::template match< A, rewind_mode::required, Action, Control, Input, States... >;
+      }
+      return false;
+   }
+
+   template< typename C, typename N, apply_mode A, template< typename... > class Action, template< typename... > class Control, typename Input, typename... States >
+   [[nodiscard]] constexpr bool same_match( long /*unused*/ )
+   {
+      return false;
+   }
+
+   template< typename Rule, apply_mode A, template< typename... > class Action, template< typename... > class Control, typename Input, typename... States >
+   [[nodiscard]] constexpr bool has_any_apply() noexcept
+   {
+      if constexpr( A == apply_mode::nothing ) {
+         return false;
+      }
+      else {
+         using iterator_t = typename Input::iterator_t;
+         return has_apply< Control< Rule >, void, Action, const iterator_t&, const Input&, States... >::value
+                || has_apply< Control< Rule >, bool, Action, const iterator_t&, const Input&, States... >::value
+                || has_apply0< Control< Rule >, void, Action, const Input&, States... >::value
+                || has_apply0< Control< Rule >, bool, Action, const Input&, States... >::value;
+      }
+   }
+
+   template< typename Rule, apply_mode A, template< typename... > class Action, template< typename... > class Control, typename Input, typename... States >
+   inline constexpr bool fast_path_v = ( !has_any_apply< Rule, A, Action, Control, Input, States... >() )
+                                       && same_start< Control< Rule >, normal< Rule >, Input, States... >( 0 )
+                                       && same_success< Control< Rule >, normal< Rule >, Input, States... >( 0 )
+                                       && same_failure< Control< Rule >, normal< Rule >, Input, States... >( 0 )
+                                       && same_match< Control< Rule >, normal< Rule >, A, Action, Control, Input, States... >( 0 );
+
+   // Inputs that keep all data in one contiguous range of memory, i.e.
+   // where the remaining input is always [ in.current(), in.end() ).
+
+   template< typename Input, typename = void >
+   inline constexpr bool is_memory_input_v = false;
+
+   template< typename Input >
+   inline constexpr bool is_memory_input_v< Input, std::enable_if_t< std::is_same_v< decltype( std::declval< const Input& >().begin() ), const char* > > > = true;
+
+}  // namespace TAO_PEGTL_NAMESPACE::internal
+
+#endif
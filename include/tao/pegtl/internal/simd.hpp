@@ -0,0 +1,207 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_INTERNAL_SIMD_HPP
+#define TAO_PEGTL_INTERNAL_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "../config.hpp"
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+#define TAO_PEGTL_INTERNAL_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined( __PCLMUL__ )
+#define TAO_PEGTL_INTERNAL_SIMD_PCLMUL 1
+#include <wmmintrin.h>
+#endif
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+namespace TAO_PEGTL_NAMESPACE::internal::simd
+{
+   // Building blocks for scanners that classify 64 input bytes at a time
+   // into 64-bit masks (bit i corresponds to byte i). Uses SSE2 where it
+   // is available, everything else falls back to (auto-vectorisable)
+   // scalar loops with identical results.
+
+   [[nodiscard]] inline unsigned ctz64( const std::uint64_t x ) noexcept
+   {
+      // Assumes x != 0.
+#if defined( _MSC_VER ) && defined( _M_X64 )
+      unsigned long r;
+      _BitScanForward64( &r, x );
+      return unsigned( r );
+#elif defined( _MSC_VER )
+      unsigned long r;
+      if( _BitScanForward( &r, std::uint32_t( x ) ) ) {
+         return unsigned( r );
+      }
+      _BitScanForward( &r, std::uint32_t( x >> 32 ) );
+      return unsigned( r ) + 32;
+#else
+      return unsigned( __builtin_ctzll( x ) );
+#endif
+   }
+
+   [[nodiscard]] inline unsigned popcount64( std::uint64_t x ) noexcept
+   {
+#if defined( _MSC_VER )
+      unsigned r = 0;
+      for( ; x != 0; x &= x - 1 ) {
+         ++r;
+      }
+      return r;
+#else
+      return unsigned( __builtin_popcountll( x ) );
+#endif
+   }
+
+   // Bit i of the result is the XOR of bits 0 to i of x.
+
+   [[nodiscard]] inline std::uint64_t prefix_xor( std::uint64_t x ) noexcept
+   {
+#if defined( TAO_PEGTL_INTERNAL_SIMD_PCLMUL )
+      const __m128i r = _mm_clmulepi64_si128( _mm_set_epi64x( 0, std::int64_t( x ) ), _mm_set1_epi8( -1 ), 0 );
+      return std::uint64_t( _mm_cvtsi128_si64( r ) );
+#else
+      x ^= x << 1;
+      x ^= x << 2;
+      x ^= x << 4;
+      x ^= x << 8;
+      x ^= x << 16;
+      x ^= x << 32;
+      return x;
+#endif
+   }
+
+   // Returns a + b and sets carry to whether the addition overflowed.
+
+   [[nodiscard]] inline std::uint64_t add_overflow( const std::uint64_t a, const std::uint64_t b, bool& carry ) noexcept
+   {
+      const std::uint64_t r = a + b;
+      carry = r < a;
+      return r;
+   }
+
+   class block64
+   {
+   public:
+      static constexpr std::size_t size = 64;
+
+      // Loads 64 bytes, p MUST point to at least 64 readable bytes.
+
+      explicit block64( const char* p ) noexcept
+      {
+         load( p );
+      }
+
+      // Loads n < 64 bytes and pads with the given byte.
+
+      block64( const char* p, const std::size_t n, const char pad = 0 ) noexcept
+      {
+         char tmp[ size ];
+         std::memset( tmp, pad, size );
+         std::memcpy( tmp, p, n );
+         load( tmp );
+      }
+
+      // Bytes equal to any of Cs.
+
+      template< char... Cs >
+      [[nodiscard]] std::uint64_t eq() const noexcept
+      {
+#if defined( TAO_PEGTL_INTERNAL_SIMD_SSE2 )
+         std::uint64_t r = 0;
+         for( unsigned i = 0; i < 4; ++i ) {
+            const __m128i v = m_v[ i ];
+            __m128i m = _mm_setzero_si128();
+            ( ( m = _mm_or_si128( m, _mm_cmpeq_epi8( v, _mm_set1_epi8( Cs ) ) ) ), ... );
+            r |= std::uint64_t( std::uint16_t( _mm_movemask_epi8( m ) ) ) << ( 16 * i );
+         }
+         return r;
+#else
+         std::uint64_t r = 0;
+         for( unsigned i = 0; i < size; ++i ) {
+            r |= std::uint64_t( ( ( m_c[ i ] == Cs ) || ... ) ) << i;
+         }
+         return r;
+#endif
+      }
+
+      // Bytes c with Lo <= c <= Hi, compared as unsigned values.
+
+      template< unsigned char Lo, unsigned char Hi >
+      [[nodiscard]] std::uint64_t in_range() const noexcept
+      {
+         static_assert( Lo <= Hi );
+#if defined( TAO_PEGTL_INTERNAL_SIMD_SSE2 )
+         const __m128i lo = _mm_set1_epi8( char( Lo ) );
+         const __m128i d = _mm_set1_epi8( char( Hi - Lo ) );
+         std::uint64_t r = 0;
+         for( unsigned i = 0; i < 4; ++i ) {
+            const __m128i x = _mm_sub_epi8( m_v[ i ], lo );
+            const __m128i m = _mm_cmpeq_epi8( _mm_max_epu8( x, d ), d );
+            r |= std::uint64_t( std::uint16_t( _mm_movemask_epi8( m ) ) ) << ( 16 * i );
+         }
+         return r;
+#else
+         std::uint64_t r = 0;
+         for( unsigned i = 0; i < size; ++i ) {
+            const auto c = static_cast< unsigned char >( m_c[ i ] );
+            r |= std::uint64_t( ( Lo <= c ) && ( c <= Hi ) ) << i;
+         }
+         return r;
+#endif
+      }
+
+   private:
+      void load( const char* p ) noexcept
+      {
+#if defined( TAO_PEGTL_INTERNAL_SIMD_SSE2 )
+         for( unsigned i = 0; i < 4; ++i ) {
+            m_v[ i ] = _mm_loadu_si128( reinterpret_cast< const __m128i* >( p + 16 * i ) );
+         }
+#else
+         std::memcpy( m_c, p, size );
+#endif
+      }
+
+#if defined( TAO_PEGTL_INTERNAL_SIMD_SSE2 )
+      __m128i m_v[ 4 ];
+#else
+      char m_c[ size ];
+#endif
+   };
+
+   // Returns the first byte in [ begin, end ) whose bit is set in the
+   // mask returned by c() for its block, or end when there is none. The
+   // last, incomplete block is padded with Pad before being classified.
+
+   template< char Pad = 0, typename Classify >
+   [[nodiscard]] const char* find_first( const char* begin, const char* end, Classify&& c ) noexcept
+   {
+      while( end - begin >= std::ptrdiff_t( block64::size ) ) {
+         if( const std::uint64_t m = c( block64( begin ) ) ) {
+            return begin + ctz64( m );
+         }
+         begin += block64::size;
+      }
+      if( begin != end ) {
+         const auto n = std::size_t( end - begin );
+         if( const std::uint64_t m = c( block64( begin, n, Pad ) ) & ( ~std::uint64_t( 0 ) >> ( block64::size - n ) ) ) {
+            return begin + ctz64( m );
+         }
+      }
+      return end;
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE::internal::simd
+
+#endif
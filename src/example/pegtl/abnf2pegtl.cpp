@@ -2,9 +2,12 @@
 // Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
 
 #include <algorithm>
+#include <bitset>
+#include <iomanip>
 #include <iostream>
 #include <iterator>
 #include <map>
+#include <optional>
 #include <set>
 #include <sstream>
 #include <string>
@@ -377,14 +380,6 @@ namespace TAO_PEGTL_NAMESPACE::abnf
    std::string to_string( const node_ptr& n );
    std::string to_string( const std::vector< node_ptr >& v );
 
-   std::string to_string_unwrap_seq( const node_ptr& n )
-   {
-      if( n->is_type< grammar::group >() || n->is_type< grammar::concatenation >() ) {
-         return to_string( n->children );
-      }
-      return to_string( n );
-   }
-
    namespace
    {
       std::string get_rulename( const node_ptr& n )
@@ -493,6 +488,565 @@ namespace TAO_PEGTL_NAMESPACE::abnf
       }
    };
 
+   namespace
+   {
+      // Optimisation stage: Alternations and concatenations are not
+      // emitted node by node, instead they are first converted into
+      // sequences of elements that either match a single character from
+      // a set, or that are opaque, i.e. already emitted, rules. This
+      // allows to merge adjacent literal characters into string<> or
+      // istring<>, to left-factor alternatives that start with the same
+      // elements, which turns alternations of literals into tries, and
+      // to collapse alternatives that match a single character into
+      // one<>, range<> or ranges<>.
+      //
+      // All transformations preserve the PEG semantics, alternatives are
+      // only moved past other alternatives that start with a disjoint
+      // set of characters.
+
+      using char_set = std::bitset< 256 >;
+
+      struct element
+      {
+         char_set chars;     // matched characters, or FIRST set of opaque elements
+         std::string rule;   // for opaque elements
+         std::string name;   // for single character elements from core rules
+         char spelling = 0;  // for case-insensitive letters
+
+         [[nodiscard]] bool is_char() const noexcept
+         {
+            return rule.empty();
+         }
+
+         [[nodiscard]] bool operator==( const element& other ) const noexcept
+         {
+            return ( rule == other.rule ) && ( is_char() ? ( chars == other.chars ) : true );
+         }
+      };
+
+      using sequence = std::vector< element >;
+
+      char_set make_char_set( const std::initializer_list< std::pair< unsigned, unsigned > >& ranges )
+      {
+         char_set r;
+         for( const auto& [ lo, hi ] : ranges ) {
+            for( auto c = lo; c <= hi; ++c ) {
+               r.set( c );
+            }
+         }
+         return r;
+      }
+
+      // The single character core rules from RFC 5234, inlined when the
+      // grammar does not define them.
+
+      const std::map< std::string, char_set, ccmp > core_rules = {
+         { "ALPHA", make_char_set( { { 0x41, 0x5A }, { 0x61, 0x7A } } ) },
+         { "BIT", make_char_set( { { 0x30, 0x31 } } ) },
+         { "CHAR", make_char_set( { { 0x01, 0x7F } } ) },
+         { "CR", make_char_set( { { 0x0D, 0x0D } } ) },
+         { "CTL", make_char_set( { { 0x00, 0x1F }, { 0x7F, 0x7F } } ) },
+         { "DIGIT", make_char_set( { { 0x30, 0x39 } } ) },
+         { "DQUOTE", make_char_set( { { 0x22, 0x22 } } ) },
+         { "HEXDIG", make_char_set( { { 0x30, 0x39 }, { 0x41, 0x46 }, { 0x61, 0x66 } } ) },
+         { "HTAB", make_char_set( { { 0x09, 0x09 } } ) },
+         { "LF", make_char_set( { { 0x0A, 0x0A } } ) },
+         { "OCTET", make_char_set( { { 0x00, 0xFF } } ) },
+         { "SP", make_char_set( { { 0x20, 0x20 } } ) },
+         { "VCHAR", make_char_set( { { 0x21, 0x7E } } ) },
+         { "WSP", make_char_set( { { 0x09, 0x09 }, { 0x20, 0x20 } } ) }
+      };
+
+      const char_set* find_core_rule( const node_ptr& n )
+      {
+         const auto v = get_rulename( n );
+         if( find_rule( rules_defined, v ) != rules_defined.rend() ) {
+            return nullptr;
+         }
+         const auto it = core_rules.find( v );
+         return ( it != core_rules.end() ) ? &it->second : nullptr;
+      }
+
+      [[nodiscard]] bool is_letter( const unsigned c ) noexcept
+      {
+         return ( ( c >= 'a' ) && ( c <= 'z' ) ) || ( ( c >= 'A' ) && ( c <= 'Z' ) );
+      }
+
+      [[nodiscard]] bool is_num_val( const node_ptr& n )
+      {
+         return n->is_type< grammar::hex_val::type >() || n->is_type< grammar::dec_val::type >() || n->is_type< grammar::bin_val::type >();
+      }
+
+      std::optional< unsigned > byte_value( const node_ptr& n )
+      {
+         const auto v = remove_leading_zeroes( n->string() );
+         if( v.size() > 8 ) {
+            return std::nullopt;
+         }
+         const int base = n->is_type< grammar::hex_val::value >() ? 16 : ( n->is_type< grammar::bin_val::value >() ? 2 : 10 );
+         const auto r = std::stoul( '0' + v, nullptr, base );
+         if( r > 0xFF ) {
+            return std::nullopt;
+         }
+         return unsigned( r );
+      }
+
+      // Returns the single character elements for a numerical value, or
+      // an empty sequence when the values do not fit into a char.
+      sequence num_val_elements( const node_ptr& n )
+      {
+         sequence r;
+         if( ( n->children.size() == 2 ) && !n->children.back()->children.empty() ) {
+            const auto lo = byte_value( n->children.front() );
+            const auto hi = byte_value( n->children.back()->children.front() );
+            if( lo && hi && ( *lo <= *hi ) ) {
+               r.emplace_back().chars = make_char_set( { { *lo, *hi } } );
+            }
+            return r;
+         }
+         for( const auto& c : n->children ) {
+            const auto v = byte_value( c );
+            if( !v ) {
+               return sequence();
+            }
+            r.emplace_back().chars.set( *v );
+         }
+         return r;
+      }
+
+      // FIRST sets allow reordering alternatives past rules, and are
+      // used to flag alternations where the first character decides
+      // which alternative to take; once the first element of such an
+      // alternative matched, the rest could be wrapped in must<>.
+
+      struct first_set
+      {
+         char_set chars;
+         bool nullable = false;
+      };
+
+      first_set unknown_first()
+      {
+         first_set r;
+         r.chars.set();
+         r.nullable = true;
+         return r;
+      }
+
+      first_set first( const node_ptr& n, std::set< const parse_tree::node* >& active )
+      {
+         first_set r;
+         if( n->is_type< string_tag >() || n->is_type< one_tag >() || n->is_type< istring_tag >() ) {
+            const auto content = n->string_view();
+            if( content.empty() ) {
+               r.nullable = true;
+            }
+            else {
+               const auto c = static_cast< unsigned char >( content.front() );
+               r.chars.set( c );
+               if( n->is_type< istring_tag >() && is_letter( c ) ) {
+                  r.chars.set( c ^ 0x20 );
+               }
+            }
+         }
+         else if( is_num_val( n ) ) {
+            const auto v = num_val_elements( n );
+            if( v.empty() ) {
+               return unknown_first();
+            }
+            r.chars = v.front().chars;
+         }
+         else if( n->is_type< grammar::rulename >() ) {
+            const auto p = previous_rules.find( get_rulename( n ) );
+            if( p != previous_rules.end() ) {
+               if( !active.insert( p->second ).second ) {
+                  return unknown_first();
+               }
+               r = first( p->second->children.back(), active );
+               active.erase( p->second );
+            }
+            else if( const auto* core = find_core_rule( n ) ) {
+               r.chars = *core;
+            }
+            else {
+               r = unknown_first();
+            }
+         }
+         else if( n->is_type< grammar::alternation >() ) {
+            for( const auto& c : n->children ) {
+               const auto f = first( c, active );
+               r.chars |= f.chars;
+               r.nullable = r.nullable || f.nullable;
+            }
+         }
+         else if( n->is_type< grammar::concatenation >() ) {
+            r.nullable = true;
+            for( auto it = n->children.begin(); r.nullable && ( it != n->children.end() ); ++it ) {
+               const auto f = first( *it, active );
+               r.chars |= f.chars;
+               r.nullable = f.nullable;
+            }
+         }
+         else if( n->is_type< grammar::option >() ) {
+            r = first( n->children.front(), active );
+            r.nullable = true;
+         }
+         else if( n->is_type< grammar::repetition >() ) {
+            r = first( n->children.back(), active );
+            const auto rep = n->children.front()->string();
+            r.nullable = r.nullable || remove_leading_zeroes( rep.substr( 0, rep.find( '*' ) ) ).empty();
+         }
+         else if( n->is_type< grammar::and_predicate >() || n->is_type< grammar::not_predicate >() ) {
+            r.nullable = true;
+         }
+         else {
+            r = unknown_first();
+         }
+         return r;
+      }
+
+      first_set first( const node_ptr& n )
+      {
+         std::set< const parse_tree::node* > active;
+         return first( n, active );
+      }
+
+      void append_elements( sequence& s, const node_ptr& n )
+      {
+         if( n->is_type< grammar::concatenation >() ) {
+            for( const auto& c : n->children ) {
+               append_elements( s, c );
+            }
+         }
+         else if( n->is_type< string_tag >() || n->is_type< one_tag >() ) {
+            for( const auto c : n->string_view() ) {
+               s.emplace_back().chars.set( static_cast< unsigned char >( c ) );
+            }
+         }
+         else if( n->is_type< istring_tag >() ) {
+            for( const auto c : n->string_view() ) {
+               auto& e = s.emplace_back();
+               e.chars.set( static_cast< unsigned char >( c ) );
+               if( is_letter( static_cast< unsigned char >( c ) ) ) {
+                  e.chars.set( static_cast< unsigned char >( c ^ 0x20 ) );
+                  e.spelling = c;
+               }
+            }
+         }
+         else if( const auto v = is_num_val( n ) ? num_val_elements( n ) : sequence(); !v.empty() ) {
+            s.insert( s.end(), v.begin(), v.end() );
+         }
+         else if( const auto* core = n->is_type< grammar::rulename >() ? find_core_rule( n ) : nullptr ) {
+            auto& e = s.emplace_back();
+            e.chars = *core;
+            e.name = to_string( n );
+         }
+         else {
+            auto& e = s.emplace_back();
+            e.rule = to_string( n );
+            const auto f = first( n );
+            e.chars = f.nullable ? ~char_set() : f.chars;
+         }
+      }
+
+      void append_alternatives( std::vector< sequence >& v, const node_ptr& n )
+      {
+         if( n->is_type< grammar::alternation >() ) {
+            for( const auto& c : n->children ) {
+               append_alternatives( v, c );
+            }
+         }
+         else {
+            append_elements( v.emplace_back(), n );
+         }
+      }
+
+      std::string char_literal( const unsigned c )
+      {
+         std::string s;
+         if( ( c >= 0x20 ) && ( c < 0x7F ) ) {
+            append_char( s, char( c ) );
+            return s;
+         }
+         std::ostringstream o;
+         o << "0x" << std::hex << std::uppercase << std::setw( 2 ) << std::setfill( '0' ) << c;
+         return ( c < 0x80 ) ? o.str() : ( "char( " + o.str() + " )" );
+      }
+
+      std::string join( const std::vector< std::string >& v )
+      {
+         std::string r;
+         for( const auto& s : v ) {
+            if( !r.empty() ) {
+               r += ", ";
+            }
+            r += s;
+         }
+         return r;
+      }
+
+      std::string wrap( const char* rule, const std::vector< std::string >& v )
+      {
+         if( v.empty() ) {
+            return prefix + "success";
+         }
+         if( v.size() == 1 ) {
+            return v.front();
+         }
+         return prefix + rule + "< " + join( v ) + " >";
+      }
+
+      std::string char_set_to_string( const char_set& s )
+      {
+         if( s.all() ) {
+            return prefix + "any";
+         }
+         std::vector< std::pair< unsigned, unsigned > > runs;
+         for( unsigned c = 0; c < s.size(); ++c ) {
+            if( s.test( c ) ) {
+               if( !runs.empty() && ( runs.back().second + 1 == c ) ) {
+                  runs.back().second = c;
+               }
+               else {
+                  runs.emplace_back( c, c );
+               }
+            }
+         }
+         if( std::all_of( runs.begin(), runs.end(), []( const auto& r ) { return r.second - r.first < 2; } ) ) {
+            std::vector< std::string > v;
+            for( unsigned c = 0; c < s.size(); ++c ) {
+               if( s.test( c ) ) {
+                  v.emplace_back( char_literal( c ) );
+               }
+            }
+            return prefix + "one< " + join( v ) + " >";
+         }
+         if( runs.size() == 1 ) {
+            return prefix + "range< " + char_literal( runs.front().first ) + ", " + char_literal( runs.front().second ) + " >";
+         }
+         // a single character can be given as last argument of ranges<>
+         const auto single = std::find_if( runs.begin(), runs.end(), []( const auto& r ) { return r.first == r.second; } );
+         if( single != runs.end() ) {
+            std::rotate( single, single + 1, runs.end() );
+         }
+         std::vector< std::string > v;
+         for( const auto& [ lo, hi ] : runs ) {
+            v.emplace_back( char_literal( lo ) );
+            if( ( lo != hi ) || ( &runs.back().first != &lo ) ) {
+               v.emplace_back( char_literal( hi ) );
+            }
+         }
+         return prefix + "ranges< " + join( v ) + " >";
+      }
+
+      enum class literal_kind
+      {
+         none,
+         neutral,
+         sensitive,
+         insensitive
+      };
+
+      [[nodiscard]] literal_kind get_literal_kind( const element& e )
+      {
+         if( !e.is_char() || !e.name.empty() ) {
+            return literal_kind::none;
+         }
+         for( unsigned c = 'A'; c <= 'Z'; ++c ) {
+            if( ( e.chars.count() == 2 ) && e.chars.test( c ) && e.chars.test( c ^ 0x20 ) ) {
+               return literal_kind::insensitive;
+            }
+         }
+         if( e.chars.count() != 1 ) {
+            return literal_kind::none;
+         }
+         for( unsigned c = 0; c < e.chars.size(); ++c ) {
+            if( e.chars.test( c ) ) {
+               return is_letter( c ) ? literal_kind::sensitive : literal_kind::neutral;
+            }
+         }
+         return literal_kind::none;
+      }
+
+      std::string literal_char( const element& e )
+      {
+         if( e.spelling != 0 ) {
+            return char_literal( static_cast< unsigned char >( e.spelling ) );
+         }
+         for( unsigned c = 0; c < e.chars.size(); ++c ) {
+            if( e.chars.test( c ) ) {
+               return char_literal( ( e.chars.count() == 2 ) ? ( c | 0x20 ) : c );
+            }
+         }
+         return "";
+      }
+
+      // Emits each element, merging runs of literal characters.
+      std::vector< std::string > sequence_to_strings( const sequence& s )
+      {
+         std::vector< std::string > r;
+         for( std::size_t i = 0; i < s.size(); ) {
+            bool sensitive = false;
+            bool insensitive = false;
+            std::size_t j = i;
+            for( ; j < s.size(); ++j ) {
+               const auto k = get_literal_kind( s[ j ] );
+               if( ( k == literal_kind::none ) || ( ( k == literal_kind::sensitive ) && insensitive ) || ( ( k == literal_kind::insensitive ) && sensitive ) ) {
+                  break;
+               }
+               sensitive = sensitive || ( k == literal_kind::sensitive );
+               insensitive = insensitive || ( k == literal_kind::insensitive );
+            }
+            if( j == i ) {
+               const auto& e = s[ i++ ];
+               r.emplace_back( !e.is_char() ? e.rule : ( !e.name.empty() ? e.name : char_set_to_string( e.chars ) ) );
+               continue;
+            }
+            std::vector< std::string > v;
+            for( ; i < j; ++i ) {
+               v.emplace_back( literal_char( s[ i ] ) );
+            }
+            r.emplace_back( prefix + ( insensitive ? "istring< " : ( ( v.size() == 1 ) ? "one< " : "string< " ) ) + join( v ) + " >" );
+         }
+         return r;
+      }
+
+      [[nodiscard]] bool disjoint( const element& a, const element& b )
+      {
+         return ( a.chars & b.chars ).none();
+      }
+
+      struct choice
+      {
+         element key;
+         std::vector< sequence > tails;
+      };
+
+      [[nodiscard]] bool is_single( const choice& c )
+      {
+         return c.key.is_char() && ( c.tails.size() == 1 ) && c.tails.front().empty();
+      }
+
+      // Returns the empty string when the first alternative is empty.
+      std::string alternatives_to_string( const std::vector< sequence >& alternatives )
+      {
+         std::vector< choice > choices;
+         bool nullable = false;
+         for( const auto& a : alternatives ) {
+            if( a.empty() ) {
+               nullable = true;  // all further alternatives are unreachable
+               break;
+            }
+            // an alternative may join an earlier choice with the same first
+            // element, and a single character may join an earlier single
+            // character, when all choices in between start with disjoint
+            // characters
+            const bool single = ( a.size() == 1 ) && a.front().is_char();
+            auto it = choices.rbegin();
+            while( ( it != choices.rend() ) && !( it->key == a.front() ) && !( single && is_single( *it ) ) && disjoint( it->key, a.front() ) ) {
+               ++it;
+            }
+            if( ( it != choices.rend() ) && ( it->key == a.front() ) ) {
+               it->tails.emplace_back( a.begin() + 1, a.end() );
+            }
+            else if( ( it != choices.rend() ) && single && is_single( *it ) ) {
+               it->key.chars |= a.front().chars;
+               it->key.name.clear();
+               it->key.spelling = 0;
+            }
+            else {
+               choices.push_back( { a.front(), { sequence( a.begin() + 1, a.end() ) } } );
+            }
+         }
+         std::vector< std::string > items;
+         std::vector< const element* > singles;
+         const auto flush = [ & ]() {
+            if( singles.size() == 1 ) {
+               items.emplace_back( sequence_to_strings( { *singles.front() } ).front() );
+            }
+            else if( !singles.empty() ) {
+               char_set s;
+               for( const auto* e : singles ) {
+                  s |= e->chars;
+               }
+               items.emplace_back( char_set_to_string( s ) );
+            }
+            singles.clear();
+         };
+         for( auto& c : choices ) {
+            sequence common = { c.key };
+            while( std::all_of( c.tails.begin(), c.tails.end(), [ & ]( const sequence& t ) { return !t.empty() && ( t.front() == c.tails.front().front() ); } ) ) {
+               common.push_back( c.tails.front().front() );
+               for( auto& t : c.tails ) {
+                  t.erase( t.begin() );
+               }
+            }
+            const auto rest = alternatives_to_string( c.tails );
+            if( ( common.size() == 1 ) && c.key.is_char() && rest.empty() ) {
+               singles.push_back( &c.key );
+               continue;
+            }
+            flush();
+            if( !rest.empty() ) {
+               common.emplace_back().rule = rest;
+            }
+            items.emplace_back( wrap( "seq", sequence_to_strings( common ) ) );
+         }
+         flush();
+         if( items.empty() ) {
+            return "";
+         }
+         const auto r = wrap( "sor", items );
+         return nullable ? ( prefix + "opt< " + r + " >" ) : r;
+      }
+
+      std::vector< std::string > concatenation_to_strings( const node_ptr& n )
+      {
+         sequence s;
+         append_elements( s, n );
+         return sequence_to_strings( s );
+      }
+
+      std::string alternation_to_string( const node_ptr& n )
+      {
+         std::vector< sequence > v;
+         append_alternatives( v, n );
+         const auto r = alternatives_to_string( v );
+         return r.empty() ? ( prefix + "success" ) : r;
+      }
+
+      std::string must_note( const std::string& rname, const node_ptr& n )
+      {
+         if( !n->is_type< grammar::alternation >() ) {
+            return "";
+         }
+         char_set seen;
+         bool concatenation = false;
+         for( const auto& c : n->children ) {
+            const auto f = first( c );
+            if( f.nullable || ( f.chars & seen ).any() ) {
+               return "";
+            }
+            seen |= f.chars;
+            concatenation = concatenation || c->is_type< grammar::concatenation >();
+         }
+         if( !concatenation ) {
+            return "";
+         }
+         return "// note: the alternatives of " + rname + " are decided by their first character, consider must<> after the first element of each alternative\n";
+      }
+
+   }  // namespace
+
+   std::string to_string_unwrap_seq( const node_ptr& n )
+   {
+      if( n->is_type< grammar::concatenation >() ) {
+         const auto v = concatenation_to_strings( n );
+         return v.empty() ? ( prefix + "success" ) : join( v );
+      }
+      return to_string( n );
+   }
+
    struct stringifier
    {
       using function_t = std::string ( * )( const node_ptr& n );
@@ -526,7 +1080,9 @@ namespace TAO_PEGTL_NAMESPACE::abnf
       nrv.add< grammar::rulename >( []( const node_ptr& n ) { return get_rulename( n, true ); } );
 
       nrv.add< grammar::rule >( []( const node_ptr& n ) {
-         return "struct " + get_rulename( n->children.front(), false ) + " : " + to_string( n->children.back() ) + " {};";
+         const auto rname = get_rulename( n->children.front(), false );
+         const auto body = to_string( n->children.back() );
+         return must_note( rname, n->children.back() ) + "struct " + rname + " : " + body + " {};";
       } );
 
       nrv.add< string_tag >( []( const node_ptr& n ) {
@@ -575,7 +1131,7 @@ namespace TAO_PEGTL_NAMESPACE::abnf
       nrv.add< grammar::dec_val::type >( []( const node_ptr& n ) { return gen_val< grammar::dec_val::range >( n ); } );
       nrv.add< grammar::bin_val::type >( []( const node_ptr& n ) { return gen_val< grammar::bin_val::range >( n ); } );
 
-      nrv.add< grammar::alternation >( []( const node_ptr& n ) { return prefix + "sor< " + to_string( n->children ) + " >"; } );
+      nrv.add< grammar::alternation >( []( const node_ptr& n ) { return alternation_to_string( n ); } );
       nrv.add< grammar::option >( []( const node_ptr& n ) { return prefix + "opt< " + to_string( n->children ) + " >"; } );
       nrv.add< grammar::group >( []( const node_ptr& n ) { return prefix + "seq< " + to_string( n->children ) + " >"; } );
 
@@ -593,7 +1149,7 @@ namespace TAO_PEGTL_NAMESPACE::abnf
 
       nrv.add< grammar::concatenation >( []( const node_ptr& n ) {
          assert( !n->children.empty() );
-         return prefix + "seq< " + to_string( n->children ) + " >";
+         return wrap( "seq", concatenation_to_strings( n ) );
       } );
 
       nrv.add< grammar::repetition >( []( const node_ptr& n ) -> std::string {
@@ -0,0 +1,99 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <tao/pegtl.hpp>
+#include <tao/pegtl/contrib/csv.hpp>
+
+namespace pegtl = TAO_PEGTL_NAMESPACE;
+
+namespace examples
+{
+   // Synthetic input used when no files are given on the command line.
+
+   inline std::string generate_csv( const std::size_t records )
+   {
+      std::string r = "id,name,score,comment\r\n";
+      for( std::size_t i = 0; i < records; ++i ) {
+         const auto n = std::to_string( i );
+         r += n + ",record number " + n + ',' + n + ".25,";
+         r += ( i % 4 ) ? "plain comment" : "\"quoted, with \"\"quotes\"\"\"";
+         r += "\r\n";
+      }
+      return r;
+   }
+
+   template< typename Rule >
+   struct count_action
+      : pegtl::nothing< Rule >
+   {
+   };
+
+   template<>
+   struct count_action< pegtl::csv::field<> >
+   {
+      template< typename Input >
+      static void apply( const Input& /*unused*/, std::size_t& n )
+      {
+         ++n;
+      }
+   };
+
+   template< typename F >
+   void measure( const char* name, const std::string& data, const unsigned iterations, F&& f )
+   {
+      const auto start = std::chrono::steady_clock::now();
+      for( unsigned i = 0; i < iterations; ++i ) {
+         f();
+      }
+      const std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+      const double mb = double( data.size() ) * iterations / ( 1024.0 * 1024.0 );
+      std::cout << std::setw( 12 ) << name << std::setw( 12 ) << std::fixed << std::setprecision( 1 ) << ( mb / elapsed.count() ) << " MB/s" << std::endl;
+   }
+
+   inline void benchmark( const std::string& source, const std::string& data, const std::vector< pegtl::csv::column_type >& types, const unsigned iterations )
+   {
+      std::cout << source << " (" << data.size() << " bytes, " << iterations << " iterations)" << std::endl;
+
+      measure( "grammar", data, iterations, [ & ]() {
+         pegtl::memory_input in( data, source );
+         pegtl::parse< pegtl::must< pegtl::csv::file<> > >( in );
+      } );
+      measure( "columnar", data, iterations, [ & ]() {
+         pegtl::csv::table t( types, true );
+         pegtl::memory_input in( data, source );
+         pegtl::parse< pegtl::must< pegtl::csv::file<> >, pegtl::csv::columnar_action >( in, t );
+      } );
+      measure( "read", data, iterations, [ & ]() {
+         pegtl::csv::table t( types, true );
+         pegtl::csv::read( pegtl::memory_input( data, source ), t );
+      } );
+   }
+
+}  // namespace examples
+
+int main( int argc, char** argv )  // NOLINT(bugprone-exception-escape)
+{
+   using pegtl::csv::column_type;
+
+   const unsigned iterations = 5;
+
+   if( argc < 2 ) {
+      examples::benchmark( "generated", examples::generate_csv( 500000 ), { column_type::integer, column_type::text, column_type::real, column_type::text }, iterations );
+   }
+   for( int i = 1; i < argc; ++i ) {
+      // All columns of files are read as text, the number of columns is that of the header.
+      pegtl::read_input in( argv[ i ] );
+      const std::string data( in.begin(), in.size() );
+      std::size_t columns = 0;
+      pegtl::parse< pegtl::csv::record<>, examples::count_action >( in, columns );
+      examples::benchmark( argv[ i ], data, std::vector< column_type >( columns, column_type::text ), iterations );
+   }
+   return 0;
+}
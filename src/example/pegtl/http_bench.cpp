@@ -0,0 +1,73 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <tao/pegtl.hpp>
+#include <tao/pegtl/contrib/http.hpp>
+#include <tao/pegtl/contrib/http_parser.hpp>
+
+namespace pegtl = TAO_PEGTL_NAMESPACE;
+
+namespace examples
+{
+   // A typical browser request, repeated to simulate pipelining.
+
+   const char* const request = "GET /wp-content/uploads/2010/03/hello-kitty-darth-vader-pink.jpg HTTP/1.1\r\n"
+                               "Host: www.kittyhell.com\r\n"
+                               "User-Agent: Mozilla/5.0 (Macintosh; U; Intel Mac OS X 10.6; ja-JP-mac; rv:1.9.2.3) Gecko/20100401 Firefox/3.6.3 Pathtraq/0.9\r\n"
+                               "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8\r\n"
+                               "Accept-Language: ja,en-us;q=0.7,en;q=0.3\r\n"
+                               "Accept-Encoding: gzip,deflate\r\n"
+                               "Accept-Charset: Shift_JIS,utf-8;q=0.7,*;q=0.7\r\n"
+                               "Keep-Alive: 115\r\n"
+                               "Connection: keep-alive\r\n"
+                               "Cookie: wp_ozh_wsa_visits=2; wp_ozh_wsa_visit_lasttime=xxxxxxxxxx; __utma=xxxxxxxxx.xxxxxxxxxx.xxxxxxxxxx.xxxxxxxxxx.xxxxxxxxxx.x; __utmz=xxxxxxxxx.xxxxxxxxxx.x.x.utmccn=(referral)|utmcsr=reader.livedoor.com|utmcct=/reader/|utmcmd=referral\r\n"
+                               "\r\n";
+
+   // The head of a message according to the grammar in http.hpp.
+
+   using grammar = pegtl::seq< pegtl::http::request_line, pegtl::star< pegtl::http::header_field, pegtl::abnf::CRLF >, pegtl::abnf::CRLF >;
+
+   template< typename F >
+   void measure( const char* name, const std::string& data, const std::size_t messages, const unsigned iterations, F&& f )
+   {
+      const auto start = std::chrono::steady_clock::now();
+      for( unsigned i = 0; i < iterations; ++i ) {
+         f();
+      }
+      const std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+      const double mb = double( data.size() ) * iterations / ( 1024.0 * 1024.0 );
+      const double mps = double( messages ) * iterations / elapsed.count();
+      std::cout << std::setw( 12 ) << name << std::setw( 12 ) << std::fixed << std::setprecision( 1 ) << ( mb / elapsed.count() ) << " MB/s" << std::setw( 14 ) << std::setprecision( 0 ) << mps << " requests/s" << std::endl;
+   }
+
+}  // namespace examples
+
+int main( int argc, char** argv )  // NOLINT(bugprone-exception-escape)
+{
+   const std::size_t messages = ( argc > 1 ) ? std::stoul( argv[ 1 ] ) : 100000;
+   const unsigned iterations = 5;
+
+   std::string data;
+   for( std::size_t i = 0; i < messages; ++i ) {
+      data += examples::request;
+   }
+   std::cout << messages << " requests (" << data.size() << " bytes, " << iterations << " iterations)" << std::endl;
+
+   examples::measure( "grammar", data, messages, iterations, [ & ]() {
+      pegtl::memory_input in( data, "grammar" );
+      pegtl::parse< pegtl::must< pegtl::star< examples::grammar >, pegtl::eof > >( in );
+   } );
+   examples::measure( "parser", data, messages, iterations, [ & ]() {
+      pegtl::http::parser::request r;
+      for( std::size_t p = 0; p < data.size(); ) {
+         p += pegtl::http::parser::parse_request( data.data() + p, data.size() - p, r );
+      }
+   } );
+   return 0;
+}
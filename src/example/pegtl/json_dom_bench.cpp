@@ -0,0 +1,92 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <tao/pegtl.hpp>
+#include <tao/pegtl/contrib/json_dom.hpp>
+#include <tao/pegtl/contrib/json_index.hpp>
+
+#include "json_build.hpp"
+
+namespace pegtl = TAO_PEGTL_NAMESPACE;
+
+namespace examples
+{
+   // Synthetic input used when no files are given on the command line,
+   // a mix of the value types typically found in JSON records.
+
+   inline std::string generate_json( const std::size_t records )
+   {
+      std::string r = "[\n";
+      for( std::size_t i = 0; i < records; ++i ) {
+         const auto n = std::to_string( i );
+         r += i ? ",\n" : "";
+         r += "{\"id\":" + n + ",\"name\":\"record number " + n + "\",\"score\":" + n + ".25e-1,";
+         r += "\"active\":" + std::string( ( i % 3 ) ? "true" : "false" ) + ",\"parent\":null,";
+         r += "\"tags\":[\"alpha\",\"beta\",\"gamma\\u00e4\\n\"],\"point\":{\"x\":-" + n + ",\"y\":" + n + "}}";
+      }
+      r += "\n]\n";
+      return r;
+   }
+
+   template< typename F >
+   void measure( const char* name, const std::string& data, const unsigned iterations, F&& f )
+   {
+      const auto start = std::chrono::steady_clock::now();
+      for( unsigned i = 0; i < iterations; ++i ) {
+         f();
+      }
+      const std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+      const double mb = double( data.size() ) * iterations / ( 1024.0 * 1024.0 );
+      std::cout << std::setw( 12 ) << name << std::setw( 12 ) << std::fixed << std::setprecision( 1 ) << ( mb / elapsed.count() ) << " MB/s" << std::endl;
+   }
+
+   inline void benchmark( const std::string& source, const std::string& data, const unsigned iterations )
+   {
+      std::cout << source << " (" << data.size() << " bytes, " << iterations << " iterations)" << std::endl;
+
+      measure( "grammar", data, iterations, [ & ]() {
+         pegtl::memory_input in( data, source );
+         pegtl::parse< pegtl::json_dom::internal::grammar >( in );
+      } );
+      measure( "indexed", data, iterations, [ & ]() {
+         pegtl::json::indexed_input in( data, source );
+         pegtl::parse< pegtl::json_dom::internal::grammar >( in );
+      } );
+      measure( "json_build", data, iterations, [ & ]() {
+         json_state state;
+         pegtl::memory_input in( data, source );
+         pegtl::parse< grammar, action >( in, state );
+      } );
+      measure( "json_dom", data, iterations, [ & ]() {
+         pegtl::memory_input in( data, source );
+         const auto doc = pegtl::json_dom::parse( in );
+         (void)doc;
+      } );
+      measure( "json_dom+idx", data, iterations, [ & ]() {
+         pegtl::json::indexed_input in( data, source );
+         const auto doc = pegtl::json_dom::parse( in );
+         (void)doc;
+      } );
+   }
+
+}  // namespace examples
+
+int main( int argc, char** argv )  // NOLINT(bugprone-exception-escape)
+{
+   const unsigned iterations = 5;
+
+   if( argc < 2 ) {
+      examples::benchmark( "generated", examples::generate_json( 100000 ), iterations );
+   }
+   for( int i = 1; i < argc; ++i ) {
+      pegtl::read_input in( argv[ i ] );
+      examples::benchmark( argv[ i ], std::string( in.begin(), in.size() ), iterations );
+   }
+   return 0;
+}
@@ -0,0 +1,31 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <tao/pegtl.hpp>
+#include <tao/pegtl/contrib/json_pointer_extract.hpp>
+
+namespace pegtl = TAO_PEGTL_NAMESPACE;
+
+int main( int argc, char** argv )  // NOLINT(bugprone-exception-escape)
+{
+   if( argc < 3 ) {
+      std::cerr << "usage: " << argv[ 0 ] << " <json-file> <json-pointer>..." << std::endl;
+      return 1;
+   }
+   std::vector< std::string > pointers;
+   pegtl::json_pointer::extractor x;
+   for( int i = 2; i < argc; ++i ) {
+      pointers.emplace_back( argv[ i ] );
+      (void)x.add( pointers.back() );
+   }
+   pegtl::file_input in( argv[ 1 ] );
+   x.extract( in, [ & ]( const std::size_t id, const std::string_view value ) {
+      std::cout << pointers[ id ] << " = " << value << std::endl;
+   } );
+   return 0;
+}
@@ -0,0 +1,182 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <tao/pegtl.hpp>
+#include <tao/pegtl/contrib/clf.hpp>
+#include <tao/pegtl/contrib/logfmt.hpp>
+#include <tao/pegtl/contrib/syslog.hpp>
+
+namespace pegtl = TAO_PEGTL_NAMESPACE;
+
+namespace examples
+{
+   // Generates log lines from a few typical shapes with varying values.
+
+   struct generator
+   {
+      std::uint64_t state = 0x9e3779b97f4a7c15;
+
+      unsigned next( const unsigned n )
+      {
+         state ^= state << 13;
+         state ^= state >> 7;
+         state ^= state << 17;
+         return unsigned( state % n );
+      }
+
+      const char* pick( const std::vector< const char* >& v )
+      {
+         return v[ next( unsigned( v.size() ) ) ];
+      }
+   };
+
+   const std::vector< const char* > hosts = { "web-01.example.com", "web-02.example.com", "db.internal", "192.0.2.17", "cache-eu-west-3" };
+   const std::vector< const char* > apps = { "nginx", "sshd", "postgres", "kernel", "cron", "app-server" };
+   const std::vector< const char* > targets = { "/", "/index.html", "/api/v2/users/1234/orders?limit=50&offset=100", "/static/js/app.3f9a2c.min.js", "/wp-login.php", "/images/logo@2x.png" };
+   const std::vector< const char* > agents = { "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/84.0.4147.105 Safari/537.36", "curl/7.68.0", "Mozilla/5.0 (iPhone; CPU iPhone OS 13_6 like Mac OS X) AppleWebKit/605.1.15 (KHTML, like Gecko) Version/13.1.2 Mobile/15E148 Safari/604.1", "Go-http-client/1.1" };
+   const std::vector< const char* > messages = { "Accepted publickey for deploy from 198.51.100.4 port 50122 ssh2", "connection received: host=10.0.0.3 port=53312", "CPU0: Core temperature above threshold, cpu clock throttled", "(root) CMD (run-parts /etc/cron.hourly)", "request completed" };
+   const char* const months[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+
+   std::string syslog_corpus( generator& g, const std::size_t lines )
+   {
+      std::string r;
+      char b[ 64 ];
+      for( std::size_t i = 0; i < lines; ++i ) {
+         std::snprintf( b, sizeof( b ), "<%u>1 2020-%02u-%02uT%02u:%02u:%02u.%03uZ ", g.next( 192 ), g.next( 12 ) + 1, g.next( 28 ) + 1, g.next( 24 ), g.next( 60 ), g.next( 60 ), g.next( 1000 ) );
+         r += b;
+         r += g.pick( hosts );
+         r += ' ';
+         r += g.pick( apps );
+         r += ' ' + std::to_string( g.next( 65536 ) ) + " - ";
+         if( g.next( 2 ) == 0 ) {
+            r += "[origin ip=\"192.0.2.1\" software=\"rsyslogd\"][meta sequenceId=\"" + std::to_string( i ) + "\"] ";
+         }
+         else {
+            r += "- ";
+         }
+         r += g.pick( messages );
+         r += '\n';
+      }
+      return r;
+   }
+
+   std::string clf_corpus( generator& g, const std::size_t lines )
+   {
+      std::string r;
+      char b[ 64 ];
+      for( std::size_t i = 0; i < lines; ++i ) {
+         std::snprintf( b, sizeof( b ), "198.51.%u.%u - - [%02u/%s/2020:%02u:%02u:%02u +0000] \"", g.next( 256 ), g.next( 256 ), g.next( 28 ) + 1, months[ g.next( 12 ) ], g.next( 24 ), g.next( 60 ), g.next( 60 ) );
+         r += b;
+         r += ( g.next( 4 ) == 0 ) ? "POST " : "GET ";
+         r += g.pick( targets );
+         r += " HTTP/1.1\" ";
+         r += ( g.next( 8 ) == 0 ) ? "404 " : "200 ";
+         r += std::to_string( g.next( 100000 ) );
+         r += " \"https://www.example.com/\" \"";
+         r += g.pick( agents );
+         r += "\"\n";
+      }
+      return r;
+   }
+
+   std::string logfmt_corpus( generator& g, const std::size_t lines )
+   {
+      std::string r;
+      for( std::size_t i = 0; i < lines; ++i ) {
+         r += "time=2020-08-";
+         r += std::to_string( 10 + g.next( 20 ) );
+         r += "T12:34:56.789Z level=";
+         r += ( g.next( 8 ) == 0 ) ? "warn" : "info";
+         r += " msg=\"";
+         r += g.pick( messages );
+         r += "\" service=";
+         r += g.pick( apps );
+         r += " path=";
+         r += g.pick( targets );
+         r += " status=200 duration=" + std::to_string( g.next( 5000 ) ) + "ms request_id=";
+         r += std::to_string( g.state );
+         r += ( g.next( 4 ) == 0 ) ? " cached\n" : "\n";
+      }
+      return r;
+   }
+
+   template< typename F >
+   void measure( const char* name, const std::string& data, const std::size_t lines, const unsigned iterations, F&& f )
+   {
+      const auto start = std::chrono::steady_clock::now();
+      for( unsigned i = 0; i < iterations; ++i ) {
+         f();
+      }
+      const std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+      const double mb = double( data.size() ) * iterations / ( 1024.0 * 1024.0 );
+      const double lps = double( lines ) * iterations / elapsed.count();
+      std::cout << std::setw( 16 ) << name << std::setw( 12 ) << std::fixed << std::setprecision( 1 ) << ( mb / elapsed.count() ) << " MB/s" << std::setw( 14 ) << std::setprecision( 0 ) << lps << " lines/s" << std::endl;
+   }
+
+   // Calls f( line ) for every line and throws when it returns false.
+
+   template< typename F >
+   void for_each_line( const std::string& data, F&& f )
+   {
+      const char* p = data.data();
+      const char* const e = p + data.size();
+      while( p != e ) {
+         const char* n = static_cast< const char* >( std::memchr( p, '\n', std::size_t( e - p ) ) );
+         n = n ? n : e;
+         if( !f( std::string_view( p, std::size_t( n - p ) ) ) ) {
+            throw std::runtime_error( "invalid line: " + std::string( p, n ) );
+         }
+         p = ( n == e ) ? e : ( n + 1 );
+      }
+   }
+
+   template< typename Rule >
+   void grammar( const std::string& data )
+   {
+      pegtl::memory_input in( data, "grammar" );
+      pegtl::parse< pegtl::must< pegtl::star< Rule, pegtl::one< '\n' > >, pegtl::eof > >( in );
+   }
+
+}  // namespace examples
+
+int main( int argc, char** argv )  // NOLINT(bugprone-exception-escape)
+{
+   const std::size_t lines = ( argc > 1 ) ? std::stoul( argv[ 1 ] ) : 100000;
+   const unsigned iterations = 5;
+
+   examples::generator g;
+   const std::string syslog = examples::syslog_corpus( g, lines );
+   const std::string clf = examples::clf_corpus( g, lines );
+   const std::string logfmt = examples::logfmt_corpus( g, lines );
+
+   std::cout << lines << " lines per format (" << syslog.size() << ", " << clf.size() << " and " << logfmt.size() << " bytes, " << iterations << " iterations)" << std::endl;
+
+   examples::measure( "syslog grammar", syslog, lines, iterations, [ & ]() { examples::grammar< pegtl::syslog::syslog_msg >( syslog ); } );
+   examples::measure( "syslog parse", syslog, lines, iterations, [ & ]() {
+      pegtl::syslog::message m;
+      examples::for_each_line( syslog, [ & ]( const std::string_view l ) { return pegtl::syslog::parse( l, m ); } );
+   } );
+   examples::measure( "clf grammar", clf, lines, iterations, [ & ]() { examples::grammar< pegtl::clf::combined >( clf ); } );
+   examples::measure( "clf parse", clf, lines, iterations, [ & ]() {
+      pegtl::clf::entry r;
+      examples::for_each_line( clf, [ & ]( const std::string_view l ) { return pegtl::clf::parse( l, r ); } );
+   } );
+   examples::measure( "logfmt grammar", logfmt, lines, iterations, [ & ]() { examples::grammar< pegtl::logfmt::line >( logfmt ); } );
+   examples::measure( "logfmt parse", logfmt, lines, iterations, [ & ]() {
+      std::vector< pegtl::logfmt::field > f;
+      examples::for_each_line( logfmt, [ & ]( const std::string_view l ) { return pegtl::logfmt::parse( l, f ); } );
+   } );
+   return 0;
+}
@@ -0,0 +1,108 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <tao/pegtl.hpp>
+#include <tao/pegtl/contrib/lua53.hpp>
+
+namespace pegtl = TAO_PEGTL_NAMESPACE;
+
+namespace examples
+{
+   // Synthetic input used when no files are given on the command line,
+   // modelled on typical library code with documentation comments.
+
+   inline std::string generate_lua( const std::size_t functions )
+   {
+      std::string r = "#!/usr/bin/env lua\n--[==[\n  Generated module for benchmarking.\n  ]] and ]=] are not the end of this comment.\n]==]\n\nlocal M = {}\nlocal insert, concat = table.insert, table.concat\n\n";
+      for( std::size_t i = 0; i < functions; ++i ) {
+         const auto n = std::to_string( i );
+         r += "--- Returns the items of t selected by f, see issue #" + n + ".\n";
+         r += "-- @param t table\n-- @param f function\nfunction M.select_" + n + "( t, f, ... )\n";
+         r += "   local result, count = {}, 0\n";
+         r += "   for index, value in ipairs( t ) do\n";
+         r += "      if f( value, index ) and value ~= nil then  -- keep it\n";
+         r += "         count = count + 1\n";
+         r += "         result[ count ] = { value = value, index = index, label = \"item \\\"" + n + "\\\"\\n\" }\n";
+         r += "      elseif type( value ) == 'table' and #value > 0x1F then\n";
+         r += "         insert( result, M.select_" + n + "( value, f ) )\n";
+         r += "      else\n";
+         r += "         local x = ( index * 2.5e-3 + " + n + " ) // 3 % 7 ^ 2\n";
+         r += "      end\n";
+         r += "   end\n";
+         r += "   local doc = [==[\n   Long string with ]] and \"quotes\" inside.\n]==]\n";
+         r += "   while count > 100 do count = count >> 1 end\n";
+         r += "   return setmetatable( result, { __index = M, __len = function( s ) return count end } ), doc .. concat( { ... }, ', ' )\n";
+         r += "end\n\n";
+      }
+      r += "return M\n";
+      return r;
+   }
+
+   template< typename Rule >
+   struct count_action
+      : pegtl::nothing< Rule >
+   {
+   };
+
+   template<>
+   struct count_action< pegtl::lua53::name >
+   {
+      template< typename Input >
+      static void apply( const Input& /*unused*/, std::size_t& n )
+      {
+         ++n;
+      }
+   };
+
+   template< typename F >
+   void measure( const char* name, const std::string& data, const unsigned iterations, F&& f )
+   {
+      const auto start = std::chrono::steady_clock::now();
+      for( unsigned i = 0; i < iterations; ++i ) {
+         f();
+      }
+      const std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+      const double mb = double( data.size() ) * iterations / ( 1024.0 * 1024.0 );
+      std::cout << std::setw( 12 ) << name << std::setw( 12 ) << std::fixed << std::setprecision( 1 ) << ( mb / elapsed.count() ) << " MB/s" << std::endl;
+   }
+
+   inline void benchmark( const std::string& source, const std::string& data, const unsigned iterations )
+   {
+      std::cout << source << " (" << data.size() << " bytes, " << iterations << " iterations)" << std::endl;
+
+      measure( "grammar", data, iterations, [ & ]() {
+         pegtl::memory_input in( data, source );
+         pegtl::parse< pegtl::lua53::grammar >( in );
+      } );
+      measure( "lazy", data, iterations, [ & ]() {
+         pegtl::memory_input< pegtl::tracking_mode::lazy > in( data, source );
+         pegtl::parse< pegtl::lua53::grammar >( in );
+      } );
+      measure( "names", data, iterations, [ & ]() {
+         std::size_t n = 0;
+         pegtl::memory_input< pegtl::tracking_mode::lazy > in( data, source );
+         pegtl::parse< pegtl::lua53::grammar, count_action >( in, n );
+      } );
+   }
+
+}  // namespace examples
+
+int main( int argc, char** argv )  // NOLINT(bugprone-exception-escape)
+{
+   const unsigned iterations = 5;
+
+   if( argc < 2 ) {
+      examples::benchmark( "generated", examples::generate_lua( 20000 ), iterations );
+   }
+   for( int i = 1; i < argc; ++i ) {
+      pegtl::read_input in( argv[ i ] );
+      examples::benchmark( argv[ i ], std::string( in.begin(), in.size() ), iterations );
+   }
+   return 0;
+}
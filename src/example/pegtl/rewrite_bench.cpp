@@ -0,0 +1,164 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined( __unix__ ) || ( defined( __APPLE__ ) && defined( __MACH__ ) )
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <tao/pegtl.hpp>
+#include <tao/pegtl/contrib/rewrite.hpp>
+
+namespace pegtl = TAO_PEGTL_NAMESPACE;
+
+namespace examples
+{
+   // clang-format off
+   struct local : pegtl::plus< pegtl::sor< pegtl::alnum, pegtl::one< '.', '_', '-' > > > {};
+   struct domain : pegtl::list< pegtl::plus< pegtl::alnum >, pegtl::one< '.' > > {};
+   struct email : pegtl::seq< local, pegtl::one< '@' >, domain > {};
+   struct key : pegtl::sor< TAO_PEGTL_STRING( "user=" ), TAO_PEGTL_STRING( "to=" ) > {};
+   struct field : pegtl::seq< key, email > {};
+   // clang-format on
+
+   // Log lines where one in 32 contains an e-mail address, the addresses
+   // in user and to fields are redacted.
+
+   const std::vector< const char* > common = {
+      "time=2020-08-14T12:34:56.789Z level=info msg=\"request completed\" service=app-server path=/api/v2/users status=200 duration=17ms\n",
+      "time=2020-08-14T12:34:57.012Z level=info msg=\"cache hit\" service=cache-eu-west-3 key=users/1234/orders status=200\n",
+      "time=2020-08-14T12:34:58.678Z level=info msg=\"request completed\" service=nginx path=/static/js/app.min.js status=304\n"
+   };
+
+   const std::vector< const char* > rare = {
+      "time=2020-08-14T12:34:59.901Z level=info msg=\"login\" service=auth user=jane.doe@example.com method=password\n",
+      "time=2020-08-14T12:35:00.234Z level=warn msg=\"bounce\" service=mailer to=j_smith-42@mail.example.org\n"
+   };
+
+   std::string corpus( const std::size_t lines )
+   {
+      std::string r;
+      std::uint64_t x = 0x9e3779b97f4a7c15;
+      for( std::size_t i = 0; i < lines; ++i ) {
+         x ^= x << 13;
+         x ^= x >> 7;
+         x ^= x << 17;
+         r += ( ( x & 31 ) == 0 ) ? rare[ ( x >> 8 ) % rare.size() ] : common[ ( x >> 8 ) % common.size() ];
+      }
+      return r;
+   }
+
+   // Builds the output string in actions, the usual approach.
+
+   template< typename Rule >
+   struct copy
+      : pegtl::nothing< Rule >
+   {
+   };
+
+   template<>
+   struct copy< email >
+   {
+      template< typename ActionInput >
+      static void apply( const ActionInput& /*unused*/, std::string& s )
+      {
+         s += "<redacted>";
+      }
+   };
+
+   template<>
+   struct copy< key >
+   {
+      template< typename ActionInput >
+      static void apply( const ActionInput& in, std::string& s )
+      {
+         s.append( in.begin(), in.size() );
+      }
+   };
+
+   template<>
+   struct copy< pegtl::any >
+   {
+      template< typename ActionInput >
+      static void apply( const ActionInput& in, std::string& s )
+      {
+         s += *in.begin();
+      }
+   };
+
+   template< typename Rule >
+   struct redact
+      : pegtl::nothing< Rule >
+   {
+   };
+
+   template<>
+   struct redact< email >
+   {
+      template< typename ActionInput, typename Output >
+      static void apply( const ActionInput& in, Output& out )
+      {
+         out.replace( in, "<redacted>" );
+      }
+   };
+
+   template< typename F >
+   void measure( const char* name, const std::string& data, const unsigned iterations, F&& f )
+   {
+      std::size_t n = 0;
+      const auto start = std::chrono::steady_clock::now();
+      for( unsigned i = 0; i < iterations; ++i ) {
+         n = f();
+      }
+      const std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+      const double mb = double( data.size() ) * iterations / ( 1024.0 * 1024.0 );
+      std::cout << std::setw( 20 ) << name << std::setw( 12 ) << std::fixed << std::setprecision( 1 ) << ( mb / elapsed.count() ) << " MB/s" << std::setw( 12 ) << n << " bytes" << std::endl;
+   }
+
+}  // namespace examples
+
+// Usage: rewrite_bench [lines]
+
+int main( int argc, char** argv )  // NOLINT(bugprone-exception-escape)
+{
+   const std::size_t lines = ( argc > 1 ) ? std::stoul( argv[ 1 ] ) : 200000;
+   const unsigned iterations = 5;
+
+   const std::string data = examples::corpus( lines );
+   std::cout << lines << " lines (" << data.size() << " bytes, " << iterations << " iterations)" << std::endl;
+
+   examples::measure( "actions to string", data, iterations, [ & ]() {
+      pegtl::memory_input< pegtl::tracking_mode::lazy > in( data, "actions" );
+      std::string s;
+      pegtl::parse< pegtl::star< pegtl::sor< examples::field, pegtl::any > >, examples::copy >( in, s );
+      return s.size();
+   } );
+   examples::measure( "transform to string", data, iterations, [ & ]() {
+      pegtl::memory_input< pegtl::tracking_mode::lazy > in( data, "transform" );
+      std::string s;
+      pegtl::rewrite::transform< examples::field, examples::redact >( in, pegtl::rewrite::string_sink( s ) );
+      return s.size();
+   } );
+#if defined( _POSIX_VERSION )
+   const int fd = ::open( "/dev/null", O_WRONLY );
+   if( fd >= 0 ) {
+      examples::measure( "transform to fd", data, iterations, [ & ]() {
+         pegtl::memory_input< pegtl::tracking_mode::lazy > in( data, "transform" );
+         pegtl::rewrite::output out( in.begin(), pegtl::rewrite::fd_sink( fd ) );
+         pegtl::search< examples::field, examples::redact >( in, []( const auto& /*unused*/ ) {}, out );
+         out.finish( in.end() );
+         return out.size();
+      } );
+      ::close( fd );
+   }
+#endif
+   return 0;
+}
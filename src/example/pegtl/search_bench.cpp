@@ -0,0 +1,130 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <tao/pegtl.hpp>
+#include <tao/pegtl/contrib/search.hpp>
+
+namespace pegtl = TAO_PEGTL_NAMESPACE;
+
+namespace examples
+{
+   // clang-format off
+   struct octet : pegtl::rep_min_max< 1, 3, pegtl::digit > {};
+   struct ipv4 : pegtl::seq< octet, pegtl::one< '.' >, octet, pegtl::one< '.' >, octet, pegtl::one< '.' >, octet, pegtl::not_at< pegtl::digit > > {};
+   struct error : pegtl::seq< TAO_PEGTL_STRING( "error=" ), pegtl::identifier > {};
+   struct quoted : pegtl::seq< pegtl::one< '"' >, pegtl::until< pegtl::one< '"' > > > {};
+   // clang-format on
+
+   // Log lines where only one in 64 contains an address or an error.
+
+   const std::vector< const char* > common = {
+      "time=2020-08-14T12:34:56.789Z level=info msg=\"request completed\" service=app-server path=/api/v2/users status=200 duration=17ms\n",
+      "time=2020-08-14T12:34:57.012Z level=info msg=\"cache hit\" service=cache-eu-west-3 key=users/1234/orders status=200\n",
+      "time=2020-08-14T12:34:57.345Z level=debug msg=\"connection pool\" service=postgres active=12 idle=4 waiting=0\n",
+      "time=2020-08-14T12:34:58.678Z level=info msg=\"request completed\" service=nginx path=/static/js/app.min.js status=304\n",
+      "time=2020-08-14T12:35:01.567Z level=info msg=\"scheduled job\" service=cron job=run-parts directory=/etc/cron.hourly\n"
+   };
+
+   const std::vector< const char* > rare = {
+      "time=2020-08-14T12:34:59.901Z level=warn msg=\"connection received\" service=sshd host=10.0.0.3 port=53312\n",
+      "time=2020-08-14T12:35:00.234Z level=error msg=\"query failed\" service=postgres error=deadlock_detected\n"
+   };
+
+   std::string corpus( const std::size_t lines )
+   {
+      std::string r;
+      std::uint64_t x = 0x9e3779b97f4a7c15;
+      for( std::size_t i = 0; i < lines; ++i ) {
+         x ^= x << 13;
+         x ^= x >> 7;
+         x ^= x << 17;
+         r += ( ( x & 63 ) == 0 ) ? rare[ ( x >> 8 ) % rare.size() ] : common[ ( x >> 8 ) % common.size() ];
+      }
+      return r;
+   }
+
+   template< typename Rule >
+   struct collect
+      : pegtl::nothing< Rule >
+   {
+   };
+
+   template<>
+   struct collect< ipv4 >
+   {
+      template< typename ActionInput >
+      static void apply( const ActionInput& /*unused*/, std::size_t& n )
+      {
+         ++n;
+      }
+   };
+
+   template<>
+   struct collect< error >
+      : collect< ipv4 >
+   {
+   };
+
+   template<>
+   struct collect< quoted >
+      : collect< ipv4 >
+   {
+   };
+
+   template< typename Rule >
+   std::size_t with_search( const std::string& data )
+   {
+      pegtl::memory_input< pegtl::tracking_mode::lazy > in( data, "search" );
+      return pegtl::search< Rule >( in, []( const auto& /*unused*/ ) {} );
+   }
+
+   template< typename Rule >
+   std::size_t with_star( const std::string& data )
+   {
+      pegtl::memory_input< pegtl::tracking_mode::lazy > in( data, "star" );
+      std::size_t n = 0;
+      pegtl::parse< pegtl::star< pegtl::sor< Rule, pegtl::any > >, collect >( in, n );
+      return n;
+   }
+
+   template< typename F >
+   void measure( const char* name, const std::string& data, const unsigned iterations, F&& f )
+   {
+      std::size_t n = 0;
+      const auto start = std::chrono::steady_clock::now();
+      for( unsigned i = 0; i < iterations; ++i ) {
+         n = f();
+      }
+      const std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+      const double mb = double( data.size() ) * iterations / ( 1024.0 * 1024.0 );
+      std::cout << std::setw( 16 ) << name << std::setw( 12 ) << std::fixed << std::setprecision( 1 ) << ( mb / elapsed.count() ) << " MB/s" << std::setw( 10 ) << n << " matches" << std::endl;
+   }
+
+}  // namespace examples
+
+// Usage: search_bench [lines]
+
+int main( int argc, char** argv )  // NOLINT(bugprone-exception-escape)
+{
+   const std::size_t lines = ( argc > 1 ) ? std::stoul( argv[ 1 ] ) : 200000;
+   const unsigned iterations = 5;
+
+   const std::string data = examples::corpus( lines );
+   std::cout << lines << " lines (" << data.size() << " bytes, " << iterations << " iterations)" << std::endl;
+
+   examples::measure( "ipv4 star", data, iterations, [ & ]() { return examples::with_star< examples::ipv4 >( data ); } );
+   examples::measure( "ipv4 search", data, iterations, [ & ]() { return examples::with_search< examples::ipv4 >( data ); } );
+   examples::measure( "error star", data, iterations, [ & ]() { return examples::with_star< examples::error >( data ); } );
+   examples::measure( "error search", data, iterations, [ & ]() { return examples::with_search< examples::error >( data ); } );
+   examples::measure( "quoted star", data, iterations, [ & ]() { return examples::with_star< examples::quoted >( data ); } );
+   examples::measure( "quoted search", data, iterations, [ & ]() { return examples::with_search< examples::quoted >( data ); } );
+   return 0;
+}
@@ -0,0 +1,307 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <tao/pegtl.hpp>
+
+namespace pegtl = TAO_PEGTL_NAMESPACE;
+
+namespace ucd
+{
+   // Generates <tao/pegtl/contrib/unicode/tables.hpp> from the files of the
+   // Unicode Character Database (UCD) that contain the properties used by
+   // the rules in <tao/pegtl/contrib/unicode/...>.
+
+   // Grammar for the data lines of the UCD files, e.g.
+   // 0041..005A    ; XID_Start # L&  [26] LATIN CAPITAL LETTER A..LATIN CAPITAL LETTER Z
+   // Only the first field after the range is used, comment and empty
+   // lines are ignored.
+
+   // clang-format off
+   struct first : pegtl::plus< pegtl::xdigit > {};
+   struct last : pegtl::plus< pegtl::xdigit > {};
+   struct value : pegtl::plus< pegtl::sor< pegtl::alnum, pegtl::one< '_' > > > {};
+   struct range : pegtl::seq< first, pegtl::opt< pegtl::two< '.' >, last > > {};
+   struct data : pegtl::seq< range, pegtl::star< pegtl::blank >, pegtl::one< ';' >, pegtl::star< pegtl::blank >, value, pegtl::until< pegtl::eolf > > {};
+   struct other : pegtl::until< pegtl::eolf > {};
+   struct file : pegtl::until< pegtl::eof, pegtl::sor< data, other > > {};
+   // clang-format on
+
+   struct entry
+   {
+      char32_t first = 0;
+      char32_t last = 0;
+      std::string value;
+   };
+
+   template< typename Rule >
+   struct action
+   {
+   };
+
+   template<>
+   struct action< first >
+   {
+      template< typename Input >
+      static void apply( const Input& in, std::vector< entry >& v )
+      {
+         const auto c = char32_t( std::stoul( in.string(), nullptr, 16 ) );
+         v.push_back( { c, c, std::string() } );
+      }
+   };
+
+   template<>
+   struct action< last >
+   {
+      template< typename Input >
+      static void apply( const Input& in, std::vector< entry >& v )
+      {
+         v.back().last = char32_t( std::stoul( in.string(), nullptr, 16 ) );
+      }
+   };
+
+   template<>
+   struct action< value >
+   {
+      template< typename Input >
+      static void apply( const Input& in, std::vector< entry >& v )
+      {
+         v.back().value = in.string();
+      }
+   };
+
+   std::vector< entry > read( const char* filename )
+   {
+      std::vector< entry > result;
+      pegtl::file_input in( filename );
+      pegtl::parse< file, action >( in, result );
+      return result;
+   }
+
+   // The version is taken from the first line of the file, for example
+   // "# DerivedGeneralCategory-14.0.0.txt".
+
+   std::string version( const char* filename )
+   {
+      std::ifstream stream( filename );
+      std::string line;
+      std::getline( stream, line );
+      const auto b = line.rfind( '-' );
+      const auto e = line.rfind( ".txt" );
+      return ( ( b != std::string::npos ) && ( e != std::string::npos ) && ( b < e ) ) ? line.substr( b + 1, e - b - 1 ) : "unknown";
+   }
+
+   // The general categories in the order of the enumeration, the value
+   // of unassigned code points that are not listed is the last one.
+
+   const char* const categories[][ 2 ] = {
+      { "Lu", "uppercase_letter" },
+      { "Ll", "lowercase_letter" },
+      { "Lt", "titlecase_letter" },
+      { "Lm", "modifier_letter" },
+      { "Lo", "other_letter" },
+      { "Mn", "nonspacing_mark" },
+      { "Mc", "spacing_mark" },
+      { "Me", "enclosing_mark" },
+      { "Nd", "decimal_number" },
+      { "Nl", "letter_number" },
+      { "No", "other_number" },
+      { "Pc", "connector_punctuation" },
+      { "Pd", "dash_punctuation" },
+      { "Ps", "open_punctuation" },
+      { "Pe", "close_punctuation" },
+      { "Pi", "initial_punctuation" },
+      { "Pf", "final_punctuation" },
+      { "Po", "other_punctuation" },
+      { "Sm", "math_symbol" },
+      { "Sc", "currency_symbol" },
+      { "Sk", "modifier_symbol" },
+      { "So", "other_symbol" },
+      { "Zs", "space_separator" },
+      { "Zl", "line_separator" },
+      { "Zp", "paragraph_separator" },
+      { "Cc", "control" },
+      { "Cf", "format" },
+      { "Cs", "surrogate" },
+      { "Co", "private_use" },
+      { "Cn", "unassigned" }
+   };
+
+   constexpr std::size_t category_count = sizeof( categories ) / sizeof( categories[ 0 ] );
+
+   constexpr std::uint8_t xid_start_flag = 0x20;
+   constexpr std::uint8_t xid_continue_flag = 0x40;
+   constexpr std::uint8_t white_space_flag = 0x80;
+
+   constexpr char32_t code_points = 0x110000;
+
+   std::string lower( std::string s )
+   {
+      for( auto& c : s ) {
+         c = char( std::tolower( static_cast< unsigned char >( c ) ) );
+      }
+      return s;
+   }
+
+   // A two-stage table maps code point c to stage2[ ( stage1[ c >> shift ] << shift ) + ( c & mask ) ],
+   // identical blocks of the second stage are stored only once; the block
+   // size is chosen to minimise the total size, the first stage uses bytes
+   // when there are at most 256 different blocks.
+
+   struct table
+   {
+      unsigned shift = 0;
+      std::vector< std::uint16_t > stage1;
+      std::vector< std::uint8_t > stage2;
+
+      [[nodiscard]] bool small() const noexcept
+      {
+         return ( stage2.size() >> shift ) <= 256;
+      }
+
+      [[nodiscard]] std::size_t bytes() const noexcept
+      {
+         return stage1.size() * ( small() ? 1 : 2 ) + stage2.size();
+      }
+   };
+
+   table compress( const std::vector< std::uint8_t >& values, const unsigned shift )
+   {
+      table t;
+      t.shift = shift;
+      const std::size_t block = std::size_t( 1 ) << shift;
+      std::map< std::vector< std::uint8_t >, std::uint16_t > blocks;
+      for( std::size_t i = 0; i < values.size(); i += block ) {
+         std::vector< std::uint8_t > v( values.begin() + std::ptrdiff_t( i ), values.begin() + std::ptrdiff_t( i + block ) );
+         const auto r = blocks.try_emplace( std::move( v ), std::uint16_t( blocks.size() ) );
+         if( r.second ) {
+            t.stage2.insert( t.stage2.end(), r.first->first.begin(), r.first->first.end() );
+         }
+         t.stage1.push_back( r.first->second );
+      }
+      return t;
+   }
+
+   table compress( const std::vector< std::uint8_t >& values )
+   {
+      table best = compress( values, 4 );
+      for( unsigned shift = 5; shift <= 12; ++shift ) {
+         auto t = compress( values, shift );
+         if( t.bytes() < best.bytes() ) {
+            best = std::move( t );
+         }
+      }
+      return best;
+   }
+
+   template< typename T >
+   void print_array( const char* type, const std::string& name, const std::vector< T >& v )
+   {
+      std::cout << "   inline constexpr " << type << ' ' << name << "[ " << v.size() << " ] = {";
+      for( std::size_t i = 0; i < v.size(); ++i ) {
+         std::cout << ( ( i % 16 ) ? " " : "\n      " ) << unsigned( v[ i ] ) << ',';
+      }
+      std::cout << "\n   };\n\n";
+   }
+
+   void print_table( const std::string& name, const table& t )
+   {
+      std::cout << "   inline constexpr unsigned " << name << "_shift = " << t.shift << ";\n\n";
+      print_array( t.small() ? "std::uint8_t" : "std::uint16_t", name + "_stage1", t.stage1 );
+      print_array( "std::uint8_t", name + "_stage2", t.stage2 );
+   }
+
+}  // namespace ucd
+
+int main( int argc, char** argv )  // NOLINT(bugprone-exception-escape)
+{
+   if( argc != 5 ) {
+      std::cerr << "usage: " << argv[ 0 ] << " DerivedGeneralCategory.txt DerivedCoreProperties.txt PropList.txt Scripts.txt" << std::endl;
+      return 1;
+   }
+   std::vector< std::uint8_t > properties( ucd::code_points, std::uint8_t( ucd::category_count - 1 ) );
+   std::vector< std::uint8_t > scripts( ucd::code_points, 0 );
+
+   for( const auto& e : ucd::read( argv[ 1 ] ) ) {
+      const auto* const i = std::find_if( std::begin( ucd::categories ), std::end( ucd::categories ), [ & ]( const auto& c ) { return e.value == c[ 0 ]; } );
+      if( i == std::end( ucd::categories ) ) {
+         std::cerr << "unknown general category " << e.value << std::endl;
+         return 1;
+      }
+      std::fill( properties.begin() + e.first, properties.begin() + e.last + 1, std::uint8_t( i - std::begin( ucd::categories ) ) );
+   }
+   const auto flags = [ & ]( const char* filename ) {
+      for( const auto& e : ucd::read( filename ) ) {
+         const std::uint8_t f = ( e.value == "XID_Start" ) ? ucd::xid_start_flag : ( e.value == "XID_Continue" ) ? ucd::xid_continue_flag : ( e.value == "White_Space" ) ? ucd::white_space_flag : 0;
+         for( char32_t c = e.first; c <= e.last; ++c ) {
+            properties[ c ] |= f;
+         }
+      }
+   };
+   flags( argv[ 2 ] );
+   flags( argv[ 3 ] );
+
+   // The script of code points that are not listed is unknown, which is
+   // the first value; the others are sorted by name.
+
+   const auto entries = ucd::read( argv[ 4 ] );
+   std::map< std::string, std::uint8_t > names;
+   for( const auto& e : entries ) {
+      names.try_emplace( ucd::lower( e.value ), 0 );
+   }
+   names.erase( "unknown" );
+   if( names.size() > 255 ) {
+      std::cerr << "too many scripts" << std::endl;
+      return 1;
+   }
+   std::uint8_t n = 0;
+   for( auto& i : names ) {
+      i.second = ++n;
+   }
+   for( const auto& e : entries ) {
+      std::fill( scripts.begin() + e.first, scripts.begin() + e.last + 1, names[ ucd::lower( e.value ) ] );
+   }
+
+   std::cout << "// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey\n"
+             << "// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/\n\n"
+             << "// Generated by src/example/pegtl/unicode_tables.cpp from the Unicode\n"
+             << "// Character Database version " << ucd::version( argv[ 1 ] ) << ", do not edit.\n\n"
+             << "#ifndef TAO_PEGTL_CONTRIB_UNICODE_TABLES_HPP\n"
+             << "#define TAO_PEGTL_CONTRIB_UNICODE_TABLES_HPP\n\n"
+             << "#include <cstdint>\n\n"
+             << "#include \"../../config.hpp\"\n\n"
+             << "namespace TAO_PEGTL_NAMESPACE::unicode\n{\n"
+             << "   enum class general_category : std::uint8_t\n   {\n";
+   for( const auto& c : ucd::categories ) {
+      std::cout << "      " << c[ 1 ] << ( ( &c == std::end( ucd::categories ) - 1 ) ? "\n" : ",\n" );
+   }
+   std::cout << "   };\n\n"
+             << "   enum class script : std::uint8_t\n   {\n"
+             << "      unknown";
+   for( const auto& i : names ) {
+      std::cout << ",\n      " << i.first;
+   }
+   std::cout << "\n   };\n\n"
+             << "}  // namespace TAO_PEGTL_NAMESPACE::unicode\n\n"
+             << "namespace TAO_PEGTL_NAMESPACE::internal::unicode\n{\n"
+             << "   inline constexpr std::uint8_t general_category_mask = 0x1f;\n"
+             << "   inline constexpr std::uint8_t xid_start_flag = 0x20;\n"
+             << "   inline constexpr std::uint8_t xid_continue_flag = 0x40;\n"
+             << "   inline constexpr std::uint8_t white_space_flag = 0x80;\n\n"
+             << "   // clang-format off\n";
+   ucd::print_table( "property", ucd::compress( properties ) );
+   ucd::print_table( "script", ucd::compress( scripts ) );
+   std::cout << "   // clang-format on\n\n"
+             << "}  // namespace TAO_PEGTL_NAMESPACE::internal::unicode\n\n"
+             << "#endif\n";
+   return 0;
+}
@@ -0,0 +1,114 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <tao/pegtl.hpp>
+#include <tao/pegtl/contrib/uri.hpp>
+#include <tao/pegtl/contrib/uri_parser.hpp>
+
+namespace pegtl = TAO_PEGTL_NAMESPACE;
+
+namespace examples
+{
+   // Synthetic URLs used when no file with one URL per line is given.
+
+   inline std::vector< std::string > generate_urls( const std::size_t count )
+   {
+      std::vector< std::string > r;
+      for( std::size_t i = 0; i < count; ++i ) {
+         const auto n = std::to_string( i );
+         r.push_back( "https://user" + n + "@www.example" + std::to_string( i % 97 ) + ".com:8443/static/assets/images/item-" + n + "/photo%20large.jpg?session=" + n + "&lang=en-US&ref=%2Fhome%2Findex#section-" + std::to_string( i % 7 ) );
+      }
+      return r;
+   }
+
+   struct string_components
+   {
+      std::string scheme;
+      std::string host;
+      std::string path;
+      std::string query;
+   };
+
+   template< typename Rule >
+   struct string_action
+      : pegtl::nothing< Rule >
+   {
+   };
+
+   template< std::string string_components::*Field >
+   struct bind
+   {
+      template< typename Input >
+      static void apply( const Input& in, string_components& c )
+      {
+         c.*Field = in.string();
+      }
+   };
+
+   // clang-format off
+   template<> struct string_action< pegtl::uri::scheme > : bind< &string_components::scheme > {};
+   template<> struct string_action< pegtl::uri::host > : bind< &string_components::host > {};
+   template<> struct string_action< pegtl::uri::path_abempty > : bind< &string_components::path > {};
+   template<> struct string_action< pegtl::uri::query > : bind< &string_components::query > {};
+   // clang-format on
+
+   template< typename F >
+   void measure( const char* name, const std::vector< std::string >& urls, const unsigned iterations, F&& f )
+   {
+      std::size_t bytes = 0;
+      for( const auto& url : urls ) {
+         bytes += url.size();
+      }
+      std::size_t check = 0;
+      const auto start = std::chrono::steady_clock::now();
+      for( unsigned i = 0; i < iterations; ++i ) {
+         for( const auto& url : urls ) {
+            check += f( url );
+         }
+      }
+      const std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+      const double mb = double( bytes ) * iterations / ( 1024.0 * 1024.0 );
+      std::cout << std::setw( 12 ) << name << std::setw( 12 ) << std::fixed << std::setprecision( 1 ) << ( mb / elapsed.count() ) << " MB/s  (" << check << ')' << std::endl;
+   }
+
+}  // namespace examples
+
+int main( int argc, char** argv )  // NOLINT(bugprone-exception-escape)
+{
+   std::vector< std::string > urls;
+   if( argc > 1 ) {
+      std::ifstream stream( argv[ 1 ] );
+      for( std::string line; std::getline( stream, line ); ) {
+         urls.push_back( line );
+      }
+   }
+   else {
+      urls = examples::generate_urls( 200000 );
+   }
+   const unsigned iterations = 5;
+   std::cout << urls.size() << " URLs, " << iterations << " iterations" << std::endl;
+
+   examples::measure( "grammar", urls, iterations, []( const std::string& url ) {
+      examples::string_components c;
+      pegtl::memory_input in( url, "url" );
+      pegtl::parse< pegtl::must< pegtl::uri::URI_reference, pegtl::eof >, examples::string_action >( in, c );
+      return c.path.size();
+   } );
+   examples::measure( "split", urls, iterations, []( const std::string& url ) {
+      return pegtl::uri::parser::split( url ).path.size();
+   } );
+   examples::measure( "decode", urls, iterations, []( std::string url ) {
+      auto c = pegtl::uri::parser::split( url );
+      pegtl::uri::parser::decode_in_place( c, url );
+      return c.path.size();
+   } );
+   return 0;
+}
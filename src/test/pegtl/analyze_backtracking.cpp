@@ -0,0 +1,67 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include "test.hpp"
+
+#include <tao/pegtl/analyze.hpp>
+#include <tao/pegtl/contrib/json.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   // Alternatives that share the (recursive) prefix atom.
+
+   struct bad_expr;
+
+   struct bad_atom
+      : sor< plus< digit >, seq< one< '(' >, bad_expr, one< ')' > > >
+   {
+   };
+
+   struct bad_term
+      : sor< seq< bad_atom, one< '*' >, bad_term >, seq< bad_atom, one< '/' >, bad_term >, bad_atom >
+   {
+   };
+
+   struct bad_expr
+      : sor< seq< bad_term, one< '+' >, bad_expr >, bad_term >
+   {
+   };
+
+   // The same language with the common prefixes factored out.
+
+   struct good_expr;
+
+   struct good_atom
+      : sor< plus< digit >, seq< one< '(' >, good_expr, one< ')' > > >
+   {
+   };
+
+   struct good_term
+      : seq< good_atom, star< one< '*', '/' >, good_atom > >
+   {
+   };
+
+   struct good_expr
+      : seq< good_term, star< one< '+' >, good_term > >
+   {
+   };
+
+   void unit_test()
+   {
+      TAO_PEGTL_TEST_ASSERT( analyze_backtracking< bad_expr >( false ) == 2 );
+      TAO_PEGTL_TEST_ASSERT( analyze_backtracking< good_expr >( false ) == 0 );
+
+      TAO_PEGTL_TEST_ASSERT( analyze_backtracking< star< sor< seq< star< alpha >, one< ';' > >, alpha > > >( false ) == 1 );
+      TAO_PEGTL_TEST_ASSERT( analyze_backtracking< star< sor< until< one< ';' > >, any > > >( false ) == 1 );
+      TAO_PEGTL_TEST_ASSERT( analyze_backtracking< star< sor< seq< one< '#' >, star< alpha >, one< ';' > >, alpha > > >( false ) == 0 );
+      TAO_PEGTL_TEST_ASSERT( analyze_backtracking< star< sor< seq< star< alpha >, one< ';' > >, plus< alpha > > > >( false ) == 0 );
+      TAO_PEGTL_TEST_ASSERT( analyze_backtracking< star< seq< plus< alpha >, one< ';' > > > >( false ) == 0 );
+      TAO_PEGTL_TEST_ASSERT( analyze_backtracking< star< until< eolf > > >( false ) == 0 );
+      TAO_PEGTL_TEST_ASSERT( analyze_backtracking< list< plus< digit >, one< ',' > > >( false ) == 0 );
+
+      TAO_PEGTL_TEST_ASSERT( analyze_backtracking< json::text >( false ) == 0 );
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
@@ -13,6 +13,33 @@ namespace TAO_PEGTL_NAMESPACE
       using analyze_t = analysis::generic< analysis::rule_type::any, Rules... >;
    };
 
+   // Larger grammars where every rule reaches most other rules without
+   // consuming input, one of them with cycles without progress.
+
+   template< unsigned N >
+   struct chain
+      : sor< seq< opt< one< 'x' > >, chain< N - 1 > >, seq< one< 'y' >, chain< ( N * 7 ) % 100 > > >
+   {
+   };
+
+   template<>
+   struct chain< 0 >
+      : plus< any >
+   {
+   };
+
+   template< unsigned N >
+   struct loop
+      : sor< seq< opt< one< 'x' > >, loop< N - 1 > >, seq< one< 'y' >, loop< ( N * 7 ) % 100 > > >
+   {
+   };
+
+   template<>
+   struct loop< 0 >
+      : star< loop< 50 > >
+   {
+   };
+
    void unit_test()
    {
       verify_analyze< eof >( __LINE__, __FILE__, false, false );
@@ -149,6 +176,8 @@ namespace TAO_PEGTL_NAMESPACE
          verify_analyze< exp >( __LINE__, __FILE__, true, true );
          verify_analyze< fun >( __LINE__, __FILE__, true, true );
          verify_analyze< var >( __LINE__, __FILE__, true, true );
+         TAO_PEGTL_TEST_ASSERT( analyze< exp >( false ) == 7 );
+         static_assert( analyze_v< exp > == 7 );
       }
       {
          struct exp : sor< exp, seq< any, exp > >
@@ -300,6 +329,17 @@ namespace TAO_PEGTL_NAMESPACE
          };
          verify_analyze< tst >( __LINE__, __FILE__, false, true );
       }
+      verify_analyze< chain< 99 > >( __LINE__, __FILE__, true, false );
+      verify_analyze< loop< 99 > >( __LINE__, __FILE__, false, true );
+      verify_analyze< seq< any, loop< 99 > > >( __LINE__, __FILE__, true, true );
+      TAO_PEGTL_TEST_ASSERT( analyze< loop< 99 > >( false ) == 400 );
+
+      static_assert( analyze_v< chain< 99 > > == 0 );
+      static_assert( analyze_v< loop< 99 > > == 400 );
+      static_assert( analysis::consumes_v< chain< 99 > > );
+      static_assert( analysis::consumes_v< seq< opt< any >, one< 'a' > > > );
+      static_assert( analysis::nullable_v< sor< one< 'a' >, opt< any > > > );
+      static_assert( analysis::nullable_v< star< chain< 99 > > > );
    }
 
 }  // namespace TAO_PEGTL_NAMESPACE
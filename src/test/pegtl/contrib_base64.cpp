@@ -0,0 +1,147 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "test.hpp"
+#include "verify_rule.hpp"
+
+#include <tao/pegtl/contrib/base64.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   std::string encode( const std::string& s, const char* alphabet, const bool padding )
+   {
+      std::string r;
+      std::size_t i = 0;
+      for( ; i + 3 <= s.size(); i += 3 ) {
+         const unsigned v = ( unsigned( std::uint8_t( s[ i ] ) ) << 16 ) | ( unsigned( std::uint8_t( s[ i + 1 ] ) ) << 8 ) | std::uint8_t( s[ i + 2 ] );
+         r += alphabet[ v >> 18 ];
+         r += alphabet[ ( v >> 12 ) & 63 ];
+         r += alphabet[ ( v >> 6 ) & 63 ];
+         r += alphabet[ v & 63 ];
+      }
+      if( i + 1 == s.size() ) {
+         const unsigned v = unsigned( std::uint8_t( s[ i ] ) ) << 16;
+         r += alphabet[ v >> 18 ];
+         r += alphabet[ ( v >> 12 ) & 63 ];
+         r += padding ? "==" : "";
+      }
+      else if( i + 2 == s.size() ) {
+         const unsigned v = ( unsigned( std::uint8_t( s[ i ] ) ) << 16 ) | ( unsigned( std::uint8_t( s[ i + 1 ] ) ) << 8 );
+         r += alphabet[ v >> 18 ];
+         r += alphabet[ ( v >> 12 ) & 63 ];
+         r += alphabet[ ( v >> 6 ) & 63 ];
+         r += padding ? "=" : "";
+      }
+      return r;
+   }
+
+   const char* const standard = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+   const char* const url = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+   template< typename Rule >
+   struct decode_action
+   {
+   };
+
+   template<>
+   struct decode_action< base64::value >
+      : base64::append_decoded
+   {
+   };
+
+   template<>
+   struct decode_action< base64url::value >
+      : base64url::append_decoded
+   {
+   };
+
+   template< typename Rule >
+   std::string parse_decoded( const std::string& data )
+   {
+      std::string s;
+      memory_input in( data, __FUNCTION__ );
+      TAO_PEGTL_TEST_ASSERT( parse< seq< Rule, eof >, decode_action >( in, s ) );
+      return s;
+   }
+
+   void test_rules()
+   {
+      verify_rule< base64::value >( __LINE__, __FILE__, "", result_type::local_failure );
+      verify_rule< base64::value >( __LINE__, __FILE__, "Zg==", result_type::success );
+      verify_rule< base64::value >( __LINE__, __FILE__, "Zm8=", result_type::success );
+      verify_rule< base64::value >( __LINE__, __FILE__, "Zm9v", result_type::success );
+      verify_rule< base64::value >( __LINE__, __FILE__, "Zm9v\"", result_type::success, 1 );
+      verify_rule< base64::value >( __LINE__, __FILE__, "Zm9v=", result_type::success, 1 );
+      verify_rule< base64::value >( __LINE__, __FILE__, "Zm9vYg==,", result_type::success, 1 );
+      verify_rule< base64::value >( __LINE__, __FILE__, "+/+/", result_type::success );
+      verify_rule< base64::value >( __LINE__, __FILE__, "Z", result_type::local_failure );
+      verify_rule< base64::value >( __LINE__, __FILE__, "Zg", result_type::local_failure );
+      verify_rule< base64::value >( __LINE__, __FILE__, "Zg=", result_type::local_failure );
+      verify_rule< base64::value >( __LINE__, __FILE__, "Zm8", result_type::local_failure );
+      verify_rule< base64::value >( __LINE__, __FILE__, "Zm9vY", result_type::local_failure );
+      verify_rule< base64::value >( __LINE__, __FILE__, "-_-_", result_type::local_failure );
+
+      verify_rule< base64url::value >( __LINE__, __FILE__, "", result_type::local_failure );
+      verify_rule< base64url::value >( __LINE__, __FILE__, "Zg", result_type::success );
+      verify_rule< base64url::value >( __LINE__, __FILE__, "Zg==", result_type::success );
+      verify_rule< base64url::value >( __LINE__, __FILE__, "Zg=", result_type::success, 1 );
+      verify_rule< base64url::value >( __LINE__, __FILE__, "Zm8", result_type::success );
+      verify_rule< base64url::value >( __LINE__, __FILE__, "-_-_.", result_type::success, 1 );
+      verify_rule< base64url::value >( __LINE__, __FILE__, "Zm9vY", result_type::local_failure );
+      verify_rule< base64url::value >( __LINE__, __FILE__, "+/+/", result_type::local_failure );
+   }
+
+   void test_decode()
+   {
+      TAO_PEGTL_TEST_ASSERT( parse_decoded< base64::value >( "Zm9vYmFy" ) == "foobar" );
+      TAO_PEGTL_TEST_ASSERT( parse_decoded< base64::value >( "Zm9vYmE=" ) == "fooba" );
+      TAO_PEGTL_TEST_ASSERT( parse_decoded< base64::value >( "Zm9vYg==" ) == "foob" );
+      TAO_PEGTL_TEST_ASSERT( parse_decoded< base64url::value >( "Zm9vYg" ) == "foob" );
+
+      // All lengths up to a few SIMD blocks, with all byte values.
+
+      std::string data;
+      for( std::size_t i = 0; i < 200; ++i ) {
+         data += char( i * 73 + ( i >> 3 ) );
+      }
+      for( std::size_t n = 1; n <= data.size(); ++n ) {
+         const std::string d = data.substr( 0, n );
+         const std::string e = encode( d, standard, true );
+         TAO_PEGTL_TEST_ASSERT( base64::decoded_size( e.data(), e.data() + e.size() ) == n );
+         TAO_PEGTL_TEST_ASSERT( parse_decoded< base64::value >( e ) == d );
+         TAO_PEGTL_TEST_ASSERT( parse_decoded< base64url::value >( encode( d, url, true ) ) == d );
+         TAO_PEGTL_TEST_ASSERT( parse_decoded< base64url::value >( encode( d, url, false ) ) == d );
+      }
+
+      std::vector< std::uint8_t > v = { 1, 2 };
+      const std::string e = encode( std::string( "\xff\x00\x80", 3 ), standard, true );
+      memory_input in( e, __FUNCTION__ );
+      TAO_PEGTL_TEST_ASSERT( parse< base64::value, decode_action >( in, v ) );
+      TAO_PEGTL_TEST_ASSERT( ( v == std::vector< std::uint8_t >{ 1, 2, 0xff, 0x00, 0x80 } ) );
+   }
+
+   void test_stream()
+   {
+      std::istringstream stream( "Zm9vYmE=" );
+      std::string s;
+      TAO_PEGTL_TEST_ASSERT( parse< seq< base64::value, eof >, decode_action >( istream_input( stream, 16, __FUNCTION__ ), s ) );
+      TAO_PEGTL_TEST_ASSERT( s == "fooba" );
+
+      std::istringstream failure( "Zm9vY" );
+      TAO_PEGTL_TEST_ASSERT( !parse< base64::value >( istream_input( failure, 16, __FUNCTION__ ) ) );
+   }
+
+   void unit_test()
+   {
+      test_rules();
+      test_decode();
+      test_stream();
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
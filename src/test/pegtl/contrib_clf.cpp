@@ -0,0 +1,82 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <string>
+
+#include "test.hpp"
+#include "verify_rule.hpp"
+
+#include <tao/pegtl/contrib/clf.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   void test_rules()
+   {
+      verify_rule< clf::host >( __LINE__, __FILE__, "127.0.0.1 -", result_type::success, 2 );
+      verify_rule< clf::host >( __LINE__, __FILE__, " ", result_type::local_failure, 1 );
+      verify_rule< clf::timestamp >( __LINE__, __FILE__, "[10/Oct/2000:13:55:36 -0700]", result_type::success );
+      verify_rule< clf::timestamp >( __LINE__, __FILE__, "[10/Oct/2000:13:55:36]", result_type::local_failure );
+      verify_rule< clf::request >( __LINE__, __FILE__, "\"GET / HTTP/1.1\"", result_type::success );
+      verify_rule< clf::request >( __LINE__, __FILE__, "\"a\\\"b\\\\\" ", result_type::success, 1 );
+      verify_rule< clf::request >( __LINE__, __FILE__, "\"a\\\"", result_type::local_failure );
+      verify_rule< clf::request >( __LINE__, __FILE__, "\"a\n\"", result_type::local_failure );
+      verify_rule< clf::bytes >( __LINE__, __FILE__, "-", result_type::success );
+      verify_rule< clf::bytes >( __LINE__, __FILE__, "2326", result_type::success );
+   }
+
+   void test_parse()
+   {
+      clf::entry r;
+      TAO_PEGTL_TEST_ASSERT( clf::parse( "127.0.0.1 - frank [10/Oct/2000:13:55:36 -0700] \"GET /apache_pb.gif HTTP/1.0\" 200 2326", r ) );
+      TAO_PEGTL_TEST_ASSERT( r.host == "127.0.0.1" );
+      TAO_PEGTL_TEST_ASSERT( r.ident.empty() );
+      TAO_PEGTL_TEST_ASSERT( r.user == "frank" );
+      TAO_PEGTL_TEST_ASSERT( ( r.timestamp == timestamp::epoch{ 971211336, 0 } ) );
+      TAO_PEGTL_TEST_ASSERT( r.request == "GET /apache_pb.gif HTTP/1.0" );
+      TAO_PEGTL_TEST_ASSERT( r.method == "GET" );
+      TAO_PEGTL_TEST_ASSERT( r.target == "/apache_pb.gif" );
+      TAO_PEGTL_TEST_ASSERT( r.protocol == "HTTP/1.0" );
+      TAO_PEGTL_TEST_ASSERT( r.status == 200 );
+      TAO_PEGTL_TEST_ASSERT( r.bytes == 2326 );
+      TAO_PEGTL_TEST_ASSERT( r.referer.empty() );
+      TAO_PEGTL_TEST_ASSERT( r.user_agent.empty() );
+
+      TAO_PEGTL_TEST_ASSERT( clf::parse( "::1 - - [01/Jan/1970:00:00:00 +0000] \"\\x16\\x03\\x01\" 400 - \"-\" \"Mozilla/4.08 [en] (Win98; I ;Nav)\"\r", r ) );
+      TAO_PEGTL_TEST_ASSERT( r.host == "::1" );
+      TAO_PEGTL_TEST_ASSERT( r.user.empty() );
+      TAO_PEGTL_TEST_ASSERT( r.timestamp.seconds == 0 );
+      TAO_PEGTL_TEST_ASSERT( r.request == "\\x16\\x03\\x01" );
+      TAO_PEGTL_TEST_ASSERT( r.method.empty() );
+      TAO_PEGTL_TEST_ASSERT( r.status == 400 );
+      TAO_PEGTL_TEST_ASSERT( r.bytes == 0 );
+      TAO_PEGTL_TEST_ASSERT( r.referer.empty() );
+      TAO_PEGTL_TEST_ASSERT( r.user_agent == "Mozilla/4.08 [en] (Win98; I ;Nav)" );
+
+      std::string s;
+      clf::unescape( r.request, s );
+      TAO_PEGTL_TEST_ASSERT( s == "\x16\x03\x01" );
+      s.clear();
+      clf::unescape( "a\\\"b\\\\c\\q\\x4", s );
+      TAO_PEGTL_TEST_ASSERT( s == "a\"b\\c\\q\\x4" );
+
+      TAO_PEGTL_TEST_ASSERT( clf::parse( "h i u [10/Oct/2000:13:55:36 -0700] \"GET  HTTP/1.0\" 200 1 \"http://example.com/\" \"\"", r ) );
+      TAO_PEGTL_TEST_ASSERT( r.method.empty() );
+      TAO_PEGTL_TEST_ASSERT( r.referer == "http://example.com/" );
+
+      TAO_PEGTL_TEST_ASSERT( !clf::parse( "", r ) );
+      TAO_PEGTL_TEST_ASSERT( !clf::parse( "h i u [10/Oct/2000:13:55:36 -0700] \"GET / HTTP/1.0\" 200", r ) );
+      TAO_PEGTL_TEST_ASSERT( !clf::parse( "h i u [10/Oct/2000:13:55:36 -0700] \"GET / HTTP/1.0\" 2000 1", r ) );
+      TAO_PEGTL_TEST_ASSERT( !clf::parse( "h i u [10/Oct/2000:13:55:36 -0700] \"GET / HTTP/1.0\" 200 1 \"-\"", r ) );
+      TAO_PEGTL_TEST_ASSERT( !clf::parse( "h i u [10/Oct/2000:13:55:36 -0700] \"GET / HTTP/1.0\" 200 1 x", r ) );
+      TAO_PEGTL_TEST_ASSERT( !clf::parse( "h i u [10/Oct/2000:13:55:36] \"GET / HTTP/1.0\" 200 1", r ) );
+   }
+
+   void unit_test()
+   {
+      test_rules();
+      test_parse();
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
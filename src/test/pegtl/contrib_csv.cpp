@@ -0,0 +1,138 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "test.hpp"
+#include "verify_analyze.hpp"
+#include "verify_rule.hpp"
+
+#include <tao/pegtl/contrib/csv.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   std::string dump( const csv::table& t )
+   {
+      std::string r;
+      for( const auto& n : t.names() ) {
+         r += n + '|';
+      }
+      for( std::size_t i = 0; i < t.columns(); ++i ) {
+         r += ';';
+         for( const auto& s : t.text( i ) ) {
+            r += std::string( s ) + '|';
+         }
+         for( const auto n : t.integers( i ) ) {
+            r += std::to_string( n ) + '|';
+         }
+         for( const auto d : t.reals( i ) ) {
+            r += std::to_string( d ) + '|';
+         }
+      }
+      return r;
+   }
+
+   template< char Sep = ',' >
+   std::string columns( const std::string& data, const std::vector< csv::column_type >& types, const bool header = false )
+   {
+      csv::table a( types, header );
+      memory_input in( data, __FUNCTION__ );
+      TAO_PEGTL_TEST_ASSERT( parse< must< csv::file< Sep > >, csv::columnar_action >( in, a ) );
+      csv::table b( types, header );
+      csv::read< Sep >( memory_input( data, __FUNCTION__ ), b );
+      TAO_PEGTL_TEST_ASSERT( a.rows() == b.rows() );
+      TAO_PEGTL_TEST_ASSERT( dump( a ) == dump( b ) );
+      return std::to_string( a.rows() ) + dump( a );
+   }
+
+   void verify_error( const std::size_t line, const char* file, const std::string& data, const std::vector< csv::column_type >& types, const std::size_t byte )
+   {
+      csv::table a( types );
+      memory_input in( data, __FUNCTION__ );
+      try {
+         (void)parse< must< csv::file<> >, csv::columnar_action >( in, a );
+         TAO_PEGTL_TEST_UNWRAP( std::cerr << "pegtl: unit test failed, no error from grammar for [ " << data << " ] in line [ " << line << " ] file [ " << file << " ]" << std::endl );
+         ++failed;
+      }
+      catch( const parse_error& /*unused*/ ) {
+      }
+      csv::table b( types );
+      try {
+         csv::read( memory_input( data, __FUNCTION__ ), b );
+         TAO_PEGTL_TEST_UNWRAP( std::cerr << "pegtl: unit test failed, no error from read for [ " << data << " ] in line [ " << line << " ] file [ " << file << " ]" << std::endl );
+         ++failed;
+      }
+      catch( const parse_error& e ) {
+         if( e.positions.at( 0 ).byte != byte ) {
+            TAO_PEGTL_TEST_UNWRAP( std::cerr << "pegtl: unit test failed, error at " << e.positions.at( 0 ) << " for [ " << data << " ] in line [ " << line << " ] file [ " << file << " ]" << std::endl );
+            ++failed;
+         }
+      }
+   }
+
+   void unit_test()
+   {
+      verify_analyze< csv::file<> >( __LINE__, __FILE__, false, false );
+
+      verify_rule< csv::field<> >( __LINE__, __FILE__, "", result_type::success, 0 );
+      verify_rule< csv::field<> >( __LINE__, __FILE__, "abc,d", result_type::success, 2 );
+      verify_rule< csv::field<> >( __LINE__, __FILE__, "a b\r\n", result_type::success, 2 );
+      verify_rule< csv::field<> >( __LINE__, __FILE__, "a\"b", result_type::success, 2 );
+      verify_rule< csv::field<> >( __LINE__, __FILE__, "\"a,\"\"b\nc\",d", result_type::success, 2 );
+      verify_rule< csv::field<> >( __LINE__, __FILE__, "\"\"\"\",", result_type::success, 1 );
+      verify_rule< csv::field<> >( __LINE__, __FILE__, "\"abc", result_type::global_failure, 0 );
+      verify_rule< csv::field< '\t' > >( __LINE__, __FILE__, "a,b\tc", result_type::success, 2 );
+      verify_rule< csv::record<> >( __LINE__, __FILE__, "a,\"b\",,c\r\n", result_type::success, 2 );
+      verify_rule< csv::file<> >( __LINE__, __FILE__, "", result_type::success, 0 );
+      verify_rule< csv::file<> >( __LINE__, __FILE__, "a,b\r\nc,d", result_type::success, 0 );
+      verify_rule< csv::file<> >( __LINE__, __FILE__, "a,b\nc,d\n", result_type::success, 0 );
+      verify_rule< csv::file<> >( __LINE__, __FILE__, "a,b\rc,d\n", result_type::global_failure, 6 );
+      verify_rule< csv::file<> >( __LINE__, __FILE__, "a,\"b\"c\n", result_type::global_failure, 2 );
+
+      using csv::column_type;
+      const std::vector< column_type > types = { column_type::text, column_type::integer, column_type::skip, column_type::real };
+
+      TAO_PEGTL_TEST_ASSERT( columns( "", types ) == "0;;;;" );
+      TAO_PEGTL_TEST_ASSERT( columns( "a,1,x,1.5\n\"b\"\"\",-2,,3e2\r\n\"c\nd\",+3,\"y,z\",-0.25", types ) == "3;a|b\"|c\nd|;1|-2|3|;;1.500000|300.000000|-0.250000|" );
+      TAO_PEGTL_TEST_ASSERT( columns( "name,id,-,value\r\na,1,x,1\r\n", types, true ) == "1name|id|-|value|;a|;1|;;1.000000|" );
+      TAO_PEGTL_TEST_ASSERT( columns< '\t' >( "a,b\t7\n", { column_type::text, column_type::integer } ) == "1;a,b|;7|" );
+      TAO_PEGTL_TEST_ASSERT( columns( "\n\"\"\n", { column_type::text } ) == "2;||" );
+
+      // A closing quote at the end of the input, also as the last byte of an incomplete block.
+      TAO_PEGTL_TEST_ASSERT( columns( "\"a\"", { column_type::text } ) == "1;a|" );
+      TAO_PEGTL_TEST_ASSERT( columns( "1,\"a\"", { column_type::integer, column_type::text } ) == "1;1|;a|" );
+      for( const std::size_t n : { 58, 59, 60, 122, 123 } ) {
+         const std::string x( n, 'x' );
+         TAO_PEGTL_TEST_ASSERT( columns( x + ",\"a\"", { column_type::text, column_type::text } ) == "1;" + x + "|;a|" );
+      }
+
+      std::string big;
+      std::string expected;
+      for( int i = 0; i < 300; ++i ) {
+         const std::string s( std::size_t( i % 70 ), char( 'a' + i % 26 ) );
+         big += ( i % 3 ) ? s : ( '"' + s + ",\"\"\n\"" );
+         big += ',' + std::to_string( i * 7 ) + ( ( i % 2 ) ? "\n" : "\r\n" );
+         expected += ( i % 3 ) ? s : ( s + ",\"\n" );
+         expected += '|';
+      }
+      TAO_PEGTL_TEST_ASSERT( columns( big, { column_type::text, column_type::skip } ) == "300;" + expected + ';' );
+
+      verify_error( __LINE__, __FILE__, "a,1,x,1\nb,2,y\n", types, 8 );
+      verify_error( __LINE__, __FILE__, "a,1,x,1,2\n", types, 8 );
+      verify_error( __LINE__, __FILE__, "a,1,x,1\nb,2.5,y,1\n", types, 10 );
+      verify_error( __LINE__, __FILE__, "a,1,x,1e\n", types, 6 );
+      verify_error( __LINE__, __FILE__, "a,,x,1\n", types, 2 );
+      verify_error( __LINE__, __FILE__, "a,1,x\"y,1\n", types, 5 );
+      verify_error( __LINE__, __FILE__, "a\rb,1,x,1\n", types, 1 );
+      verify_error( __LINE__, __FILE__, "\"a\"b,1,x,1\n", types, 2 );
+      verify_error( __LINE__, __FILE__, "\"a,1,x,1\n", types, 0 );
+      verify_error( __LINE__, __FILE__, "a,1,x,1\r", types, 7 );
+      verify_error( __LINE__, __FILE__, "a,1,x,\"1\"\r", types, 9 );
+      verify_error( __LINE__, __FILE__, "a,1,x,\"1\"2", types, 8 );
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
@@ -0,0 +1,68 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <sstream>
+#include <string>
+
+#include "test.hpp"
+#include "verify_rule.hpp"
+
+#include <tao/pegtl/contrib/hex.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   template< typename Rule >
+   struct decode_action
+   {
+   };
+
+   template<>
+   struct decode_action< hex::value >
+      : hex::append_decoded
+   {
+   };
+
+   std::string parse_decoded( const std::string& data )
+   {
+      std::string s;
+      memory_input in( data, __FUNCTION__ );
+      TAO_PEGTL_TEST_ASSERT( parse< seq< hex::value, eof >, decode_action >( in, s ) );
+      return s;
+   }
+
+   void unit_test()
+   {
+      verify_rule< hex::value >( __LINE__, __FILE__, "", result_type::local_failure );
+      verify_rule< hex::value >( __LINE__, __FILE__, "0", result_type::local_failure );
+      verify_rule< hex::value >( __LINE__, __FILE__, "00", result_type::success );
+      verify_rule< hex::value >( __LINE__, __FILE__, "aF9", result_type::local_failure );
+      verify_rule< hex::value >( __LINE__, __FILE__, "aF9b", result_type::success );
+      verify_rule< hex::value >( __LINE__, __FILE__, "aF9bg", result_type::success, 1 );
+      verify_rule< hex::value >( __LINE__, __FILE__, "gg", result_type::local_failure );
+
+      TAO_PEGTL_TEST_ASSERT( parse_decoded( "00ff7F80" ) == std::string( "\x00\xff\x7f\x80", 4 ) );
+
+      // All lengths up to a few SIMD blocks, with all byte values in both cases.
+
+      const char* const digits[] = { "0123456789abcdef", "0123456789ABCDEF" };
+      for( const char* d : digits ) {
+         std::string data;
+         std::string text;
+         for( std::size_t i = 0; i < 256; ++i ) {
+            data += char( i * 73 );
+            text += d[ std::uint8_t( data.back() ) >> 4 ];
+            text += d[ std::uint8_t( data.back() ) & 15 ];
+            TAO_PEGTL_TEST_ASSERT( hex::decoded_size( text.data(), text.data() + text.size() ) == data.size() );
+            TAO_PEGTL_TEST_ASSERT( parse_decoded( text ) == data );
+         }
+      }
+
+      std::istringstream stream( "c0ffee" );
+      std::string s;
+      TAO_PEGTL_TEST_ASSERT( parse< seq< hex::value, eof >, decode_action >( istream_input( stream, 16, __FUNCTION__ ), s ) );
+      TAO_PEGTL_TEST_ASSERT( s == "\xc0\xff\xee" );
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
@@ -0,0 +1,210 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <limits>
+#include <string>
+
+#include "test.hpp"
+#include "verify_analyze.hpp"
+#include "verify_rule.hpp"
+
+#include <tao/pegtl/contrib/http_parser.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   using namespace http::parser;
+
+   void test_header_ids()
+   {
+      for( std::size_t i = 1; i <= std::size_t( header_id::x_request_id ); ++i ) {
+         const auto id = header_id( i );
+         std::string name( header_name( id ) );
+         TAO_PEGTL_TEST_ASSERT( find_header_id( name ) == id );
+         for( auto& c : name ) {
+            if( ( 'a' <= c ) && ( c <= 'z' ) ) {
+               c = char( c - 'a' + 'A' );
+            }
+         }
+         TAO_PEGTL_TEST_ASSERT( find_header_id( name ) == id );
+         TAO_PEGTL_TEST_ASSERT( find_header_id( name + 'x' ) == header_id::unknown );
+         TAO_PEGTL_TEST_ASSERT( find_header_id( name.substr( 1 ) ) == header_id::unknown );
+      }
+      TAO_PEGTL_TEST_ASSERT( find_header_id( "" ) == header_id::unknown );
+      TAO_PEGTL_TEST_ASSERT( find_header_id( "X-Custom" ) == header_id::unknown );
+      TAO_PEGTL_TEST_ASSERT( find_header_id( "Hosu" ) == header_id::unknown );
+      TAO_PEGTL_TEST_ASSERT( find_header_id( "Content-Length" ) == header_id::content_length );
+   }
+
+   void test_rules()
+   {
+      verify_analyze< request_head >( __LINE__, __FILE__, true, false );
+      verify_analyze< response_head >( __LINE__, __FILE__, true, false );
+
+      verify_rule< token >( __LINE__, __FILE__, "", result_type::local_failure, 0 );
+      verify_rule< token >( __LINE__, __FILE__, "Content-Type: x", result_type::success, 3 );
+      verify_rule< token >( __LINE__, __FILE__, "a!#$%&'*+-.^_`|~Z9 ", result_type::success, 1 );
+      verify_rule< field_value >( __LINE__, __FILE__, "", result_type::success, 0 );
+      verify_rule< field_value >( __LINE__, __FILE__, "a \tb\xff\r\n", result_type::success, 2 );
+      verify_rule< field_value >( __LINE__, __FILE__, "a\x7f", result_type::success, 1 );
+      verify_rule< request_target >( __LINE__, __FILE__, "", result_type::local_failure, 0 );
+      verify_rule< request_target >( __LINE__, __FILE__, "/a?b=c HTTP/1.1", result_type::success, 9 );
+
+      std::string value( 200, 'v' );
+      value[ 150 ] = '\r';
+      verify_rule< field_value >( __LINE__, __FILE__, value, result_type::success, 50 );
+      value[ 70 ] = '\0';
+      verify_rule< field_value >( __LINE__, __FILE__, value, result_type::success, 130 );
+   }
+
+   void test_request()
+   {
+      const std::string head = "POST /index.html?a=b HTTP/1.1\r\n"
+                               "Host: www.example.com\r\n"
+                               "X-Custom:  some value \t\r\n"
+                               "Content-Length: 12\r\n"
+                               "empty:\r\n"
+                               "CONNECTION: close\r\n"
+                               "\r\n";
+      const std::string data = head + "Hello World!";
+      request r;
+      for( std::size_t i = 0; i < head.size(); ++i ) {
+         TAO_PEGTL_TEST_ASSERT( parse_request( data.data(), i, r ) == 0 );
+      }
+      for( std::size_t i = head.size(); i <= data.size(); ++i ) {
+         TAO_PEGTL_TEST_ASSERT( parse_request( data.data(), i, r ) == head.size() );
+      }
+      TAO_PEGTL_TEST_ASSERT( r.method == "POST" );
+      TAO_PEGTL_TEST_ASSERT( r.target == "/index.html?a=b" );
+      TAO_PEGTL_TEST_ASSERT( r.minor_version == 1 );
+      TAO_PEGTL_TEST_ASSERT( r.headers.size() == 5 );
+      TAO_PEGTL_TEST_ASSERT( r.headers[ 0 ].id == header_id::host );
+      TAO_PEGTL_TEST_ASSERT( r.headers[ 0 ].name == "Host" );
+      TAO_PEGTL_TEST_ASSERT( r.headers[ 0 ].value == "www.example.com" );
+      TAO_PEGTL_TEST_ASSERT( r.headers[ 1 ].id == header_id::unknown );
+      TAO_PEGTL_TEST_ASSERT( r.headers[ 1 ].value == "some value" );
+      TAO_PEGTL_TEST_ASSERT( r.headers[ 3 ].name == "empty" );
+      TAO_PEGTL_TEST_ASSERT( r.headers[ 3 ].value.empty() );
+      TAO_PEGTL_TEST_ASSERT( r.find( header_id::content_length ) == "12" );
+      TAO_PEGTL_TEST_ASSERT( !r.find( header_id::cookie ) );
+      TAO_PEGTL_TEST_ASSERT( r.content_length == 12 );
+      TAO_PEGTL_TEST_ASSERT( !r.chunked );
+      TAO_PEGTL_TEST_ASSERT( !r.keep_alive );
+
+      TAO_PEGTL_TEST_ASSERT( parse_request( "GET / HTTP/1.0\nTransfer-Encoding: gzip, Chunked\n\n", r ) == 49 );
+      TAO_PEGTL_TEST_ASSERT( r.minor_version == 0 );
+      TAO_PEGTL_TEST_ASSERT( r.chunked );
+      TAO_PEGTL_TEST_ASSERT( !r.keep_alive );
+      TAO_PEGTL_TEST_ASSERT( !r.content_length );
+      TAO_PEGTL_TEST_ASSERT( r.headers.size() == 1 );
+
+      TAO_PEGTL_TEST_ASSERT( parse_request( "GET / HTTP/1.0\r\nConnection: foo, keep-alive\r\n\r\n", r ) == 47 );
+      TAO_PEGTL_TEST_ASSERT( r.keep_alive );
+      TAO_PEGTL_TEST_ASSERT( parse_request( "GET * HTTP/1.1\r\nTransfer-Encoding: chunked, gzip\r\n\r\n", r ) == 52 );
+      TAO_PEGTL_TEST_ASSERT( !r.chunked );
+      TAO_PEGTL_TEST_ASSERT( r.keep_alive );
+
+      TAO_PEGTL_TEST_THROWS( (void)parse_request( "GET / HTTP/1.1\r\nContent-Length: 1x\r\n\r\n", r ) );
+      TAO_PEGTL_TEST_THROWS( (void)parse_request( "GET / HTTP/1.1\r\nContent-Length: 1\r\nContent-Length: 2\r\n\r\n", r ) );
+      TAO_PEGTL_TEST_THROWS( (void)parse_request( "GET / HTTP/1.1\r\nContent-Length: 1\r\nTransfer-Encoding: chunked\r\n\r\n", r ) );
+      TAO_PEGTL_TEST_THROWS( (void)parse_request( "GET / HTTP/1.1\r\nTransfer-Encoding: chunked\r\nContent-Length: 1\r\n\r\n", r ) );
+      TAO_PEGTL_TEST_THROWS( (void)parse_request( "GET / HTTP/1.1\r\nA: b\r\n c\r\n\r\n", r ) );
+      TAO_PEGTL_TEST_THROWS( (void)parse_request( "GET / HTTP/1.1\r\nA b\r\n\r\n", r ) );
+      TAO_PEGTL_TEST_THROWS( (void)parse_request( "GET / HTTP/2.0\r\n\r\n", r ) );
+      TAO_PEGTL_TEST_THROWS( (void)parse_request( "GET  / HTTP/1.1\r\n\r\n", r ) );
+      TAO_PEGTL_TEST_THROWS( (void)parse_request( "GET / HTTP/1.1\r\nA: b\x01\r\n\r\n", r ) );
+
+      // Errors in complete lines are reported without waiting for the end of the head.
+      TAO_PEGTL_TEST_THROWS( (void)parse_request( "GET  / HTTP/1.1\r\n", r ) );
+      TAO_PEGTL_TEST_THROWS( (void)parse_request( "GET / HTTP/1.1\r\nA b\r\n", r ) );
+      TAO_PEGTL_TEST_THROWS( (void)parse_request( "GET / HTTP/1.1\r\nContent-Length: 1x\r\n", r ) );
+      TAO_PEGTL_TEST_ASSERT( parse_request( "GET / HTTP/1.1\r\nA b", r ) == 0 );
+      TAO_PEGTL_TEST_ASSERT( parse_request( "GET / HTTP/1.1\r\nA: b\r", r ) == 0 );
+
+      const std::string max = std::to_string( std::numeric_limits< std::size_t >::max() );
+      TAO_PEGTL_TEST_ASSERT( parse_request( "GET / HTTP/1.1\r\nContent-Length: " + max + "\r\n\r\n", r ) != 0 );
+      TAO_PEGTL_TEST_ASSERT( r.content_length == std::numeric_limits< std::size_t >::max() );
+      TAO_PEGTL_TEST_ASSERT( parse_request( "GET / HTTP/1.1\r\nContent-Length: 000000000000000000000000012\r\n\r\n", r ) != 0 );
+      TAO_PEGTL_TEST_ASSERT( r.content_length == 12 );
+      TAO_PEGTL_TEST_THROWS( (void)parse_request( "GET / HTTP/1.1\r\nContent-Length: " + max + "0\r\n\r\n", r ) );
+      TAO_PEGTL_TEST_THROWS( (void)parse_request( "GET / HTTP/1.1\r\nContent-Length: 1" + max + "\r\n\r\n", r ) );
+      try {
+         (void)parse_request( "GET / HTTP/1.1\r\nHost: x\r\nA:\x7f\r\n\r\n", r );
+         TAO_PEGTL_TEST_UNWRAP( std::cerr << "pegtl: unit test failed, no exception for DEL" << std::endl );
+         ++failed;
+      }
+      catch( const parse_error& e ) {
+         TAO_PEGTL_TEST_ASSERT( e.positions.at( 0 ).byte == 27 );
+         TAO_PEGTL_TEST_ASSERT( e.positions.at( 0 ).line == 3 );
+         TAO_PEGTL_TEST_ASSERT( e.positions.at( 0 ).byte_in_line == 2 );
+      }
+   }
+
+   void test_response()
+   {
+      response r;
+      TAO_PEGTL_TEST_ASSERT( parse_response( "HTTP/1.1 404 Not Found\r\nServer: test\r\n\r\nbody", r ) == 40 );
+      TAO_PEGTL_TEST_ASSERT( r.status == 404 );
+      TAO_PEGTL_TEST_ASSERT( r.reason == "Not Found" );
+      TAO_PEGTL_TEST_ASSERT( r.headers.size() == 1 );
+      TAO_PEGTL_TEST_ASSERT( r.headers[ 0 ].id == header_id::server );
+      TAO_PEGTL_TEST_ASSERT( parse_response( "HTTP/1.0 200\r\n\r\n", r ) == 16 );
+      TAO_PEGTL_TEST_ASSERT( r.status == 200 );
+      TAO_PEGTL_TEST_ASSERT( r.reason.empty() );
+      TAO_PEGTL_TEST_ASSERT( r.headers.empty() );
+      TAO_PEGTL_TEST_ASSERT( parse_response( "HTTP/1.1 200 OK\r\n", r ) == 0 );
+      TAO_PEGTL_TEST_THROWS( (void)parse_response( "HTTP/1.1 20 OK\r\n\r\n", r ) );
+   }
+
+   std::string decode_all( const std::string& body, const std::size_t piece, std::size_t& consumed )
+   {
+      std::string r;
+      chunked_decoder d;
+      consumed = 0;
+      while( ( consumed < body.size() ) && !d.done() ) {
+         const auto n = std::min( piece, body.size() - consumed );
+         const auto c = d.decode( body.data() + consumed, n, [ & ]( const std::string_view s ) { r += s; } );
+         TAO_PEGTL_TEST_ASSERT( ( c == n ) || d.done() );
+         consumed += c;
+      }
+      return d.done() ? r : ( r + "<incomplete>" );
+   }
+
+   void test_chunked()
+   {
+      const std::string body = "5\r\nHello\r\n1;ext=\"a\"\r\n \r\n6\nWorld!\r\n2 \r\n\r\n\r\n10 \r\n0123456789abcdef\r\n0\r\nTrailer: x\r\nMore: y\r\n\r\nNEXT";
+      for( std::size_t piece = 1; piece <= body.size(); ++piece ) {
+         std::size_t consumed;
+         TAO_PEGTL_TEST_ASSERT( decode_all( body, piece, consumed ) == "Hello World!\r\n0123456789abcdef" );
+         TAO_PEGTL_TEST_ASSERT( consumed == body.size() - 4 );
+      }
+      std::size_t consumed;
+      TAO_PEGTL_TEST_ASSERT( decode_all( "0\n\n", 1, consumed ) == "" );
+      TAO_PEGTL_TEST_ASSERT( decode_all( "3\r\nabc\r\n", 2, consumed ) == "abc<incomplete>" );
+
+      TAO_PEGTL_TEST_THROWS( decode_all( "\r\n", 1, consumed ) );
+      TAO_PEGTL_TEST_THROWS( decode_all( "g\r\n", 1, consumed ) );
+      TAO_PEGTL_TEST_THROWS( decode_all( "1\r\nab\r\n", 1, consumed ) );
+      TAO_PEGTL_TEST_THROWS( decode_all( "1\rx", 1, consumed ) );
+      TAO_PEGTL_TEST_THROWS( decode_all( "1000000000000000000\r\n", 7, consumed ) );
+      try {
+         (void)decode_all( "2\r\nab\r\nz\r\n", 3, consumed );
+         TAO_PEGTL_TEST_UNWRAP( std::cerr << "pegtl: unit test failed, no exception for invalid chunk size" << std::endl );
+         ++failed;
+      }
+      catch( const parse_error& e ) {
+         TAO_PEGTL_TEST_ASSERT( e.positions.at( 0 ).byte == 7 );
+      }
+   }
+
+   void unit_test()
+   {
+      test_header_ids();
+      test_rules();
+      test_request();
+      test_response();
+      test_chunked();
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
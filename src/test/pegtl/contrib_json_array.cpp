@@ -0,0 +1,152 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <iostream>
+#include <string>
+
+#include "sum_action.hpp"
+#include "test.hpp"
+
+#include <tao/pegtl/contrib/json_array.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   struct totals
+   {
+      std::size_t elements = 0;
+      std::size_t strings = 0;
+      long long sum = 0;
+      std::string positions;
+      bool speculative = false;
+   };
+
+   totals parse_array( const std::string& data, const std::size_t threads, const std::size_t chunk_size )
+   {
+      json_array::options op;
+      op.threads = threads;
+      op.chunk_size = chunk_size;
+      const auto r = json_array::parse< json::value, sum_action >( data.data(), data.data() + data.size(), "data", []() { return sum_state(); }, op );
+      totals t;
+      t.elements = r.elements;
+      t.speculative = r.speculative;
+      for( const auto& s : r.states ) {
+         t.strings += s.strings;
+         t.sum += s.sum;
+         t.positions += s.positions;
+      }
+      return t;
+   }
+
+   position sequential_error( const std::string& data )
+   {
+      memory_input in( data, "data" );
+      try {
+         sum_state s;
+         (void)parse< json_array::internal::sequential< json::value >, sum_action >( in, s );
+      }
+      catch( const parse_error& e ) {
+         return e.positions.at( 0 );
+      }
+      throw std::logic_error( "no parse error" );
+   }
+
+   void verify_error( const std::size_t line, const char* file, const std::string& data )
+   {
+      const position expected = sequential_error( data );
+      for( const std::size_t threads : { 1, 3 } ) {
+         for( const std::size_t chunk_size : { 1, 5, 64 } ) {
+            try {
+               (void)parse_array( data, threads, chunk_size );
+               std::cerr << "pegtl: unit test failed, no error for [ " << data << " ] in line [ " << line << " ] file [ " << file << " ]" << std::endl;
+               ++failed;
+            }
+            catch( const parse_error& e ) {
+               const auto& p = e.positions.at( 0 );
+               if( ( p.byte != expected.byte ) || ( p.line != expected.line ) || ( p.byte_in_line != expected.byte_in_line ) ) {
+                  std::cerr << "pegtl: unit test failed, error at " << p << " instead of " << expected << " for [ " << data << " ] in line [ " << line << " ] file [ " << file << " ]" << std::endl;
+                  ++failed;
+               }
+            }
+         }
+      }
+   }
+
+   void unit_test()
+   {
+      std::string data = " \n[";
+      totals expected;
+      for( int i = 0; i < 500; ++i ) {
+         if( i != 0 ) {
+            data += ( i % 7 ) ? "," : "\n,\n";
+         }
+         switch( i % 5 ) {
+            case 0:
+               data += std::to_string( i );
+               expected.sum += i;
+               break;
+            case 1:
+               data += "\"a,[{\\\"b\\\\\\\\\\\",\" ";
+               ++expected.strings;
+               break;
+            case 2:
+               data += "{ \"x\" : [ " + std::to_string( i ) + ", \"]\", {} ], \"y\" : \"\\\\\" }";
+               expected.sum += i;
+               expected.strings += 2;
+               break;
+            case 3:
+               data += "[[[ \"" + std::string( std::size_t( i ), ',' ) + "\" ]]]";
+               ++expected.strings;
+               break;
+            default:
+               data += "\r\n\t[ true, null, { \"\\\"\" : \"{\" } ]";
+               expected.strings += 1;
+         }
+         ++expected.elements;
+      }
+      data += "]\n";
+
+      memory_input in( data, "data" );
+      sum_state s;
+      TAO_PEGTL_TEST_ASSERT( parse< json_array::internal::sequential< json::value >, sum_action >( in, s ) );
+      TAO_PEGTL_TEST_ASSERT( s.sum == expected.sum );
+
+      for( const std::size_t threads : { 1, 2, 4 } ) {
+         for( const std::size_t chunk_size : { 1, 2, 7, 64, 1000, 1 << 20 } ) {
+            const totals t = parse_array( data, threads, chunk_size );
+            TAO_PEGTL_TEST_ASSERT( t.speculative );
+            TAO_PEGTL_TEST_ASSERT( t.elements == expected.elements );
+            TAO_PEGTL_TEST_ASSERT( t.strings == expected.strings );
+            TAO_PEGTL_TEST_ASSERT( t.sum == expected.sum );
+            TAO_PEGTL_TEST_ASSERT( t.positions == s.positions );
+         }
+      }
+      {
+         const totals t = parse_array( " [ ] ", 2, 1 );
+         TAO_PEGTL_TEST_ASSERT( t.speculative );
+         TAO_PEGTL_TEST_ASSERT( t.elements == 0 );
+      }
+      {
+         const totals t = parse_array( "[\"\\\\\",\"\\\"\"]", 2, 1 );
+         TAO_PEGTL_TEST_ASSERT( t.speculative );
+         TAO_PEGTL_TEST_ASSERT( t.elements == 2 );
+         TAO_PEGTL_TEST_ASSERT( t.strings == 2 );
+      }
+      verify_error( __LINE__, __FILE__, "" );
+      verify_error( __LINE__, __FILE__, "{}" );
+      verify_error( __LINE__, __FILE__, "[ 1, 2 ] 3" );
+      verify_error( __LINE__, __FILE__, "[ 1, 2, ]" );
+      verify_error( __LINE__, __FILE__, "[ 1,\n 2 3 ]" );
+      verify_error( __LINE__, __FILE__, "[ 1, [ 2 ], 3 ], [ 4 ]" );
+      verify_error( __LINE__, __FILE__, "[ 1, [ 2 }, 3 ]" );
+      verify_error( __LINE__, __FILE__, "[ \"a\", \"b ]" );
+      verify_error( __LINE__, __FILE__, "[ \"a\\\" ]" );
+      verify_error( __LINE__, __FILE__, "[ 1, \\\"\", 2 ]" );
+      verify_error( __LINE__, __FILE__, "[ 1 ]]" );
+      verify_error( __LINE__, __FILE__, "[\n 1,\n\n { \"a\" : [ 1 2 ] }\n]" );
+
+      TAO_PEGTL_TEST_THROWS( parse_array( "[ 1, -666, 2 ]", 2, 1 ) );
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
@@ -0,0 +1,120 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#include "test.hpp"
+
+#include <tao/pegtl/contrib/json_dom.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   std::string round_trip( const std::string& s )
+   {
+      memory_input in( s, __FUNCTION__ );
+      const auto doc = json_dom::parse( in );
+      std::ostringstream o;
+      o << doc.root();
+      return o.str();
+   }
+
+   void test_numbers()
+   {
+      TAO_PEGTL_TEST_ASSERT( json::number_view( "0" ).is_integer() );
+      TAO_PEGTL_TEST_ASSERT( !json::number_view( "0.5" ).is_integer() );
+      TAO_PEGTL_TEST_ASSERT( !json::number_view( "1e5" ).is_integer() );
+
+      std::int64_t i = 0;
+      TAO_PEGTL_TEST_ASSERT( json::number_view( "-9223372036854775808" ).to_integer( i ) );
+      TAO_PEGTL_TEST_ASSERT( i == INT64_MIN );
+      TAO_PEGTL_TEST_ASSERT( !json::number_view( "9223372036854775808" ).to_integer( i ) );
+      TAO_PEGTL_TEST_ASSERT( !json::number_view( "1.0" ).to_integer( i ) );
+
+      std::uint8_t u = 0;
+      TAO_PEGTL_TEST_ASSERT( json::number_view( "255" ).to_integer( u ) );
+      TAO_PEGTL_TEST_ASSERT( u == 255 );
+      TAO_PEGTL_TEST_ASSERT( !json::number_view( "256" ).to_integer( u ) );
+      TAO_PEGTL_TEST_ASSERT( !json::number_view( "-1" ).to_integer( u ) );
+
+      TAO_PEGTL_TEST_ASSERT( json::number_view( "0" ).to_double() == 0.0 );
+      TAO_PEGTL_TEST_ASSERT( json::number_view( "-1.5" ).to_double() == -1.5 );
+      TAO_PEGTL_TEST_ASSERT( json::number_view( "0.1" ).to_double() == 0.1 );
+      TAO_PEGTL_TEST_ASSERT( json::number_view( "123.456e3" ).to_double() == 123456.0 );
+      TAO_PEGTL_TEST_ASSERT( json::number_view( "1E-2" ).to_double() == 0.01 );
+      TAO_PEGTL_TEST_ASSERT( json::number_view( "1e+22" ).to_double() == 1e22 );
+      TAO_PEGTL_TEST_ASSERT( json::number_view( "1e300" ).to_double() == 1e300 );
+      TAO_PEGTL_TEST_ASSERT( json::number_view( "2.2250738585072014e-308" ).to_double() == 2.2250738585072014e-308 );
+      TAO_PEGTL_TEST_ASSERT( json::number_view( "12345678901234567890123" ).to_double() == 12345678901234567890123.0 );
+      TAO_PEGTL_TEST_ASSERT( json::number_view( "0.000000000000000000000000001" ).to_double() == 1e-27 );
+   }
+
+   void unit_test()
+   {
+      TAO_PEGTL_TEST_ASSERT( sizeof( json_dom::value ) == 16 );
+
+      test_numbers();
+
+      TAO_PEGTL_TEST_ASSERT( round_trip( "null" ) == "null" );
+      TAO_PEGTL_TEST_ASSERT( round_trip( " [ ] " ) == "[]" );
+      TAO_PEGTL_TEST_ASSERT( round_trip( " { } " ) == "{}" );
+      TAO_PEGTL_TEST_ASSERT( round_trip( "[ true, false, null, 0, -1.5e3, \"\" ]" ) == "[true,false,null,0,-1.5e3,\"\"]" );
+      TAO_PEGTL_TEST_ASSERT( round_trip( "{ \"a\" : [ 1, { \"b\" : [ ] } ], \"c\" : { } }" ) == "{\"a\":[1,{\"b\":[]}],\"c\":{}}" );
+      TAO_PEGTL_TEST_ASSERT( round_trip( "[[[[1],2],3],4]" ) == "[[[[1],2],3],4]" );
+      TAO_PEGTL_TEST_ASSERT( round_trip( "[\"a\\\"b\\\\c\\/d\\te\\nf\"]" ) == "[\"a\\\"b\\\\c/d\\te\\nf\"]" );
+      TAO_PEGTL_TEST_ASSERT( round_trip( "[\"\\b\\f\\r\\u0001\"]" ) == "[\"\\u0008\\u000c\\u000d\\u0001\"]" );
+      TAO_PEGTL_TEST_ASSERT( round_trip( "{\"\\u00e4\":\"\\uD834\\uDD1E\"}" ) == "{\"\xc3\xa4\":\"\xf0\x9d\x84\x9e\"}" );
+
+      {
+         const std::string s = "{ \"id\": 42, \"name\": \"zero-copy\", \"escaped\": \"x\\ny\", \"list\": [ 1, 2, 3 ], \"id\": 43 }";
+         memory_input in( s, __FUNCTION__ );
+         const auto doc = json_dom::parse( in );
+         const auto& root = doc.root();
+         TAO_PEGTL_TEST_ASSERT( root.is_object() );
+         TAO_PEGTL_TEST_ASSERT( root.size() == 5 );
+
+         const auto* id = root.find( "id" );
+         TAO_PEGTL_TEST_ASSERT( id && id->is_number() );
+         int v = 0;
+         TAO_PEGTL_TEST_ASSERT( id->get_number().to_integer( v ) && ( v == 42 ) );
+
+         const auto* name = root.find( "name" );
+         TAO_PEGTL_TEST_ASSERT( name && name->is_string() );
+         TAO_PEGTL_TEST_ASSERT( name->get_string() == "zero-copy" );
+         TAO_PEGTL_TEST_ASSERT( name->get_string().data() == s.data() + s.find( "zero-copy" ) );
+
+         const auto* escaped = root.find( "escaped" );
+         TAO_PEGTL_TEST_ASSERT( escaped && ( escaped->get_string() == "x\ny" ) );
+
+         const auto* list = root.find( "list" );
+         TAO_PEGTL_TEST_ASSERT( list && list->is_array() && ( list->size() == 3 ) );
+         TAO_PEGTL_TEST_ASSERT( ( *list )[ 2 ].get_number().raw() == "3" );
+
+         TAO_PEGTL_TEST_ASSERT( root.find( "missing" ) == nullptr );
+         TAO_PEGTL_TEST_ASSERT( list->find( "id" ) == nullptr );
+      }
+      {
+         json_dom::arena a( 16 );
+         void* p = a.allocate( 3, 1 );
+         void* q = a.allocate( 8, 8 );
+         TAO_PEGTL_TEST_ASSERT( ( reinterpret_cast< std::uintptr_t >( q ) % 8 ) == 0 );
+         TAO_PEGTL_TEST_ASSERT( p != q );
+         (void)a.allocate( 1000 );
+         TAO_PEGTL_TEST_ASSERT( a.blocks() >= 2 );
+      }
+
+      TAO_PEGTL_TEST_THROWS( round_trip( "" ) );
+      TAO_PEGTL_TEST_THROWS( round_trip( "[1,]" ) );
+      TAO_PEGTL_TEST_THROWS( round_trip( "{\"a\":1}x" ) );
+      TAO_PEGTL_TEST_THROWS( round_trip( "[\"\\uD834\"]" ) );
+
+      file_input in( "src/test/pegtl/data/pass1.json" );
+      const auto doc = json_dom::parse( in );
+      TAO_PEGTL_TEST_ASSERT( doc.root().is_array() );
+      TAO_PEGTL_TEST_ASSERT( doc.root().size() == 20 );
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
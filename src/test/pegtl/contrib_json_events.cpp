@@ -0,0 +1,121 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <string>
+
+#include "test.hpp"
+
+#include <tao/pegtl/contrib/json_events.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   struct recorder
+   {
+      std::string events;
+      std::string buffer;
+      const char* first_string = nullptr;
+
+      void null()
+      {
+         events += "null ";
+      }
+
+      void boolean( const bool b )
+      {
+         events += b ? "true " : "false ";
+      }
+
+      void number( const json::number_view& n )
+      {
+         events += "number(" + std::string( n.raw() ) + ") ";
+      }
+
+      void string( const json_events::string_ref& s )
+      {
+         if( first_string == nullptr ) {
+            first_string = s.raw().data();
+         }
+         events += "string(" + std::string( s.view( buffer ) ) + ( s.has_escapes() ? ")* " : ") " );
+      }
+
+      void begin_array()
+      {
+         events += "[ ";
+      }
+
+      void end_array()
+      {
+         events += "] ";
+      }
+
+      void begin_object()
+      {
+         events += "{ ";
+      }
+
+      void key( const json_events::string_ref& s )
+      {
+         events += "key(" + s.unescape() + ") ";
+      }
+
+      void end_object()
+      {
+         events += "} ";
+      }
+   };
+
+   struct counter
+      : json_events::consumer_base
+   {
+      unsigned numbers = 0;
+      double sum = 0.0;
+
+      void number( const json::number_view& n )
+      {
+         ++numbers;
+         sum += n.to_double();
+      }
+   };
+
+   std::string record( const std::string& s )
+   {
+      recorder r;
+      memory_input in( s, __FUNCTION__ );
+      TAO_PEGTL_TEST_ASSERT( json_events::parse( in, r ) );
+      return r.events;
+   }
+
+   void unit_test()
+   {
+      TAO_PEGTL_TEST_ASSERT( record( "null" ) == "null " );
+      TAO_PEGTL_TEST_ASSERT( record( " [ true , false ] " ) == "[ true false ] " );
+      TAO_PEGTL_TEST_ASSERT( record( "{ \"a\" : -1.5e3, \"b\\u0063\" : [ ] }" ) == "{ key(a) number(-1.5e3) key(bc) [ ] } " );
+      TAO_PEGTL_TEST_ASSERT( record( "[\"abc\",\"a\\tb\"]" ) == "[ string(abc) string(a\tb)* ] " );
+
+      {
+         const std::string s = "[ \"zero-copy\" ]";
+         recorder r;
+         memory_input in( s, __FUNCTION__ );
+         TAO_PEGTL_TEST_ASSERT( json_events::parse( in, r ) );
+         TAO_PEGTL_TEST_ASSERT( r.first_string == s.data() + 3 );
+      }
+      {
+         counter c;
+         memory_input in( "[ 1, [ 2, { \"x\" : 3.5 } ], \"4\" ]", __FUNCTION__ );
+         TAO_PEGTL_TEST_ASSERT( json_events::parse( in, c ) );
+         TAO_PEGTL_TEST_ASSERT( c.numbers == 3 );
+         TAO_PEGTL_TEST_ASSERT( c.sum == 6.5 );
+      }
+      {
+         const json_events::string_ref lone( "\\uD834", true );
+         std::string buffer;
+         TAO_PEGTL_TEST_THROWS( (void)lone.view( buffer ) );
+      }
+      counter c;
+      TAO_PEGTL_TEST_THROWS( json_events::parse( memory_input( "[ 1, ]", __FUNCTION__ ), c ) );
+      TAO_PEGTL_TEST_ASSERT( json_events::parse( file_input( "src/test/pegtl/data/pass1.json" ), c ) );
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
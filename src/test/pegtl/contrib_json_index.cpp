@@ -0,0 +1,124 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <cstdint>
+#include <string>
+
+#include "test.hpp"
+
+#include <tao/pegtl/contrib/json_index.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   using GRAMMAR = must< json::text, eof >;
+
+   template< typename Rule >
+   struct counter
+      : nothing< Rule >
+   {
+   };
+
+   template<>
+   struct counter< json::unescaped >
+   {
+      static void apply0( std::size_t& count )
+      {
+         ++count;
+      }
+   };
+
+   void verify_index( const std::string& s )
+   {
+      // Straightforward scalar reference implementation.
+      const json::structural_index index( s.data(), s.data() + s.size() );
+      TAO_PEGTL_TEST_ASSERT( index.blocks() == ( s.size() + 63 ) / 64 );
+      for( std::size_t i = 0; i < s.size(); ++i ) {
+         const char c = s[ i ];
+         const bool quote = ( c == '"' );
+         const bool special = ( c == '\\' ) || ( static_cast< unsigned char >( c ) < 0x20 ) || ( static_cast< unsigned char >( c ) >= 0x80 );
+         const bool ws = ( c == ' ' ) || ( c == '\t' ) || ( c == '\n' ) || ( c == '\r' );
+         const std::uint64_t bit = std::uint64_t( 1 ) << ( i % 64 );
+         TAO_PEGTL_TEST_ASSERT( bool( index.string_stops( i / 64 ) & bit ) == ( quote || special ) );
+         TAO_PEGTL_TEST_ASSERT( bool( index.whitespace( i / 64 ) & bit ) == ws );
+      }
+   }
+
+   std::string parse_result( const std::string& s, const bool indexed )
+   {
+      try {
+         if( indexed ) {
+            json::indexed_input<> in( s, __FUNCTION__ );
+            return parse< GRAMMAR >( in ) ? "success" : "failure";
+         }
+         memory_input<> in( s, __FUNCTION__ );
+         return parse< GRAMMAR >( in ) ? "success" : "failure";
+      }
+      catch( const parse_error& e ) {
+         return e.what();
+      }
+   }
+
+   void verify_same( const std::string& s )
+   {
+      TAO_PEGTL_TEST_ASSERT( parse_result( s, true ) == parse_result( s, false ) );
+   }
+
+   void verify_file( const std::string& name )
+   {
+      file_input<> in( name );
+      verify_same( std::string( in.begin(), in.end() ) );
+   }
+
+   void unit_test()
+   {
+      verify_index( "" );
+      verify_index( "[ \"a\\\"b\", { \"c\" : 1 }, \"\\\\\", \"\\\\\\\"\" ]" );
+
+      // Pseudo-random inputs with runs of backslashes and quotes across block boundaries.
+      const char alphabet[] = "\"\\\\\\\\[]{},: a\n\x01\xc3";
+      std::uint32_t seed = 42;
+      for( std::size_t n = 0; n < 300; ++n ) {
+         std::string s;
+         for( std::size_t i = 0; i < n * 3; ++i ) {
+            seed = seed * 1103515245 + 12345;
+            s += alphabet[ ( seed >> 16 ) % ( sizeof( alphabet ) - 1 ) ];
+         }
+         verify_index( s );
+      }
+      {
+         const std::string s = std::string( 63, ' ' ) + "\"" + std::string( 100, 'x' ) + "\"  ,";
+         const json::structural_index index( s.data(), s.data() + s.size() );
+         TAO_PEGTL_TEST_ASSERT( index.next_non_whitespace( s.data() ) == s.data() + 63 );
+         TAO_PEGTL_TEST_ASSERT( index.next_string_stop( s.data() + 64 ) == s.data() + 164 );
+         TAO_PEGTL_TEST_ASSERT( index.next_string_stop( s.data() + 165 ) == s.data() + s.size() );
+         TAO_PEGTL_TEST_ASSERT( index.next_non_whitespace( s.data() + 165 ) == s.data() + 167 );
+      }
+      verify_same( "[]" );
+      verify_same( "  {  \"a\" : [ 1, 2, \"x\\ty\" ], \"b\" : null }  " );
+      verify_same( "[ \"" + std::string( 200, 'a' ) + "\\\"" + std::string( 200, 'b' ) + "\" ]" );
+      verify_same( "[ \"" + std::string( 200, 'a' ) + "\xC3\x84" + std::string( 200, 'b' ) + "\" ]" );
+      verify_same( "[ \"" + std::string( 200, 'a' ) + "\x01\" ]" );
+      verify_same( "[ \"" + std::string( 200, 'a' ) + "\\x\" ]" );
+      verify_same( "[ \"" + std::string( 200, 'a' ) );
+      verify_same( "[\n  \"abc\",\n  \"def\n\"\n]" );
+      {
+         const std::string s = "[ \"a\\u0062c\", \"" + std::string( 100, 'd' ) + "\" ]";
+         std::size_t plain = 0;
+         std::size_t indexed = 0;
+         TAO_PEGTL_TEST_ASSERT( parse< GRAMMAR, counter >( memory_input( s, __FUNCTION__ ), plain ) );
+         TAO_PEGTL_TEST_ASSERT( parse< GRAMMAR, counter >( json::indexed_input( s, __FUNCTION__ ), indexed ) );
+         TAO_PEGTL_TEST_ASSERT( plain == 102 );
+         TAO_PEGTL_TEST_ASSERT( indexed == 102 );
+      }
+      for( unsigned i = 1; i <= 3; ++i ) {
+         verify_file( "src/test/pegtl/data/pass" + std::to_string( i ) + ".json" );
+      }
+      for( unsigned i = 1; i <= 39; ++i ) {
+         verify_file( "src/test/pegtl/data/fail" + std::to_string( i ) + ".json" );
+      }
+      verify_file( "src/test/pegtl/data/blns.json" );
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
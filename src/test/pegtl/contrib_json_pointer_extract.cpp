@@ -0,0 +1,70 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "test.hpp"
+
+#include <tao/pegtl/contrib/json_index.hpp>
+#include <tao/pegtl/contrib/json_pointer_extract.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   std::string extract( const json_pointer::extractor& x, const std::string& data )
+   {
+      std::string result;
+      const auto f = [ & ]( const std::size_t id, const std::string_view value ) {
+         TAO_PEGTL_TEST_ASSERT( value.data() >= data.data() );
+         TAO_PEGTL_TEST_ASSERT( value.data() + value.size() <= data.data() + data.size() );
+         result += std::to_string( id ) + '=' + std::string( value ) + ' ';
+      };
+      TAO_PEGTL_TEST_ASSERT( x.extract( memory_input( data, __FUNCTION__ ), f ) );
+      std::string indexed;
+      TAO_PEGTL_TEST_ASSERT( x.extract( json::indexed_input( data, __FUNCTION__ ), [ & ]( const std::size_t id, const std::string_view value ) {
+         indexed += std::to_string( id ) + '=' + std::string( value ) + ' ';
+      } ) );
+      TAO_PEGTL_TEST_ASSERT( indexed == result );
+      return result;
+   }
+
+   void unit_test()
+   {
+      TAO_PEGTL_TEST_ASSERT( json_pointer::tokens( "" ).empty() );
+      TAO_PEGTL_TEST_ASSERT( json_pointer::tokens( "/" ) == std::vector< std::string >{ "" } );
+      TAO_PEGTL_TEST_ASSERT( json_pointer::tokens( "/a~1b/m~0n/~01" ) == ( std::vector< std::string >{ "a/b", "m~n", "~1" } ) );
+      TAO_PEGTL_TEST_THROWS( (void)json_pointer::tokens( "a" ) );
+      TAO_PEGTL_TEST_THROWS( (void)json_pointer::tokens( "/~2" ) );
+
+      const std::string event = R"({
+         "user" : { "name" : "x", "id" : 42, "tags" : [ "a", "b" ] },
+         "payload" : { "deep" : [ [ { "id" : 1 } ], "]" ], "id" : 2 },
+         "event" : { "ts" : "2020-01-01T00:00:00Z" },
+         "a/b" : true, "m~n" : null, "esc" : -1.5,
+         "arr" : [ 0, { "x" : [ 1 ] }, 2 ]
+      })";
+
+      TAO_PEGTL_TEST_ASSERT( extract( json_pointer::extractor(), event ).empty() );
+      TAO_PEGTL_TEST_ASSERT( extract( { "/user/id", "/event/ts" }, event ) == "0=42 1=\"2020-01-01T00:00:00Z\" " );
+      TAO_PEGTL_TEST_ASSERT( extract( { "/event/ts", "/user/id" }, event ) == "1=42 0=\"2020-01-01T00:00:00Z\" " );
+      TAO_PEGTL_TEST_ASSERT( extract( { "/a~1b", "/m~0n", "/esc", "/missing", "/user/id/x" }, event ) == "0=true 1=null 2=-1.5 " );
+      TAO_PEGTL_TEST_ASSERT( extract( { "/arr/1/x", "/arr/1", "/arr/-", "/arr/01", "/user/tags/1" }, event ) == "4=\"b\" 0=[ 1 ] 1={ \"x\" : [ 1 ] } " );
+      TAO_PEGTL_TEST_ASSERT( extract( { "/user/id", "/user/id" }, event ) == "0=42 1=42 " );
+      TAO_PEGTL_TEST_ASSERT( extract( { "" }, " [ 1 ] " ) == "0=[ 1 ] " );
+      TAO_PEGTL_TEST_ASSERT( extract( { "/0/a" }, "[ { \"a\" : 1 }, { \"a\" : 2 } ]" ) == "0=1 " );
+      TAO_PEGTL_TEST_ASSERT( extract( { "/a" }, "{ \"a\" : 1, \"a\" : 2 }" ) == "0=1 0=2 " );
+
+      // Only values on a path to a pointer are validated.
+      TAO_PEGTL_TEST_ASSERT( extract( { "/a" }, "{ \"b\" : [ 1 2 ], \"a\" : 1 }" ) == "0=1 " );
+      const json_pointer::extractor x{ "/a/b" };
+      const auto ignore = []( const std::size_t /*unused*/, const std::string_view /*unused*/ ) {};
+      TAO_PEGTL_TEST_THROWS( x.extract( memory_input( "{ \"a\" : { \"b\" : [ 1 2 ] } }", __FUNCTION__ ), ignore ) );
+      TAO_PEGTL_TEST_THROWS( x.extract( memory_input( "{ \"a\" : { \"c\" : [ 1 ] }", __FUNCTION__ ), ignore ) );
+      TAO_PEGTL_TEST_THROWS( x.extract( memory_input( "{ \"a\" : [ 1 }", __FUNCTION__ ), ignore ) );
+      TAO_PEGTL_TEST_THROWS( x.extract( memory_input( "{ \"a\" : 1 } x", __FUNCTION__ ), ignore ) );
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
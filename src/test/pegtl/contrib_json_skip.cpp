@@ -0,0 +1,115 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <string>
+#include <string_view>
+
+#include "test.hpp"
+#include "verify_analyze.hpp"
+#include "verify_rule.hpp"
+
+#include <tao/pegtl/contrib/json_index.hpp>
+#include <tao/pegtl/contrib/json_skip.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   struct selection
+   {
+      json::key_set keys;
+      std::string numbers;
+   };
+
+   struct select_from_state
+   {
+      static bool select( const std::string_view raw, const selection& s )
+      {
+         return s.keys.contains_raw( raw );
+      }
+   };
+
+   template< typename Rule >
+   struct select_action
+      : nothing< Rule >
+   {
+   };
+
+   template<>
+   struct select_action< json::number >
+   {
+      template< typename Input >
+      static void apply( const Input& in, selection& s )
+      {
+         s.numbers += in.string() + ' ';
+      }
+   };
+
+   using GRAMMAR = must< json::selective_text< select_from_state >, eof >;
+
+   template< typename Input >
+   std::string select_in( Input&& in, json::key_set keys )
+   {
+      selection s{ std::move( keys ), "" };
+      TAO_PEGTL_TEST_ASSERT( parse< GRAMMAR, select_action >( in, s ) );
+      return s.numbers;
+   }
+
+   std::string select( const std::string& data, json::key_set keys )
+   {
+      const std::string r = select_in( memory_input( data, __FUNCTION__ ), keys );
+      TAO_PEGTL_TEST_ASSERT( select_in( json::indexed_input( data, __FUNCTION__ ), std::move( keys ) ) == r );
+      return r;
+   }
+
+   template< typename Input >
+   bool skips( Input&& in )
+   {
+      return parse< seq< json::skip_value, eof > >( in );
+   }
+
+   void verify_skip( const std::size_t line, const char* file, const std::string& data, const result_type expected, const int remain )
+   {
+      verify_rule< json::skip_value >( line, file, data, expected, remain );
+      if( remain == 0 ) {
+         TAO_PEGTL_TEST_ASSERT( skips( json::indexed_input( data, __FUNCTION__ ) ) == ( expected == result_type::success ) );
+      }
+   }
+
+   void unit_test()
+   {
+      verify_analyze< json::skip_value >( __LINE__, __FILE__, true, false );
+      verify_analyze< GRAMMAR >( __LINE__, __FILE__, true, false );
+
+      verify_skip( __LINE__, __FILE__, "", result_type::local_failure, 0 );
+      verify_skip( __LINE__, __FILE__, "1", result_type::success, 0 );
+      verify_skip( __LINE__, __FILE__, "-1.5e3 ", result_type::success, 0 );
+      verify_skip( __LINE__, __FILE__, "true,", result_type::success, 1 );
+      verify_skip( __LINE__, __FILE__, "\"a\\\"b\" ", result_type::success, 0 );
+      verify_skip( __LINE__, __FILE__, "\"a\\\\\"b", result_type::success, 1 );
+      verify_skip( __LINE__, __FILE__, "\"abc", result_type::local_failure, 4 );
+      verify_skip( __LINE__, __FILE__, "[]", result_type::success, 0 );
+      verify_skip( __LINE__, __FILE__, "[1,[2,{\"a\":\"]}\\\"\"}],3]  ", result_type::success, 0 );
+      verify_skip( __LINE__, __FILE__, "{\"a\":[{\"b\":{}}]}]", result_type::success, 1 );
+      verify_skip( __LINE__, __FILE__, "[1,2", result_type::local_failure, 4 );
+      verify_skip( __LINE__, __FILE__, "[1,2}", result_type::local_failure, 5 );
+      verify_skip( __LINE__, __FILE__, "]", result_type::local_failure, 1 );
+      verify_skip( __LINE__, __FILE__, ",", result_type::local_failure, 1 );
+      verify_skip( __LINE__, __FILE__, "[\"" + std::string( 100, 'x' ) + "\\\"]\"," + std::string( 100, ' ' ) + "{}]", result_type::success, 0 );
+
+      TAO_PEGTL_TEST_ASSERT( skips( file_input( "src/test/pegtl/data/pass1.json" ) ) );
+
+      const std::string record = "{ \"a\" : 1, \"b\" : { \"a\" : 2, \"c\" : [ 3, \"}\" ] }, \"d\" : [ 4, [ 5 ] ], \"e\" : 6 }";
+      TAO_PEGTL_TEST_ASSERT( select( record, {} ).empty() );
+      TAO_PEGTL_TEST_ASSERT( select( record, { "a", "e" } ) == "1 6 " );
+      TAO_PEGTL_TEST_ASSERT( select( record, { "b" } ) == "2 3 " );
+      TAO_PEGTL_TEST_ASSERT( select( record, { "d", "x" } ) == "4 5 " );
+      TAO_PEGTL_TEST_ASSERT( select( "{ \"\\u0065\" : 7, \"f\" : 8 }", { "e" } ) == "7 " );
+      TAO_PEGTL_TEST_ASSERT( select( " [ 1, 2 ] ", { "a" } ) == "1 2 " );
+
+      TAO_PEGTL_TEST_THROWS( select( "{ \"a\" : 1, \"b\" : [ 2 }", { "a" } ) );
+      TAO_PEGTL_TEST_THROWS( select( "{ \"a\" : 1, \"b\" : [ 2 ] ", { "a" } ) );
+      TAO_PEGTL_TEST_THROWS( select( "{ \"a\" : [ 1, ] }", { "a" } ) );
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
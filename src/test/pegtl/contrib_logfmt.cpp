@@ -0,0 +1,70 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <string>
+#include <vector>
+
+#include "test.hpp"
+#include "verify_rule.hpp"
+
+#include <tao/pegtl/contrib/logfmt.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   void test_rules()
+   {
+      verify_rule< logfmt::pair >( __LINE__, __FILE__, "a=b", result_type::success );
+      verify_rule< logfmt::pair >( __LINE__, __FILE__, "a=", result_type::success );
+      verify_rule< logfmt::pair >( __LINE__, __FILE__, "a", result_type::success );
+      verify_rule< logfmt::pair >( __LINE__, __FILE__, "a=\"b c\" d", result_type::success, 2 );
+      verify_rule< logfmt::pair >( __LINE__, __FILE__, "a=\"b", result_type::success, 2 );
+      verify_rule< logfmt::pair >( __LINE__, __FILE__, "=b", result_type::local_failure );
+      verify_rule< logfmt::pair >( __LINE__, __FILE__, "\"a\"=b", result_type::local_failure );
+   }
+
+   void test_parse()
+   {
+      std::vector< logfmt::field > f;
+      TAO_PEGTL_TEST_ASSERT( logfmt::parse( "level=info msg=\"request done\" path=/api?a=b took=12ms cached", f ) );
+      TAO_PEGTL_TEST_ASSERT( f.size() == 5 );
+      TAO_PEGTL_TEST_ASSERT( f[ 0 ].key == "level" );
+      TAO_PEGTL_TEST_ASSERT( f[ 0 ].value == "info" );
+      TAO_PEGTL_TEST_ASSERT( !f[ 0 ].quoted );
+      TAO_PEGTL_TEST_ASSERT( f[ 1 ].key == "msg" );
+      TAO_PEGTL_TEST_ASSERT( f[ 1 ].value == "request done" );
+      TAO_PEGTL_TEST_ASSERT( f[ 1 ].quoted );
+      TAO_PEGTL_TEST_ASSERT( f[ 2 ].value == "/api?a=b" );
+      TAO_PEGTL_TEST_ASSERT( f[ 4 ].key == "cached" );
+      TAO_PEGTL_TEST_ASSERT( f[ 4 ].value.empty() );
+      TAO_PEGTL_TEST_ASSERT( !f[ 4 ].quoted );
+
+      TAO_PEGTL_TEST_ASSERT( logfmt::parse( " \ta=\"\" b= c=\"x\\\"y\\\\z\\n\"\t\r", f ) );
+      TAO_PEGTL_TEST_ASSERT( f.size() == 3 );
+      TAO_PEGTL_TEST_ASSERT( f[ 0 ].value.empty() );
+      TAO_PEGTL_TEST_ASSERT( f[ 0 ].quoted );
+      TAO_PEGTL_TEST_ASSERT( f[ 1 ].value.empty() );
+      TAO_PEGTL_TEST_ASSERT( !f[ 1 ].quoted );
+      std::string s;
+      logfmt::unescape( f[ 2 ].value, s );
+      TAO_PEGTL_TEST_ASSERT( s == "x\"y\\z\n" );
+
+      TAO_PEGTL_TEST_ASSERT( logfmt::parse( "", f ) );
+      TAO_PEGTL_TEST_ASSERT( f.empty() );
+      TAO_PEGTL_TEST_ASSERT( logfmt::parse( "  ", f ) );
+
+      TAO_PEGTL_TEST_ASSERT( !logfmt::parse( "a=\"b", f ) );
+      TAO_PEGTL_TEST_ASSERT( !logfmt::parse( "a=b\"c\"", f ) );
+      TAO_PEGTL_TEST_ASSERT( !logfmt::parse( "a=\"b\"c", f ) );
+      TAO_PEGTL_TEST_ASSERT( !logfmt::parse( "a =b", f ) );
+      TAO_PEGTL_TEST_ASSERT( !logfmt::parse( "a=b\nc=d", f ) );
+   }
+
+   void unit_test()
+   {
+      test_rules();
+      test_parse();
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
@@ -0,0 +1,114 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <string>
+#include <vector>
+
+#include "test.hpp"
+#include "verify_rule.hpp"
+
+#include <tao/pegtl/analyze.hpp>
+#include <tao/pegtl/contrib/lua53.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   template< typename Rule >
+   struct name_action
+      : nothing< Rule >
+   {
+   };
+
+   template<>
+   struct name_action< lua53::name >
+   {
+      template< typename Input >
+      static void apply( const Input& in, std::vector< std::string >& names )
+      {
+         names.emplace_back( in.string() );
+      }
+   };
+
+   void test_lexical()
+   {
+      verify_rule< lua53::name >( __LINE__, __FILE__, "x", result_type::success );
+      verify_rule< lua53::name >( __LINE__, __FILE__, "_a1 ", result_type::success, 1 );
+      verify_rule< lua53::name >( __LINE__, __FILE__, "orange", result_type::success );
+      verify_rule< lua53::name >( __LINE__, __FILE__, "end_", result_type::success );
+      verify_rule< lua53::name >( __LINE__, __FILE__, "1a", result_type::local_failure );
+      verify_rule< lua53::name >( __LINE__, __FILE__, "", result_type::local_failure );
+
+      for( const char* w : { "and", "break", "do", "else", "elseif", "end", "false", "for", "function", "goto", "if", "in", "local", "nil", "not", "or", "repeat", "return", "then", "true", "until", "while" } ) {
+         verify_rule< lua53::keyword >( __LINE__, __FILE__, w, result_type::success );
+         verify_rule< lua53::name >( __LINE__, __FILE__, w, result_type::local_failure );
+      }
+      verify_rule< lua53::keyword >( __LINE__, __FILE__, "endless", result_type::local_failure );
+      verify_rule< lua53::keyword >( __LINE__, __FILE__, "self", result_type::local_failure );
+
+      verify_rule< lua53::key_end >( __LINE__, __FILE__, "end", result_type::success );
+      verify_rule< lua53::key_end >( __LINE__, __FILE__, "end(", result_type::success, 1 );
+      verify_rule< lua53::key_end >( __LINE__, __FILE__, "ending", result_type::local_failure );
+      verify_rule< lua53::key_end >( __LINE__, __FILE__, "en", result_type::local_failure );
+
+      verify_rule< lua53::long_string >( __LINE__, __FILE__, "[[]]", result_type::success );
+      verify_rule< lua53::long_string >( __LINE__, __FILE__, "[[a]]]", result_type::success, 1 );
+      verify_rule< lua53::long_string >( __LINE__, __FILE__, "[==[\na]]b]=]]===]]==]", result_type::success );
+      verify_rule< lua53::long_string >( __LINE__, __FILE__, "[=[a]]", result_type::global_failure );
+      verify_rule< lua53::long_string >( __LINE__, __FILE__, "[=a", result_type::local_failure );
+      verify_rule< lua53::long_string >( __LINE__, __FILE__, "a", result_type::local_failure );
+
+      verify_rule< lua53::seps >( __LINE__, __FILE__, "", result_type::success );
+      verify_rule< lua53::seps >( __LINE__, __FILE__, " \t\r\n\v\f-- a\n--[[ b\n]] --[==[ ]] ]==]--\nx", result_type::success, 1 );
+      verify_rule< lua53::seps >( __LINE__, __FILE__, "--[==[ b\n", result_type::global_failure );
+      verify_rule< lua53::seps >( __LINE__, __FILE__, "-x", result_type::success, 2 );
+      verify_rule< lua53::sep >( __LINE__, __FILE__, "--", result_type::success );
+      verify_rule< lua53::sep >( __LINE__, __FILE__, "x", result_type::local_failure );
+
+      verify_rule< lua53::literal_string >( __LINE__, __FILE__, "\"a\\\"b\\x41\\65\\u{20AC}\\z  \\\n'\"", result_type::success );
+      verify_rule< lua53::literal_string >( __LINE__, __FILE__, "'a\"b'", result_type::success );
+      verify_rule< lua53::literal_string >( __LINE__, __FILE__, "\"a\nb\"", result_type::global_failure );
+      verify_rule< lua53::literal_string >( __LINE__, __FILE__, "\"\\q\"", result_type::global_failure );
+   }
+
+   void test_grammar()
+   {
+      TAO_PEGTL_TEST_ASSERT( analyze< lua53::grammar >() == 0 );
+
+      const std::string source = "#!/usr/bin/lua\n"
+                                 "--[[ Long\n comment ]] local t = { 1, 2.5e3, 0x1p4, [ 'k' ] = \"v\", f = function( ... ) return ... end; }\n"
+                                 "for i, v in ipairs( t ) do if v ~= nil and #t > i // 2 then print( v ) elseif not v then goto done else break end end\n"
+                                 "::done:: a.b[ 1 ]:c{ x = [==[]]]==] }\n"
+                                 "repeat local x <const> = 1 until true\n";
+      std::vector< std::string > names;
+      memory_input in( source, __FUNCTION__ );
+      TAO_PEGTL_TEST_THROWS( parse< lua53::grammar, name_action >( in, names ) );
+
+      const std::string valid = source.substr( 0, source.rfind( "repeat" ) ) + "repeat local x = 1 until x or y\n";
+      memory_input in2( valid, __FUNCTION__ );
+      TAO_PEGTL_TEST_ASSERT( parse< lua53::grammar >( in2 ) );
+
+      names.clear();
+      memory_input in3( "local a, b = c, d.e -- f\n", __FUNCTION__ );
+      TAO_PEGTL_TEST_ASSERT( parse< lua53::grammar, name_action >( in3, names ) );
+      TAO_PEGTL_TEST_ASSERT( ( names == std::vector< std::string >{ "a", "b", "c", "d", "e" } ) );
+
+      bool thrown = false;
+      memory_input in4( "--[[\n\n]] x = 1\n--\n\nx = = 2\n", __FUNCTION__ );
+      try {
+         (void)parse< lua53::grammar >( in4 );
+      }
+      catch( const parse_error& e ) {
+         TAO_PEGTL_TEST_ASSERT( e.positions.at( 0 ).line == 6 );
+         thrown = true;
+      }
+      TAO_PEGTL_TEST_ASSERT( thrown );
+   }
+
+   void unit_test()
+   {
+      test_lexical();
+      test_grammar();
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
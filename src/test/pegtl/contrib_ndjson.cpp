@@ -0,0 +1,79 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <string>
+#include <vector>
+
+#include "sum_action.hpp"
+#include "test.hpp"
+
+#include <tao/pegtl/contrib/ndjson.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   void unit_test()
+   {
+      std::string data;
+      std::vector< std::size_t > error_lines;
+      std::vector< std::size_t > error_bytes;
+      std::size_t records = 0;
+      long long sum = 0;
+      for( std::size_t line = 1; line <= 1000; ++line ) {
+         if( line % 97 == 0 ) {
+            error_lines.push_back( line );
+            error_bytes.push_back( data.size() + 8 );
+            data += "{ \"a\" : }\n";
+            ++records;
+         }
+         else if( line % 13 == 0 ) {
+            data += ( line % 2 ) ? "\n" : "  \r\n";
+         }
+         else {
+            data += "{ \"id\" : " + std::to_string( line ) + ", \"v\" : [ 1, 2 ] }" + ( ( line % 3 ) ? "\n" : "\r\n" );
+            sum += line + 3;
+            ++records;
+         }
+      }
+      data += "[ 0 ]";  // Last line without line end.
+      ++records;
+
+      for( const std::size_t threads : { 1, 2, 4 } ) {
+         for( const std::size_t chunk_size : { 1, 100, 1000, 1 << 20 } ) {
+            ndjson::options op;
+            op.threads = threads;
+            op.chunk_size = chunk_size;
+            const auto r = ndjson::parse< json::text, sum_action >( data.data(), data.data() + data.size(), "data", [](){ return sum_state(); }, op );
+            TAO_PEGTL_TEST_ASSERT( r.records == records );
+            long long total = 0;
+            for( const auto& s : r.states ) {
+               total += s.sum;
+            }
+            TAO_PEGTL_TEST_ASSERT( total == sum );
+            TAO_PEGTL_TEST_ASSERT( r.errors.size() == error_lines.size() );
+            for( std::size_t i = 0; i < r.errors.size(); ++i ) {
+               const auto& p = r.errors[ i ].positions.at( 0 );
+               TAO_PEGTL_TEST_ASSERT( p.line == error_lines[ i ] );
+               TAO_PEGTL_TEST_ASSERT( p.byte == error_bytes[ i ] );
+               TAO_PEGTL_TEST_ASSERT( p.byte_in_line == 8 );
+               TAO_PEGTL_TEST_ASSERT( p.source == "data" );
+            }
+         }
+      }
+      {
+         const std::string evil = "[ 1 ]\n[ -666 ]\n[ 2 ]\n";
+         ndjson::options op;
+         op.threads = 2;
+         op.chunk_size = 1;
+         TAO_PEGTL_TEST_THROWS( (void)ndjson::parse< json::text, sum_action >( evil.data(), evil.data() + evil.size(), "evil", [](){ return sum_state(); }, op ) );
+      }
+      {
+         const memory_input in( "\n\n", "empty" );
+         const auto r = ndjson::parse( in, [](){ return 0; } );
+         TAO_PEGTL_TEST_ASSERT( r.records == 0 );
+         TAO_PEGTL_TEST_ASSERT( r.errors.empty() );
+      }
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
@@ -0,0 +1,222 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "sum_action.hpp"
+#include "test.hpp"
+
+#include <tao/pegtl/contrib/json.hpp>
+#include <tao/pegtl/contrib/parallel.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   // clang-format off
+   struct name : identifier {};
+   struct value : seq< opt< one< '-' > >, plus< digit > > {};
+   struct record : seq< name, pad< one< '=' >, blank >, value, one< ';' >, eolf > {};
+   struct word : seq< plus< alpha >, string< ';', ';' > > {};
+   // clang-format on
+
+   // The numbers and words of the records are added up and counted as
+   // the numbers and strings of the shared JSON fixture.
+
+   template<>
+   struct sum_action< value >
+      : sum_action< json::number >
+   {
+   };
+
+   template<>
+   struct sum_action< word >
+      : sum_action< json::string_content >
+   {
+   };
+
+   void test_for_each()
+   {
+      for( const std::size_t n : { 0, 1, 7, 100, 1000 } ) {
+         for( const std::size_t threads : { 1, 2, 3, 8 } ) {
+            std::unique_ptr< std::atomic< int >[] > seen( new std::atomic< int >[ n + 1 ] );
+            for( std::size_t i = 0; i < n; ++i ) {
+               seen[ i ] = 0;
+            }
+            parallel::internal::for_each( n, threads, [ & ]( const std::size_t i ) {
+               // Uneven work to make stealing likely.
+               volatile std::size_t x = 0;
+               for( std::size_t j = 0; j < ( ( i < n / 4 ) ? 20000 : 10 ); ++j ) {
+                  x = x + j;
+               }
+               ++seen[ i ];
+            } );
+            for( std::size_t i = 0; i < n; ++i ) {
+               TAO_PEGTL_TEST_ASSERT( seen[ i ] == 1 );
+            }
+         }
+      }
+   }
+
+   template< typename Rule >
+   struct count_action
+      : nothing< Rule >
+   {
+   };
+
+   template<>
+   struct count_action< json::value >
+   {
+      template< typename Input >
+      static void apply( const Input& /*unused*/, std::size_t& values )
+      {
+         ++values;
+      }
+   };
+
+   void test_files()
+   {
+      std::vector< std::string > paths;
+      std::vector< std::size_t > failures;
+      for( int i = 1; i <= 39; ++i ) {
+         if( ( i != 1 ) && ( i != 18 ) ) {
+            failures.push_back( paths.size() );
+         }
+         paths.push_back( "src/test/pegtl/data/fail" + std::to_string( i ) + ".json" );
+      }
+      for( int i = 1; i <= 3; ++i ) {
+         paths.push_back( "src/test/pegtl/data/pass" + std::to_string( i ) + ".json" );
+      }
+      failures.push_back( paths.size() );
+      paths.emplace_back( "src/test/pegtl/data/no_such_file.json" );
+      paths.emplace_back( "src/test/pegtl/data/blns.json" );
+
+      std::size_t expected = 0;
+      for( const auto& path : paths ) {
+         try {
+            file_input in( path );
+            (void)parse< must< json::text, eof >, count_action >( in, expected );
+         }
+         catch( ... ) {
+         }
+      }
+      for( const std::size_t threads : { 1, 2, 5 } ) {
+         for( const std::size_t readahead : { 0, 3 } ) {
+            parallel::options op;
+            op.threads = threads;
+            op.readahead = readahead;
+            const auto r = parallel::parse_files< must< json::text, eof >, count_action >( paths, []() { return std::size_t( 0 ); }, op );
+            TAO_PEGTL_TEST_ASSERT( r.states.size() == threads );
+            TAO_PEGTL_TEST_ASSERT( r.files == paths.size() - failures.size() );
+            TAO_PEGTL_TEST_ASSERT( r.errors.size() == failures.size() );
+            for( std::size_t i = 0; i < std::min( r.errors.size(), failures.size() ); ++i ) {
+               TAO_PEGTL_TEST_ASSERT( r.errors[ i ].index == failures[ i ] );
+               TAO_PEGTL_TEST_THROWS( std::rethrow_exception( r.errors[ i ].exception ) );
+            }
+            std::size_t values = 0;
+            for( const auto s : r.states ) {
+               values += s;
+            }
+            // Values of failed files are included, as for the sequential parse.
+            TAO_PEGTL_TEST_ASSERT( values == expected );
+         }
+      }
+      {
+         const auto r = parallel::parse_files< seq< json::text, eof > >( { "src/test/pegtl/data/pass1.json", "src/test/pegtl/data/fail10.json" }, []() { return 0; } );
+         TAO_PEGTL_TEST_ASSERT( r.files == 1 );
+         TAO_PEGTL_TEST_ASSERT( r.errors.size() == 1 );
+         try {
+            std::rethrow_exception( r.errors.at( 0 ).exception );
+         }
+         catch( const parse_error& e ) {
+            TAO_PEGTL_TEST_ASSERT( e.positions.at( 0 ).byte == 0 );
+            TAO_PEGTL_TEST_ASSERT( e.positions.at( 0 ).source == "src/test/pegtl/data/fail10.json" );
+         }
+      }
+      {
+         const auto r = parallel::parse_files< json::text >( {}, []() { return 0; } );
+         TAO_PEGTL_TEST_ASSERT( r.files == 0 );
+         TAO_PEGTL_TEST_ASSERT( r.errors.empty() );
+      }
+   }
+
+   void unit_test()
+   {
+      test_for_each();
+      test_files();
+
+      std::string data;
+      std::vector< std::size_t > error_lines;
+      std::vector< std::size_t > error_bytes;
+      std::size_t records = 0;
+      long long sum = 0;
+      for( std::size_t line = 1; line <= 1000; ++line ) {
+         if( line % 51 == 0 ) {
+            error_lines.push_back( line );
+            error_bytes.push_back( data.size() + 5 );  // Where pad< one< '=' > > fails.
+            data += "abc  x 1;\n";
+         }
+         else {
+            data += "v" + std::to_string( line ) + " = " + std::to_string( line * 3 ) + ";" + ( ( line % 4 ) ? "\n" : "\r\n" );
+            sum += line * 3;
+            ++records;
+         }
+      }
+      data += "last=1;";
+      ++records;
+      ++sum;
+
+      for( const std::size_t threads : { 1, 2, 4 } ) {
+         for( const std::size_t chunk_size : { 1, 100, 1000, 1 << 20 } ) {
+            parallel::options op;
+            op.threads = threads;
+            op.chunk_size = chunk_size;
+            const auto r = parallel::parse< record, one< '\n' >, sum_action >( data.data(), data.data() + data.size(), "data", []() { return sum_state(); }, op );
+            TAO_PEGTL_TEST_ASSERT( r.records == records );
+            long long total = 0;
+            for( const auto& s : r.states ) {
+               total += s.sum;
+            }
+            TAO_PEGTL_TEST_ASSERT( total == sum );
+            TAO_PEGTL_TEST_ASSERT( r.errors.size() == error_lines.size() );
+            for( std::size_t i = 0; i < r.errors.size(); ++i ) {
+               const auto& p = r.errors[ i ].positions.at( 0 );
+               TAO_PEGTL_TEST_ASSERT( p.line == error_lines[ i ] );
+               TAO_PEGTL_TEST_ASSERT( p.byte == error_bytes[ i ] );
+               TAO_PEGTL_TEST_ASSERT( p.byte_in_line == 5 );
+               TAO_PEGTL_TEST_ASSERT( p.source == "data" );
+            }
+         }
+      }
+      {
+         const std::string words = "ab;;cd;;e\nf;;g1;;h;;\ni;;";
+         for( const std::size_t chunk_size : { 1, 5, 100 } ) {
+            parallel::options op;
+            op.threads = 2;
+            op.chunk_size = chunk_size;
+            const auto r = parallel::parse< word, string< ';', ';' >, sum_action >( memory_input( words, "words" ), []() { return sum_state(); }, op );
+            TAO_PEGTL_TEST_ASSERT( r.records == 3 );
+            TAO_PEGTL_TEST_ASSERT( r.errors.size() == 3 );
+            const std::size_t expected[ 3 ][ 3 ] = { { 8, 1, 8 }, { 13, 2, 3 }, { 20, 2, 10 } };
+            for( std::size_t i = 0; i < std::min( r.errors.size(), std::size_t( 3 ) ); ++i ) {
+               const auto& p = r.errors[ i ].positions.at( 0 );
+               TAO_PEGTL_TEST_ASSERT( p.byte == expected[ i ][ 0 ] );
+               TAO_PEGTL_TEST_ASSERT( p.line == expected[ i ][ 1 ] );
+               TAO_PEGTL_TEST_ASSERT( p.byte_in_line == expected[ i ][ 2 ] );
+            }
+         }
+      }
+      {
+         const std::string evil = "a=1;\nb=-666;\nc=2;\n";
+         parallel::options op;
+         op.threads = 2;
+         op.chunk_size = 1;
+         TAO_PEGTL_TEST_THROWS( (void)parallel::parse< record, one< '\n' >, sum_action >( evil.data(), evil.data() + evil.size(), "evil", []() { return sum_state(); }, op ) );
+      }
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
@@ -0,0 +1,200 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <string>
+
+#include "test.hpp"
+#include "verify_rule.hpp"
+
+#include <tao/pegtl/analyze.hpp>
+#include <tao/pegtl/contrib/proto3.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   void test_grammar()
+   {
+      TAO_PEGTL_TEST_ASSERT( analyze< proto3::proto >() == 0 );
+
+      verify_rule< proto3::sps >( __LINE__, __FILE__, " // a\n/* b\n * c */ /**/x", result_type::success, 1 );
+      verify_rule< proto3::sps >( __LINE__, __FILE__, "/* b *", result_type::global_failure );
+      verify_rule< proto3::sps >( __LINE__, __FILE__, "/ x", result_type::success, 3 );
+      verify_rule< proto3::field >( __LINE__, __FILE__, "repeated int32 a = 1;", result_type::success );
+      verify_rule< proto3::field >( __LINE__, __FILE__, "repeatedFoo a = 1;", result_type::success );
+      verify_rule< proto3::field >( __LINE__, __FILE__, "int32 a = 1", result_type::local_failure );
+      verify_rule< proto3::constant >( __LINE__, __FILE__, "-1", result_type::success );
+      verify_rule< proto3::constant >( __LINE__, __FILE__, "+ /* c */ 0x1F", result_type::success );
+      verify_rule< proto3::str_lit >( __LINE__, __FILE__, "'a\\x41\\101\\n'", result_type::success );
+      verify_rule< proto3::rpc >( __LINE__, __FILE__, "rpc A( stream B ) returns ( stream ) {}", result_type::success );
+      verify_rule< proto3::service >( __LINE__, __FILE__, "service S { rpc A( B ) returns ( C ); rpc D( E ) returns ( F ); }", result_type::success );
+      verify_rule< proto3::reserved >( __LINE__, __FILE__, "reserved \"a\", 'b';", result_type::success );
+      verify_rule< proto3::reserved >( __LINE__, __FILE__, "reserved 1, 3 to max, 5 to 6;", result_type::success );
+      verify_rule< proto3::reserved >( __LINE__, __FILE__, "reserved 1 to;", result_type::global_failure );
+   }
+
+   void test_load()
+   {
+      proto3::descriptor_set set( { "src/test/pegtl/data/proto3" } );
+      TAO_PEGTL_TEST_ASSERT( set.load( { "user.proto", "common/types.proto" } ).empty() );
+      TAO_PEGTL_TEST_ASSERT( set.files().size() == 2 );
+      TAO_PEGTL_TEST_ASSERT( set.load( { "user.proto" } ).empty() );
+      TAO_PEGTL_TEST_ASSERT( set.files().size() == 2 );
+
+      const auto* u = set.find_file( "user.proto" );
+      const auto* t = set.find_file( "common/types.proto" );
+      TAO_PEGTL_TEST_ASSERT( u && t );
+      TAO_PEGTL_TEST_ASSERT( u->package == "example.user" );
+      TAO_PEGTL_TEST_ASSERT( u->imports.size() == 2 );
+      TAO_PEGTL_TEST_ASSERT( u->dependencies.size() == 2 );
+      TAO_PEGTL_TEST_ASSERT( u->dependencies[ 0 ] == t );
+      TAO_PEGTL_TEST_ASSERT( t->options.size() == 1 );
+      TAO_PEGTL_TEST_ASSERT( t->options[ 0 ].name == "java_package" );
+      TAO_PEGTL_TEST_ASSERT( t->options[ 0 ].value == "\"com.example.common\"" );
+
+      const auto* s = set.find_enum( "example.common.Status" );
+      TAO_PEGTL_TEST_ASSERT( s && ( s == &t->enums[ 0 ] ) );
+      TAO_PEGTL_TEST_ASSERT( s->options.size() == 1 );
+      TAO_PEGTL_TEST_ASSERT( s->values.size() == 4 );
+      TAO_PEGTL_TEST_ASSERT( s->values[ 2 ].name == "STATUS_SUCCESS" );
+      TAO_PEGTL_TEST_ASSERT( s->values[ 2 ].number == 1 );
+      TAO_PEGTL_TEST_ASSERT( s->values[ 2 ].options.size() == 1 );
+      TAO_PEGTL_TEST_ASSERT( s->values[ 3 ].number == -1 );
+
+      const auto* m = set.find_message( "example.user.User" );
+      TAO_PEGTL_TEST_ASSERT( m && ( m == &u->messages[ 0 ] ) );
+      TAO_PEGTL_TEST_ASSERT( m->name == "User" );
+      TAO_PEGTL_TEST_ASSERT( m->messages.size() == 1 );
+      TAO_PEGTL_TEST_ASSERT( m->enums.size() == 1 );
+      TAO_PEGTL_TEST_ASSERT( m->enums[ 0 ].values[ 1 ].number == 16 );
+      TAO_PEGTL_TEST_ASSERT( m->oneofs.size() == 1 );
+      TAO_PEGTL_TEST_ASSERT( m->oneofs[ 0 ] == "contact" );
+      TAO_PEGTL_TEST_ASSERT( m->fields.size() == 10 );
+
+      const auto* a = set.find_message( "example.user.User.Address" );
+      TAO_PEGTL_TEST_ASSERT( a && ( a == &m->messages[ 0 ] ) );
+      TAO_PEGTL_TEST_ASSERT( a->fields[ 1 ].options.size() == 2 );
+      TAO_PEGTL_TEST_ASSERT( a->fields[ 1 ].options[ 0 ].name == "(validate.rules).string.min_len" );
+
+      const auto& f = m->fields;
+      TAO_PEGTL_TEST_ASSERT( f[ 0 ].name == "id" );
+      TAO_PEGTL_TEST_ASSERT( f[ 0 ].type == proto3::field_type::uint64_type );
+      TAO_PEGTL_TEST_ASSERT( f[ 0 ].type_name.empty() );
+      TAO_PEGTL_TEST_ASSERT( f[ 2 ].label == proto3::field_label::repeated );
+      TAO_PEGTL_TEST_ASSERT( f[ 2 ].message_type == a );
+      TAO_PEGTL_TEST_ASSERT( f[ 3 ].message_type == set.find_message( "example.common.Timestamp" ) );
+      TAO_PEGTL_TEST_ASSERT( f[ 3 ].message_type != nullptr );
+      TAO_PEGTL_TEST_ASSERT( f[ 4 ].enum_type == s );
+      TAO_PEGTL_TEST_ASSERT( f[ 5 ].label == proto3::field_label::map );
+      TAO_PEGTL_TEST_ASSERT( f[ 5 ].key_type == proto3::field_type::string_type );
+      TAO_PEGTL_TEST_ASSERT( f[ 5 ].message_type == a );
+      TAO_PEGTL_TEST_ASSERT( f[ 6 ].enum_type == &m->enums[ 0 ] );
+      TAO_PEGTL_TEST_ASSERT( f[ 6 ].key_type == proto3::field_type::defined_type );
+      TAO_PEGTL_TEST_ASSERT( f[ 7 ].key_type == proto3::field_type::defined_type );
+      TAO_PEGTL_TEST_ASSERT( f[ 6 ].oneof == proto3::field_descriptor::no_oneof );
+      TAO_PEGTL_TEST_ASSERT( f[ 7 ].oneof == 0 );
+      TAO_PEGTL_TEST_ASSERT( f[ 8 ].oneof == 0 );
+      TAO_PEGTL_TEST_ASSERT( f[ 9 ].number == 16 );
+      TAO_PEGTL_TEST_ASSERT( f[ 9 ].message_type == nullptr );
+      TAO_PEGTL_TEST_ASSERT( f[ 9 ].enum_type == nullptr );
+
+      // Interned names are shared between files.
+      TAO_PEGTL_TEST_ASSERT( a->fields[ 0 ].type_name.empty() );
+      TAO_PEGTL_TEST_ASSERT( f[ 1 ].name.data() == set.names().intern( "name" ).data() );
+
+      const auto* v = set.find_service( "example.user.UserService" );
+      TAO_PEGTL_TEST_ASSERT( v && ( v->methods.size() == 2 ) );
+      TAO_PEGTL_TEST_ASSERT( v->options.size() == 1 );
+      TAO_PEGTL_TEST_ASSERT( !v->methods[ 0 ].client_streaming );
+      TAO_PEGTL_TEST_ASSERT( v->methods[ 0 ].input == m );
+      TAO_PEGTL_TEST_ASSERT( v->methods[ 1 ].client_streaming );
+      TAO_PEGTL_TEST_ASSERT( v->methods[ 1 ].server_streaming );
+      TAO_PEGTL_TEST_ASSERT( v->methods[ 1 ].output == f[ 3 ].message_type );
+      TAO_PEGTL_TEST_ASSERT( v->methods[ 1 ].options.size() == 1 );
+      TAO_PEGTL_TEST_ASSERT( v->methods[ 1 ].options[ 0 ].value == "NO_SIDE_EFFECTS" );
+   }
+
+   void test_keywords()
+   {
+      // Options in messages are not fields of a type named option.
+      proto3::descriptor_set set( { "src/test/pegtl/data/proto3" } );
+      TAO_PEGTL_TEST_ASSERT( set.load( { "options.proto" } ).empty() );
+      const auto* m = set.find_message( "M" );
+      TAO_PEGTL_TEST_ASSERT( m != nullptr );
+      TAO_PEGTL_TEST_ASSERT( m->options.size() == 1 );
+      TAO_PEGTL_TEST_ASSERT( m->options[ 0 ].name == "foo" );
+      TAO_PEGTL_TEST_ASSERT( m->fields.size() == 2 );
+      TAO_PEGTL_TEST_ASSERT( m->fields[ 0 ].name == "a" );
+      TAO_PEGTL_TEST_ASSERT( m->fields[ 1 ].type_name == "optional_type" );
+   }
+
+   void test_package()
+   {
+      // The package can follow definitions.
+      proto3::descriptor_set set( { "src/test/pegtl/data/proto3" } );
+      TAO_PEGTL_TEST_ASSERT( set.load( { "late_package.proto" } ).empty() );
+      const auto* f = set.find_file( "late_package.proto" );
+      TAO_PEGTL_TEST_ASSERT( f && ( f->package == "example.late" ) );
+      const auto* e = set.find_message( "example.late.Early" );
+      TAO_PEGTL_TEST_ASSERT( e && ( e == &f->messages[ 0 ] ) );
+      TAO_PEGTL_TEST_ASSERT( set.find_message( "Early" ) == nullptr );
+      const auto* i = set.find_message( "example.late.Early.Inner" );
+      TAO_PEGTL_TEST_ASSERT( i && ( i == &e->messages[ 0 ] ) );
+      TAO_PEGTL_TEST_ASSERT( e->fields[ 0 ].message_type == i );
+      TAO_PEGTL_TEST_ASSERT( set.find_enum( "example.late.Early.E" ) == &e->enums[ 0 ] );
+      const auto* v = set.find_service( "example.late.S" );
+      TAO_PEGTL_TEST_ASSERT( v && ( v->methods[ 0 ].input == e ) && ( v->methods[ 0 ].output == i ) );
+      TAO_PEGTL_TEST_ASSERT( set.load( { "two_packages.proto" } ).size() == 1 );
+   }
+
+   void test_scoping()
+   {
+      proto3::descriptor_set set( { "src/test/pegtl/data/proto3" } );
+      TAO_PEGTL_TEST_ASSERT( set.load( { "scoping.proto" } ).empty() );
+      const auto* bar = set.find_message( "example.scoping.Bar" );
+      const auto* baz = set.find_message( "example.scoping.Bar.Baz" );
+      const auto* qux = set.find_message( "example.scoping.Qux" );
+      const auto* other = set.find_message( "example.scoping.Other" );
+      TAO_PEGTL_TEST_ASSERT( bar && baz && qux && other );
+
+      // The first component Bar is found in Qux, which has no Baz.
+      TAO_PEGTL_TEST_ASSERT( qux->fields[ 0 ].message_type == nullptr );
+      TAO_PEGTL_TEST_ASSERT( qux->fields[ 1 ].message_type == &qux->messages[ 0 ] );
+      TAO_PEGTL_TEST_ASSERT( qux->fields[ 2 ].message_type == baz );
+      TAO_PEGTL_TEST_ASSERT( other->fields[ 0 ].message_type == baz );
+
+      // A scalar field after a map field has no key type.
+      TAO_PEGTL_TEST_ASSERT( other->fields[ 1 ].key_type == proto3::field_type::int32_type );
+      TAO_PEGTL_TEST_ASSERT( other->fields[ 1 ].message_type == bar );
+      TAO_PEGTL_TEST_ASSERT( other->fields[ 2 ].type == proto3::field_type::int32_type );
+      TAO_PEGTL_TEST_ASSERT( other->fields[ 2 ].key_type == proto3::field_type::defined_type );
+   }
+
+   void test_errors()
+   {
+      proto3::descriptor_set set( { "src/test/pegtl/data/proto3" } );
+      parallel::options op;
+      op.threads = 2;
+      const auto errors = set.load( { "broken.proto", "nothing.proto" }, op );
+      TAO_PEGTL_TEST_ASSERT( errors.size() == 2 );
+      TAO_PEGTL_TEST_ASSERT( set.files().empty() );
+      for( const auto& e : errors ) {
+         TAO_PEGTL_TEST_ASSERT( ( e.name == "broken.proto" ) || ( e.name == "nothing.proto" ) );
+         TAO_PEGTL_TEST_THROWS( std::rethrow_exception( e.exception ) );
+      }
+      proto3::descriptor_set other;
+      TAO_PEGTL_TEST_ASSERT( other.load( { "src/test/pegtl/data/proto3/common/types.proto" } ).empty() );
+      TAO_PEGTL_TEST_ASSERT( other.find_message( "example.common.Timestamp" ) != nullptr );
+   }
+
+   void unit_test()
+   {
+      test_grammar();
+      test_load();
+      test_keywords();
+      test_package();
+      test_scoping();
+      test_errors();
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
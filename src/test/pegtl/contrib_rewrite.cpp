@@ -0,0 +1,156 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+#include "test.hpp"
+
+#include <tao/pegtl/contrib/rewrite.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   // clang-format off
+   struct local : plus< sor< alnum, one< '.', '_' > > > {};
+   struct domain : list< plus< alnum >, one< '.' > > {};
+   struct email : seq< local, one< '@' >, domain > {};
+   struct number : plus< digit > {};
+   struct word : plus< alpha > {};
+   struct tagged : seq< number, one< '#' > > {};
+   struct grammar : star< sor< number, word, any > > {};
+   // clang-format on
+
+   template< typename Rule >
+   struct redact
+      : nothing< Rule >
+   {
+   };
+
+   template<>
+   struct redact< email >
+   {
+      template< typename ActionInput, typename Output >
+      static void apply( const ActionInput& in, Output& out )
+      {
+         out.replace( in, "<redacted>" );
+      }
+   };
+
+   template<>
+   struct redact< number >
+   {
+      template< typename ActionInput, typename Output >
+      static void apply( const ActionInput& in, Output& out )
+      {
+         // Removes leading zeros, erases the number 0.
+         const char* b = in.begin();
+         while( ( b != in.end() ) && ( *b == '0' ) ) {
+            ++b;
+         }
+         out.replace( in.begin(), b, "" );
+      }
+   };
+
+   template<>
+   struct redact< word >
+   {
+      template< typename ActionInput, typename Output >
+      static void apply( const ActionInput& in, Output& out )
+      {
+         if( in.size() > 4 ) {
+            out.replace( in, std::string( 20000, 'w' ) );
+         }
+      }
+   };
+
+   template< typename Rule >
+   std::string transformed( const std::string& s, std::size_t& n )
+   {
+      memory_input<> in( s, __FUNCTION__ );
+      std::string r;
+      n = rewrite::transform< Rule, redact >( in, rewrite::string_sink( r ) );
+      return r;
+   }
+
+   void test_transform()
+   {
+      std::size_t n = 0;
+      TAO_PEGTL_TEST_ASSERT( transformed< email >( "", n ).empty() );
+      TAO_PEGTL_TEST_ASSERT( n == 0 );
+      TAO_PEGTL_TEST_ASSERT( transformed< email >( "no address @ here.", n ) == "no address @ here." );
+      TAO_PEGTL_TEST_ASSERT( n == 0 );
+      TAO_PEGTL_TEST_ASSERT( transformed< email >( "mail a.b@example.com, x_y@z.org.\n", n ) == "mail <redacted>, <redacted>.\n" );
+      TAO_PEGTL_TEST_ASSERT( n == 2 );
+      TAO_PEGTL_TEST_ASSERT( transformed< number >( "a007 b0 c10 0042", n ) == "a7 b c10 42" );
+      TAO_PEGTL_TEST_ASSERT( n == 4 );
+
+      // The replacements of the actions on number are discarded when tagged fails.
+      TAO_PEGTL_TEST_ASSERT( transformed< tagged >( "007 0042# 08", n ) == "007 42# 08" );
+      TAO_PEGTL_TEST_ASSERT( n == 1 );
+
+      // Many more spans than fit in a batch, and more replacements than fit in the buffer.
+      std::string s;
+      std::string e;
+      for( unsigned i = 1; i <= 5000; ++i ) {
+         s += "x" + std::to_string( i ) + "@a.b 00" + std::to_string( i ) + " ";
+         e += "<redacted> " + std::to_string( i ) + " ";
+      }
+      TAO_PEGTL_TEST_ASSERT( transformed< sor< email, number > >( s, n ) == e );
+      TAO_PEGTL_TEST_ASSERT( n == 10000 );
+   }
+
+   void test_output()
+   {
+      const std::string s = "abc 012 longer words and 3\n";
+      memory_input<> in( s, __FUNCTION__ );
+      std::ostringstream os;
+      rewrite::output out( in.begin(), rewrite::ostream_sink( os ) );
+      TAO_PEGTL_TEST_ASSERT( parse< grammar, redact >( in, out ) );
+      out.finish( in.end() );
+      TAO_PEGTL_TEST_ASSERT( os.str() == "abc 12 " + std::string( 20000, 'w' ) + ' ' + std::string( 20000, 'w' ) + " and 3\n" );
+      TAO_PEGTL_TEST_ASSERT( out.size() == os.str().size() );
+      TAO_PEGTL_TEST_ASSERT( out.replaced() == 40000 );
+
+      std::string r;
+      rewrite::output out2( s.data(), rewrite::string_sink( r ) );
+      out2.replace( s.data(), s.data(), ">" );
+      out2.replace( s.data() + 1, s.data() + 3, "" );
+      out2.replace( s.data() + 4, s.data() + 4, "<" );
+      out2.finish( s.data() + 7 );
+      TAO_PEGTL_TEST_ASSERT( r == ">a <012" );
+   }
+
+   void test_fd_sink()
+   {
+#if defined( _POSIX_VERSION )
+      std::FILE* f = std::tmpfile();
+      TAO_PEGTL_TEST_ASSERT( f != nullptr );
+      std::string s;
+      for( unsigned i = 0; i < 20000; ++i ) {
+         s += "n" + std::to_string( i ) + "@host.example ";
+      }
+      memory_input<> in( s, __FUNCTION__ );
+      TAO_PEGTL_TEST_ASSERT( rewrite::transform< email, redact >( in, rewrite::fd_sink( fileno( f ) ) ) == 20000 );
+      std::rewind( f );
+      std::string r;
+      char b[ 4096 ];
+      while( const auto n = std::fread( b, 1, sizeof( b ), f ) ) {
+         r.append( b, n );
+      }
+      std::fclose( f );
+      TAO_PEGTL_TEST_ASSERT( r.size() == 20000 * 11 );
+      TAO_PEGTL_TEST_ASSERT( r.compare( 0, 22, "<redacted> <redacted> " ) == 0 );
+#endif
+   }
+
+   void unit_test()
+   {
+      test_transform();
+      test_output();
+      test_fd_sink();
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
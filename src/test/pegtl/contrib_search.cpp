@@ -0,0 +1,167 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "test.hpp"
+
+#include <tao/pegtl/contrib/integer.hpp>
+#include <tao/pegtl/contrib/search.hpp>
+#include <tao/pegtl/contrib/uri.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   // clang-format off
+   struct ipv4 : seq< uri::IPv4address, not_at< digit > > {};
+   struct hello : seq< TAO_PEGTL_STRING( "hel" ), one< 'l' >, string< 'o', ' ' >, identifier > {};
+   struct keywords : sor< keyword< 'i', 'f' >, keyword< 'f', 'o', 'r' > > {};
+   struct number : seq< opt< one< '-' > >, plus< digit > > {};
+   struct either : sor< istring< 'a', 'b' >, one< 'x' > > {};
+   // clang-format on
+
+   // Tries every position, for comparison.
+
+   template< typename Rule >
+   struct everywhere
+   {
+      using analyze_t = analysis::generic< analysis::rule_type::any >;
+
+      template< apply_mode A,
+                rewind_mode M,
+                template< typename... >
+                class Action,
+                template< typename... >
+                class Control,
+                typename Input,
+                typename... States >
+      [[nodiscard]] static bool match( Input& in, States&&... st )
+      {
+         return Control< Rule >::template match< A, M, Action, Control >( in, st... );
+      }
+   };
+
+   template< typename Rule >
+   std::vector< std::string > find_all( const std::string& s )
+   {
+      memory_input<> in( s, __FUNCTION__ );
+      std::vector< std::string > r;
+      search< Rule >( in, [ & ]( const auto& m ) { r.emplace_back( m.string() ); } );
+      return r;
+   }
+
+   template< typename Rule >
+   struct count_action
+      : nothing< Rule >
+   {
+   };
+
+   template<>
+   struct count_action< digit >
+   {
+      static void apply0( std::size_t& n )
+      {
+         ++n;
+      }
+   };
+
+   void test_first()
+   {
+      using internal::search_first_v;
+
+      TAO_PEGTL_TEST_ASSERT( search_first_v< ipv4 >.count() == 10 );
+      TAO_PEGTL_TEST_ASSERT( search_first_v< ipv4 >.ranges() == 1 );
+      TAO_PEGTL_TEST_ASSERT( !search_first_v< ipv4 >.nullable );
+      TAO_PEGTL_TEST_ASSERT( search_first_v< identifier >.count() == 53 );
+      TAO_PEGTL_TEST_ASSERT( search_first_v< identifier >.ranges() == 3 );
+      TAO_PEGTL_TEST_ASSERT( search_first_v< keywords >.count() == 2 );
+      TAO_PEGTL_TEST_ASSERT( search_first_v< number >.count() == 11 );
+      TAO_PEGTL_TEST_ASSERT( search_first_v< either >.count() == 3 );
+      TAO_PEGTL_TEST_ASSERT( search_first_v< either >.contains( 'A' ) );
+      TAO_PEGTL_TEST_ASSERT( search_first_v< not_one< 'a' > >.count() == 255 );
+      TAO_PEGTL_TEST_ASSERT( search_first_v< not_one< 'a' > >.ranges( true ) == 1 );
+      TAO_PEGTL_TEST_ASSERT( search_first_v< integer::signed_rule >.count() == 12 );
+      TAO_PEGTL_TEST_ASSERT( search_first_v< if_must< one< 'a' >, one< 'b' > > >.count() == 1 );
+      TAO_PEGTL_TEST_ASSERT( search_first_v< star< one< 'a' > > >.nullable );
+      TAO_PEGTL_TEST_ASSERT( search_first_v< pad< one< 'a' >, blank > >.count() == 3 );
+      TAO_PEGTL_TEST_ASSERT( search_first_v< until< eol > >.count() == 256 );
+      TAO_PEGTL_TEST_ASSERT( search_first_v< failure >.count() == 0 );
+      TAO_PEGTL_TEST_ASSERT( search_first_v< everywhere< digit > >.count() == 256 );
+
+      using internal::search_literal;
+      using internal::search_literal_t;
+
+      TAO_PEGTL_TEST_ASSERT( ( std::is_same_v< search_literal_t< hello >, search_literal< false, 'h', 'e', 'l', 'l', 'o', ' ' > > ) );
+      TAO_PEGTL_TEST_ASSERT( ( std::is_same_v< search_literal_t< keyword< 'i', 'f' > >, search_literal< false, 'i', 'f' > > ) );
+      TAO_PEGTL_TEST_ASSERT( ( std::is_same_v< search_literal_t< seq< one< 'a' >, string< 'b' > > >, search_literal< true, 'a', 'b' > > ) );
+      TAO_PEGTL_TEST_ASSERT( ( std::is_same_v< search_literal_t< seq< one< 'a' >, one< 'b', 'c' >, one< 'd' > > >, search_literal< false, 'a' > > ) );
+      TAO_PEGTL_TEST_ASSERT( ( std::is_same_v< search_literal_t< keywords >, search_literal< false > > ) );
+   }
+
+   void test_search()
+   {
+      const std::string text = "from 10.0.0.1 to 192.168.100.200, not 1.2.3 or 1.2.3.45x\nbut 127.0.0.1";
+      TAO_PEGTL_TEST_ASSERT( find_all< ipv4 >( text ) == std::vector< std::string >( { "10.0.0.1", "192.168.100.200", "1.2.3.45", "127.0.0.1" } ) );
+      TAO_PEGTL_TEST_ASSERT( find_all< number >( "a1 -22 - 333-4" ) == std::vector< std::string >( { "1", "-22", "333", "-4" } ) );
+      TAO_PEGTL_TEST_ASSERT( find_all< keywords >( "if for fork of iff if" ) == std::vector< std::string >( { "if", "for", "if" } ) );
+      TAO_PEGTL_TEST_ASSERT( find_all< either >( "aB xx Ab" ) == std::vector< std::string >( { "aB", "x", "x", "Ab" } ) );
+      TAO_PEGTL_TEST_ASSERT( find_all< hello >( "hello world, hello hello 1" ) == std::vector< std::string >( { "hello world", "hello hello" } ) );
+      TAO_PEGTL_TEST_ASSERT( find_all< star< one< 'a' > > >( "baab" ) == std::vector< std::string >( { "", "aa", "", "" } ) );
+      TAO_PEGTL_TEST_ASSERT( find_all< failure >( "abc" ).empty() );
+      TAO_PEGTL_TEST_ASSERT( find_all< ipv4 >( "" ).empty() );
+
+      memory_input<> in( text, __FUNCTION__ );
+      std::vector< std::size_t > lines;
+      TAO_PEGTL_TEST_ASSERT( search< ipv4 >( in, [ & ]( const auto& m ) { lines.push_back( m.position().line ); } ) == 4 );
+      TAO_PEGTL_TEST_ASSERT( lines == std::vector< std::size_t >( { 1, 1, 1, 2 } ) );
+      TAO_PEGTL_TEST_ASSERT( in.empty() );
+
+      std::size_t n = 0;
+      memory_input<> in2( "a 12 b 345", __FUNCTION__ );
+      TAO_PEGTL_TEST_ASSERT( search< plus< digit >, count_action >( in2, []( const auto& /*unused*/ ) {}, n ) == 2 );
+      TAO_PEGTL_TEST_ASSERT( n == 5 );
+
+      memory_input<> in3( "a 1 b 2c", __FUNCTION__ );
+      TAO_PEGTL_TEST_THROWS( search< seq< digit, must< one< ' ' > > > >( in3, []( const auto& /*unused*/ ) {} ) );
+   }
+
+   template< typename Rule >
+   void verify_same( const std::string& s )
+   {
+      const auto a = find_all< Rule >( s );
+      const auto b = find_all< everywhere< Rule > >( s );
+      TAO_PEGTL_TEST_ASSERT( a == b );
+   }
+
+   void test_blocks()
+   {
+      // Matches around the boundaries of the 64 byte blocks.
+      std::string s;
+      unsigned x = 1;
+      for( std::size_t i = 0; i < 2000; ++i ) {
+         x = x * 1103515245 + 12345;
+         s += "ab xyz.0123\n\t"[ ( x >> 16 ) % 13 ];
+      }
+      verify_same< number >( s );
+      verify_same< identifier >( s );
+      verify_same< string< 'a', 'b' > >( s );
+      verify_same< seq< string< 'a', 'b', ' ' >, one< 'x' > > >( s );
+      verify_same< not_one< 'a', 'b', 'x', 'y', 'z' > >( s );
+      verify_same< ranges< 'a', 'b', 'x', 'x', '0', '1', '\n' > >( s );
+      verify_same< one< '\t', '.', '1', '3', '5', 'a', 'c', 'x', 'z', '~' > >( s );
+      verify_same< seq< one< '.' >, digit > >( s );
+      TAO_PEGTL_TEST_ASSERT( find_all< string< 'a', 'b' > >( s ).size() > 10 );
+   }
+
+   void unit_test()
+   {
+      test_first();
+      test_search();
+      test_blocks();
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
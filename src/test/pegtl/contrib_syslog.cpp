@@ -0,0 +1,105 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <string>
+
+#include "test.hpp"
+#include "verify_rule.hpp"
+
+#include <tao/pegtl/contrib/syslog.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   void test_rules()
+   {
+      verify_rule< syslog::pri >( __LINE__, __FILE__, "<0>", result_type::success );
+      verify_rule< syslog::pri >( __LINE__, __FILE__, "<191>", result_type::success );
+      verify_rule< syslog::pri >( __LINE__, __FILE__, "<192>", result_type::local_failure );
+      verify_rule< syslog::pri >( __LINE__, __FILE__, "<0013>", result_type::local_failure );
+      verify_rule< syslog::pri >( __LINE__, __FILE__, "<>", result_type::local_failure );
+
+      verify_rule< syslog::hostname >( __LINE__, __FILE__, "mymachine.example.com", result_type::success );
+      verify_rule< syslog::hostname >( __LINE__, __FILE__, "a b", result_type::success, 2 );
+      verify_rule< syslog::hostname >( __LINE__, __FILE__, "", result_type::local_failure );
+      verify_rule< syslog::msgid >( __LINE__, __FILE__, std::string( 32, 'x' ), result_type::success );
+      verify_rule< syslog::msgid >( __LINE__, __FILE__, std::string( 33, 'x' ), result_type::local_failure );
+
+      verify_rule< syslog::sd_element >( __LINE__, __FILE__, "[exampleSDID@32473 iut=\"3\" eventSource=\"Application\"]", result_type::success );
+      verify_rule< syslog::sd_element >( __LINE__, __FILE__, "[id v=\"a\\\"]b\"]", result_type::success );
+      verify_rule< syslog::sd_element >( __LINE__, __FILE__, "[id v=\"a\\\"]", result_type::local_failure );
+      verify_rule< syslog::sd_element >( __LINE__, __FILE__, "[id v=a]", result_type::local_failure );
+      verify_rule< syslog::sd_element >( __LINE__, __FILE__, "[i=d]", result_type::local_failure );
+   }
+
+   void test_parse()
+   {
+      syslog::message m;
+      TAO_PEGTL_TEST_ASSERT( syslog::parse( "<34>1 2003-10-11T22:14:15.003Z mymachine.example.com su - ID47 - \xef\xbb\xbf'su root' failed for lonvick on /dev/pts/8", m ) );
+      TAO_PEGTL_TEST_ASSERT( m.facility == 4 );
+      TAO_PEGTL_TEST_ASSERT( m.severity == 2 );
+      TAO_PEGTL_TEST_ASSERT( m.version == 1 );
+      TAO_PEGTL_TEST_ASSERT( m.timestamp );
+      TAO_PEGTL_TEST_ASSERT( ( *m.timestamp == timestamp::epoch{ 1065910455, 3000000 } ) );
+      TAO_PEGTL_TEST_ASSERT( m.hostname == "mymachine.example.com" );
+      TAO_PEGTL_TEST_ASSERT( m.app_name == "su" );
+      TAO_PEGTL_TEST_ASSERT( m.procid.empty() );
+      TAO_PEGTL_TEST_ASSERT( m.msgid == "ID47" );
+      TAO_PEGTL_TEST_ASSERT( m.structured_data.empty() );
+      TAO_PEGTL_TEST_ASSERT( m.msg == "\xef\xbb\xbf'su root' failed for lonvick on /dev/pts/8" );
+
+      TAO_PEGTL_TEST_ASSERT( syslog::parse( "<165>1 2003-08-24T05:14:15.000003-07:00 192.0.2.1 myproc 8710 - - %% It's time to make the do-nuts.\r", m ) );
+      TAO_PEGTL_TEST_ASSERT( m.facility == 20 );
+      TAO_PEGTL_TEST_ASSERT( m.severity == 5 );
+      TAO_PEGTL_TEST_ASSERT( ( *m.timestamp == timestamp::epoch{ 1061727255, 3000 } ) );
+      TAO_PEGTL_TEST_ASSERT( m.procid == "8710" );
+      TAO_PEGTL_TEST_ASSERT( m.msgid.empty() );
+      TAO_PEGTL_TEST_ASSERT( m.msg == "%% It's time to make the do-nuts." );
+
+      TAO_PEGTL_TEST_ASSERT( syslog::parse( "<165>1 2003-10-11T22:14:15.003Z mymachine.example.com evntslog - ID47 [exampleSDID@32473 iut=\"3\" eventSource=\"Application\" eventID=\"1011\"][examplePriority@32473 class=\"high\"]", m ) );
+      TAO_PEGTL_TEST_ASSERT( m.structured_data.size() == 2 );
+      TAO_PEGTL_TEST_ASSERT( m.params.size() == 4 );
+      TAO_PEGTL_TEST_ASSERT( m.structured_data[ 0 ].id == "exampleSDID@32473" );
+      TAO_PEGTL_TEST_ASSERT( m.structured_data[ 0 ].first == 0 );
+      TAO_PEGTL_TEST_ASSERT( m.structured_data[ 0 ].count == 3 );
+      TAO_PEGTL_TEST_ASSERT( m.structured_data[ 1 ].id == "examplePriority@32473" );
+      TAO_PEGTL_TEST_ASSERT( m.structured_data[ 1 ].first == 3 );
+      TAO_PEGTL_TEST_ASSERT( m.structured_data[ 1 ].count == 1 );
+      TAO_PEGTL_TEST_ASSERT( m.params[ 1 ].name == "eventSource" );
+      TAO_PEGTL_TEST_ASSERT( m.params[ 1 ].value == "Application" );
+      TAO_PEGTL_TEST_ASSERT( m.params[ 3 ].value == "high" );
+      TAO_PEGTL_TEST_ASSERT( m.msg.empty() );
+
+      TAO_PEGTL_TEST_ASSERT( syslog::parse( "<0>12 - - - - - [a b=\"x\\\"y\\\\z\\]\" c=\"\"] msg", m ) );
+      TAO_PEGTL_TEST_ASSERT( m.version == 12 );
+      TAO_PEGTL_TEST_ASSERT( !m.timestamp );
+      TAO_PEGTL_TEST_ASSERT( m.hostname.empty() );
+      TAO_PEGTL_TEST_ASSERT( m.params.size() == 2 );
+      TAO_PEGTL_TEST_ASSERT( m.params[ 0 ].value == "x\\\"y\\\\z\\]" );
+      TAO_PEGTL_TEST_ASSERT( m.params[ 1 ].value.empty() );
+      TAO_PEGTL_TEST_ASSERT( m.msg == "msg" );
+      std::string s;
+      syslog::unescape( m.params[ 0 ].value, s );
+      TAO_PEGTL_TEST_ASSERT( s == "x\"y\\z]" );
+
+      TAO_PEGTL_TEST_ASSERT( syslog::parse( "<0>1 - - - - - -", m ) );
+      TAO_PEGTL_TEST_ASSERT( syslog::parse( "<0>1 - - - - - - ", m ) );
+
+      TAO_PEGTL_TEST_ASSERT( !syslog::parse( "", m ) );
+      TAO_PEGTL_TEST_ASSERT( !syslog::parse( "<0>1 - - - - -", m ) );
+      TAO_PEGTL_TEST_ASSERT( !syslog::parse( "<0>0 - - - - - -", m ) );
+      TAO_PEGTL_TEST_ASSERT( !syslog::parse( "<0>1 2003-10-11 22:14:15Z - - - - -", m ) );
+      TAO_PEGTL_TEST_ASSERT( !syslog::parse( "<0>1 - - - - - -x", m ) );
+      TAO_PEGTL_TEST_ASSERT( !syslog::parse( "<0>1 - - - - - [a b=\"c\"]x", m ) );
+      TAO_PEGTL_TEST_ASSERT( !syslog::parse( "<0>1 - - - - - - a\nb", m ) );
+      TAO_PEGTL_TEST_ASSERT( !syslog::parse( "<0>1 - - - - " + std::string( 33, 'x' ) + " -", m ) );
+   }
+
+   void unit_test()
+   {
+      test_rules();
+      test_parse();
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
@@ -0,0 +1,144 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+#include "test.hpp"
+#include "verify_rule.hpp"
+
+#include <tao/pegtl/contrib/timestamp.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   bool rfc3339( const std::string& s, const timestamp::epoch& expected )
+   {
+      timestamp::epoch t;
+      return ( timestamp::parse_rfc3339( s.data(), s.data() + s.size(), t ) == s.data() + s.size() ) && ( t == expected );
+   }
+
+   bool clf( const std::string& s, const timestamp::epoch& expected )
+   {
+      timestamp::epoch t;
+      return ( timestamp::parse_clf( s.data(), s.data() + s.size(), t ) == s.data() + s.size() ) && ( t == expected );
+   }
+
+   bool rfc3339_fails( const std::string& s )
+   {
+      timestamp::epoch t;
+      return timestamp::parse_rfc3339( s.data(), s.data() + s.size(), t ) == nullptr;
+   }
+
+   bool clf_fails( const std::string& s )
+   {
+      timestamp::epoch t;
+      return timestamp::parse_clf( s.data(), s.data() + s.size(), t ) == nullptr;
+   }
+
+   void test_rfc3339()
+   {
+      TAO_PEGTL_TEST_ASSERT( rfc3339( "1970-01-01T00:00:00Z", { 0, 0 } ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339( "1985-04-12T23:20:50.52Z", { 482196050, 520000000 } ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339( "1996-12-19T16:39:57-08:00", { 851042397, 0 } ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339( "1990-12-31T23:59:60Z", { 662688000, 0 } ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339( "1937-01-01T12:00:27.87+00:20", { -1041337173, 870000000 } ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339( "2003-08-24T05:14:15.000003-07:00", { 1061727255, 3000 } ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339( "2003-10-11t22:14:15.1234567891z", { 1065910455, 123456789 } ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339( "0001-01-01T00:00:00Z", { -62135596800, 0 } ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339( "9999-12-31T23:59:59Z", { 253402300799, 0 } ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339( "2000-02-29T00:00:00Z", { 951782400, 0 } ) );
+
+      TAO_PEGTL_TEST_ASSERT( rfc3339_fails( "" ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339_fails( "1985-04-12T23:20:50" ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339_fails( "1985-04-12T23:20:50.Z" ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339_fails( "1985-04-12T23:20:50.5" ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339_fails( "1985-04-12 23:20:50Z" ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339_fails( "1985-04-12T23:20:50+01" ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339_fails( "1985-04-12T23:20:50+0100" ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339_fails( "1985-04-12T23:20:50+24:00" ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339_fails( "1985/04/12T23:20:50Z" ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339_fails( "1985-4-12T23:20:50Z" ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339_fails( "1985-00-12T23:20:50Z" ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339_fails( "1985-13-12T23:20:50Z" ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339_fails( "1985-04-31T23:20:50Z" ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339_fails( "1900-02-29T23:20:50Z" ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339_fails( "1985-04-12T24:20:50Z" ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339_fails( "1985-04-12T23:60:50Z" ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339_fails( "1985-04-12T23:20:61Z" ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339_fails( "1985-04-12T23:2a:50Z" ) );
+      TAO_PEGTL_TEST_ASSERT( rfc3339_fails( "1985-04-12T23:20:50\xff" ) );
+
+      verify_rule< timestamp::rfc3339 >( __LINE__, __FILE__, "1985-04-12T23:20:50Z", result_type::success );
+      verify_rule< timestamp::rfc3339 >( __LINE__, __FILE__, "1985-04-12T23:20:50.52+01:00 x", result_type::success, 2 );
+      verify_rule< timestamp::rfc3339 >( __LINE__, __FILE__, "1985-04-12T23:20:50", result_type::local_failure );
+   }
+
+   // Every day from 1600 to 2400 is one day after the previous one, and
+   // no day is accepted that does not exist.
+
+   void test_days()
+   {
+      bool first = true;
+      std::int64_t previous = 0;
+      for( unsigned y = 1600; y <= 2400; ++y ) {
+         for( unsigned m = 0; m <= 13; ++m ) {
+            for( unsigned d = 0; d <= 32; ++d ) {
+               char s[ 32 ];
+               std::snprintf( s, sizeof( s ), "%04u-%02u-%02uT00:00:00Z", y, m, d );
+               timestamp::epoch t;
+               if( timestamp::parse_rfc3339( s, s + 20, t ) != nullptr ) {
+                  TAO_PEGTL_TEST_ASSERT( first || ( t.seconds == previous + 86400 ) );
+                  TAO_PEGTL_TEST_ASSERT( t.seconds == timestamp::days_from_civil( y, m, d ) * 86400 );
+                  first = false;
+                  previous = t.seconds;
+               }
+            }
+         }
+      }
+      TAO_PEGTL_TEST_ASSERT( previous == timestamp::days_from_civil( 2400, 12, 31 ) * 86400 );
+      TAO_PEGTL_TEST_ASSERT( timestamp::days_from_civil( 1970, 1, 1 ) == 0 );
+      TAO_PEGTL_TEST_ASSERT( timestamp::days_from_civil( 1969, 12, 31 ) == -1 );
+   }
+
+   void test_clf()
+   {
+      TAO_PEGTL_TEST_ASSERT( clf( "10/Oct/2000:13:55:36 -0700", { 971211336, 0 } ) );
+      TAO_PEGTL_TEST_ASSERT( clf( "01/Jan/1970:00:00:00 +0000", { 0, 0 } ) );
+      TAO_PEGTL_TEST_ASSERT( clf( "01/Jan/1970:01:00:00 +0100", { 0, 0 } ) );
+
+      const char* const months[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+      for( unsigned m = 0; m < 12; ++m ) {
+         const std::string s = std::string( "28/" ) + months[ m ] + "/2020:12:00:00 +0000";
+         TAO_PEGTL_TEST_ASSERT( clf( s, { timestamp::days_from_civil( 2020, m + 1, 28 ) * 86400 + 43200, 0 } ) );
+      }
+
+      TAO_PEGTL_TEST_ASSERT( clf_fails( "10/oct/2000:13:55:36 -0700" ) );
+      TAO_PEGTL_TEST_ASSERT( clf_fails( "10/Okt/2000:13:55:36 -0700" ) );
+      TAO_PEGTL_TEST_ASSERT( clf_fails( "31/Nov/2000:13:55:36 -0700" ) );
+      TAO_PEGTL_TEST_ASSERT( clf_fails( "10/Oct/2000:13:55:36 0700" ) );
+      TAO_PEGTL_TEST_ASSERT( clf_fails( "10/Oct/2000:13:55:36 -07:00" ) );
+      TAO_PEGTL_TEST_ASSERT( clf_fails( "10/Oct/2000 13:55:36 -0700" ) );
+      TAO_PEGTL_TEST_ASSERT( clf_fails( "10/Oct/2000:13:55:36 -070" ) );
+
+      verify_rule< timestamp::clf >( __LINE__, __FILE__, "10/Oct/2000:13:55:36 -0700]", result_type::success, 1 );
+      verify_rule< timestamp::clf >( __LINE__, __FILE__, "10/Oct/2000:13:55:36", result_type::local_failure );
+   }
+
+   void test_stream()
+   {
+      std::istringstream stream( "1985-04-12T23:20:50.52Z 10/Oct/2000:13:55:36 -0700" );
+      TAO_PEGTL_TEST_ASSERT( parse< seq< timestamp::rfc3339, one< ' ' >, timestamp::clf, eof > >( istream_input( stream, 64, __FUNCTION__ ) ) );
+   }
+
+   void unit_test()
+   {
+      test_rfc3339();
+      test_days();
+      test_clf();
+      test_stream();
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
@@ -0,0 +1,95 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include <string>
+
+#include "test.hpp"
+#include "verify_rule.hpp"
+
+#include <tao/pegtl/contrib/trivia.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   using cpp_line = line_comment< TAO_PEGTL_STRING( "//" ) >;
+   using cpp_block = block_comment< TAO_PEGTL_STRING( "/*" ), TAO_PEGTL_STRING( "*/" ) >;
+   using hash_line = line_comment< one< '#' > >;
+
+   using cpp_trivia = skip_trivia< space, cpp_line, cpp_block >;
+
+   template< typename Rule >
+   struct comment_action
+      : nothing< Rule >
+   {
+   };
+
+   template<>
+   struct comment_action< cpp_line >
+   {
+      template< typename ActionInput >
+      static void apply( const ActionInput& in, std::string& s )
+      {
+         s += in.string();
+      }
+   };
+
+   void test_comments()
+   {
+      verify_rule< cpp_line >( __LINE__, __FILE__, "//", result_type::success );
+      verify_rule< cpp_line >( __LINE__, __FILE__, "// a\nb", result_type::success, 2 );
+      verify_rule< cpp_line >( __LINE__, __FILE__, "/ a", result_type::local_failure );
+      verify_rule< cpp_block >( __LINE__, __FILE__, "/**/", result_type::success );
+      verify_rule< cpp_block >( __LINE__, __FILE__, "/* * / \n ***/*/", result_type::success, 2 );
+      verify_rule< cpp_block >( __LINE__, __FILE__, "/*/", result_type::global_failure );
+      verify_rule< cpp_block >( __LINE__, __FILE__, "/* *", result_type::global_failure );
+      verify_rule< cpp_block >( __LINE__, __FILE__, "//", result_type::local_failure );
+      verify_rule< hash_line >( __LINE__, __FILE__, "#!\r\n", result_type::success, 2 );
+   }
+
+   void test_trivia()
+   {
+      verify_rule< cpp_trivia >( __LINE__, __FILE__, "", result_type::success );
+      verify_rule< cpp_trivia >( __LINE__, __FILE__, "a", result_type::success, 1 );
+      verify_rule< cpp_trivia >( __LINE__, __FILE__, " \t\r\n\v\f// a\n/* b\n */ /**/x", result_type::success, 1 );
+      verify_rule< cpp_trivia >( __LINE__, __FILE__, "/ ", result_type::success, 2 );
+      verify_rule< cpp_trivia >( __LINE__, __FILE__, " /* ", result_type::global_failure );
+      verify_rule< cpp_trivia >( __LINE__, __FILE__, std::string( 200, ' ' ) + "// a", result_type::success );
+      verify_rule< cpp_trivia >( __LINE__, __FILE__, std::string( 100, '\n' ) + "x" + std::string( 100, ' ' ), result_type::success, 101 );
+
+      verify_rule< trivia< blank, hash_line > >( __LINE__, __FILE__, " # a\n", result_type::success, 1 );
+      verify_rule< trivia< blank, hash_line > >( __LINE__, __FILE__, "\n", result_type::local_failure );
+      verify_rule< trivia< blank, hash_line > >( __LINE__, __FILE__, "", result_type::local_failure );
+      verify_rule< trivia< one< '_' > > >( __LINE__, __FILE__, "__a", result_type::success, 1 );
+
+      memory_input in( "  // a\n\n  /* b\n\n */  x", __FUNCTION__ );
+      TAO_PEGTL_TEST_ASSERT( parse< seq< cpp_trivia, one< 'x' > > >( in ) );
+      TAO_PEGTL_TEST_ASSERT( in.position().line == 5 );
+      TAO_PEGTL_TEST_ASSERT( in.position().byte_in_line == 6 );
+
+      // With an action on a sub-rule the sub-rules are matched individually.
+      std::string s;
+      memory_input in3( " // a\n/* b */// c", __FUNCTION__ );
+      TAO_PEGTL_TEST_ASSERT( parse< seq< cpp_trivia, eof >, comment_action >( in3, s ) );
+      TAO_PEGTL_TEST_ASSERT( s == "// a// c" );
+
+      memory_input in2( "\n /* a", __FUNCTION__ );
+      bool thrown = false;
+      try {
+         (void)parse< cpp_trivia >( in2 );
+      }
+      catch( const parse_error& e ) {
+         TAO_PEGTL_TEST_ASSERT( e.positions.at( 0 ).line == 2 );
+         TAO_PEGTL_TEST_ASSERT( e.positions.at( 0 ).byte_in_line == 1 );
+         thrown = true;
+      }
+      TAO_PEGTL_TEST_ASSERT( thrown );
+   }
+
+   void unit_test()
+   {
+      test_comments();
+      test_trivia();
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
@@ -0,0 +1,119 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#include "test.hpp"
+#include "verify_rule.hpp"
+
+#include <tao/pegtl/contrib/unicode/utf16.hpp>
+#include <tao/pegtl/contrib/unicode/utf32.hpp>
+#include <tao/pegtl/contrib/unicode/utf8.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   namespace
+   {
+      std::string u16s_be( const char16_t v )
+      {
+         const std::uint16_t u = internal::h_to_be( std::uint16_t( v ) );
+         return std::string( reinterpret_cast< const char* >( &u ), sizeof( u ) );
+      }
+
+      std::string u32s_le( const char32_t v )
+      {
+         const std::uint32_t u = internal::h_to_le( std::uint32_t( v ) );
+         return std::string( reinterpret_cast< const char* >( &u ), sizeof( u ) );
+      }
+
+   }  // namespace
+
+   void test_tables()
+   {
+      TAO_PEGTL_TEST_ASSERT( unicode::general_category_of( U'A' ) == unicode::general_category::uppercase_letter );
+      TAO_PEGTL_TEST_ASSERT( unicode::general_category_of( U'z' ) == unicode::general_category::lowercase_letter );
+      TAO_PEGTL_TEST_ASSERT( unicode::general_category_of( U'7' ) == unicode::general_category::decimal_number );
+      TAO_PEGTL_TEST_ASSERT( unicode::general_category_of( U'_' ) == unicode::general_category::connector_punctuation );
+      TAO_PEGTL_TEST_ASSERT( unicode::general_category_of( U' ' ) == unicode::general_category::space_separator );
+      TAO_PEGTL_TEST_ASSERT( unicode::general_category_of( 0x0a ) == unicode::general_category::control );
+      TAO_PEGTL_TEST_ASSERT( unicode::general_category_of( 0x01c5 ) == unicode::general_category::titlecase_letter );
+      TAO_PEGTL_TEST_ASSERT( unicode::general_category_of( 0x0301 ) == unicode::general_category::nonspacing_mark );
+      TAO_PEGTL_TEST_ASSERT( unicode::general_category_of( 0x20ac ) == unicode::general_category::currency_symbol );
+      TAO_PEGTL_TEST_ASSERT( unicode::general_category_of( 0x2028 ) == unicode::general_category::line_separator );
+      TAO_PEGTL_TEST_ASSERT( unicode::general_category_of( 0xd800 ) == unicode::general_category::surrogate );
+      TAO_PEGTL_TEST_ASSERT( unicode::general_category_of( 0xe000 ) == unicode::general_category::private_use );
+      TAO_PEGTL_TEST_ASSERT( unicode::general_category_of( 0xfffe ) == unicode::general_category::unassigned );
+      TAO_PEGTL_TEST_ASSERT( unicode::general_category_of( 0x1f600 ) == unicode::general_category::other_symbol );
+      TAO_PEGTL_TEST_ASSERT( unicode::general_category_of( 0x10ffff ) == unicode::general_category::unassigned );
+
+      TAO_PEGTL_TEST_ASSERT( unicode::script_of( U'A' ) == unicode::script::latin );
+      TAO_PEGTL_TEST_ASSERT( unicode::script_of( U'1' ) == unicode::script::common );
+      TAO_PEGTL_TEST_ASSERT( unicode::script_of( 0x03b1 ) == unicode::script::greek );
+      TAO_PEGTL_TEST_ASSERT( unicode::script_of( 0x0430 ) == unicode::script::cyrillic );
+      TAO_PEGTL_TEST_ASSERT( unicode::script_of( 0x0301 ) == unicode::script::inherited );
+      TAO_PEGTL_TEST_ASSERT( unicode::script_of( 0x540d ) == unicode::script::han );
+      TAO_PEGTL_TEST_ASSERT( unicode::script_of( 0x10300 ) == unicode::script::old_italic );
+      TAO_PEGTL_TEST_ASSERT( unicode::script_of( 0x10ffff ) == unicode::script::unknown );
+   }
+
+   void test_utf8()
+   {
+      verify_rule< utf8::unicode::white_space >( __LINE__, __FILE__, "", result_type::local_failure );
+      verify_rule< utf8::unicode::white_space >( __LINE__, __FILE__, " ", result_type::success );
+      verify_rule< utf8::unicode::white_space >( __LINE__, __FILE__, "\t", result_type::success );
+      verify_rule< utf8::unicode::white_space >( __LINE__, __FILE__, "\xc2\xa0", result_type::success );      // U+00A0
+      verify_rule< utf8::unicode::white_space >( __LINE__, __FILE__, "\xe3\x80\x80x", result_type::success, 1 );  // U+3000
+      verify_rule< utf8::unicode::white_space >( __LINE__, __FILE__, "\xe2\x80\x8b", result_type::local_failure );  // U+200B
+      verify_rule< utf8::unicode::white_space >( __LINE__, __FILE__, "a", result_type::local_failure );
+
+      verify_rule< utf8::unicode::xid_start >( __LINE__, __FILE__, "a", result_type::success );
+      verify_rule< utf8::unicode::xid_start >( __LINE__, __FILE__, "_", result_type::local_failure );
+      verify_rule< utf8::unicode::xid_start >( __LINE__, __FILE__, "1", result_type::local_failure );
+      verify_rule< utf8::unicode::xid_start >( __LINE__, __FILE__, "\xce\xb1", result_type::success );  // U+03B1
+      verify_rule< utf8::unicode::xid_start >( __LINE__, __FILE__, "\xcc\x81", result_type::local_failure );  // U+0301
+      verify_rule< utf8::unicode::xid_continue >( __LINE__, __FILE__, "_", result_type::success );
+      verify_rule< utf8::unicode::xid_continue >( __LINE__, __FILE__, "1", result_type::success );
+      verify_rule< utf8::unicode::xid_continue >( __LINE__, __FILE__, "\xcc\x81", result_type::success );
+      verify_rule< utf8::unicode::xid_continue >( __LINE__, __FILE__, "-", result_type::local_failure );
+      verify_rule< utf8::unicode::xid_continue >( __LINE__, __FILE__, "\xff", result_type::local_failure );
+
+      verify_rule< utf8::unicode::identifier >( __LINE__, __FILE__, "", result_type::local_failure );
+      verify_rule< utf8::unicode::identifier >( __LINE__, __FILE__, "a", result_type::success );
+      verify_rule< utf8::unicode::identifier >( __LINE__, __FILE__, "a_1", result_type::success );
+      verify_rule< utf8::unicode::identifier >( __LINE__, __FILE__, "a_1 b", result_type::success, 2 );
+      verify_rule< utf8::unicode::identifier >( __LINE__, __FILE__, "_a", result_type::local_failure );
+      verify_rule< utf8::unicode::identifier >( __LINE__, __FILE__, "1a", result_type::local_failure );
+      verify_rule< utf8::unicode::identifier >( __LINE__, __FILE__, "\xce\xb1\xcc\x81x9", result_type::success );
+      verify_rule< utf8::unicode::identifier >( __LINE__, __FILE__, "\xe5\x90\x8d\xe5\x89\x8d-", result_type::success, 1 );
+      verify_rule< utf8::unicode::identifier >( __LINE__, __FILE__, "x\xff", result_type::success, 1 );
+
+      verify_rule< utf8::unicode::general_category< unicode::general_category::uppercase_letter > >( __LINE__, __FILE__, "A", result_type::success );
+      verify_rule< utf8::unicode::general_category< unicode::general_category::uppercase_letter > >( __LINE__, __FILE__, "a", result_type::local_failure );
+      verify_rule< utf8::unicode::general_category< unicode::general_category::currency_symbol > >( __LINE__, __FILE__, "\xe2\x82\xac", result_type::success );
+
+      verify_rule< utf8::unicode::script< unicode::script::greek > >( __LINE__, __FILE__, "\xce\xb1", result_type::success );
+      verify_rule< utf8::unicode::script< unicode::script::greek > >( __LINE__, __FILE__, "a", result_type::local_failure );
+      verify_rule< utf8::unicode::script< unicode::script::latin > >( __LINE__, __FILE__, "a", result_type::success );
+   }
+
+   void test_utf16_utf32()
+   {
+      verify_rule< utf16_be::unicode::white_space >( __LINE__, __FILE__, u16s_be( 0x3000 ), result_type::success );
+      verify_rule< utf16_be::unicode::identifier >( __LINE__, __FILE__, u16s_be( 0x03b1 ) + u16s_be( 0x0301 ) + u16s_be( '-' ), result_type::success, 2 );
+      verify_rule< utf16_be::unicode::identifier >( __LINE__, __FILE__, u16s_be( '_' ), result_type::local_failure );
+      verify_rule< utf16_be::unicode::script< unicode::script::han > >( __LINE__, __FILE__, u16s_be( 0x540d ), result_type::success );
+
+      verify_rule< utf32_le::unicode::white_space >( __LINE__, __FILE__, u32s_le( 0x2028 ), result_type::success );
+      verify_rule< utf32_le::unicode::identifier >( __LINE__, __FILE__, u32s_le( 0x10300 ) + u32s_le( '1' ) + u32s_le( ' ' ), result_type::success, 4 );
+      verify_rule< utf32_le::unicode::xid_start >( __LINE__, __FILE__, u32s_le( 0x110000 ), result_type::local_failure );
+      verify_rule< utf32_le::unicode::general_category< unicode::general_category::private_use > >( __LINE__, __FILE__, u32s_le( 0xe000 ), result_type::success );
+   }
+
+   void unit_test()
+   {
+      test_tables();
+      test_utf8();
+      test_utf16_utf32();
+   }
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#include "main.hpp"
@@ -0,0 +1,65 @@
+// Copyright (c) 2020 Dr. Colin Hirsch and Daniel Frey
+// Please see LICENSE for license or visit https://github.com/taocpp/PEGTL/
+
+#ifndef TAO_PEGTL_SRC_TEST_PEGTL_SUM_ACTION_HPP
+#define TAO_PEGTL_SRC_TEST_PEGTL_SUM_ACTION_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#include <tao/pegtl/config.hpp>
+#include <tao/pegtl/nothing.hpp>
+
+#include <tao/pegtl/contrib/json.hpp>
+
+namespace TAO_PEGTL_NAMESPACE
+{
+   // Shared by the tests of the parallel parsers: the numbers and their
+   // positions are collected, and the strings are counted, in one state
+   // per chunk. The number -666 throws an exception that is not a
+   // parse_error, which must be propagated.
+
+   struct sum_state
+   {
+      std::size_t numbers = 0;
+      std::size_t strings = 0;
+      long long sum = 0;
+      std::string positions;
+   };
+
+   template< typename Rule >
+   struct sum_action
+      : nothing< Rule >
+   {
+   };
+
+   template<>
+   struct sum_action< json::number >
+   {
+      template< typename ActionInput >
+      static void apply( const ActionInput& in, sum_state& s )
+      {
+         if( in.string() == "-666" ) {
+            throw std::runtime_error( "evil number" );
+         }
+         ++s.numbers;
+         s.sum += std::stoll( in.string() );
+         const auto p = in.position();
+         s.positions += std::to_string( p.byte ) + ':' + std::to_string( p.line ) + ':' + std::to_string( p.byte_in_line ) + ' ';
+      }
+   };
+
+   template<>
+   struct sum_action< json::string_content >
+   {
+      template< typename ActionInput >
+      static void apply( const ActionInput& /*unused*/, sum_state& s )
+      {
+         ++s.strings;
+      }
+   };
+
+}  // namespace TAO_PEGTL_NAMESPACE
+
+#endif
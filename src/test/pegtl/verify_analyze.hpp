@@ -4,6 +4,8 @@
 #ifndef TAO_PEGTL_SRC_TEST_PEGTL_VERIFY_ANALYZE_HPP
 #define TAO_PEGTL_SRC_TEST_PEGTL_VERIFY_ANALYZE_HPP
 
+#include <cstddef>
+
 #include <tao/pegtl/analyze.hpp>
 
 #include "test.hpp"
@@ -15,15 +17,21 @@ namespace TAO_PEGTL_NAMESPACE
    {
       analysis::analyze_cycles< Rule > a( false );
 
-      const bool has_problems = ( a.problems() != 0 );
+      const std::size_t problems = a.problems();
+      const bool has_problems = ( problems != 0 );
       const bool does_consume = a.template consumes< Rule >();
 
+      constexpr auto s = analysis::analyze_static_v< Rule >;
+
       if( has_problems != expect_problems ) {
          TAO_PEGTL_TEST_FAILED( "analyze -- problems received/expected [ " << has_problems << " / " << expect_problems << " ]" );
       }
       if( does_consume != expect_consume ) {
          TAO_PEGTL_TEST_FAILED( "analyze -- consumes received/expected [ " << does_consume << " / " << expect_consume << " ]" );
       }
+      if( ( s.problems != problems ) || ( s.consumes != does_consume ) ) {
+         TAO_PEGTL_TEST_FAILED( "analyze -- static problems/consumes [ " << s.problems << " / " << s.consumes << " ] dynamic [ " << problems << " / " << does_consume << " ]" );
+      }
    }
 
 }  // namespace TAO_PEGTL_NAMESPACE